@@ -0,0 +1,49 @@
+//! Fixed benchmark corpus
+//!
+//! The pages are real-world patterns from the integration tests. Medium and
+//! large documents repeat a page's body until it reaches the target size, the
+//! way a category listing or a long comment thread does, so every size keeps
+//! the same head and the same mix of formats per kilobyte.
+
+/// News article with meta tags, Open Graph, Twitter Card and JSON-LD (~3KB)
+pub const NEWS_ARTICLE: &str = include_str!("news_article.html");
+
+/// Product card with microdata, microformats and RDFa
+pub const PRODUCT_LISTING: &str = include_str!("product_listing.html");
+
+/// Blog post marked up as an h-entry
+pub const BLOG_POST: &str = include_str!("blog_post.html");
+
+/// Base URL the documents are extracted against
+pub const BASE_URL: &str = "https://example.com/page";
+
+/// A named benchmark document
+pub struct Document {
+    pub name: &'static str,
+    pub html: String,
+}
+
+/// Small (~3KB), medium (~100KB) and large (~1MB) documents
+pub fn documents() -> Vec<Document> {
+    vec![
+        Document { name: "small", html: NEWS_ARTICLE.to_string() },
+        Document { name: "medium", html: grow(PRODUCT_LISTING, 100 * 1024) },
+        Document { name: "large", html: grow(BLOG_POST, 1024 * 1024) },
+    ]
+}
+
+/// Repeat the body of `page` until the document is at least `target` bytes
+fn grow(page: &str, target: usize) -> String {
+    let open = page.find("<body").expect("corpus page has a body");
+    let start = open + page[open..].find('>').expect("body tag is closed") + 1;
+    let end = page.rfind("</body>").expect("corpus page closes its body");
+    let body = &page[start..end];
+
+    let mut html = String::with_capacity(target + page.len());
+    html.push_str(&page[..end]);
+    while html.len() + page.len() - end < target {
+        html.push_str(body);
+    }
+    html.push_str(&page[end..]);
+    html
+}
@@ -0,0 +1,177 @@
+//! Extraction benchmarks
+//!
+//! Each extractor, the microformats parser, the combined `extract_all` path,
+//! JSON serialization and the C entry point are measured separately over the
+//! small/medium/large corpus.
+//!
+//! ```text
+//! cargo bench --bench extract
+//! cargo bench --bench extract -- 'extractors/json_ld'
+//! ```
+
+mod corpus;
+
+use std::ffi::CString;
+use std::hint::black_box;
+use std::ptr;
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use meta_oxide::extract::{self, ExtractOptions, Extraction};
+use meta_oxide::{extractors, ffi, html_utils, parser};
+
+use corpus::{Document, BASE_URL};
+
+/// Benchmark `f` over every corpus document in group `group`, under `name`
+fn over_corpus(
+    c: &mut Criterion,
+    docs: &[Document],
+    group: &str,
+    name: &str,
+    mut f: impl FnMut(&str),
+) {
+    let mut group = c.benchmark_group(group);
+    for doc in docs {
+        group.throughput(Throughput::Bytes(doc.html.len() as u64));
+        group.bench_with_input(BenchmarkId::new(name, doc.name), doc.html.as_str(), |b, html| {
+            b.iter(|| f(black_box(html)))
+        });
+    }
+    group.finish();
+}
+
+fn bench_parse(c: &mut Criterion) {
+    let docs = corpus::documents();
+    over_corpus(c, &docs, "parse", "dom", |html| {
+        black_box(html_utils::parse_html(html));
+    });
+    over_corpus(c, &docs, "parse", "microformats", |html| {
+        black_box(parser::parse_html(html, Some(BASE_URL)).ok());
+    });
+}
+
+fn bench_extractors(c: &mut Criterion) {
+    let docs = corpus::documents();
+    let base = Some(BASE_URL);
+
+    over_corpus(c, &docs, "extractors", "meta", |html| {
+        black_box(extractors::meta::extract(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "open_graph", |html| {
+        black_box(extractors::social::extract_opengraph(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "twitter", |html| {
+        black_box(extractors::social::extract_twitter_with_fallback(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "json_ld", |html| {
+        black_box(extractors::jsonld::extract(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "microdata", |html| {
+        black_box(extractors::microdata::extract(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "rdfa", |html| {
+        black_box(extractors::rdfa::extract(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "dublin_core", |html| {
+        black_box(extractors::dublin_core::extract(html).ok());
+    });
+    over_corpus(c, &docs, "extractors", "manifest", |html| {
+        black_box(extractors::manifest::extract(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "oembed", |html| {
+        black_box(extractors::oembed::extract(html, base).ok());
+    });
+    over_corpus(c, &docs, "extractors", "rel_links", |html| {
+        black_box(extractors::rel_links::extract(html, base).ok());
+    });
+}
+
+fn bench_extract_all(c: &mut Criterion) {
+    let docs = corpus::documents();
+    let all = ExtractOptions::default();
+    let head_only = ExtractOptions { head_only: true, ..Default::default() };
+
+    over_corpus(c, &docs, "extract_all", "all", |html| {
+        black_box(extract::extract_all(html, Some(BASE_URL), &all));
+    });
+    over_corpus(c, &docs, "extract_all", "head_only", |html| {
+        black_box(extract::extract_all(html, Some(BASE_URL), &head_only));
+    });
+}
+
+/// Serialize every field the way the C API does, one JSON string per format
+fn serialize_fields(extraction: &Extraction) -> usize {
+    fn len<T: serde::Serialize>(value: &Option<T>) -> usize {
+        value.as_ref().map_or(0, |v| serde_json::to_string(v).map_or(0, |s| s.len()))
+    }
+
+    len(&extraction.meta)
+        + len(&extraction.open_graph)
+        + len(&extraction.twitter)
+        + len(&extraction.json_ld)
+        + len(&extraction.microdata)
+        + len(&extraction.microformats)
+        + len(&extraction.rdfa)
+        + len(&extraction.dublin_core)
+        + len(&extraction.manifest)
+        + len(&extraction.oembed)
+        + len(&extraction.rel_links)
+}
+
+fn bench_serialize(c: &mut Criterion) {
+    let docs = corpus::documents();
+    let mut group = c.benchmark_group("serialize");
+    for doc in &docs {
+        let extraction =
+            extract::extract_all(&doc.html, Some(BASE_URL), &ExtractOptions::default());
+        group.throughput(Throughput::Bytes(serialize_fields(&extraction) as u64));
+        group.bench_with_input(BenchmarkId::new("json", doc.name), &extraction, |b, extraction| {
+            b.iter(|| serialize_fields(black_box(extraction)))
+        });
+    }
+    group.finish();
+}
+
+fn bench_ffi(c: &mut Criterion) {
+    let docs = corpus::documents();
+    let base = CString::new(BASE_URL).unwrap();
+    let mut group = c.benchmark_group("ffi");
+    for doc in &docs {
+        let html = CString::new(doc.html.as_str()).unwrap();
+        group.throughput(Throughput::Bytes(doc.html.len() as u64));
+        group.bench_with_input(BenchmarkId::new("extract_all", doc.name), &html, |b, html| {
+            b.iter(|| unsafe {
+                let result = ffi::meta_oxide_extract_all(html.as_ptr(), base.as_ptr());
+                ffi::meta_oxide_result_free(black_box(result));
+            })
+        });
+        group.bench_with_input(
+            BenchmarkId::new("extract_all_buffer", doc.name),
+            &html,
+            |b, html| {
+                b.iter(|| unsafe {
+                    let mut out = std::mem::MaybeUninit::<ffi::MetaOxideBuffer>::uninit();
+                    ffi::meta_oxide_extract_all_buffer(
+                        html.as_ptr(),
+                        doc.html.len(),
+                        base.as_ptr(),
+                        BASE_URL.len(),
+                        ptr::null(),
+                        out.as_mut_ptr(),
+                    );
+                    ffi::meta_oxide_buffer_free(black_box(out.as_mut_ptr()));
+                })
+            },
+        );
+    }
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_parse,
+    bench_extractors,
+    bench_extract_all,
+    bench_serialize,
+    bench_ffi
+);
+criterion_main!(benches);
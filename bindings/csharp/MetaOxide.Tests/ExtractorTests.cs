@@ -52,6 +52,53 @@ namespace MetaOxide.Tests
             Assert.Throws<ArgumentNullException>(() => Extractor.ExtractAll(""));
         }
 
+        [Fact]
+        public void ExtractSelected_OnlyReturnsSelectedFormats()
+        {
+            // Act
+            var result = Extractor.ExtractSelected(SimpleHtml, MetaOxideFormat.OpenGraph);
+
+            // Assert
+            result.OpenGraph.Should().NotBeNull();
+            result.OpenGraph!["title"].ToString().Should().Be("OG Title");
+            result.Meta.Should().BeNull();
+            result.Twitter.Should().BeNull();
+        }
+
+        [Fact]
+        public void ExtractSelected_WithNullHtml_ThrowsArgumentNullException()
+        {
+            // Act & Assert
+            Assert.Throws<ArgumentNullException>(() => Extractor.ExtractSelected(null!, MetaOxideFormat.All));
+        }
+
+        [Fact]
+        public void ExtractAllUtf8_WithBytes_ReturnsResult()
+        {
+            // Arrange
+            var bytes = System.Text.Encoding.UTF8.GetBytes(SimpleHtml);
+
+            // Act
+            var result = Extractor.ExtractAllUtf8(bytes);
+
+            // Assert
+            result.Meta.Should().NotBeNull();
+            result.Meta!["title"].ToString().Should().Be("Test Page");
+        }
+
+        [Fact]
+        public void ExtractAllUtf8_WithInvalidUtf8_ThrowsUnlessLossy()
+        {
+            // Arrange
+            var bytes = System.Text.Encoding.ASCII.GetBytes("<title>A?</title>");
+            bytes[8] = 0xE9;
+
+            // Act & Assert
+            Assert.Throws<MetaOxideException>(() => Extractor.ExtractAllUtf8(bytes));
+            var result = Extractor.ExtractAllUtf8(bytes, 0, bytes.Length, lossy: true);
+            result.Meta!["title"].ToString().Should().Be("A\uFFFD");
+        }
+
         [Fact]
         public void ExtractAll_WithBaseUrl_ReturnsResult()
         {
@@ -318,6 +365,43 @@ namespace MetaOxide.Tests
             result.GetMetadataFormatCount().Should().BeGreaterThan(3);
         }
 
+        [Fact]
+        public void ConfigureCache_AnswersRepeatedCalls()
+        {
+            // Test classes run in parallel and may extract meanwhile, so only lower bounds hold
+            const string html = "<html><head><title>Cached</title></head></html>";
+
+            Extractor.ConfigureCache(1 << 20);
+            try
+            {
+                // Act
+                Extractor.ExtractAll(html);
+                var result = Extractor.ExtractAll(html);
+                var stats = Extractor.GetCacheStats();
+
+                // Assert
+                result.Meta!["title"].ToString().Should().Be("Cached");
+                stats.Hits.Should().BeGreaterOrEqualTo(1);
+                stats.Entries.Should().BeGreaterOrEqualTo(1);
+            }
+            finally
+            {
+                Extractor.ConfigureCache(0);
+            }
+
+            Extractor.GetCacheStats().Entries.Should().Be(0);
+        }
+
+        [Fact]
+        public void ConfigureCache_RejectsNegativeBudget()
+        {
+            // Act
+            Action act = () => Extractor.ConfigureCache(-1);
+
+            // Assert
+            act.Should().Throw<ArgumentOutOfRangeException>();
+        }
+
         [Fact]
         public void GetDiagnosticInfo_ReturnsInformation()
         {
@@ -0,0 +1,44 @@
+namespace MetaOxide
+{
+    /// <summary>
+    /// Counters of the result cache, see <see cref="Extractor.ConfigureCache"/>.
+    /// </summary>
+    /// <remarks>
+    /// All counters are 0 while the cache is disabled. Every
+    /// <see cref="Extractor.ConfigureCache"/> call resets them.
+    /// </remarks>
+    public sealed class CacheStats
+    {
+        /// <summary>Full-document calls answered from the cache</summary>
+        public ulong Hits { get; }
+
+        /// <summary>Full-document calls that had to be extracted</summary>
+        public ulong Misses { get; }
+
+        /// <summary>Head-only calls answered from the cache</summary>
+        public ulong HeadHits { get; }
+
+        /// <summary>Head-only calls that had to be extracted</summary>
+        public ulong HeadMisses { get; }
+
+        /// <summary>Entries dropped to make room for newer ones</summary>
+        public ulong Evictions { get; }
+
+        /// <summary>Entries currently stored</summary>
+        public ulong Entries { get; }
+
+        /// <summary>Bytes currently accounted to the cache</summary>
+        public ulong Bytes { get; }
+
+        internal CacheStats(MetaOxideInterop.MetaOxideCacheStats stats)
+        {
+            Hits = stats.Hits;
+            Misses = stats.Misses;
+            HeadHits = stats.HeadHits;
+            HeadMisses = stats.HeadMisses;
+            Evictions = stats.Evictions;
+            Entries = stats.Entries.ToUInt64();
+            Bytes = stats.Bytes.ToUInt64();
+        }
+    }
+}
@@ -1,6 +1,7 @@
 using System;
 using System.Collections.Generic;
 using System.Runtime.InteropServices;
+using System.Text;
 using Newtonsoft.Json;
 using Newtonsoft.Json.Linq;
 
@@ -90,6 +91,115 @@ namespace MetaOxide
             }
         }
 
+        /// <summary>
+        /// Extract ALL metadata from UTF-8 encoded HTML bytes.
+        /// </summary>
+        /// <remarks>
+        /// The bytes are passed to the native library by pointer and length, without
+        /// decoding them into a string or making a NUL-terminated copy, so a response
+        /// body can be passed straight from a network buffer.
+        /// </remarks>
+        /// <param name="html">Buffer holding the UTF-8 encoded HTML (required)</param>
+        /// <param name="offset">Start of the HTML within <paramref name="html"/></param>
+        /// <param name="count">Length of the HTML in bytes</param>
+        /// <param name="baseUrl">Optional base URL for resolving relative URLs</param>
+        /// <param name="lossy">Replace invalid UTF-8 with U+FFFD instead of failing</param>
+        /// <returns>An ExtractionResult containing all extracted metadata</returns>
+        /// <exception cref="ArgumentNullException">Thrown when html is null</exception>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown when offset/count are outside html</exception>
+        /// <exception cref="MetaOxideException">Thrown when extraction fails or the bytes are not valid UTF-8</exception>
+        public static unsafe ExtractionResult ExtractAllUtf8(byte[] html, int offset, int count, string? baseUrl = null, bool lossy = false)
+        {
+            if (html == null)
+                throw new ArgumentNullException(nameof(html));
+            if (offset < 0 || count < 0 || offset > html.Length - count)
+                throw new ArgumentOutOfRangeException(nameof(count), "Slice is outside the HTML buffer");
+
+            byte[]? baseUrlBytes = baseUrl == null ? null : Encoding.UTF8.GetBytes(baseUrl);
+            uint flags = lossy ? MetaOxideInterop.InputLossy : 0;
+
+            IntPtr resultPtr;
+            fixed (byte* htmlPtr = html)
+            fixed (byte* baseUrlPtr = baseUrlBytes)
+            {
+                resultPtr = MetaOxideInterop.meta_oxide_extract_all_n(
+                    htmlPtr + offset,
+                    (UIntPtr)count,
+                    baseUrlPtr,
+                    (UIntPtr)(baseUrlBytes?.Length ?? 0),
+                    flags);
+            }
+
+            if (resultPtr == IntPtr.Zero)
+                throw MetaOxideException.FromLastError();
+
+            try
+            {
+                var nativeResult = Marshal.PtrToStructure<MetaOxideInterop.MetaOxideResult>(resultPtr);
+                return ExtractionResult.FromNative(nativeResult);
+            }
+            finally
+            {
+                MetaOxideInterop.meta_oxide_result_free(resultPtr);
+            }
+        }
+
+        /// <summary>
+        /// Extract ALL metadata from UTF-8 encoded HTML bytes.
+        /// </summary>
+        /// <param name="html">The UTF-8 encoded HTML (required)</param>
+        /// <param name="baseUrl">Optional base URL for resolving relative URLs</param>
+        /// <returns>An ExtractionResult containing all extracted metadata</returns>
+        /// <exception cref="ArgumentNullException">Thrown when html is null</exception>
+        /// <exception cref="MetaOxideException">Thrown when extraction fails or the bytes are not valid UTF-8</exception>
+        public static ExtractionResult ExtractAllUtf8(byte[] html, string? baseUrl = null)
+        {
+            if (html == null)
+                throw new ArgumentNullException(nameof(html));
+
+            return ExtractAllUtf8(html, 0, html.Length, baseUrl);
+        }
+
+        /// <summary>
+        /// Extract only the selected metadata formats from HTML.
+        /// </summary>
+        /// <remarks>
+        /// Extractors for formats not in <paramref name="formats"/> are never run,
+        /// and the corresponding properties of the result are null.
+        /// <see cref="MetaOxideFormat.None"/> selects every format.
+        /// </remarks>
+        /// <param name="html">The HTML content to parse (required)</param>
+        /// <param name="formats">The formats to extract</param>
+        /// <param name="baseUrl">Optional base URL for resolving relative URLs</param>
+        /// <returns>An ExtractionResult containing the selected metadata</returns>
+        /// <exception cref="ArgumentNullException">Thrown when html is null or empty</exception>
+        /// <exception cref="MetaOxideException">Thrown when extraction fails</exception>
+        /// <example>
+        /// <code>
+        /// var result = Extractor.ExtractSelected(html, MetaOxideFormat.Meta | MetaOxideFormat.OpenGraph);
+        /// </code>
+        /// </example>
+        public static ExtractionResult ExtractSelected(string html, MetaOxideFormat formats, string? baseUrl = null)
+        {
+            if (string.IsNullOrEmpty(html))
+                throw new ArgumentNullException(nameof(html), "HTML content cannot be null or empty");
+
+            IntPtr resultPtr = MetaOxideInterop.meta_oxide_extract_selected(html, baseUrl, (uint)formats);
+
+            if (resultPtr == IntPtr.Zero)
+                throw MetaOxideException.FromLastError();
+
+            try
+            {
+                var nativeResult = Marshal.PtrToStructure<MetaOxideInterop.MetaOxideResult>(resultPtr);
+                return ExtractionResult.FromNative(nativeResult);
+            }
+            finally
+            {
+                MetaOxideInterop.meta_oxide_result_free(resultPtr);
+            }
+        }
+
         #endregion
 
         #region Extract Individual Formats
@@ -342,6 +452,39 @@ namespace MetaOxide
 
         #endregion
 
+        #region Result Cache
+
+        /// <summary>
+        /// Enable or disable the result cache.
+        /// </summary>
+        /// <remarks>
+        /// While enabled, <see cref="ExtractAll"/> and the other multi-format methods look each
+        /// call up by a hash of its HTML, base URL and options and return the stored result of an
+        /// identical earlier call without parsing again. The cache is shared by the whole process,
+        /// including other bindings loaded into it; every call drops its entries and resets the
+        /// counters.
+        /// </remarks>
+        /// <param name="maxBytes">Memory budget of the cache; 0 disables it (the default)</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown when maxBytes is negative</exception>
+        public static void ConfigureCache(long maxBytes)
+        {
+            if (maxBytes < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxBytes), "Cache budget cannot be negative");
+
+            MetaOxideInterop.meta_oxide_cache_configure(new UIntPtr((ulong)maxBytes));
+        }
+
+        /// <summary>
+        /// Get the counters of the result cache.
+        /// </summary>
+        /// <returns>The current counters; all 0 while the cache is disabled</returns>
+        public static CacheStats GetCacheStats()
+        {
+            return new CacheStats(MetaOxideInterop.meta_oxide_cache_stats());
+        }
+
+        #endregion
+
         #region Helper Methods
 
         /// <summary>
@@ -69,6 +69,34 @@ namespace MetaOxide
             public IntPtr Manifest;
         }
 
+        /// <summary>
+        /// Native hit, miss and size counters of the result cache.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct MetaOxideCacheStats
+        {
+            /// <summary>Full-document calls answered from the cache</summary>
+            public ulong Hits;
+
+            /// <summary>Full-document calls that had to be extracted</summary>
+            public ulong Misses;
+
+            /// <summary>Head-only calls answered from the cache</summary>
+            public ulong HeadHits;
+
+            /// <summary>Head-only calls that had to be extracted</summary>
+            public ulong HeadMisses;
+
+            /// <summary>Entries dropped to make room for newer ones</summary>
+            public ulong Evictions;
+
+            /// <summary>Entries currently stored (size_t)</summary>
+            public UIntPtr Entries;
+
+            /// <summary>Bytes currently accounted to the cache (size_t)</summary>
+            public UIntPtr Bytes;
+        }
+
         /// <summary>
         /// Error codes returned by FFI functions.
         /// </summary>
@@ -94,6 +122,12 @@ namespace MetaOxide
 
             /// <summary>NULL pointer passed as argument</summary>
             NullPointer = 6,
+
+            /// <summary>Caller-provided output buffer is too small</summary>
+            BufferTooSmall = 7,
+
+            /// <summary>A resource limit was hit; the results are partial</summary>
+            LimitExceeded = 8,
         }
 
         #region Extraction Functions
@@ -109,6 +143,39 @@ namespace MetaOxide
             [MarshalAs(UnmanagedType.LPUTF8Str)] string html,
             [MarshalAs(UnmanagedType.LPUTF8Str)] string? baseUrl);
 
+        /// <summary>
+        /// Extract ALL metadata from a length-delimited UTF-8 buffer.
+        /// </summary>
+        /// <param name="html">Pointer to the HTML bytes (must not be null)</param>
+        /// <param name="len">Length of the HTML in bytes</param>
+        /// <param name="baseUrl">Pointer to the base URL bytes (can be null)</param>
+        /// <param name="baseLen">Length of the base URL in bytes</param>
+        /// <param name="flags">META_OXIDE_INPUT_* flags</param>
+        /// <returns>Pointer to MetaOxideResult structure, or IntPtr.Zero on error</returns>
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern unsafe IntPtr meta_oxide_extract_all_n(
+            byte* html,
+            UIntPtr len,
+            byte* baseUrl,
+            UIntPtr baseLen,
+            uint flags);
+
+        /// <summary>Replace invalid UTF-8 sequences with U+FFFD (META_OXIDE_INPUT_LOSSY)</summary>
+        internal const uint InputLossy = 1 << 0;
+
+        /// <summary>
+        /// Extract only the metadata formats selected by a bitmask.
+        /// </summary>
+        /// <param name="html">HTML content (must not be null)</param>
+        /// <param name="baseUrl">Optional base URL for resolving relative URLs (can be null)</param>
+        /// <param name="formats">Bitmask of META_OXIDE_FMT_* flags</param>
+        /// <returns>Pointer to MetaOxideResult structure, or IntPtr.Zero on error</returns>
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        internal static extern IntPtr meta_oxide_extract_selected(
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string html,
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string? baseUrl,
+            uint formats);
+
         /// <summary>
         /// Extract standard HTML meta tags.
         /// </summary>
@@ -199,6 +266,23 @@ namespace MetaOxide
 
         #endregion
 
+        #region Result Cache Functions
+
+        /// <summary>
+        /// Enable the result cache with a total budget of maxBytes, or disable it with 0.
+        /// </summary>
+        /// <param name="maxBytes">Memory budget of the cache (size_t)</param>
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void meta_oxide_cache_configure(UIntPtr maxBytes);
+
+        /// <summary>
+        /// Get the counters of the result cache; all zero while caching is disabled.
+        /// </summary>
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern MetaOxideCacheStats meta_oxide_cache_stats();
+
+        #endregion
+
         #region Memory Management Functions
 
         /// <summary>
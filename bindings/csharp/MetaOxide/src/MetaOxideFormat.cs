@@ -0,0 +1,42 @@
+using System;
+
+namespace MetaOxide
+{
+    /// <summary>
+    /// Metadata formats that can be selected with <see cref="Extractor.ExtractSelected"/>.
+    /// </summary>
+    /// <remarks>
+    /// Values match the <c>META_OXIDE_FMT_*</c> constants of the C API and can be
+    /// combined with bitwise OR.
+    /// </remarks>
+    [Flags]
+    public enum MetaOxideFormat : uint
+    {
+        /// <summary>No format given; extraction then selects every format</summary>
+        None = 0,
+        /// <summary>Standard HTML meta tags</summary>
+        Meta = 1 << 0,
+        /// <summary>Open Graph</summary>
+        OpenGraph = 1 << 1,
+        /// <summary>Twitter Cards</summary>
+        Twitter = 1 << 2,
+        /// <summary>JSON-LD</summary>
+        JsonLd = 1 << 3,
+        /// <summary>Microdata</summary>
+        Microdata = 1 << 4,
+        /// <summary>Microformats</summary>
+        Microformats = 1 << 5,
+        /// <summary>RDFa</summary>
+        Rdfa = 1 << 6,
+        /// <summary>Dublin Core</summary>
+        DublinCore = 1 << 7,
+        /// <summary>Web App Manifest discovery</summary>
+        Manifest = 1 << 8,
+        /// <summary>oEmbed discovery</summary>
+        OEmbed = 1 << 9,
+        /// <summary>rel-* link relationships</summary>
+        RelLinks = 1 << 10,
+        /// <summary>Every format</summary>
+        All = (1 << 11) - 1,
+    }
+}
@@ -5,6 +5,7 @@ import com.fasterxml.jackson.databind.ObjectMapper;
 
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardCopyOption;
@@ -45,6 +46,8 @@ import java.util.Map;
 public class Extractor {
 
     private static final ObjectMapper MAPPER = new ObjectMapper();
+    /** Matches META_OXIDE_INPUT_LOSSY in the C API. */
+    private static final int INPUT_LOSSY = 1;
     private static boolean libraryLoaded = false;
 
     static {
@@ -114,6 +117,29 @@ public class Extractor {
      */
     private static native String nativeExtractAll(String html, String baseUrl);
 
+    /**
+     * Native method to extract all metadata formats from a slice of UTF-8 bytes.
+     */
+    private static native String nativeExtractAllUtf8(byte[] html, int offset, int length,
+            String baseUrl, int flags);
+
+    /**
+     * Native method to extract all metadata formats from a slice of a direct buffer.
+     */
+    private static native String nativeExtractAllDirect(ByteBuffer html, int offset, int length,
+            String baseUrl, int flags);
+
+    /**
+     * Native method to extract all metadata formats from UTF-8 bytes as MessagePack.
+     */
+    private static native byte[] nativeExtractAllMsgpack(byte[] html, int offset, int length,
+            String baseUrl, int flags);
+
+    /**
+     * Native method to extract only the formats selected by a bitmask.
+     */
+    private static native String nativeExtractSelected(String html, String baseUrl, int formats);
+
     /**
      * Native method to extract standard HTML meta tags.
      */
@@ -174,6 +200,16 @@ public class Extractor {
      */
     private static native String nativeExtractRelLinks(String html, String baseUrl);
 
+    /**
+     * Native method to enable or disable the result cache.
+     */
+    private static native void nativeCacheConfigure(long maxBytes);
+
+    /**
+     * Native method to get the result cache counters.
+     */
+    private static native long[] nativeCacheStats();
+
     /**
      * Native method to get library version.
      */
@@ -197,31 +233,7 @@ public class Extractor {
             throw new MetaOxideException("HTML content cannot be null");
         }
 
-        String jsonResult = nativeExtractAll(html, baseUrl == null ? "" : baseUrl);
-        if (jsonResult == null) {
-            throw new MetaOxideException("Failed to extract metadata");
-        }
-
-        try {
-            @SuppressWarnings("unchecked")
-            Map<String, Object> resultMap = MAPPER.readValue(jsonResult, Map.class);
-
-            return new ExtractionResult(
-                    getMapOrEmpty(resultMap, "meta"),
-                    getMapOrEmpty(resultMap, "openGraph"),
-                    getMapOrEmpty(resultMap, "twitter"),
-                    getListOrEmpty(resultMap, "jsonLd"),
-                    getListOrEmpty(resultMap, "microdata"),
-                    getMapOrEmpty(resultMap, "microformats"),
-                    getListOrEmpty(resultMap, "rdfa"),
-                    getMapOrEmpty(resultMap, "dublinCore"),
-                    getMapOrEmpty(resultMap, "manifest"),
-                    getMapOrEmpty(resultMap, "oembed"),
-                    getMapOrEmpty(resultMap, "relLinks")
-            );
-        } catch (IOException e) {
-            throw new MetaOxideException("Failed to parse extraction result: " + e.getMessage(), e);
-        }
+        return toExtractionResult(nativeExtractAll(html, baseUrl == null ? "" : baseUrl));
     }
 
     /**
@@ -236,6 +248,126 @@ public class Extractor {
         return extractAll(html, null);
     }
 
+    /**
+     * Extract ALL metadata from UTF-8 encoded HTML bytes.
+     * <p>
+     * The slice is copied once into native memory and passed to the library as-is, skipping the
+     * String conversion of {@link #extractAll(String, String)}. Use this for bodies read straight
+     * from the network; {@link #extractAllUtf8(ByteBuffer, String, boolean)} avoids the copy for
+     * bodies already in a direct buffer. Invalid UTF-8 is rejected unless {@code lossy} is set,
+     * in which case invalid sequences are replaced with U+FFFD.
+     * </p>
+     *
+     * @param html    buffer holding the UTF-8 encoded HTML (required)
+     * @param offset  start of the HTML within {@code html}
+     * @param length  length of the HTML in bytes
+     * @param baseUrl the base URL for resolving relative URLs (optional, may be null or empty)
+     * @param lossy   whether to replace invalid UTF-8 instead of failing
+     * @return an ExtractionResult containing all extracted metadata
+     * @throws MetaOxideException if extraction fails
+     */
+    public static ExtractionResult extractAllUtf8(byte[] html, int offset, int length, String baseUrl,
+            boolean lossy) throws MetaOxideException {
+        if (html == null) {
+            throw new MetaOxideException("HTML content cannot be null");
+        }
+        if (offset < 0 || length < 0 || offset > html.length - length) {
+            throw new IndexOutOfBoundsException("Invalid HTML slice: offset=" + offset + ", length=" + length);
+        }
+
+        int flags = lossy ? INPUT_LOSSY : 0;
+        return toExtractionResult(nativeExtractAllUtf8(html, offset, length, baseUrl, flags));
+    }
+
+    /**
+     * Extract ALL metadata from the UTF-8 encoded HTML in a direct buffer.
+     * <p>
+     * The library reads the bytes between the buffer's position and limit in place, with no copy.
+     * The buffer's position is left unchanged. Invalid UTF-8 is handled as in
+     * {@link #extractAllUtf8(byte[], int, int, String, boolean)}.
+     * </p>
+     *
+     * @param html    direct buffer holding the UTF-8 encoded HTML (required)
+     * @param baseUrl the base URL for resolving relative URLs (optional, may be null or empty)
+     * @param lossy   whether to replace invalid UTF-8 instead of failing
+     * @return an ExtractionResult containing all extracted metadata
+     * @throws MetaOxideException if extraction fails
+     * @throws IllegalArgumentException if {@code html} is not a direct buffer
+     */
+    public static ExtractionResult extractAllUtf8(ByteBuffer html, String baseUrl, boolean lossy)
+            throws MetaOxideException {
+        if (html == null) {
+            throw new MetaOxideException("HTML content cannot be null");
+        }
+        if (!html.isDirect()) {
+            throw new IllegalArgumentException("HTML buffer must be a direct buffer");
+        }
+
+        int flags = lossy ? INPUT_LOSSY : 0;
+        return toExtractionResult(
+                nativeExtractAllDirect(html, html.position(), html.remaining(), baseUrl, flags));
+    }
+
+    /**
+     * Extract ALL metadata from UTF-8 encoded HTML bytes.
+     *
+     * @param html    the UTF-8 encoded HTML (required)
+     * @param baseUrl the base URL for resolving relative URLs (optional, may be null or empty)
+     * @return an ExtractionResult containing all extracted metadata
+     * @throws MetaOxideException if extraction fails or the bytes are not valid UTF-8
+     * @see #extractAllUtf8(byte[], int, int, String, boolean)
+     */
+    public static ExtractionResult extractAllUtf8(byte[] html, String baseUrl) throws MetaOxideException {
+        if (html == null) {
+            throw new MetaOxideException("HTML content cannot be null");
+        }
+        return extractAllUtf8(html, 0, html.length, baseUrl, false);
+    }
+
+    /**
+     * Extract ALL metadata from UTF-8 encoded HTML bytes as a MessagePack document.
+     * <p>
+     * The document is one map keyed like the C API's combined document ({@code meta},
+     * {@code openGraph}, {@code twitter}, {@code jsonLd}, ...), holding the values
+     * {@link #extractAll(String, String)} returns as JSON. It is typically a fraction of the
+     * size of the JSON text and needs no text parsing to read back, so it suits results that
+     * are written to a queue or a columnar store rather than used in Java.
+     * </p>
+     *
+     * @param html    the UTF-8 encoded HTML (required)
+     * @param baseUrl the base URL for resolving relative URLs (optional, may be null or empty)
+     * @return the MessagePack document
+     * @throws MetaOxideException if extraction fails or the bytes are not valid UTF-8
+     */
+    public static byte[] extractAllMsgpack(byte[] html, String baseUrl) throws MetaOxideException {
+        if (html == null) {
+            throw new MetaOxideException("HTML content cannot be null");
+        }
+        return nativeExtractAllMsgpack(html, 0, html.length, baseUrl, 0);
+    }
+
+    /**
+     * Extract only the selected metadata formats from HTML.
+     * <p>
+     * Extractors for formats not set in {@code formats} are never run, and their
+     * fields in the result are empty. A mask of 0 selects every format.
+     * </p>
+     *
+     * @param html    the HTML content to extract from (required)
+     * @param baseUrl the base URL for resolving relative URLs (optional, may be null or empty)
+     * @param formats bitmask of {@link Formats} constants, e.g. {@code Formats.META | Formats.OPEN_GRAPH}
+     * @return an ExtractionResult containing the selected metadata
+     * @throws MetaOxideException if extraction fails
+     */
+    public static ExtractionResult extractSelected(String html, String baseUrl, int formats)
+            throws MetaOxideException {
+        if (html == null) {
+            throw new MetaOxideException("HTML content cannot be null");
+        }
+
+        return toExtractionResult(nativeExtractSelected(html, baseUrl == null ? "" : baseUrl, formats));
+    }
+
     /**
      * Extract standard HTML meta tags (title, description, keywords, canonical, etc.).
      *
@@ -423,6 +555,38 @@ public class Extractor {
         return extractRelLinks(html, null);
     }
 
+    /**
+     * Enable or disable the result cache.
+     * <p>
+     * While enabled, {@link #extractAll(String, String)} and the other multi-format methods look
+     * each call up by a hash of its HTML, base URL and options and return the stored result of an
+     * identical earlier call without parsing again. The cache is shared by the whole process,
+     * including other bindings loaded into it; every call drops its entries and resets the
+     * counters.
+     * </p>
+     *
+     * @param maxBytes memory budget of the cache; 0 disables it (the default)
+     */
+    public static void configureCache(long maxBytes) {
+        nativeCacheConfigure(maxBytes);
+    }
+
+    /**
+     * Get the counters of the result cache.
+     *
+     * @return hits, misses, headHits, headMisses, evictions, entries and bytes; all 0 while the
+     *         cache is disabled
+     */
+    public static Map<String, Long> getCacheStats() {
+        String[] keys = {"hits", "misses", "headHits", "headMisses", "evictions", "entries", "bytes"};
+        long[] values = nativeCacheStats();
+        Map<String, Long> stats = new java.util.LinkedHashMap<>();
+        for (int i = 0; i < keys.length; i++) {
+            stats.put(keys[i], values[i]);
+        }
+        return stats;
+    }
+
     /**
      * Get the version of the MetaOxide library.
      *
@@ -452,6 +616,33 @@ public class Extractor {
         return new java.util.ArrayList<>();
     }
 
+    private static ExtractionResult toExtractionResult(String jsonResult) throws MetaOxideException {
+        if (jsonResult == null) {
+            throw new MetaOxideException("Failed to extract metadata");
+        }
+
+        try {
+            @SuppressWarnings("unchecked")
+            Map<String, Object> resultMap = MAPPER.readValue(jsonResult, Map.class);
+
+            return new ExtractionResult(
+                    getMapOrEmpty(resultMap, "meta"),
+                    getMapOrEmpty(resultMap, "openGraph"),
+                    getMapOrEmpty(resultMap, "twitter"),
+                    getListOrEmpty(resultMap, "jsonLd"),
+                    getListOrEmpty(resultMap, "microdata"),
+                    getMapOrEmpty(resultMap, "microformats"),
+                    getListOrEmpty(resultMap, "rdfa"),
+                    getMapOrEmpty(resultMap, "dublinCore"),
+                    getMapOrEmpty(resultMap, "manifest"),
+                    getMapOrEmpty(resultMap, "oembed"),
+                    getMapOrEmpty(resultMap, "relLinks")
+            );
+        } catch (IOException e) {
+            throw new MetaOxideException("Failed to parse extraction result: " + e.getMessage(), e);
+        }
+    }
+
     private static Map<String, Object> parseJsonObject(String json) throws MetaOxideException {
         if (json == null) {
             throw new MetaOxideException("Extraction failed - null result");
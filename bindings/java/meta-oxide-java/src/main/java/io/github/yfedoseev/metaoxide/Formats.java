@@ -0,0 +1,42 @@
+package io.github.yfedoseev.metaoxide;
+
+/**
+ * Format selection flags for {@link Extractor#extractSelected(String, String, int)}.
+ * <p>
+ * Combine flags with bitwise OR, e.g. {@code Formats.META | Formats.OPEN_GRAPH}.
+ * The values match the {@code META_OXIDE_FMT_*} constants of the C API.
+ * </p>
+ *
+ * @since 0.1.0
+ */
+public final class Formats {
+
+    /** Standard HTML meta tags. */
+    public static final int META = 1 << 0;
+    /** Open Graph. */
+    public static final int OPEN_GRAPH = 1 << 1;
+    /** Twitter Cards. */
+    public static final int TWITTER = 1 << 2;
+    /** JSON-LD. */
+    public static final int JSON_LD = 1 << 3;
+    /** Microdata. */
+    public static final int MICRODATA = 1 << 4;
+    /** Microformats. */
+    public static final int MICROFORMATS = 1 << 5;
+    /** RDFa. */
+    public static final int RDFA = 1 << 6;
+    /** Dublin Core. */
+    public static final int DUBLIN_CORE = 1 << 7;
+    /** Web App Manifest discovery. */
+    public static final int MANIFEST = 1 << 8;
+    /** oEmbed discovery. */
+    public static final int OEMBED = 1 << 9;
+    /** rel-* link relationships. */
+    public static final int REL_LINKS = 1 << 10;
+    /** Every format. */
+    public static final int ALL = (1 << 11) - 1;
+
+    // Prevent instantiation
+    private Formats() {
+    }
+}
@@ -114,6 +114,47 @@ static jstring c_string_to_java(JNIEnv *env, const char *c_str) {
     return (*env)->NewStringUTF(env, c_str);
 }
 
+/**
+ * Convert a combined result document to a Java string and free it.
+ *
+ * The library writes every format into one buffer, so the document is handed
+ * to Java as is.
+ */
+static jstring buffer_to_java(JNIEnv *env, int status, struct MetaOxideBuffer *buffer) {
+    if (status != 0) {
+        throw_last_error(env);
+        return NULL;
+    }
+
+    jstring j_result = c_string_to_java(env, buffer->data);
+    meta_oxide_buffer_free(buffer);
+    return j_result;
+}
+
+/**
+ * Copy a slice of a Java byte array into a malloc'd buffer.
+ *
+ * Extraction takes as long as the page takes to parse, so the array is copied
+ * out rather than pinned in a critical region, which would hold up garbage
+ * collection for every other thread meanwhile.
+ * Returns NULL with an exception pending on failure; the caller must free
+ * the returned buffer.
+ */
+static char *copy_byte_range(JNIEnv *env, jbyteArray array, jint offset, jint length) {
+    char *copy = malloc(length > 0 ? (size_t) length : 1);
+    if (copy == NULL) {
+        throw_exception(env, "Failed to allocate memory for HTML bytes");
+        return NULL;
+    }
+
+    (*env)->GetByteArrayRegion(env, array, offset, length, (jbyte *) copy);
+    if ((*env)->ExceptionCheck(env)) {
+        free(copy);
+        return NULL;
+    }
+    return copy;
+}
+
 // ===== JNI Native Method Implementations =====
 
 /**
@@ -133,7 +174,10 @@ Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractAll(
     char *c_base_url = java_string_to_c(env, base_url);
 
     // Call C function
-    struct MetaOxideResult *result = meta_oxide_extract_all(c_html, c_base_url);
+    struct MetaOxideBuffer buffer;
+    int status = meta_oxide_extract_all_buffer(
+        c_html, strlen(c_html), c_base_url, c_base_url != NULL ? strlen(c_base_url) : 0,
+        NULL, &buffer);
 
     // Release Java string
     (*env)->ReleaseStringUTFChars(env, html, c_html);
@@ -141,124 +185,150 @@ Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractAll(
         free(c_base_url);
     }
 
-    // Check for error
-    if (result == NULL) {
-        throw_last_error(env);
-        return NULL;
-    }
+    return buffer_to_java(env, status, &buffer);
+}
 
-    // Build JSON result manually (simple concatenation)
-    // Estimate size: all 11 fields + JSON structure
-    size_t total_size = 1024; // Base size for structure
-    if (result->meta != NULL) total_size += strlen(result->meta);
-    if (result->open_graph != NULL) total_size += strlen(result->open_graph);
-    if (result->twitter != NULL) total_size += strlen(result->twitter);
-    if (result->json_ld != NULL) total_size += strlen(result->json_ld);
-    if (result->microdata != NULL) total_size += strlen(result->microdata);
-    if (result->microformats != NULL) total_size += strlen(result->microformats);
-    if (result->rdfa != NULL) total_size += strlen(result->rdfa);
-    if (result->dublin_core != NULL) total_size += strlen(result->dublin_core);
-    if (result->manifest != NULL) total_size += strlen(result->manifest);
-    if (result->oembed != NULL) total_size += strlen(result->oembed);
-    if (result->rel_links != NULL) total_size += strlen(result->rel_links);
+/**
+ * Extract all metadata formats from UTF-8 bytes.
+ *
+ * The slice is handed to the library by pointer and length, so the HTML is
+ * neither converted to modified UTF-8 nor NUL-terminated.
+ */
+JNIEXPORT jstring JNICALL
+Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractAllUtf8(
+        JNIEnv *env, jclass cls, jbyteArray html, jint offset, jint length, jstring base_url,
+        jint flags) {
 
-    char *json = (char *) malloc(total_size);
-    if (json == NULL) {
-        meta_oxide_result_free(result);
-        throw_exception(env, "Out of memory");
+    char *c_html = copy_byte_range(env, html, offset, length);
+    if (c_html == NULL) {
         return NULL;
     }
 
-    // Build JSON object
-    strcpy(json, "{");
+    char *c_base_url = java_string_to_c(env, base_url);
 
-    if (result->meta != NULL) {
-        strcat(json, "\"meta\":");
-        strcat(json, result->meta);
-    } else {
-        strcat(json, "\"meta\":{}");
-    }
+    struct MetaOxideOptions options = {0};
+    options.input_flags = (uint32_t) flags;
 
-    strcat(json, ",\"openGraph\":");
-    if (result->open_graph != NULL) {
-        strcat(json, result->open_graph);
-    } else {
-        strcat(json, "{}");
-    }
+    struct MetaOxideBuffer buffer;
+    int status = meta_oxide_extract_all_buffer(
+        c_html, (size_t) length,
+        c_base_url, c_base_url != NULL ? strlen(c_base_url) : 0, &options, &buffer);
 
-    strcat(json, ",\"twitter\":");
-    if (result->twitter != NULL) {
-        strcat(json, result->twitter);
-    } else {
-        strcat(json, "{}");
+    free(c_html);
+    if (c_base_url != NULL) {
+        free(c_base_url);
     }
 
-    strcat(json, ",\"jsonLd\":");
-    if (result->json_ld != NULL) {
-        strcat(json, result->json_ld);
-    } else {
-        strcat(json, "[]");
-    }
+    return buffer_to_java(env, status, &buffer);
+}
 
-    strcat(json, ",\"microdata\":");
-    if (result->microdata != NULL) {
-        strcat(json, result->microdata);
-    } else {
-        strcat(json, "[]");
+/**
+ * Extract all metadata formats from the UTF-8 bytes of a direct ByteBuffer.
+ *
+ * The library reads the buffer's memory in place, without a copy and without
+ * pinning any Java object.
+ */
+JNIEXPORT jstring JNICALL
+Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractAllDirect(
+        JNIEnv *env, jclass cls, jobject html, jint offset, jint length, jstring base_url,
+        jint flags) {
+
+    const char *c_html = (*env)->GetDirectBufferAddress(env, html);
+    if (c_html == NULL) {
+        throw_exception(env, "HTML buffer is not a direct buffer");
+        return NULL;
     }
 
-    strcat(json, ",\"microformats\":");
-    if (result->microformats != NULL) {
-        strcat(json, result->microformats);
-    } else {
-        strcat(json, "{}");
+    char *c_base_url = java_string_to_c(env, base_url);
+
+    struct MetaOxideOptions options = {0};
+    options.input_flags = (uint32_t) flags;
+
+    struct MetaOxideBuffer buffer;
+    int status = meta_oxide_extract_all_buffer(
+        c_html + offset, (size_t) length,
+        c_base_url, c_base_url != NULL ? strlen(c_base_url) : 0, &options, &buffer);
+
+    if (c_base_url != NULL) {
+        free(c_base_url);
     }
 
-    strcat(json, ",\"rdfa\":");
-    if (result->rdfa != NULL) {
-        strcat(json, result->rdfa);
-    } else {
-        strcat(json, "[]");
+    return buffer_to_java(env, status, &buffer);
+}
+
+/**
+ * Extract all metadata formats from UTF-8 bytes as a MessagePack document.
+ *
+ * Same as nativeExtractAllUtf8, but the library encodes the combined document
+ * as MessagePack, which is handed to Java as a byte array.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractAllMsgpack(
+        JNIEnv *env, jclass cls, jbyteArray html, jint offset, jint length, jstring base_url,
+        jint flags) {
+
+    char *c_html = copy_byte_range(env, html, offset, length);
+    if (c_html == NULL) {
+        return NULL;
     }
 
-    strcat(json, ",\"dublinCore\":");
-    if (result->dublin_core != NULL) {
-        strcat(json, result->dublin_core);
-    } else {
-        strcat(json, "{}");
+    char *c_base_url = java_string_to_c(env, base_url);
+
+    struct MetaOxideOptions options = {0};
+    options.input_flags = (uint32_t) flags;
+    options.encoding = META_OXIDE_ENCODING_MSGPACK;
+
+    struct MetaOxideBuffer buffer;
+    int status = meta_oxide_extract_all_buffer(
+        c_html, (size_t) length,
+        c_base_url, c_base_url != NULL ? strlen(c_base_url) : 0, &options, &buffer);
+
+    free(c_html);
+    if (c_base_url != NULL) {
+        free(c_base_url);
     }
 
-    strcat(json, ",\"manifest\":");
-    if (result->manifest != NULL) {
-        strcat(json, result->manifest);
-    } else {
-        strcat(json, "{}");
+    if (status != 0) {
+        throw_last_error(env);
+        return NULL;
     }
 
-    strcat(json, ",\"oembed\":");
-    if (result->oembed != NULL) {
-        strcat(json, result->oembed);
-    } else {
-        strcat(json, "{}");
+    jbyteArray j_result = (*env)->NewByteArray(env, (jsize) buffer.len);
+    if (j_result != NULL) {
+        (*env)->SetByteArrayRegion(env, j_result, 0, (jsize) buffer.len, (const jbyte *) buffer.data);
     }
+    meta_oxide_buffer_free(&buffer);
+    return j_result;
+}
 
-    strcat(json, ",\"relLinks\":");
-    if (result->rel_links != NULL) {
-        strcat(json, result->rel_links);
-    } else {
-        strcat(json, "{}");
+/**
+ * Extract only the formats selected by a META_OXIDE_FMT_* bitmask.
+ */
+JNIEXPORT jstring JNICALL
+Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractSelected(
+        JNIEnv *env, jclass cls, jstring html, jstring base_url, jint formats) {
+
+    const char *c_html = (*env)->GetStringUTFChars(env, html, NULL);
+    if (c_html == NULL) {
+        throw_exception(env, "Failed to convert HTML string");
+        return NULL;
     }
 
-    strcat(json, "}");
+    char *c_base_url = java_string_to_c(env, base_url);
 
-    // Create Java string
-    jstring j_result = c_string_to_java(env, json);
+    struct MetaOxideBuffer buffer;
+    struct MetaOxideOptions options = {0};
+    options.formats = (uint32_t) formats;
+    int status = meta_oxide_extract_all_buffer(
+        c_html, strlen(c_html), c_base_url, c_base_url != NULL ? strlen(c_base_url) : 0,
+        &options, &buffer);
 
-    // Free resources
-    free(json);
-    meta_oxide_result_free(result);
+    (*env)->ReleaseStringUTFChars(env, html, c_html);
+    if (c_base_url != NULL) {
+        free(c_base_url);
+    }
 
-    return j_result;
+    return buffer_to_java(env, status, &buffer);
 }
 
 /**
@@ -606,6 +676,41 @@ Java_io_github_yfedoseev_metaoxide_Extractor_nativeExtractRelLinks(
     return j_result;
 }
 
+/**
+ * Enable the result cache with a memory budget, or disable it with 0.
+ */
+JNIEXPORT void JNICALL
+Java_io_github_yfedoseev_metaoxide_Extractor_nativeCacheConfigure(
+        JNIEnv *env, jclass cls, jlong max_bytes) {
+    meta_oxide_cache_configure(max_bytes > 0 ? (size_t) max_bytes : 0);
+}
+
+/**
+ * Get the result cache counters as
+ * {hits, misses, headHits, headMisses, evictions, entries, bytes}.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_io_github_yfedoseev_metaoxide_Extractor_nativeCacheStats(
+        JNIEnv *env, jclass cls) {
+    struct MetaOxideCacheStats stats = meta_oxide_cache_stats();
+    jlong values[7] = {
+        (jlong) stats.hits,
+        (jlong) stats.misses,
+        (jlong) stats.head_hits,
+        (jlong) stats.head_misses,
+        (jlong) stats.evictions,
+        (jlong) stats.entries,
+        (jlong) stats.bytes,
+    };
+
+    jlongArray j_result = (*env)->NewLongArray(env, 7);
+    if (j_result == NULL) {
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, j_result, 0, 7, values);
+    return j_result;
+}
+
 /**
  * Get library version.
  */
@@ -5,6 +5,8 @@ import org.junit.jupiter.api.DisplayName;
 import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.ValueSource;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
 import java.util.List;
 import java.util.Map;
 
@@ -54,6 +56,68 @@ class ExtractorTest {
         assertEquals("summary", result.twitter.get("card"));
     }
 
+    @Test
+    @DisplayName("Extract only the selected formats")
+    void testExtractSelected() throws MetaOxideException {
+        String html = "<html><head>" +
+                "<title>Test Page</title>" +
+                "<meta property=\"og:title\" content=\"OG Title\">" +
+                "</head></html>";
+
+        ExtractionResult result = Extractor.extractSelected(html, null, Formats.OPEN_GRAPH);
+
+        assertNotNull(result);
+        assertEquals("OG Title", result.openGraph.get("title"));
+        assertTrue(result.meta.isEmpty(), "Unselected meta should be empty");
+        assertTrue(result.twitter.isEmpty(), "Unselected twitter should be empty");
+    }
+
+    @Test
+    @DisplayName("Extract all metadata from UTF-8 bytes")
+    void testExtractAllUtf8() throws MetaOxideException {
+        byte[] html = ("<html><head><title>Caf\u00e9 \uD83D\uDE00</title></head></html>")
+                .getBytes(StandardCharsets.UTF_8);
+
+        ExtractionResult result = Extractor.extractAllUtf8(html, null);
+        assertEquals("Caf\u00e9 \uD83D\uDE00", result.meta.get("title"));
+
+        byte[] invalid = "<title>A?</title>".getBytes(StandardCharsets.US_ASCII);
+        invalid[8] = (byte) 0xE9;
+        assertThrows(MetaOxideException.class, () -> Extractor.extractAllUtf8(invalid, null));
+
+        ExtractionResult lossy = Extractor.extractAllUtf8(invalid, 0, invalid.length, null, true);
+        assertEquals("A\uFFFD", lossy.meta.get("title"));
+    }
+
+    @Test
+    @DisplayName("Extract all metadata from a direct buffer")
+    void testExtractAllUtf8Direct() throws MetaOxideException {
+        byte[] bytes = "xx<title>Direct</title>".getBytes(StandardCharsets.UTF_8);
+        ByteBuffer html = ByteBuffer.allocateDirect(bytes.length).put(bytes);
+        html.position(2);
+
+        ExtractionResult result = Extractor.extractAllUtf8(html, null, false);
+        assertEquals("Direct", result.meta.get("title"));
+        assertEquals(2, html.position());
+
+        assertThrows(IllegalArgumentException.class,
+                () -> Extractor.extractAllUtf8(ByteBuffer.wrap(bytes), null, false));
+    }
+
+    @Test
+    @DisplayName("Extract all formats as MessagePack")
+    void testExtractAllMsgpack() throws MetaOxideException {
+        String html = "<html><head><title>Packed</title>" +
+                "<meta property=\"og:title\" content=\"OG\"></head></html>";
+        byte[] utf8 = html.getBytes(StandardCharsets.UTF_8);
+
+        byte[] packed = Extractor.extractAllMsgpack(utf8, null);
+        assertEquals(0x80, packed[0] & 0xF0, "document should be a map");
+        assertEquals((byte) 0xA4, packed[1], "first key should be a 4-byte string");
+        assertEquals("meta", new String(packed, 2, 4, StandardCharsets.UTF_8));
+        assertTrue(new String(packed, StandardCharsets.ISO_8859_1).contains("openGraph"));
+    }
+
     @Test
     @DisplayName("Extract standard HTML meta tags")
     void testExtractMeta() throws MetaOxideException {
@@ -439,6 +503,27 @@ class ExtractorTest {
         assertTrue(str.contains("meta"));
     }
 
+    @Test
+    @DisplayName("Result cache answers repeated calls")
+    void testResultCache() throws MetaOxideException {
+        String html = "<html><head><title>Cached</title></head></html>";
+
+        Extractor.configureCache(1 << 20);
+        try {
+            Extractor.extractAll(html);
+            ExtractionResult result = Extractor.extractAll(html);
+            assertEquals("Cached", result.meta.get("title"));
+
+            Map<String, Long> stats = Extractor.getCacheStats();
+            assertEquals(1L, stats.get("hits"));
+            assertEquals(1L, stats.get("misses"));
+            assertEquals(1L, stats.get("entries"));
+        } finally {
+            Extractor.configureCache(0);
+        }
+        assertEquals(0L, Extractor.getCacheStats().get("entries"));
+    }
+
     @Test
     @DisplayName("Verify MetaOxideException toString")
     void testExceptionToString() {
@@ -4,10 +4,21 @@
  */
 
 const {
+  cacheConfigure,
+  cacheStats,
   extractAll,
+  extractAllAsync,
+  extractAllBatchAsync,
+  extractAllMsgpack,
+  extractAllWithStats,
+  extractJsonLd,
   extractMeta,
   extractOpengraph,
   extractTwitter,
+  FMT_JSON_LD,
+  FMT_META,
+  FMT_OPEN_GRAPH,
+  FMT_REL_LINKS,
 } = require('../index.js')
 
 describe('meta-oxide-node bindings', () => {
@@ -51,6 +62,64 @@ describe('meta-oxide-node bindings', () => {
       expect(typeof parsed).toBe('object')
     })
 
+    it('should skip the body in headOnly mode', () => {
+      const html = `
+        <html>
+          <head><meta property="og:title" content="Head Title"></head>
+          <body><a rel="me" href="https://example.com/me">Me</a></body>
+        </html>
+      `
+      const parsed = JSON.parse(extractAll(html, null, { headOnly: true }))
+      expect(parsed.opengraph.title).toBe('Head Title')
+      expect(parsed).not.toHaveProperty('rel_links')
+
+      const full = JSON.parse(extractAll(html))
+      expect(full).toHaveProperty('rel_links')
+    })
+
+    it('should only extract the selected formats', () => {
+      const html = `
+        <html>
+          <head>
+            <title>Page</title>
+            <meta property="og:title" content="Head Title">
+          </head>
+          <body><a rel="me" href="https://example.com/me">Me</a></body>
+        </html>
+      `
+      const parsed = JSON.parse(
+        extractAll(html, null, { formats: FMT_OPEN_GRAPH | FMT_REL_LINKS })
+      )
+      expect(parsed.opengraph.title).toBe('Head Title')
+      expect(parsed).toHaveProperty('rel_links')
+      expect(parsed).not.toHaveProperty('meta')
+      expect(parsed).not.toHaveProperty('twitter')
+    })
+
+    it('should report stats for the selected formats', () => {
+      const html = `
+        <html><head>
+          <title>Stats</title>
+          <script type="application/ld+json">[{"@type": "A"}, {"@type": "B"}]</script>
+        </head></html>
+      `
+      const { result, stats } = extractAllWithStats(html, null, {
+        formats: FMT_META | FMT_JSON_LD,
+      })
+      expect(JSON.parse(result).jsonld).toHaveLength(2)
+      expect(stats.inputBytes).toBe(Buffer.byteLength(html))
+      expect(stats.domNodes).toBeGreaterThan(0)
+      expect(Object.keys(stats.formats).sort()).toEqual(['jsonld', 'meta'])
+      expect(stats.formats.jsonld.items).toBe(2)
+      expect(stats.totalNs).toBeGreaterThanOrEqual(stats.parseNs + stats.serializeNs)
+    })
+
+    it('should accept HTML containing NUL characters', () => {
+      const html = '<html><head><title>Before\u0000After</title></head></html>'
+      const parsed = JSON.parse(extractAll(html))
+      expect(parsed.meta.title).toContain('Before')
+    })
+
     it('should extract from minimal HTML', () => {
       const html = '<html></html>'
       const result = extractAll(html)
@@ -629,4 +698,122 @@ describe('meta-oxide-node bindings', () => {
       expect(result.jsonld).toBeDefined()
     })
   })
+
+  describe('extractAllAsync', () => {
+    const html = `
+      <html><head>
+        <title>Café</title>
+        <meta property="og:title" content="Async Title">
+        <link rel="canonical" href="/page">
+      </head></html>
+    `
+
+    it('should resolve to the same object extractAll returns', async () => {
+      const result = await extractAllAsync(html, 'https://example.com/')
+      expect(result).toEqual(JSON.parse(extractAll(html, 'https://example.com/')))
+      expect(result.meta.canonical).toBe('https://example.com/page')
+    })
+
+    it('should read Buffer input', async () => {
+      const result = await extractAllAsync(Buffer.from(html), null, {
+        formats: FMT_META | FMT_OPEN_GRAPH,
+      })
+      expect(result.meta.title).toBe('Café')
+      expect(result.opengraph.title).toBe('Async Title')
+      expect(result).not.toHaveProperty('twitter')
+    })
+
+    it('should extract a batch in input order', async () => {
+      const template = (i) => `<html><head><meta property="og:title" content="Page ${i}"></head></html>`
+      const documents = Array.from({ length: 20 }, (_, i) =>
+        i % 2 ? Buffer.from(template(i)) : template(i)
+      )
+
+      const results = await extractAllBatchAsync(documents, null, { formats: FMT_OPEN_GRAPH })
+      expect(results.map((r) => r.opengraph.title)).toEqual(
+        Array.from({ length: 20 }, (_, i) => `Page ${i}`)
+      )
+      expect(() => extractAllBatchAsync(documents, [null])).toThrow()
+    })
+  })
+
+  describe('extractAllMsgpack', () => {
+    const html = `<html><head><title>Packed</title>
+      <meta property="og:title" content="OG"></head></html>`
+
+    it('should return a smaller MessagePack map', () => {
+      const packed = extractAllMsgpack(html)
+      expect(Buffer.isBuffer(packed)).toBe(true)
+      expect(packed[0] & 0xf0).toBe(0x80)
+      expect(packed.length).toBeLessThan(extractAll(html).length)
+      // "meta" is the first key
+      expect(packed.subarray(1, 6)).toEqual(Buffer.from([0xa4, ...Buffer.from('meta')]))
+    })
+
+    it('should honour format selection', () => {
+      const packed = extractAllMsgpack(Buffer.from(html), null, { formats: FMT_OPEN_GRAPH })
+      expect(packed[0]).toBe(0x81)
+      expect(packed.includes(Buffer.from('openGraph'))).toBe(true)
+      expect(packed.includes(Buffer.from('Packed'))).toBe(false)
+    })
+  })
+
+  describe('cacheConfigure', () => {
+    afterEach(() => cacheConfigure(0))
+
+    it('should answer repeated calls from the cache', () => {
+      const html = '<html><head><title>Cached</title></head><body><p>1</p></body></html>'
+      cacheConfigure(1 << 20)
+
+      const first = extractAll(html)
+      expect(extractAll(html)).toBe(first)
+      const stats = cacheStats()
+      expect(stats.misses).toBe(1)
+      expect(stats.hits).toBe(1)
+      expect(stats.entries).toBe(1)
+      expect(stats.bytes).toBeGreaterThan(0)
+    })
+
+    it('should share head-only entries between pages with the same head', () => {
+      const head = '<html><head><title>Shared</title></head>'
+      cacheConfigure(1 << 20)
+
+      extractAll(`${head}<body>1</body></html>`, null, { headOnly: true })
+      const result = JSON.parse(extractAll(`${head}<body>2</body></html>`, null, { headOnly: true }))
+      expect(result.meta.title).toBe('Shared')
+      expect(cacheStats().headHits).toBe(1)
+    })
+
+    it('should report zeros and reject negative budgets when disabled', () => {
+      expect(cacheStats()).toEqual({
+        hits: 0,
+        misses: 0,
+        headHits: 0,
+        headMisses: 0,
+        evictions: 0,
+        entries: 0,
+        bytes: 0,
+      })
+      expect(() => cacheConfigure(-1)).toThrow()
+    })
+  })
+
+  describe('extractJsonLd', () => {
+    const html = `<script type="application/ld+json">{"@graph": [
+      {"@type": "ItemList", "itemListElement": [{"@type": "Product", "name": "Nested"}]},
+      {"@type": "Product", "name": "Shoe", "sku": "S1"}
+    ]}</script>`
+
+    it('should return every object without a filter', () => {
+      expect(extractJsonLd(html)).toHaveLength(2)
+    })
+
+    it('should keep only the requested types and properties', () => {
+      const products = extractJsonLd(Buffer.from(html), { types: ['Product'], properties: ['name'] })
+      expect(products).toHaveLength(1)
+      expect(products[0]['@type']).toBe('Product')
+      expect(products[0].name).toBe('Shoe')
+      expect(products[0]).not.toHaveProperty('sku')
+    })
+  })
 })
@@ -2,25 +2,195 @@
 
 use napi::bindgen_prelude::*;
 use napi_derive::napi;
+use std::borrow::Cow;
+use std::collections::HashMap;
 use std::ffi::{CStr, CString};
 
+/// Options for `extractAll`
+#[napi(object)]
+pub struct ExtractOptions {
+    /// Only parse the document head; parsing stops after `</head>` or the first
+    /// body element. JSON-LD scripts in the head are still extracted.
+    pub head_only: Option<bool>,
+    /// Bitmask of `FMT_*` constants selecting the formats to extract; formats
+    /// left out are never run and missing from the result. Defaults to `FMT_ALL`.
+    pub formats: Option<u32>,
+}
+
+/// Select standard HTML meta tags
+#[napi]
+pub const FMT_META: u32 = meta_oxide::ffi::META_OXIDE_FMT_META;
+/// Select Open Graph
+#[napi]
+pub const FMT_OPEN_GRAPH: u32 = meta_oxide::ffi::META_OXIDE_FMT_OPEN_GRAPH;
+/// Select Twitter Cards
+#[napi]
+pub const FMT_TWITTER: u32 = meta_oxide::ffi::META_OXIDE_FMT_TWITTER;
+/// Select JSON-LD
+#[napi]
+pub const FMT_JSON_LD: u32 = meta_oxide::ffi::META_OXIDE_FMT_JSON_LD;
+/// Select Microdata
+#[napi]
+pub const FMT_MICRODATA: u32 = meta_oxide::ffi::META_OXIDE_FMT_MICRODATA;
+/// Select Microformats
+#[napi]
+pub const FMT_MICROFORMATS: u32 = meta_oxide::ffi::META_OXIDE_FMT_MICROFORMATS;
+/// Select RDFa
+#[napi]
+pub const FMT_RDFA: u32 = meta_oxide::ffi::META_OXIDE_FMT_RDFA;
+/// Select Dublin Core
+#[napi]
+pub const FMT_DUBLIN_CORE: u32 = meta_oxide::ffi::META_OXIDE_FMT_DUBLIN_CORE;
+/// Select Web App Manifest discovery
+#[napi]
+pub const FMT_MANIFEST: u32 = meta_oxide::ffi::META_OXIDE_FMT_MANIFEST;
+/// Select oEmbed discovery
+#[napi]
+pub const FMT_OEMBED: u32 = meta_oxide::ffi::META_OXIDE_FMT_OEMBED;
+/// Select rel-* links
+#[napi]
+pub const FMT_REL_LINKS: u32 = meta_oxide::ffi::META_OXIDE_FMT_REL_LINKS;
+/// Select every format
+#[napi]
+pub const FMT_ALL: u32 = meta_oxide::ffi::META_OXIDE_FMT_ALL;
+
+/// Extraction time and item count of one format
+#[napi(object)]
+pub struct FormatStats {
+    /// Extraction time in nanoseconds
+    pub ns: i64,
+    /// Items found (objects, root items or relation types; 1 for single-object formats)
+    pub items: u32,
+}
+
+/// Timings and counts reported by `extractAllWithStats`
+#[napi(object)]
+pub struct ExtractStats {
+    /// Bytes of HTML parsed (the head section alone with `headOnly`)
+    pub input_bytes: i64,
+    /// Bytes of JSON produced by the core library
+    pub output_bytes: i64,
+    /// Nodes in the parsed DOM
+    pub dom_nodes: i64,
+    /// JSON-LD scripts skipped because they did not parse
+    pub json_ld_errors: u32,
+    /// Time spent building the DOM, in nanoseconds
+    pub parse_ns: i64,
+    /// Time spent collecting `<title>`, `<meta>` and `<link>` tags, in nanoseconds
+    pub head_scan_ns: i64,
+    /// Time spent serializing results to JSON, in nanoseconds
+    pub serialize_ns: i64,
+    /// Wall time of extraction and serialization together, in nanoseconds
+    pub total_ns: i64,
+    /// Per-format statistics keyed like the `extractAll` result, for selected formats only
+    pub formats: HashMap<String, FormatStats>,
+}
+
+/// Result of `extractAllWithStats`
+#[napi(object)]
+pub struct ExtractWithStats {
+    /// The same JSON string `extractAll` returns
+    pub result: String,
+    pub stats: ExtractStats,
+}
+
+// `extractAll` result keys by format bit position
+const FORMAT_KEYS: [&str; meta_oxide::ffi::META_OXIDE_FORMAT_COUNT] = [
+    "meta",
+    "opengraph",
+    "twitter",
+    "jsonld",
+    "microdata",
+    "microformats",
+    "rdfa",
+    "dublin_core",
+    "manifest",
+    "oembed",
+    "rel_links",
+];
+
 /// Extract all metadata from HTML and return as JSON string
 ///
 /// Extracts metadata in 13 formats and returns the result as a JSON string
 /// that can be parsed in JavaScript.
 #[napi]
-pub fn extractAll(html: String, base_url: Option<String>) -> Result<String> {
-    unsafe {
-        let c_html = CString::new(html)
-            .map_err(|e| Error::new(Status::GenericFailure, e.to_string()))?;
-        let c_base_url = base_url.as_ref().map(|url| {
-            CString::new(url.clone())
-                .map_err(|e| Error::new(Status::GenericFailure, e.to_string()))
-        }).transpose()?;
+pub fn extractAll(
+    html: String,
+    base_url: Option<String>,
+    options: Option<ExtractOptions>,
+) -> Result<String> {
+    extract_all_json(html, base_url, options, std::ptr::null_mut())
+}
 
-        let result_ptr = meta_oxide::ffi::meta_oxide_extract_all(
-            c_html.as_ptr(),
-            c_base_url.as_ref().map(|s| s.as_ptr()).unwrap_or(std::ptr::null()),
+/// Extract all metadata from HTML and report where the time went
+///
+/// Returns the `extractAll` JSON string together with parse, per-format and
+/// serialization timings.
+#[napi]
+pub fn extractAllWithStats(
+    html: String,
+    base_url: Option<String>,
+    options: Option<ExtractOptions>,
+) -> Result<ExtractWithStats> {
+    let selected = options
+        .as_ref()
+        .and_then(|o| o.formats)
+        .unwrap_or(meta_oxide::ffi::META_OXIDE_FMT_ALL);
+    let mut stats = meta_oxide::ffi::MetaOxideStats::default();
+    let result = extract_all_json(html, base_url, options, &mut stats)?;
+
+    let ns = |value: u64| i64::try_from(value).unwrap_or(i64::MAX);
+    let formats = FORMAT_KEYS
+        .iter()
+        .enumerate()
+        .filter(|&(i, _)| selected & (1 << i) != 0)
+        .map(|(i, key)| {
+            (key.to_string(), FormatStats { ns: ns(stats.format_ns[i]), items: stats.items[i] })
+        })
+        .collect();
+
+    Ok(ExtractWithStats {
+        result,
+        stats: ExtractStats {
+            input_bytes: stats.input_bytes as i64,
+            output_bytes: stats.output_bytes as i64,
+            dom_nodes: stats.dom_nodes as i64,
+            json_ld_errors: u32::try_from(stats.json_ld_errors).unwrap_or(u32::MAX),
+            parse_ns: ns(stats.parse_ns),
+            head_scan_ns: ns(stats.head_scan_ns),
+            serialize_ns: ns(stats.serialize_ns),
+            total_ns: ns(stats.total_ns),
+            formats,
+        },
+    })
+}
+
+fn extract_all_json(
+    html: String,
+    base_url: Option<String>,
+    options: Option<ExtractOptions>,
+    stats: *mut meta_oxide::ffi::MetaOxideStats,
+) -> Result<String> {
+    // Strings from JS are already valid UTF-8, so they are passed by length
+    // without a NUL-terminated copy or a second validation pass
+    let options = meta_oxide::ffi::MetaOxideOptions {
+        head_only: options.as_ref().and_then(|o| o.head_only).unwrap_or(false),
+        formats: options
+            .as_ref()
+            .and_then(|o| o.formats)
+            .unwrap_or(meta_oxide::ffi::META_OXIDE_FMT_ALL),
+        input_flags: meta_oxide::ffi::META_OXIDE_INPUT_TRUSTED_UTF8,
+        stats,
+        ..Default::default()
+    };
+
+    unsafe {
+        let result_ptr = meta_oxide::ffi::meta_oxide_extract_all_with_options_n(
+            html.as_ptr().cast(),
+            html.len(),
+            base_url.as_ref().map_or(std::ptr::null(), |url| url.as_ptr().cast()),
+            base_url.as_ref().map_or(0, |url| url.len()),
+            &options,
         );
 
         if result_ptr.is_null() {
@@ -126,6 +296,215 @@ pub fn extractAll(html: String, base_url: Option<String>) -> Result<String> {
     }
 }
 
+/// HTML for the async functions: a `Buffer` is read in place on the worker
+/// thread, a string is copied to UTF-8 once when the call is made
+type Html = Either<Buffer, String>;
+
+// Buffers are decoded as UTF-8, replacing invalid sequences
+fn html_text(html: &Html) -> Cow<'_, str> {
+    match html {
+        Either::A(buf) => String::from_utf8_lossy(buf),
+        Either::B(s) => Cow::Borrowed(s),
+    }
+}
+
+fn core_options(options: Option<&ExtractOptions>) -> meta_oxide::extract::ExtractOptions {
+    meta_oxide::extract::ExtractOptions {
+        head_only: options.and_then(|o| o.head_only).unwrap_or(false),
+        formats: options.and_then(|o| o.formats).unwrap_or(meta_oxide::extract::formats::ALL),
+        ..Default::default()
+    }
+}
+
+// The `extractAll` object of one extraction, built off the JS thread
+fn extraction_value(extraction: &meta_oxide::extract::Extraction) -> serde_json::Value {
+    let mut output = serde_json::Map::new();
+    macro_rules! put {
+        ($index:expr, $field:ident) => {
+            if let Some(value) = extraction.$field.as_ref() {
+                if let Ok(value) = serde_json::to_value(value) {
+                    output.insert(FORMAT_KEYS[$index].to_string(), value);
+                }
+            }
+        };
+    }
+    put!(0, meta);
+    put!(1, open_graph);
+    put!(2, twitter);
+    put!(3, json_ld);
+    put!(4, microdata);
+    put!(5, microformats);
+    put!(6, rdfa);
+    put!(7, dublin_core);
+    put!(8, manifest);
+    put!(9, oembed);
+    put!(10, rel_links);
+    serde_json::Value::Object(output)
+}
+
+/// One `extractAllAsync` call, run on the libuv thread pool
+pub struct ExtractAllTask {
+    html: Html,
+    base_url: Option<String>,
+    options: meta_oxide::extract::ExtractOptions,
+}
+
+impl Task for ExtractAllTask {
+    type Output = serde_json::Value;
+    type JsValue = serde_json::Value;
+
+    fn compute(&mut self) -> Result<Self::Output> {
+        let html = html_text(&self.html);
+        let extraction =
+            meta_oxide::extract::extract_all(&html, self.base_url.as_deref(), &self.options);
+        Ok(extraction_value(&extraction))
+    }
+
+    fn resolve(&mut self, _env: Env, output: Self::Output) -> Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+/// Extract all metadata from HTML without blocking the event loop
+///
+/// Takes the same arguments as `extractAll`, and the HTML may also be a
+/// `Buffer`, which is read in place; do not modify it until the promise
+/// settles. Parsing runs on the libuv thread pool and the promise resolves to
+/// the object `JSON.parse(extractAll(...))` would give.
+#[napi]
+pub fn extractAllAsync(
+    html: Either<Buffer, String>,
+    base_url: Option<String>,
+    options: Option<ExtractOptions>,
+) -> AsyncTask<ExtractAllTask> {
+    AsyncTask::new(ExtractAllTask { html, base_url, options: core_options(options.as_ref()) })
+}
+
+/// Extract all metadata from HTML as a MessagePack document
+///
+/// The document is one map keyed like the C API's combined document and the
+/// WASM `extractAllObject` result (`meta`, `openGraph`, `twitter`, `jsonLd`,
+/// ...), with the values `extractAll` would give as JSON. It is typically a
+/// fraction of the size of the JSON string and needs no text parsing to read
+/// back, so it suits results that go to a queue or a columnar store.
+#[napi]
+pub fn extractAllMsgpack(
+    html: Either<Buffer, String>,
+    base_url: Option<String>,
+    options: Option<ExtractOptions>,
+) -> Result<Buffer> {
+    let extraction = meta_oxide::extract::extract_all(
+        &html_text(&html),
+        base_url.as_deref(),
+        &core_options(options.as_ref()),
+    );
+    meta_oxide::msgpack::extraction_to_vec(&extraction)
+        .map(Buffer::from)
+        .map_err(|e| Error::new(Status::GenericFailure, e.to_string()))
+}
+
+/// One `extractAllBatchAsync` call
+pub struct ExtractBatchTask {
+    documents: Vec<Html>,
+    base_urls: Option<Vec<Option<String>>>,
+    options: meta_oxide::extract::ExtractOptions,
+}
+
+impl Task for ExtractBatchTask {
+    type Output = serde_json::Value;
+    type JsValue = serde_json::Value;
+
+    fn compute(&mut self) -> Result<Self::Output> {
+        let texts: Vec<Cow<'_, str>> = self.documents.iter().map(html_text).collect();
+        let (base_urls, options) = (&self.base_urls, &self.options);
+
+        let results = meta_oxide::pool::global().map(texts.len(), |i| {
+            let base_url = base_urls.as_ref().and_then(|urls| urls[i].as_deref());
+            extraction_value(&meta_oxide::extract::extract_all(&texts[i], base_url, options))
+        });
+        Ok(serde_json::Value::Array(results))
+    }
+
+    fn resolve(&mut self, _env: Env, output: Self::Output) -> Result<Self::JsValue> {
+        Ok(output)
+    }
+}
+
+/// Extract all metadata from many documents without blocking the event loop
+///
+/// The batch is handed to one libuv thread, which spreads the documents over
+/// the library's own worker pool (see `meta_oxide_set_thread_count` in the C
+/// API). `baseUrls`, when given, must have one entry per document. Resolves
+/// to an array of `extractAllAsync` results in input order.
+#[napi]
+pub fn extractAllBatchAsync(
+    documents: Vec<Either<Buffer, String>>,
+    base_urls: Option<Vec<Option<String>>>,
+    options: Option<ExtractOptions>,
+) -> Result<AsyncTask<ExtractBatchTask>> {
+    if base_urls.as_ref().is_some_and(|urls| urls.len() != documents.len()) {
+        return Err(Error::new(
+            Status::InvalidArg,
+            "baseUrls must have the same length as documents",
+        ));
+    }
+    Ok(AsyncTask::new(ExtractBatchTask {
+        documents,
+        base_urls,
+        options: core_options(options.as_ref()),
+    }))
+}
+
+/// Counters reported by `cacheStats`
+#[napi(object)]
+pub struct CacheStats {
+    /// Full-document calls answered from the cache
+    pub hits: i64,
+    /// Full-document calls that had to be extracted
+    pub misses: i64,
+    /// `headOnly` calls answered from the cache
+    pub head_hits: i64,
+    /// `headOnly` calls that had to be extracted
+    pub head_misses: i64,
+    /// Entries dropped to make room for newer ones
+    pub evictions: i64,
+    /// Entries currently stored
+    pub entries: i64,
+    /// Bytes currently accounted to the cache
+    pub bytes: i64,
+}
+
+/// Enable the result cache with a budget of `maxBytes`, or disable it with 0
+///
+/// While enabled, `extractAll` and its async and batch variants return the
+/// stored result of an identical earlier call instead of parsing again; with
+/// `headOnly` only the head section is hashed, so pages sharing a templated
+/// `<head>` share one entry. The cache is shared by the whole process, and
+/// every call clears it and resets the counters.
+#[napi]
+pub fn cacheConfigure(max_bytes: i64) -> Result<()> {
+    let max_bytes = usize::try_from(max_bytes)
+        .map_err(|_| Error::new(Status::InvalidArg, "maxBytes must not be negative"))?;
+    meta_oxide::ffi::meta_oxide_cache_configure(max_bytes);
+    Ok(())
+}
+
+/// Counters of the result cache; all 0 while it is disabled
+#[napi]
+pub fn cacheStats() -> CacheStats {
+    let stats = meta_oxide::ffi::meta_oxide_cache_stats();
+    let count = |n: u64| i64::try_from(n).unwrap_or(i64::MAX);
+    CacheStats {
+        hits: count(stats.hits),
+        misses: count(stats.misses),
+        head_hits: count(stats.head_hits),
+        head_misses: count(stats.head_misses),
+        evictions: count(stats.evictions),
+        entries: count(stats.entries as u64),
+        bytes: count(stats.bytes as u64),
+    }
+}
+
 /// Extract standard HTML meta tags
 #[napi]
 pub fn extractMeta(html: String, base_url: Option<String>) -> Result<String> {
@@ -206,3 +585,43 @@ pub fn extractTwitter(html: String, base_url: Option<String>) -> Result<String>
         Ok(result)
     }
 }
+
+/// Which JSON-LD objects `extractJsonLd` returns
+#[napi(object)]
+pub struct JsonLdFilter {
+    /// Only return objects with one of these `@type` values; other objects,
+    /// including `@graph` members, are scanned without being built
+    pub types: Option<Vec<String>>,
+    /// Only keep these properties on the objects returned; `@context`,
+    /// `@type` and `@id` are always kept
+    pub properties: Option<Vec<String>>,
+}
+
+/// Extract JSON-LD structured data as an array of objects
+///
+/// Without a filter every object is returned, with `@graph` members in place
+/// of their container. With one, only the objects of the listed types are
+/// deserialized, which skips the cost of large `ItemList` graphs and other
+/// objects that would be thrown away.
+#[napi]
+pub fn extractJsonLd(html: Html, filter: Option<JsonLdFilter>) -> Result<serde_json::Value> {
+    let html = html_text(&html);
+    let objects = match &filter {
+        None => meta_oxide::extractors::jsonld::extract(&html, None),
+        Some(filter) => {
+            let types: Vec<&str> = filter.types.iter().flatten().map(String::as_str).collect();
+            let properties: Option<Vec<&str>> = filter.properties.as_ref()
+                .map(|names| names.iter().map(String::as_str).collect());
+            meta_oxide::extractors::jsonld::extract_filtered(
+                &html,
+                &meta_oxide::extractors::jsonld::Filter {
+                    types: &types,
+                    properties: properties.as_deref(),
+                },
+            )
+        }
+    }
+    .map_err(|e| Error::new(Status::GenericFailure, e.to_string()))?;
+
+    serde_json::to_value(objects).map_err(|e| Error::new(Status::GenericFailure, e.to_string()))
+}
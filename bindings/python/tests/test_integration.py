@@ -1,5 +1,7 @@
 """Integration tests for combined extraction (Phase E)"""
 
+import pytest
+
 import meta_oxide
 
 
@@ -547,3 +549,247 @@ def test_extract_all_special_characters():
     assert "&" in data["meta"]["title"]
     assert "<" in data["meta"]["title"]
     assert ">" in data["meta"]["title"]
+
+
+def test_extract_all_head_only():
+    """Test head_only=True skips everything after </head>"""
+    html = """
+        <html>
+        <head>
+            <title>Head Only</title>
+            <meta property="og:title" content="OG Head">
+            <script type="application/ld+json">{"@type": "Article", "headline": "In head"}</script>
+        </head>
+        <body>
+            <div class="h-card"><span class="p-name">Body Card</span></div>
+        </body>
+        </html>
+    """
+
+    data = meta_oxide.extract_all(html, head_only=True)
+
+    assert data["meta"]["title"] == "Head Only"
+    assert data["opengraph"]["title"] == "OG Head"
+    assert data["jsonld"][0]["@type"] == "Article"
+    assert not data.get("microformats")
+
+    full = meta_oxide.extract_all(html)
+    assert len(full["microformats"]["h-card"]) == 1
+
+
+def test_extract_all_selected_formats():
+    """Test formats= restricts extraction to the selected formats"""
+    html = """
+        <html>
+        <head>
+            <title>Selected</title>
+            <meta property="og:title" content="OG Selected">
+        </head>
+        <body>
+            <div class="h-card"><span class="p-name">Body Card</span></div>
+        </body>
+        </html>
+    """
+
+    data = meta_oxide.extract_all(
+        html, formats=meta_oxide.FMT_OPENGRAPH | meta_oxide.FMT_MICROFORMATS
+    )
+
+    assert data["opengraph"]["title"] == "OG Selected"
+    assert len(data["microformats"]["h-card"]) == 1
+    assert "meta" not in data
+    assert "twitter" not in data
+
+    full = meta_oxide.extract_all(html)
+    assert meta_oxide.extract_all(html, formats=meta_oxide.FMT_ALL) == full
+    # As in the C API, a mask of 0 selects every format
+    assert meta_oxide.extract_all(html, formats=0) == full
+    assert meta_oxide.extract_all_batch([html], formats=0) == [full]
+
+
+def test_extract_all_batch():
+    """Test extract_all_batch returns one result per document, in order"""
+    template = '<html><head><meta property="og:title" content="Page {}"></head></html>'
+    pages = [template.format(i) for i in range(20)]
+
+    results = meta_oxide.extract_all_batch(pages, formats=meta_oxide.FMT_OPENGRAPH)
+
+    assert len(results) == 20
+    assert [r["opengraph"]["title"] for r in results] == [f"Page {i}" for i in range(20)]
+    assert all("meta" not in r for r in results)
+
+
+def test_extract_all_batch_matches_extract_all():
+    """Test batch results have the shape extract_all gives each document"""
+    html = '<div class="h-card"><span class="p-name">Ada</span></div>'
+
+    assert meta_oxide.extract_all_batch([html]) == [meta_oxide.extract_all(html)]
+    assert meta_oxide.extract_many([html], workers=2) == [meta_oxide.extract_all(html)]
+
+
+def test_extract_all_batch_base_urls():
+    """Test extract_all_batch resolves each document against its own base URL"""
+    html = '<html><head><link rel="canonical" href="/page"></head></html>'
+
+    results = meta_oxide.extract_all_batch(
+        [html, html], base_urls=["https://a.example", None], formats=meta_oxide.FMT_META
+    )
+
+    assert results[0]["meta"]["canonical"] == "https://a.example/page"
+
+    with pytest.raises(ValueError):
+        meta_oxide.extract_all_batch([html], base_urls=[])
+
+
+def test_extract_all_with_stats():
+    """Test extract_all_with_stats reports timings and counts per selected format"""
+    html = """
+    <html><head>
+        <title>Stats</title>
+        <script type="application/ld+json">[{"@type": "A"}, {"@type": "B"}]</script>
+    </head></html>
+    """
+
+    result, stats = meta_oxide.extract_all_with_stats(
+        html, formats=meta_oxide.FMT_META | meta_oxide.FMT_JSONLD
+    )
+
+    assert result["meta"]["title"] == "Stats"
+    assert len(result["jsonld"]) == 2
+    assert stats["input_bytes"] == len(html.encode())
+    assert stats["dom_nodes"] > 0
+    assert set(stats["formats"]) == {"meta", "jsonld"}
+    assert stats["formats"]["jsonld"]["items"] == 2
+    assert stats["total_ns"] >= stats["parse_ns"] + stats["convert_ns"]
+
+
+def test_bytes_and_buffer_input():
+    """Test every input kind gives the same result as str input"""
+    html = '<html><head><title>Café</title><meta property="og:title" content="Ünï"></head></html>'
+    data = html.encode()
+    expected = meta_oxide.extract_all(html)
+
+    assert meta_oxide.extract_all(data) == expected
+    assert meta_oxide.extract_all(memoryview(data)) == expected
+    assert meta_oxide.extract_all(bytearray(data)) == expected
+    assert meta_oxide.extract_opengraph(data)["title"] == "Ünï"
+    assert meta_oxide.extract_all(b"") == meta_oxide.extract_all("")
+
+    # Invalid UTF-8 is replaced rather than rejected
+    assert meta_oxide.extract_meta(b"<title>a\xffb</title>")["title"] == "a�b"
+
+    with pytest.raises(TypeError):
+        meta_oxide.extract_meta(42)
+
+
+def test_extract_many():
+    """Test extract_many accepts mixed input kinds and a worker count"""
+    template = '<html><head><meta property="og:title" content="Page {}"></head></html>'
+    pages = [template.format(i) for i in range(20)]
+    documents = [page.encode() if i % 2 else page for i, page in enumerate(pages)]
+
+    results = meta_oxide.extract_many(documents, workers=2, formats=meta_oxide.FMT_OPENGRAPH)
+
+    assert [r["opengraph"]["title"] for r in results] == [f"Page {i}" for i in range(20)]
+    assert results == meta_oxide.extract_all_batch(pages, formats=meta_oxide.FMT_OPENGRAPH)
+
+    with pytest.raises(ValueError):
+        meta_oxide.extract_many(documents, base_urls=[None])
+
+
+def test_set_thread_count():
+    """Test the shared pool is only resized by set_thread_count"""
+    original = meta_oxide.thread_count()
+    try:
+        meta_oxide.set_thread_count(3)
+        assert meta_oxide.thread_count() == 3
+
+        pages = ['<meta property="og:title" content="T">'] * 4
+        meta_oxide.extract_many(pages, workers=2)
+        assert meta_oxide.thread_count() == 3
+    finally:
+        meta_oxide.set_thread_count(original)
+
+
+def test_extraction_releases_gil():
+    """Test extraction from many Python threads gives the same results as serial calls"""
+    from concurrent.futures import ThreadPoolExecutor
+
+    body = "<p>x</p>" * 500
+    pages = [f"<html><head><title>T{i}</title></head><body>{body}</body></html>" for i in range(32)]
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        titles = list(executor.map(lambda page: meta_oxide.extract_meta(page)["title"], pages))
+
+    assert titles == [f"T{i}" for i in range(32)]
+
+
+def test_result_cache():
+    """Test the result cache serves repeated and same-head documents"""
+    head = "<html><head><title>Shared</title></head>"
+    pages = [f"{head}<body><p>{i}</p></body></html>" for i in range(4)]
+
+    meta_oxide.cache_configure(1 << 20)
+    try:
+        first = meta_oxide.extract_many(pages)
+        assert meta_oxide.extract_many(pages) == first
+        stats = meta_oxide.cache_stats()
+        assert stats["misses"] == 4 and stats["hits"] == 4
+        assert stats["entries"] == 4 and stats["bytes"] > 0
+
+        # One page first, so the rest cannot race it to the miss
+        heads = meta_oxide.extract_many(pages[:1], head_only=True)
+        heads += meta_oxide.extract_many(pages[1:], head_only=True)
+        assert all(r["meta"]["title"] == "Shared" for r in heads)
+        stats = meta_oxide.cache_stats()
+        assert stats["head_misses"] == 1 and stats["head_hits"] == 3
+    finally:
+        meta_oxide.cache_configure(0)
+
+    assert meta_oxide.cache_stats()["entries"] == 0
+
+
+def test_extract_all_msgpack():
+    """Test extract_all_msgpack returns a compact map keyed like the C API"""
+    html = '<html><head><title>Packed</title><meta property="og:title" content="OG"></head></html>'
+
+    packed = meta_oxide.extract_all_msgpack(html)
+    assert isinstance(packed, bytes)
+    assert packed[0] & 0xF0 == 0x80
+    assert packed[1:6] == b"\xa4meta"
+    assert b"openGraph" in packed and b"jsonLd" not in packed
+
+    og_only = meta_oxide.extract_all_msgpack(html.encode(), formats=meta_oxide.FMT_OPENGRAPH)
+    assert og_only[0] == 0x81 and b"Packed" not in og_only
+
+
+def test_extract_all_detect_encoding():
+    """Test bytes input is decoded in its declared encoding on request"""
+    page = b'<html><head><meta charset="windows-1251"><title>\xcf\xf0\xe8</title></head></html>'
+
+    assert meta_oxide.extract_all(page)["meta"]["title"] == "���"
+    assert meta_oxide.extract_all(page, detect_encoding=True)["meta"]["title"] == "При"
+
+    latin1 = meta_oxide.extract_all(
+        page, detect_encoding=True, content_type="text/html; charset=iso-8859-1"
+    )
+    assert latin1["meta"]["title"] == "Ïðè"
+
+
+def test_extract_jsonld_filtered():
+    """Test extract_jsonld keeps only the requested types and properties"""
+    html = """<script type="application/ld+json">{"@graph": [
+        {"@type": "ItemList", "itemListElement": [{"@type": "Product", "name": "Nested"}]},
+        {"@type": "Product", "@id": "#shoe", "name": "Shoe", "sku": "S1"},
+        {"@type": "BreadcrumbList", "itemListElement": []}
+    ]}</script>"""
+
+    products = meta_oxide.extract_jsonld(html, types=["Product"])
+    assert len(products) == 1
+    assert products[0]["name"] == "Shoe" and products[0]["sku"] == "S1"
+
+    both = meta_oxide.extract_jsonld(html, types=["Product", "BreadcrumbList"], properties=["name"])
+    assert [obj["@type"] for obj in both] == ["Product", "BreadcrumbList"]
+    assert "sku" not in both[0] and both[0]["@id"] == "#shoe"
+    assert "itemListElement" not in both[1]
+
+    assert len(meta_oxide.extract_jsonld(html)) == 3
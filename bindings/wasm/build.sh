@@ -29,6 +29,13 @@ echo ""
 echo "🔨 Building WASM for web target..."
 wasm-pack build --target web --out-dir pkg
 
+echo ""
+echo "🔨 Building SIMD128 WASM for web target..."
+# memchr's substring search, used by the format prefilter, switches to 128-bit
+# vector code when simd128 is enabled at compile time. lib/simd.js picks this
+# build at runtime where the engine supports it and falls back to pkg/.
+RUSTFLAGS="-C target-feature=+simd128" wasm-pack build --target web --out-dir pkg-simd
+
 echo ""
 echo "🔨 Building WASM for Node.js target..."
 wasm-pack build --target nodejs --out-dir pkg-node
@@ -46,6 +53,7 @@ echo "✅ Build complete!"
 echo ""
 echo "📊 Build artifacts:"
 echo "  - pkg/          (Web target)"
+echo "  - pkg-simd/     (Web target, SIMD128)"
 echo "  - pkg-node/     (Node.js target)"
 echo "  - pkg-bundler/  (Bundler target)"
 echo "  - dist/         (TypeScript compiled)"
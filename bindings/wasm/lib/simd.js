@@ -0,0 +1,40 @@
+/**
+ * Runtime selection between the SIMD128 and scalar WASM builds
+ *
+ * build.sh produces pkg/ (scalar) and pkg-simd/ (compiled with +simd128).
+ * Engines without SIMD support reject the whole SIMD module at compile time,
+ * so the choice has to be made before loading it.
+ */
+
+// The smallest module using a SIMD instruction (i8x16.splat then
+// i8x16.popcnt); it validates only where SIMD128 is supported
+const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253,
+    15, 253, 98, 11,
+]);
+
+let simd;
+
+/** Whether this engine runs WebAssembly SIMD128 code */
+export function simdSupported() {
+    if (simd === undefined) {
+        simd = typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE);
+    }
+    return simd;
+}
+
+/**
+ * Import and initialize the fastest build this engine supports
+ *
+ * @param {BufferSource | WebAssembly.Module} [wasm] Module or bytes to
+ *     instantiate instead of fetching the default `.wasm` file, as Cloudflare
+ *     Workers require; pass the one matching `simdSupported()`
+ * @returns The wasm-bindgen exports (`extractAllObject`, `extractAllBytes`, ...)
+ */
+export async function loadMetaOxide(wasm) {
+    const bindings = simdSupported()
+        ? await import('../pkg-simd/meta_oxide_wasm.js')
+        : await import('../pkg/meta_oxide_wasm.js');
+    await bindings.default(wasm);
+    return bindings;
+}
@@ -25,7 +25,13 @@ use wasm_bindgen::prelude::*;
 use serde::{Deserialize, Serialize};
 
 // Re-export from core library
-use meta_oxide::{extractors, parser};
+use meta_oxide::extract::{self, Extraction};
+use meta_oxide::{
+    dublin_core::DublinCore, extractors, jsonld::JsonLdObject,
+    manifest::ManifestDiscovery, meta::MetaTags, microdata::MicrodataItem, oembed::OEmbedDiscovery,
+    parser, rdfa::RdfaItem, social::OpenGraph, social::TwitterCard, MicroformatItem,
+};
+use std::collections::HashMap;
 
 /// Initialize panic hook for better error messages in development
 #[wasm_bindgen(start)]
@@ -179,77 +185,198 @@ impl ExtractionResult {
 /// ```
 #[wasm_bindgen(js_name = extractAll)]
 pub fn extract_all(html: &str, base_url: Option<String>) -> Result<ExtractionResult, JsValue> {
-    let base = base_url.as_deref();
-
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let meta = extractors::meta::extract(&document, base)
-        .ok()
-        .and_then(|m| serde_json::to_string(&m).ok());
-
-    let open_graph = extractors::open_graph::extract(&document, base)
-        .ok()
-        .and_then(|og| serde_json::to_string(&og).ok());
-
-    let twitter = extractors::twitter::extract(&document, base)
-        .ok()
-        .and_then(|tw| serde_json::to_string(&tw).ok());
-
-    let json_ld = extractors::json_ld::extract(&document, base)
-        .ok()
-        .and_then(|jl| serde_json::to_string(&jl).ok());
-
-    let microdata = extractors::microdata::extract(&document, base)
-        .ok()
-        .and_then(|md| serde_json::to_string(&md).ok());
-
-    let microformats = extractors::microformats::extract(&document, base)
-        .ok()
-        .and_then(|mf| serde_json::to_string(&mf).ok());
-
-    let rdfa = extractors::rdfa::extract(&document, base)
-        .ok()
-        .and_then(|r| serde_json::to_string(&r).ok());
-
-    let dublin_core = extractors::dublin_core::extract(&document, base)
-        .ok()
-        .and_then(|dc| serde_json::to_string(&dc).ok());
-
-    let manifest = extractors::manifest::extract(&document, base)
-        .ok()
-        .and_then(|m| serde_json::to_string(&m).ok());
-
-    let oembed = extractors::oembed::extract(&document, base)
-        .ok()
-        .and_then(|oe| serde_json::to_string(&oe).ok());
-
-    let rel_links = extractors::rel_links::extract(&document, base)
-        .ok()
-        .and_then(|rl| serde_json::to_string(&rl).ok());
-
-    Ok(ExtractionResult {
-        meta,
-        open_graph,
-        twitter,
-        json_ld,
-        microdata,
-        microformats,
-        rdfa,
-        dublin_core,
-        manifest,
-        oembed,
-        rel_links,
-    })
+    let extraction = extract::extract_all(
+        html,
+        base_url.as_deref(),
+        &extract::ExtractOptions::default(),
+    );
+    Ok(ExtractionResult::from(&extraction))
+}
+
+impl From<&Extraction> for ExtractionResult {
+    fn from(extraction: &Extraction) -> Self {
+        fn json<T: Serialize>(value: &Option<T>) -> Option<String> {
+            value.as_ref().and_then(|v| serde_json::to_string(v).ok())
+        }
+
+        Self {
+            meta: json(&extraction.meta),
+            open_graph: json(&extraction.open_graph),
+            twitter: json(&extraction.twitter),
+            json_ld: json(&extraction.json_ld),
+            microdata: json(&extraction.microdata),
+            microformats: json(&extraction.microformats),
+            rdfa: json(&extraction.rdfa),
+            dublin_core: json(&extraction.dublin_core),
+            manifest: json(&extraction.manifest),
+            oembed: json(&extraction.oembed),
+            rel_links: json(&extraction.rel_links),
+        }
+    }
+}
+
+/// Every format found by one extraction, keyed like the combined JSON
+/// document of the C API; formats that were not found are left out
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+struct ExtractionObject<'a> {
+    #[serde(skip_serializing_if = "Option::is_none")]
+    meta: Option<&'a MetaTags>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    open_graph: Option<&'a OpenGraph>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    twitter: Option<&'a TwitterCard>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    json_ld: Option<&'a Vec<JsonLdObject>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    microdata: Option<&'a Vec<MicrodataItem>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    microformats: Option<&'a HashMap<String, Vec<MicroformatItem>>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    rdfa: Option<&'a Vec<RdfaItem>>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    dublin_core: Option<&'a DublinCore>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    manifest: Option<&'a ManifestDiscovery>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    oembed: Option<&'a OEmbedDiscovery>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    rel_links: Option<&'a HashMap<String, Vec<String>>>,
+}
+
+impl<'a> From<&'a Extraction> for ExtractionObject<'a> {
+    fn from(extraction: &'a Extraction) -> Self {
+        Self {
+            meta: extraction.meta.as_ref(),
+            open_graph: extraction.open_graph.as_ref(),
+            twitter: extraction.twitter.as_ref(),
+            json_ld: extraction.json_ld.as_ref(),
+            microdata: extraction.microdata.as_ref(),
+            microformats: extraction.microformats.as_ref(),
+            rdfa: extraction.rdfa.as_ref(),
+            dublin_core: extraction.dublin_core.as_ref(),
+            manifest: extraction.manifest.as_ref(),
+            oembed: extraction.oembed.as_ref(),
+            rel_links: extraction.rel_links.as_ref(),
+        }
+    }
+}
+
+// Extract every format and build the result directly as JS objects
+fn extract_all_js(html: &str, base_url: Option<&str>) -> Result<JsValue, JsValue> {
+    let extraction = extract::extract_all(html, base_url, &extract::ExtractOptions::default());
+
+    // Maps become plain objects, as JSON.parse would have produced
+    ExtractionObject::from(&extraction)
+        .serialize(&serde_wasm_bindgen::Serializer::json_compatible())
+        .map_err(|e| JsValue::from_str(&format!("Serialization error: {}", e)))
+}
+
+/// Extract ALL metadata from HTML as a plain JS object
+///
+/// Unlike `extractAll`, no field is a JSON string: the result is built
+/// directly as JS objects, so there is nothing to `JSON.parse`. Keys are
+/// `meta`, `openGraph`, `twitter`, `jsonLd`, `microdata`, `microformats`,
+/// `rdfa`, `dublinCore`, `manifest`, `oembed` and `relLinks`; formats that
+/// were not found are left out.
+///
+/// # Example
+/// ```javascript
+/// const result = extractAllObject(htmlString, 'https://example.com');
+/// console.log(result.openGraph?.title);
+/// ```
+#[wasm_bindgen(js_name = extractAllObject)]
+pub fn extract_all_object(html: &str, base_url: Option<String>) -> Result<JsValue, JsValue> {
+    extract_all_js(html, base_url.as_deref())
+}
+
+/// Extract ALL metadata from UTF-8 bytes as a plain JS object
+///
+/// Takes the `Uint8Array` from `await response.arrayBuffer()` as is, saving
+/// the `TextDecoder` pass and the re-encoding of the string into UTF-8 that
+/// `extractAllObject` needs. Invalid UTF-8 sequences are replaced with U+FFFD.
+///
+/// # Example
+/// ```javascript
+/// const bytes = new Uint8Array(await response.arrayBuffer());
+/// const result = extractAllBytes(bytes, response.url);
+/// ```
+#[wasm_bindgen(js_name = extractAllBytes)]
+pub fn extract_all_bytes(html: &[u8], base_url: Option<String>) -> Result<JsValue, JsValue> {
+    extract_all_js(&String::from_utf8_lossy(html), base_url.as_deref())
+}
+
+/// Extract ALL metadata from HTML as a MessagePack document
+///
+/// Returns a `Uint8Array` holding one map with the same keys and values as
+/// `extractAllObject`. It is typically a fraction of the size of the JSON
+/// text, so it suits results sent on over the network or to storage rather
+/// than used in place.
+///
+/// # Example
+/// ```javascript
+/// const packed = extractAllMsgpack(htmlString, 'https://example.com');
+/// await fetch('/ingest', { method: 'POST', body: packed });
+/// ```
+#[wasm_bindgen(js_name = extractAllMsgpack)]
+pub fn extract_all_msgpack(html: &str, base_url: Option<String>) -> Result<Vec<u8>, JsValue> {
+    let extraction =
+        extract::extract_all(html, base_url.as_deref(), &extract::ExtractOptions::default());
+    meta_oxide::msgpack::extraction_to_vec(&extraction)
+        .map_err(|e| JsValue::from_str(&e.to_string()))
+}
+
+/// Counters of the result cache, as returned by `cacheStats`
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+struct CacheStatsObject {
+    hits: u64,
+    misses: u64,
+    head_hits: u64,
+    head_misses: u64,
+    evictions: u64,
+    entries: usize,
+    bytes: usize,
+}
+
+/// Enable the result cache with a budget of `maxBytes`, or disable it with 0
+///
+/// While enabled, `extractAllObject` and `extractAllBytes` return a copy of
+/// the result of an identical earlier call instead of parsing again. Useful in
+/// long-lived workers that see the same pages repeatedly. Every call clears
+/// the cache and resets its counters.
+///
+/// # Example
+/// ```javascript
+/// cacheConfigure(16 * 1024 * 1024);
+/// ```
+#[wasm_bindgen(js_name = cacheConfigure)]
+pub fn cache_configure(max_bytes: usize) {
+    meta_oxide::cache::configure(max_bytes);
+}
+
+/// Counters of the result cache: `hits`, `misses`, `headHits`, `headMisses`,
+/// `evictions`, `entries` and `bytes`; all 0 while it is disabled
+#[wasm_bindgen(js_name = cacheStats)]
+pub fn cache_stats() -> Result<JsValue, JsValue> {
+    let stats = meta_oxide::cache::stats();
+    CacheStatsObject {
+        hits: stats.hits,
+        misses: stats.misses,
+        head_hits: stats.head_hits,
+        head_misses: stats.head_misses,
+        evictions: stats.evictions,
+        entries: stats.entries,
+        bytes: stats.bytes,
+    }
+    .serialize(&serde_wasm_bindgen::Serializer::json_compatible())
+    .map_err(|e| JsValue::from_str(&format!("Serialization error: {}", e)))
 }
 
 /// Extract standard HTML meta tags
 #[wasm_bindgen(js_name = extractMeta)]
 pub fn extract_meta(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let meta = extractors::meta::extract(&document, base_url.as_deref())
+    let meta = extractors::meta::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&meta)
@@ -259,10 +386,7 @@ pub fn extract_meta(html: &str, base_url: Option<String>) -> Result<String, JsVa
 /// Extract Open Graph metadata
 #[wasm_bindgen(js_name = extractOpenGraph)]
 pub fn extract_open_graph(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let og = extractors::open_graph::extract(&document, base_url.as_deref())
+    let og = extractors::social::extract_opengraph(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&og)
@@ -272,10 +396,7 @@ pub fn extract_open_graph(html: &str, base_url: Option<String>) -> Result<String
 /// Extract Twitter Card metadata
 #[wasm_bindgen(js_name = extractTwitter)]
 pub fn extract_twitter(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let twitter = extractors::twitter::extract(&document, base_url.as_deref())
+    let twitter = extractors::social::extract_twitter_with_fallback(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&twitter)
@@ -285,10 +406,7 @@ pub fn extract_twitter(html: &str, base_url: Option<String>) -> Result<String, J
 /// Extract JSON-LD structured data
 #[wasm_bindgen(js_name = extractJsonLd)]
 pub fn extract_json_ld(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let json_ld = extractors::json_ld::extract(&document, base_url.as_deref())
+    let json_ld = extractors::jsonld::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&json_ld)
@@ -298,10 +416,7 @@ pub fn extract_json_ld(html: &str, base_url: Option<String>) -> Result<String, J
 /// Extract Microdata items
 #[wasm_bindgen(js_name = extractMicrodata)]
 pub fn extract_microdata(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let microdata = extractors::microdata::extract(&document, base_url.as_deref())
+    let microdata = extractors::microdata::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&microdata)
@@ -311,10 +426,7 @@ pub fn extract_microdata(html: &str, base_url: Option<String>) -> Result<String,
 /// Extract Microformats data (h-card, h-entry, etc.)
 #[wasm_bindgen(js_name = extractMicroformats)]
 pub fn extract_microformats(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let microformats = extractors::microformats::extract(&document, base_url.as_deref())
+    let microformats = parser::parse_html(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&microformats)
@@ -324,10 +436,7 @@ pub fn extract_microformats(html: &str, base_url: Option<String>) -> Result<Stri
 /// Extract RDFa structured data
 #[wasm_bindgen(js_name = extractRDFa)]
 pub fn extract_rdfa(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let rdfa = extractors::rdfa::extract(&document, base_url.as_deref())
+    let rdfa = extractors::rdfa::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&rdfa)
@@ -336,11 +445,8 @@ pub fn extract_rdfa(html: &str, base_url: Option<String>) -> Result<String, JsVa
 
 /// Extract Dublin Core metadata
 #[wasm_bindgen(js_name = extractDublinCore)]
-pub fn extract_dublin_core(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let dc = extractors::dublin_core::extract(&document, base_url.as_deref())
+pub fn extract_dublin_core(html: &str, _base_url: Option<String>) -> Result<String, JsValue> {
+    let dc = extractors::dublin_core::extract(html)
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&dc)
@@ -350,10 +456,7 @@ pub fn extract_dublin_core(html: &str, base_url: Option<String>) -> Result<Strin
 /// Extract Web App Manifest discovery
 #[wasm_bindgen(js_name = extractManifest)]
 pub fn extract_manifest(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let manifest = extractors::manifest::extract(&document, base_url.as_deref())
+    let manifest = extractors::manifest::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&manifest)
@@ -363,10 +466,7 @@ pub fn extract_manifest(html: &str, base_url: Option<String>) -> Result<String,
 /// Extract oEmbed endpoint discovery
 #[wasm_bindgen(js_name = extractOEmbed)]
 pub fn extract_oembed(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let oembed = extractors::oembed::extract(&document, base_url.as_deref())
+    let oembed = extractors::oembed::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&oembed)
@@ -376,10 +476,7 @@ pub fn extract_oembed(html: &str, base_url: Option<String>) -> Result<String, Js
 /// Extract rel-* link relationships
 #[wasm_bindgen(js_name = extractRelLinks)]
 pub fn extract_rel_links(html: &str, base_url: Option<String>) -> Result<String, JsValue> {
-    let document = parser::parse_html(html)
-        .map_err(|e| JsValue::from_str(&format!("Parse error: {}", e)))?;
-
-    let rel_links = extractors::rel_links::extract(&document, base_url.as_deref())
+    let rel_links = extractors::rel_links::extract(html, base_url.as_deref())
         .map_err(|e| JsValue::from_str(&format!("Extraction error: {}", e)))?;
 
     serde_json::to_string(&rel_links)
@@ -407,4 +504,21 @@ mod tests {
         assert!(result.open_graph.is_some());
         assert_eq!(result.get_format_count(), 2);
     }
+
+    #[test]
+    fn test_extraction_object_keys() {
+        let html = r#"<html><head>
+            <title>Test</title>
+            <meta property="og:title" content="OG Title">
+            <link rel="author" href="/me">
+        </head></html>"#;
+
+        let extraction = extract::extract_all(html, None, &extract::ExtractOptions::default());
+        let object = serde_json::to_value(ExtractionObject::from(&extraction)).unwrap();
+
+        assert_eq!(object["openGraph"]["title"], "OG Title");
+        assert!(object["relLinks"].is_object());
+        assert!(object.get("jsonLd").is_none());
+        assert!(object.get("open_graph").is_none());
+    }
 }
@@ -23,6 +23,14 @@
  * - `meta_oxide_string_free()` for individual strings
  * - `meta_oxide_manifest_discovery_free()` for ManifestDiscovery structs
  *
+ * Strings come from the Rust allocator unless `meta_oxide_set_allocator()`
+ * installs caller hooks, and the `_into` variants write into caller buffers.
+ *
+ * ## Instrumentation
+ *
+ * Point `MetaOxideOptions::stats` at a `MetaOxideStats` to get parse,
+ * per-format and serialization timings for a call.
+ *
  * ## Error Handling
  *
  * Functions return NULL on error and set the thread-local error state.
@@ -73,6 +81,137 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * Select standard HTML meta tags
+ */
+#define META_OXIDE_FMT_META (1 << 0)
+
+/**
+ * Select Open Graph
+ */
+#define META_OXIDE_FMT_OPEN_GRAPH (1 << 1)
+
+/**
+ * Select Twitter Cards
+ */
+#define META_OXIDE_FMT_TWITTER (1 << 2)
+
+/**
+ * Select JSON-LD
+ */
+#define META_OXIDE_FMT_JSON_LD (1 << 3)
+
+/**
+ * Select Microdata
+ */
+#define META_OXIDE_FMT_MICRODATA (1 << 4)
+
+/**
+ * Select Microformats
+ */
+#define META_OXIDE_FMT_MICROFORMATS (1 << 5)
+
+/**
+ * Select RDFa
+ */
+#define META_OXIDE_FMT_RDFA (1 << 6)
+
+/**
+ * Select Dublin Core
+ */
+#define META_OXIDE_FMT_DUBLIN_CORE (1 << 7)
+
+/**
+ * Select Web App Manifest discovery
+ */
+#define META_OXIDE_FMT_MANIFEST (1 << 8)
+
+/**
+ * Select oEmbed discovery
+ */
+#define META_OXIDE_FMT_OEMBED (1 << 9)
+
+/**
+ * Select rel-* links
+ */
+#define META_OXIDE_FMT_REL_LINKS (1 << 10)
+
+/**
+ * Select every format
+ */
+#define META_OXIDE_FMT_ALL 2047
+
+/**
+ * Replace invalid UTF-8 sequences in `_n` inputs with U+FFFD instead of failing
+ */
+#define META_OXIDE_INPUT_LOSSY (1 << 0)
+
+/**
+ * Skip UTF-8 validation of `_n` inputs; the caller guarantees they are valid
+ * UTF-8 (invalid input is undefined behaviour)
+ */
+#define META_OXIDE_INPUT_TRUSTED_UTF8 (1 << 1)
+
+/**
+ * Decode `_n` HTML in the encoding declared by a byte order mark,
+ * `MetaOxideOptions::content_type` or a `<meta>` charset in the first 1024
+ * bytes, falling back to UTF-8 or windows-1252
+ *
+ * Takes precedence over the other flags for the HTML; valid UTF-8 is still
+ * borrowed without a copy. The base URL is read as UTF-8.
+ */
+#define META_OXIDE_INPUT_DETECT_ENCODING (1 << 2)
+
+/**
+ * Write `MetaOxideBuffer` documents as JSON text (the default)
+ */
+#define META_OXIDE_ENCODING_JSON 0
+
+/**
+ * Write `MetaOxideBuffer` documents as MessagePack
+ */
+#define META_OXIDE_ENCODING_MSGPACK 1
+
+/**
+ * Returned by `meta_oxide_stream_feed()` while more input is needed
+ */
+#define META_OXIDE_STREAM_NEED_MORE 0
+
+/**
+ * Returned by `meta_oxide_stream_feed()` once every requested format is complete
+ */
+#define META_OXIDE_STREAM_DONE 1
+
+/**
+ * Number of entries in the per-format arrays of `MetaOxideStats`
+ */
+#define META_OXIDE_FORMAT_COUNT 11
+
+/**
+ * A reusable extraction context (see `meta_oxide_context_new()`)
+ */
+typedef struct MetaOxideContext MetaOxideContext;
+
+/**
+ * An incremental extraction session (see `meta_oxide_stream_new()`)
+ */
+typedef struct MetaOxideStream MetaOxideStream;
+
+/**
+ * Typed extraction results (see `meta_oxide_extract_typed()`)
+ */
+typedef struct MetaOxideTypedResult MetaOxideTypedResult;
+
+/**
+ * Allocation hook: return at least `size` bytes, or NULL on failure
+ */
+typedef void *(*MetaOxideMallocFn)(size_t size, void *user_data);
+
+/**
+ * Release hook for memory returned by the matching `MetaOxideMallocFn`
+ */
+typedef void (*MetaOxideFreeFn)(void *ptr, void *user_data);
+
 /**
  * Result structure containing all extracted metadata
  *
@@ -127,101 +266,1621 @@ typedef struct MetaOxideResult {
 } MetaOxideResult;
 
 /**
- * Manifest discovery result with URL and parsed content
+ * Where the time went in one extraction call
+ *
+ * The per-format arrays are indexed by the bit position of the format's
+ * `META_OXIDE_FMT_*` flag, so `format_ns[3]` is JSON-LD (`1 << 3`). Formats
+ * that were not selected report 0; Open Graph parsed only for the Twitter
+ * fallback counts as Twitter time.
  */
-typedef struct ManifestDiscovery {
+typedef struct MetaOxideStats {
   /**
-   * Manifest URL (may be NULL)
+   * Bytes of HTML parsed (the head section alone with `head_only`)
    */
-  char *href;
+  size_t input_bytes;
   /**
-   * Full manifest JSON (may be NULL)
+   * Bytes of JSON produced, excluding NUL terminators
    */
-  char *manifest;
-} ManifestDiscovery;
+  size_t output_bytes;
+  /**
+   * Nodes in the parsed DOM
+   */
+  size_t dom_nodes;
+  /**
+   * JSON-LD scripts skipped because they did not parse
+   */
+  size_t json_ld_errors;
+  /**
+   * Time spent building the DOM, in nanoseconds
+   */
+  uint64_t parse_ns;
+  /**
+   * Time spent collecting `<title>`, `<meta>` and `<link>` tags, in nanoseconds
+   */
+  uint64_t head_scan_ns;
+  /**
+   * Time spent serializing results to JSON, in nanoseconds
+   */
+  uint64_t serialize_ns;
+  /**
+   * Wall time of extraction and serialization together, in nanoseconds
+   */
+  uint64_t total_ns;
+  /**
+   * Extraction time per format, in nanoseconds
+   */
+  uint64_t format_ns[META_OXIDE_FORMAT_COUNT];
+  /**
+   * Items found per format
+   *
+   * Objects for JSON-LD, microdata and RDFa, root items for microformats,
+   * relation types for rel-* links, and 1 for the single-object formats.
+   */
+  uint32_t items[META_OXIDE_FORMAT_COUNT];
+} MetaOxideStats;
 
 /**
- * Extract ALL metadata from HTML
- *
- * Returns a MetaOxideResult containing all extracted data as JSON strings.
- * Returns NULL on error.
- *
- * # Arguments
- * * `html` - HTML content (must not be NULL)
- * * `base_url` - Base URL for resolving relative URLs (may be NULL)
- *
- * # Memory
- * The caller must free the returned struct using `meta_oxide_result_free()`.
- *
- * # Safety
- * - `html` must be a valid null-terminated C string
- * - `base_url` may be NULL or a valid null-terminated C string
+ * Hit, miss and size counters of the result caches
  */
-struct MetaOxideResult *meta_oxide_extract_all(const char *html, const char *base_url);
+typedef struct MetaOxideCacheStats {
+  /**
+   * Full-document calls answered from the cache
+   */
+  uint64_t hits;
+  /**
+   * Full-document calls that had to be extracted
+   */
+  uint64_t misses;
+  /**
+   * `head_only` calls answered from the cache
+   */
+  uint64_t head_hits;
+  /**
+   * `head_only` calls that had to be extracted
+   */
+  uint64_t head_misses;
+  /**
+   * Entries dropped to make room for newer ones
+   */
+  uint64_t evictions;
+  /**
+   * Entries currently stored
+   */
+  size_t entries;
+  /**
+   * Bytes currently accounted to the caches
+   */
+  size_t bytes;
+} MetaOxideCacheStats;
 
 /**
- * Extract standard HTML meta tags
+ * Resource limits for one extraction call
  *
- * # Returns
- * JSON string or NULL on error
+ * A field left at 0 means no limit. When a limit is hit the call still
+ * returns the results found within it and reports
+ * `MetaOxideError::LimitExceeded` (8): functions returning a result pointer
+ * set the error state but return the result, and functions returning a
+ * status code return 8 with their output filled in.
  */
-char *meta_oxide_extract_meta(const char *html, const char *base_url);
+typedef struct MetaOxideLimits {
+  /**
+   * Parse at most this many bytes of HTML
+   */
+  size_t max_input_bytes;
+  /**
+   * Parse at most this many start tags; the document is cut before the next
+   * one. A `<` in text, comments and `<script>`/`<style>` contents does
+   * not count
+   */
+  size_t max_tags;
+  /**
+   * Skip JSON-LD scripts longer than this many bytes without parsing them
+   */
+  size_t max_json_ld_bytes;
+  /**
+   * Keep at most this many JSON-LD objects, microdata items and RDFa items,
+   * and this many microformat items of each type
+   */
+  size_t max_items;
+  /**
+   * Drop every node nested more than this many levels deep
+   *
+   * Applied after parsing, so it bounds extraction but not the parse itself;
+   * pair it with `max_input_bytes` or `max_tags`.
+   */
+  size_t max_depth;
+  /**
+   * Skip the formats not yet started after this many microseconds
+   *
+   * Checked between stages, so a single slow stage can overrun it.
+   */
+  uint64_t deadline_us;
+} MetaOxideLimits;
 
 /**
- * Extract Open Graph metadata
+ * Options controlling `meta_oxide_extract_all_with_options()`
  *
- * # Returns
- * JSON string or NULL on error
+ * Zero-initialize the struct to get the default behaviour.
  */
-char *meta_oxide_extract_open_graph(const char *html, const char *base_url);
+typedef struct MetaOxideOptions {
+  /**
+   * Only parse the document head
+   *
+   * Tokenizing stops after `</head>` or at the first element that cannot
+   * appear in the head (such as `<body>`). Meta tags, Open Graph, Twitter,
+   * Dublin Core, manifest, oEmbed, rel-links and JSON-LD scripts in the head
+   * are still extracted; anything in the body is ignored.
+   */
+  bool head_only;
+  /**
+   * Bitmask of `META_OXIDE_FMT_*` flags selecting the formats to extract
+   *
+   * 0 selects every format. Fields of unselected formats are left NULL and
+   * their extractors are never run.
+   */
+  uint32_t formats;
+  /**
+   * `META_OXIDE_INPUT_*` flags for `meta_oxide_extract_all_with_options_n()`
+   * and each document of `meta_oxide_extract_batch()`
+   *
+   * Ignored by the other NUL-terminated entry points.
+   */
+  uint32_t input_flags;
+  /**
+   * Statistics to fill in for this call (NULL to skip measuring)
+   *
+   * Ignored by `meta_oxide_extract_batch()` and stream sessions.
+   */
+  struct MetaOxideStats *stats;
+  /**
+   * Resource limits for the call (NULL for none)
+   *
+   * Ignored by stream sessions.
+   */
+  const struct MetaOxideLimits *limits;
+  /**
+   * `META_OXIDE_ENCODING_*` value selecting the document format of
+   * `meta_oxide_extract_all_buffer()` and `meta_oxide_extract_all_into()`
+   *
+   * Ignored by every other entry point, whose results are JSON strings.
+   */
+  uint32_t encoding;
+  /**
+   * HTTP `Content-Type` header value or charset label of the HTML
+   * (NULL for none)
+   *
+   * Only used with `META_OXIDE_INPUT_DETECT_ENCODING`, where it overrides a
+   * `<meta>` declaration but not a byte order mark.
+   */
+  const char *content_type;
+} MetaOxideOptions;
 
 /**
- * Extract Twitter Card metadata
- *
- * # Returns
- * JSON string or NULL on error
+ * One document of a `meta_oxide_extract_batch()` call
  */
-char *meta_oxide_extract_twitter(const char *html, const char *base_url);
+typedef struct MetaOxideInput {
+  /**
+   * HTML content (must not be NULL)
+   */
+  const char *html;
+  /**
+   * Base URL for resolving relative URLs (may be NULL)
+   */
+  const char *base_url;
+} MetaOxideInput;
 
 /**
- * Extract JSON-LD structured data
- *
- * # Returns
- * JSON array string or NULL on error
+ * Manifest discovery result with URL and parsed content
  */
-char *meta_oxide_extract_json_ld(const char *html, const char *base_url);
+typedef struct ManifestDiscovery {
+  /**
+   * Manifest URL (may be NULL)
+   */
+  char *href;
+  /**
+   * Full manifest JSON (may be NULL)
+   */
+  char *manifest;
+} ManifestDiscovery;
 
 /**
- * Extract Microdata
+ * Location of one format's JSON value inside a `MetaOxideBuffer`
  *
- * # Returns
- * JSON array string or NULL on error
+ * `len` is 0 when the format was not selected or not found.
  */
-char *meta_oxide_extract_microdata(const char *html, const char *base_url);
+typedef struct MetaOxideSpan {
+  /**
+   * Byte offset of the value from the start of the buffer
+   */
+  size_t offset;
+  /**
+   * Length of the value in bytes
+   */
+  size_t len;
+} MetaOxideSpan;
 
 /**
- * Extract Microformats (all 9 types: h-card, h-entry, h-event, etc.)
+ * A complete extraction result in one contiguous buffer
  *
- * # Returns
- * JSON object string with format types as keys, or NULL on error
+ * `data` holds a single NUL-terminated JSON object keyed by the format names
+ * used by the language bindings: `meta`, `openGraph`, `twitter`, `jsonLd`,
+ * `microdata`, `microformats`, `rdfa`, `dublinCore`, `manifest`, `oembed` and
+ * `relLinks`. Formats that were not selected or not found are left out.
+ *
+ * Each span locates one format's JSON value inside `data`, so a single format
+ * can be read without parsing the whole document. Values are not
+ * NUL-terminated; use the span length.
+ *
+ * With `META_OXIDE_ENCODING_MSGPACK` in `MetaOxideOptions::encoding`, `data`
+ * holds a MessagePack map with the same keys and values instead, and each
+ * span locates one MessagePack value. A NUL byte still follows the document
+ * but is not part of it, and the document itself may contain NUL bytes.
  */
-char *meta_oxide_extract_microformats(const char *html, const char *base_url);
+typedef struct MetaOxideBuffer {
+  /**
+   * The combined JSON document (NUL-terminated)
+   */
+  char *data;
+  /**
+   * Length of the document in bytes, excluding the terminator
+   */
+  size_t len;
+  /**
+   * Standard HTML meta tags (JSON object)
+   */
+  MetaOxideSpan meta;
+  /**
+   * Open Graph metadata (JSON object)
+   */
+  MetaOxideSpan open_graph;
+  /**
+   * Twitter Card metadata (JSON object)
+   */
+  MetaOxideSpan twitter;
+  /**
+   * JSON-LD structured data (JSON array)
+   */
+  MetaOxideSpan json_ld;
+  /**
+   * Microdata items (JSON array)
+   */
+  MetaOxideSpan microdata;
+  /**
+   * Microformats data (JSON object with h-card, h-entry, etc.)
+   */
+  MetaOxideSpan microformats;
+  /**
+   * RDFa structured data (JSON array)
+   */
+  MetaOxideSpan rdfa;
+  /**
+   * Dublin Core metadata (JSON object)
+   */
+  MetaOxideSpan dublin_core;
+  /**
+   * Web App Manifest discovery (JSON object)
+   */
+  MetaOxideSpan manifest;
+  /**
+   * oEmbed endpoint discovery (JSON object)
+   */
+  MetaOxideSpan oembed;
+  /**
+   * rel-* link relationships (JSON object)
+   */
+  MetaOxideSpan rel_links;
+} MetaOxideBuffer;
 
 /**
- * Extract RDFa structured data
+ * A borrowed UTF-8 string slice (not NUL-terminated)
  *
- * # Returns
- * JSON array string or NULL on error
+ * `ptr` is NULL when the value is absent.
  */
-char *meta_oxide_extract_rdfa(const char *html, const char *base_url);
+typedef struct MetaOxideStr {
+  /**
+   * First byte of the string, or NULL if absent
+   */
+  const char *ptr;
+  /**
+   * Length in bytes
+   */
+  size_t len;
+} MetaOxideStr;
 
 /**
- * Extract Dublin Core metadata
- *
- * # Returns
- * JSON object string or NULL on error
+ * Standard HTML meta tags
  */
-char *meta_oxide_extract_dublin_core(const char *html);
+typedef struct MetaOxideMetaTags {
+  /**
+   * `<title>` text
+   */
+  MetaOxideStr title;
+  /**
+   * `description` meta tag
+   */
+  MetaOxideStr description;
+  /**
+   * `author` meta tag
+   */
+  MetaOxideStr author;
+  /**
+   * `generator` meta tag
+   */
+  MetaOxideStr generator;
+  /**
+   * Canonical URL
+   */
+  MetaOxideStr canonical;
+  /**
+   * Short link URL
+   */
+  MetaOxideStr shortlink;
+  /**
+   * Favicon URL
+   */
+  MetaOxideStr icon;
+  /**
+   * Apple touch icon URL
+   */
+  MetaOxideStr apple_touch_icon;
+  /**
+   * Web App Manifest URL
+   */
+  MetaOxideStr manifest;
+  /**
+   * Previous page URL
+   */
+  MetaOxideStr prev;
+  /**
+   * Next page URL
+   */
+  MetaOxideStr next;
+  /**
+   * `viewport` meta tag
+   */
+  MetaOxideStr viewport;
+  /**
+   * `theme-color` meta tag
+   */
+  MetaOxideStr theme_color;
+  /**
+   * Document charset
+   */
+  MetaOxideStr charset;
+  /**
+   * `lang` of the `<html>` element
+   */
+  MetaOxideStr language;
+  /**
+   * `application-name` meta tag
+   */
+  MetaOxideStr application_name;
+  /**
+   * `referrer` meta tag
+   */
+  MetaOxideStr referrer;
+  /**
+   * Raw `robots` meta tag content
+   */
+  MetaOxideStr robots;
+  /**
+   * Raw `googlebot` meta tag content
+   */
+  MetaOxideStr googlebot;
+  /**
+   * Keywords, split on commas
+   */
+  const MetaOxideStr *keywords;
+  /**
+   * Number of entries in `keywords`
+   */
+  size_t keywords_len;
+} MetaOxideMetaTags;
+
+/**
+ * One `og:image` with its structured properties
+ */
+typedef struct MetaOxideOgImage {
+  /**
+   * Image URL
+   */
+  MetaOxideStr url;
+  /**
+   * `og:image:secure_url`
+   */
+  MetaOxideStr secure_url;
+  /**
+   * `og:image:type`
+   */
+  MetaOxideStr type;
+  /**
+   * `og:image:alt`
+   */
+  MetaOxideStr alt;
+  /**
+   * `og:image:width`, or 0 if absent
+   */
+  uint32_t width;
+  /**
+   * `og:image:height`, or 0 if absent
+   */
+  uint32_t height;
+} MetaOxideOgImage;
+
+/**
+ * Open Graph metadata
+ */
+typedef struct MetaOxideOpenGraph {
+  /**
+   * `og:title`
+   */
+  MetaOxideStr title;
+  /**
+   * `og:type`
+   */
+  MetaOxideStr type;
+  /**
+   * `og:url`
+   */
+  MetaOxideStr url;
+  /**
+   * First `og:image` URL
+   */
+  MetaOxideStr image;
+  /**
+   * `og:description`
+   */
+  MetaOxideStr description;
+  /**
+   * `og:site_name`
+   */
+  MetaOxideStr site_name;
+  /**
+   * `og:locale`
+   */
+  MetaOxideStr locale;
+  /**
+   * Every `og:image`, in document order
+   */
+  const struct MetaOxideOgImage *images;
+  /**
+   * Number of entries in `images`
+   */
+  size_t images_len;
+} MetaOxideOpenGraph;
+
+/**
+ * Twitter Card metadata (with Open Graph fallback applied)
+ */
+typedef struct MetaOxideTwitterCard {
+  /**
+   * `twitter:card`
+   */
+  MetaOxideStr card;
+  /**
+   * `twitter:title`
+   */
+  MetaOxideStr title;
+  /**
+   * `twitter:description`
+   */
+  MetaOxideStr description;
+  /**
+   * `twitter:image`
+   */
+  MetaOxideStr image;
+  /**
+   * `twitter:image:alt`
+   */
+  MetaOxideStr image_alt;
+  /**
+   * `twitter:site`
+   */
+  MetaOxideStr site;
+  /**
+   * `twitter:site:id`
+   */
+  MetaOxideStr site_id;
+  /**
+   * `twitter:creator`
+   */
+  MetaOxideStr creator;
+  /**
+   * `twitter:creator:id`
+   */
+  MetaOxideStr creator_id;
+} MetaOxideTwitterCard;
+
+/**
+ * URLs for one rel-* relationship
+ */
+typedef struct MetaOxideRelLink {
+  /**
+   * Relationship, lowercased (`author`, `me`, ...)
+   */
+  MetaOxideStr rel;
+  /**
+   * URLs in document order
+   */
+  const MetaOxideStr *urls;
+  /**
+   * Number of entries in `urls`
+   */
+  size_t urls_len;
+} MetaOxideRelLink;
+
+/**
+ * A property value: text, or a nested item
+ */
+typedef struct MetaOxideValue {
+  /**
+   * Text value (NULL `ptr` for a nested item)
+   */
+  MetaOxideStr text;
+  /**
+   * Nested item (NULL for a text value)
+   */
+  const struct MetaOxideItem *item;
+} MetaOxideValue;
+
+/**
+ * A named property with one or more values
+ */
+typedef struct MetaOxideProperty {
+  /**
+   * Property name
+   */
+  MetaOxideStr name;
+  /**
+   * Values in document order
+   */
+  const struct MetaOxideValue *values;
+  /**
+   * Number of entries in `values`
+   */
+  size_t values_len;
+} MetaOxideProperty;
+
+/**
+ * A JSON-LD object, microdata item or microformat
+ */
+typedef struct MetaOxideItem {
+  /**
+   * Types (`@type`, `itemtype` or `h-*` classes)
+   */
+  const MetaOxideStr *types;
+  /**
+   * Number of entries in `types`
+   */
+  size_t types_len;
+  /**
+   * `@id` or `itemid` (NULL `ptr` if absent)
+   */
+  MetaOxideStr id;
+  /**
+   * Properties sorted by name
+   */
+  const struct MetaOxideProperty *props;
+  /**
+   * Number of entries in `props`
+   */
+  size_t props_len;
+  /**
+   * Child items (`@graph` objects or nested microformats)
+   */
+  const struct MetaOxideItem *children;
+  /**
+   * Number of entries in `children`
+   */
+  size_t children_len;
+} MetaOxideItem;
+
+/**
+ * Extract ALL metadata from HTML
+ *
+ * Returns a MetaOxideResult containing all extracted data as JSON strings.
+ * Returns NULL on error.
+ *
+ * # Arguments
+ * * `html` - HTML content (must not be NULL)
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ */
+struct MetaOxideResult *meta_oxide_extract_all(const char *html, const char *base_url);
+
+/**
+ * Extract ALL metadata from HTML with extraction options
+ *
+ * Same as `meta_oxide_extract_all()`, with behaviour controlled by `options`.
+ * Passing NULL for `options` is equivalent to `meta_oxide_extract_all()`.
+ *
+ * # Arguments
+ * * `html` - HTML content (must not be NULL)
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ * * `options` - Extraction options (may be NULL for defaults)
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ */
+struct MetaOxideResult *meta_oxide_extract_all_with_options(const char *html,
+                                                            const char *base_url,
+                                                            const struct MetaOxideOptions *options);
+
+/**
+ * Extract ALL metadata from a length-delimited HTML buffer
+ *
+ * Same as `meta_oxide_extract_all()`, but `html` and `base_url` are byte
+ * buffers with explicit lengths rather than NUL-terminated strings. The HTML
+ * may be a slice of a larger buffer and may contain NUL bytes; no copy is made
+ * unless `META_OXIDE_INPUT_LOSSY` has to replace invalid sequences or
+ * `META_OXIDE_INPUT_DETECT_ENCODING` finds a non-UTF-8 page.
+ *
+ * # Arguments
+ * * `html` - HTML bytes (must not be NULL)
+ * * `len` - Length of `html` in bytes
+ * * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+ * * `base_len` - Length of `base_url` in bytes
+ * * `flags` - `META_OXIDE_INPUT_*` flags (0 to reject invalid UTF-8)
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ * - with `META_OXIDE_INPUT_TRUSTED_UTF8`, both buffers must be valid UTF-8
+ */
+struct MetaOxideResult *meta_oxide_extract_all_n(const char *html,
+                                                 size_t len,
+                                                 const char *base_url,
+                                                 size_t base_len,
+                                                 uint32_t flags);
+
+/**
+ * Extract ALL metadata from a length-delimited HTML buffer with options
+ *
+ * Same as `meta_oxide_extract_all_with_options()` for length-delimited input;
+ * `options->input_flags` controls UTF-8 handling as in `meta_oxide_extract_all_n()`,
+ * and `options->content_type` gives the charset hint for
+ * `META_OXIDE_INPUT_DETECT_ENCODING`.
+ *
+ * # Arguments
+ * * `html` - HTML bytes (must not be NULL)
+ * * `len` - Length of `html` in bytes
+ * * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+ * * `base_len` - Length of `base_url` in bytes
+ * * `options` - Extraction options (may be NULL for defaults)
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ * - with `META_OXIDE_INPUT_TRUSTED_UTF8`, both buffers must be valid UTF-8
+ */
+struct MetaOxideResult *meta_oxide_extract_all_with_options_n(const char *html,
+                                                              size_t len,
+                                                              const char *base_url,
+                                                              size_t base_len,
+                                                              const struct MetaOxideOptions *options);
+
+/**
+ * Extract only the selected metadata formats from HTML
+ *
+ * Runs just the extractors whose `META_OXIDE_FMT_*` bit is set in
+ * `formats`; the fields of unselected formats are left NULL. As in
+ * `MetaOxideOptions.formats`, a mask of 0 selects every format.
+ *
+ * # Arguments
+ * * `html` - HTML content (must not be NULL)
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ * * `formats` - Bitmask of `META_OXIDE_FMT_*` flags
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ */
+struct MetaOxideResult *meta_oxide_extract_selected(const char *html,
+                                                    const char *base_url,
+                                                    uint32_t formats);
+
+/**
+ * Extract ALL metadata from many documents in parallel
+ *
+ * The documents are spread over an internal pool of worker threads that is
+ * started on first use and reused by later calls (see
+ * `meta_oxide_set_thread_count()`). The calling thread takes part in the work.
+ *
+ * Every document gets its own result and error code; the thread-local error
+ * state is only set for errors in the arguments themselves.
+ *
+ * # Arguments
+ * * `docs` - Array of `n` documents
+ * * `n` - Number of documents
+ * * `options` - Extraction options applied to every document (may be NULL);
+ *   `input_flags` and `content_type` say how each document's bytes are read
+ * * `out` - Array of `n` result pointers, filled in input order; an entry is
+ *   NULL if its document could not be read
+ * * `errors` - Optional array of `n` error codes (`MetaOxideError` values),
+ *   filled in input order (may be NULL); `LimitExceeded` marks a partial
+ *   result
+ *
+ * # Returns
+ * 0 on success, or an error code if `docs` or `out` is NULL
+ *
+ * # Memory
+ * The caller must free every non-NULL entry of `out` using
+ * `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `docs` must point to `n` valid `MetaOxideInput` entries whose strings are
+ *   NULL or valid null-terminated C strings
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ * - `out` must point to space for `n` pointers
+ * - `errors` may be NULL or must point to space for `n` ints
+ */
+int meta_oxide_extract_batch(const struct MetaOxideInput *docs,
+                             size_t n,
+                             const struct MetaOxideOptions *options,
+                             struct MetaOxideResult **out,
+                             int *errors);
+
+/**
+ * Set the number of worker threads used by `meta_oxide_extract_batch()`
+ *
+ * 0 selects one thread per available core, which is also the default. The
+ * pool is replaced for later calls; batches already running finish first.
+ */
+void meta_oxide_set_thread_count(size_t threads);
+
+/**
+ * Get the number of worker threads used by `meta_oxide_extract_batch()`
+ */
+size_t meta_oxide_thread_count(void);
+
+/**
+ * Enable the result caches with a total budget of `max_bytes`, or disable
+ * them with 0 (the default)
+ *
+ * While enabled, the multi-format entry points (`meta_oxide_extract_all()`
+ * and its variants, `meta_oxide_extract_batch()`) first look the call up by
+ * a hash of its HTML, base URL and options, and skip the work entirely on a
+ * hit. `head_only` calls are keyed on the head section alone, so pages that
+ * share a templated `<head>` share one entry. Calls with a `MetaOxideStats`
+ * pointer are always extracted. Every call replaces the caches, dropping
+ * their entries and resetting the counters.
+ */
+void meta_oxide_cache_configure(size_t max_bytes);
+
+/**
+ * Get the counters of the result caches; all zero while caching is disabled
+ */
+struct MetaOxideCacheStats meta_oxide_cache_stats(void);
+
+/**
+ * Create a reusable extraction context
+ *
+ * A context owns the memory behind the results of
+ * `meta_oxide_context_extract_all()`: every JSON string is bump-allocated
+ * from an arena, and the arena and result structs are recycled by
+ * `meta_oxide_context_reset()`. A worker that processes many documents with
+ * one context stops allocating result memory once the arena has grown to
+ * its peak size.
+ *
+ * A context must not be used from two threads at once; give each worker
+ * thread its own.
+ *
+ * # Memory
+ * The caller must free the context using `meta_oxide_context_free()`.
+ */
+struct MetaOxideContext *meta_oxide_context_new(void);
+
+/**
+ * Extract ALL metadata from HTML into a context
+ *
+ * Same as `meta_oxide_extract_all_with_options()`, but the result and its
+ * strings are owned by `ctx`. Results from several calls stay valid together
+ * until the next `meta_oxide_context_reset()` or `meta_oxide_context_free()`.
+ *
+ * # Arguments
+ * * `ctx` - Context from `meta_oxide_context_new()` (must not be NULL)
+ * * `html` - HTML content (must not be NULL)
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ * * `options` - Extraction options (may be NULL for defaults)
+ *
+ * # Returns
+ * A result owned by the context, or NULL on error
+ *
+ * # Memory
+ * Do NOT pass the result to `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `ctx` must be a live context
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ */
+const struct MetaOxideResult *meta_oxide_context_extract_all(struct MetaOxideContext *ctx,
+                                                             const char *html,
+                                                             const char *base_url,
+                                                             const struct MetaOxideOptions *options);
+
+/**
+ * Release every result of a context in one step
+ *
+ * All results returned by `meta_oxide_context_extract_all()` since the last
+ * reset become invalid. The memory is kept for reuse by later calls.
+ *
+ * # Safety
+ * - `ctx` must be NULL or a live context
+ */
+void meta_oxide_context_reset(struct MetaOxideContext *ctx);
+
+/**
+ * Free a context and every result it owns
+ *
+ * # Safety
+ * - `ctx` must be NULL or a live context; it must not be used afterwards
+ */
+void meta_oxide_context_free(struct MetaOxideContext *ctx);
+
+/**
+ * Extract ALL metadata into one library-owned buffer
+ *
+ * Fills `out` with the combined JSON document and the span of every format
+ * (see `MetaOxideBuffer`). Everything lives in a single allocation, so a
+ * binding can hand `out->data` to its JSON parser as is.
+ *
+ * # Arguments
+ * * `html` - HTML bytes (must not be NULL)
+ * * `len` - Length of `html` in bytes
+ * * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+ * * `base_len` - Length of `base_url` in bytes
+ * * `options` - Extraction options (may be NULL for defaults); `input_flags`
+ *   controls UTF-8 handling as in `meta_oxide_extract_all_n()`
+ * * `out` - Buffer description to fill in (must not be NULL)
+ *
+ * # Returns
+ * 0 on success, or an error code; on error `out->data` is NULL
+ *
+ * # Memory
+ * The caller must release the buffer using `meta_oxide_buffer_free()`.
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ * - `out` must point to writable space for a `MetaOxideBuffer`
+ */
+int meta_oxide_extract_all_buffer(const char *html,
+                                  size_t len,
+                                  const char *base_url,
+                                  size_t base_len,
+                                  const struct MetaOxideOptions *options,
+                                  struct MetaOxideBuffer *out);
+
+/**
+ * Extract ALL metadata into a caller-provided buffer
+ *
+ * Same as `meta_oxide_extract_all_buffer()`, but the document is written to
+ * `buf` and nothing is allocated for the output. If it does not fit,
+ * `MetaOxideError::BufferTooSmall` (7) is returned and `out->len` is set to
+ * the document length; retry with at least `out->len + 1` bytes. Passing a
+ * NULL `buf` with `cap` 0 just measures the document.
+ *
+ * # Arguments
+ * * `html` - HTML bytes (must not be NULL)
+ * * `len` - Length of `html` in bytes
+ * * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+ * * `base_len` - Length of `base_url` in bytes
+ * * `options` - Extraction options (may be NULL for defaults)
+ * * `buf` - Output buffer (may be NULL if `cap` is 0)
+ * * `cap` - Size of `buf` in bytes
+ * * `out` - Buffer description to fill in (must not be NULL); on success
+ *   `out->data` is `buf`
+ *
+ * # Returns
+ * 0 on success, or an error code; spans are only valid on success
+ *
+ * # Memory
+ * Do NOT pass `out` to `meta_oxide_buffer_free()`.
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ * - `buf` must point to `cap` writable bytes
+ * - `out` must point to writable space for a `MetaOxideBuffer`
+ */
+int meta_oxide_extract_all_into(const char *html,
+                                size_t len,
+                                const char *base_url,
+                                size_t base_len,
+                                const struct MetaOxideOptions *options,
+                                char *buf,
+                                size_t cap,
+                                struct MetaOxideBuffer *out);
+
+/**
+ * Free a buffer filled in by `meta_oxide_extract_all_buffer()`
+ *
+ * `buffer->data` is released and reset to NULL; the struct itself belongs
+ * to the caller.
+ *
+ * # Safety
+ * - `buffer` must be NULL or point to a buffer filled in by
+ *   `meta_oxide_extract_all_buffer()`
+ */
+void meta_oxide_buffer_free(struct MetaOxideBuffer *buffer);
+
+/**
+ * Route returned strings through caller-supplied allocation functions
+ *
+ * Every string later returned by the library (the fields of a
+ * `MetaOxideResult`, single-format JSON strings, `ManifestDiscovery` fields
+ * and `meta_oxide_extract_all_buffer()` data) is allocated with `malloc_fn`
+ * and released with `free_fn` by the matching `*_free()` function. Passing
+ * NULL for both restores the Rust allocator.
+ *
+ * Install the hooks once at startup. Memory obtained under one allocator
+ * must be freed before switching to another.
+ *
+ * # Arguments
+ * * `malloc_fn` - Allocation function (NULL to restore the default)
+ * * `free_fn` - Release function (NULL to restore the default)
+ * * `user_data` - Passed unchanged to every call of both hooks (may be NULL)
+ *
+ * # Returns
+ * 0 on success, or `MetaOxideError::NullPointer` (6) if only one hook is NULL
+ *
+ * # Safety
+ * - the hooks must be callable from any thread, including the workers of
+ *   `meta_oxide_extract_batch()`
+ * - `malloc_fn` must return NULL or memory that is valid until `free_fn` is
+ *   called on it
+ */
+int meta_oxide_set_allocator(MetaOxideMallocFn malloc_fn,
+                             MetaOxideFreeFn free_fn,
+                             void *user_data);
+
+/**
+ * Start an incremental extraction session
+ *
+ * Feed the document with `meta_oxide_stream_feed()` as it arrives (for example
+ * while reading an HTTP response body), then call `meta_oxide_stream_finish()`.
+ * Head-level results can be read early with `meta_oxide_stream_head()`.
+ *
+ * # Arguments
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ * * `options` - Extraction options (may be NULL for defaults); only
+ *   `META_OXIDE_INPUT_LOSSY` is honoured in `input_flags`
+ *
+ * # Memory
+ * The session must be released with `meta_oxide_stream_finish()` or
+ * `meta_oxide_stream_free()`.
+ *
+ * # Safety
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ */
+struct MetaOxideStream *meta_oxide_stream_new(const char *base_url,
+                                              const struct MetaOxideOptions *options);
+
+/**
+ * Append a chunk of the document to a stream session
+ *
+ * Chunks may split tags and multi-byte characters anywhere; each one goes
+ * straight to the parser rather than being buffered. In head-only mode
+ * (`head_only` set in the options) this returns `META_OXIDE_STREAM_DONE` once
+ * `</head>` has arrived, later chunks are ignored and the caller can stop
+ * reading the document. Other sessions keep returning
+ * `META_OXIDE_STREAM_NEED_MORE`, since tags placed in the body still count.
+ *
+ * # Arguments
+ * * `stream` - Session from `meta_oxide_stream_new()` (must not be NULL)
+ * * `chunk` - Chunk bytes (may be NULL if `len` is 0)
+ * * `len` - Length of `chunk` in bytes
+ *
+ * # Returns
+ * `META_OXIDE_STREAM_NEED_MORE`, `META_OXIDE_STREAM_DONE`, or -1 on error
+ *
+ * # Safety
+ * - `stream` must be a live session
+ * - `chunk` must point to `len` readable bytes
+ */
+int meta_oxide_stream_feed(struct MetaOxideStream *stream, const char *chunk, size_t len);
+
+/**
+ * Get the head-level results of a stream session early
+ *
+ * Available as soon as the end of the head section has been fed; the session
+ * stays usable. Only the selected head-level formats (meta, Open Graph,
+ * Twitter, Dublin Core, manifest, oEmbed, rel-links) are filled in, from the
+ * head section alone; the result of `meta_oxide_stream_finish()` also
+ * covers those tags placed in the body.
+ *
+ * # Returns
+ * A result struct, or NULL if the head has not fully arrived yet (with
+ * `meta_oxide_last_error()` returning 0) or on error
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `stream` must be a live session
+ */
+struct MetaOxideResult *meta_oxide_stream_head(struct MetaOxideStream *stream);
+
+/**
+ * Finish a stream session and extract every requested format
+ *
+ * Extracts the formats selected by the session's `head_only` and `formats`
+ * options from everything fed so far (the head section alone in head-only
+ * mode). Unlike `meta_oxide_extract_all_with_options()`, `limits` and
+ * `stats` are not honoured, nor any `input_flags` but
+ * `META_OXIDE_INPUT_LOSSY`. The session is freed whether or not this
+ * succeeds.
+ *
+ * # Returns
+ * A result struct, or NULL on error
+ *
+ * # Memory
+ * The caller must free the returned struct using `meta_oxide_result_free()`.
+ *
+ * # Safety
+ * - `stream` must be a live session; it must not be used afterwards
+ */
+struct MetaOxideResult *meta_oxide_stream_finish(struct MetaOxideStream *stream);
+
+/**
+ * Free a stream session without extracting anything
+ *
+ * # Safety
+ * - `stream` must be NULL or a live session; it must not be used afterwards
+ */
+void meta_oxide_stream_free(struct MetaOxideStream *stream);
+
+/**
+ * Extract metadata into typed C structs
+ *
+ * Same extraction as `meta_oxide_extract_all_with_options()`, without
+ * converting anything to JSON. Read the results with the
+ * `meta_oxide_typed_*` and `meta_oxide_item_*` accessors; every pointer they
+ * return is borrowed from the handle.
+ *
+ * # Arguments
+ * * `html` - HTML content (must not be NULL)
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ * * `options` - Extraction options (may be NULL for defaults)
+ *
+ * # Returns
+ * A handle, or NULL on error
+ *
+ * # Memory
+ * The caller must free the handle using `meta_oxide_typed_result_free()`,
+ * which invalidates every pointer obtained from it.
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `options` may be NULL or must point to a valid `MetaOxideOptions`
+ */
+struct MetaOxideTypedResult *meta_oxide_extract_typed(const char *html,
+                                                      const char *base_url,
+                                                      const struct MetaOxideOptions *options);
+
+/**
+ * Free a typed result and everything borrowed from it
+ *
+ * # Safety
+ * - `result` must be NULL or a handle from `meta_oxide_extract_typed()`
+ * - `result` must not have been freed previously
+ */
+void meta_oxide_typed_result_free(struct MetaOxideTypedResult *result);
+
+/**
+ * Standard meta tags, or NULL if none were extracted
+ *
+ * # Safety
+ * - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+ */
+const struct MetaOxideMetaTags *meta_oxide_typed_meta(const struct MetaOxideTypedResult *result);
+
+/**
+ * Open Graph metadata, or NULL if none was extracted
+ *
+ * # Safety
+ * - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+ */
+const struct MetaOxideOpenGraph *meta_oxide_typed_open_graph(const struct MetaOxideTypedResult *result);
+
+/**
+ * Twitter Card metadata, or NULL if none was extracted
+ *
+ * # Safety
+ * - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+ */
+const struct MetaOxideTwitterCard *meta_oxide_typed_twitter(const struct MetaOxideTypedResult *result);
+
+/**
+ * rel-* link relationships, sorted by relationship
+ *
+ * # Arguments
+ * * `result` - Typed result handle
+ * * `len` - Receives the number of entries (must not be NULL)
+ *
+ * # Returns
+ * Array of `*len` entries, or NULL if there are none
+ *
+ * # Safety
+ * - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+ * - `len` must point to writable memory
+ */
+const struct MetaOxideRelLink *meta_oxide_typed_rel_links(const struct MetaOxideTypedResult *result,
+                                                          size_t *len);
+
+/**
+ * Number of top-level items of one format
+ *
+ * # Arguments
+ * * `result` - Typed result handle
+ * * `format` - `META_OXIDE_FMT_JSON_LD`, `META_OXIDE_FMT_MICRODATA` or
+ *   `META_OXIDE_FMT_MICROFORMATS`; anything else has no items
+ *
+ * # Safety
+ * - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+ */
+size_t meta_oxide_item_count(const struct MetaOxideTypedResult *result, uint32_t format);
+
+/**
+ * Top-level item `index` of one format, or NULL if out of range
+ *
+ * # Safety
+ * - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+ */
+const struct MetaOxideItem *meta_oxide_item(const struct MetaOxideTypedResult *result,
+                                            uint32_t format,
+                                            size_t index);
+
+/**
+ * Value `index` of the property called `name`, or NULL if there is none
+ *
+ * # Arguments
+ * * `item` - Item from `meta_oxide_item()` or a property value
+ * * `name` - Property name (NUL-terminated)
+ * * `index` - Which value of the property (0 for the first)
+ *
+ * # Safety
+ * - `item` must be NULL or point to an item of a live typed result
+ * - `name` must be NULL or a valid null-terminated C string
+ */
+const struct MetaOxideValue *meta_oxide_item_prop(const struct MetaOxideItem *item,
+                                                  const char *name,
+                                                  size_t index);
+
+/**
+ * Extract standard HTML meta tags
+ *
+ * # Returns
+ * JSON string or NULL on error
+ */
+char *meta_oxide_extract_meta(const char *html, const char *base_url);
+
+/**
+ * Extract standard HTML meta tags from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_meta_n(const char *html,
+                                size_t len,
+                                const char *base_url,
+                                size_t base_len,
+                                uint32_t flags);
+
+/**
+ * Extract standard HTML meta tags into a caller-provided buffer
+ *
+ * Writes the same NUL-terminated JSON as `meta_oxide_extract_meta()` to
+ * `buf`, so the output lands in caller memory and can reuse one buffer
+ * across calls. If it does not fit, `MetaOxideError::BufferTooSmall` (7) is
+ * returned and `buf` holds a truncated, NUL-terminated prefix. Passing a
+ * NULL `buf` with `cap` 0 just measures the output.
+ *
+ * # Arguments
+ * * `html` - HTML content (must not be NULL)
+ * * `base_url` - Base URL for resolving relative URLs (may be NULL)
+ * * `buf` - Output buffer (may be NULL if `cap` is 0)
+ * * `cap` - Size of `buf` in bytes
+ * * `needed` - Set to the output size in bytes, terminator included (may be NULL)
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_meta_into(const char *html,
+                                 const char *base_url,
+                                 char *buf,
+                                 size_t cap,
+                                 size_t *needed);
+
+/**
+ * Extract Open Graph metadata
+ *
+ * # Returns
+ * JSON string or NULL on error
+ */
+char *meta_oxide_extract_open_graph(const char *html, const char *base_url);
+
+/**
+ * Extract Open Graph metadata from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_open_graph_n(const char *html,
+                                      size_t len,
+                                      const char *base_url,
+                                      size_t base_len,
+                                      uint32_t flags);
+
+/**
+ * Extract Open Graph metadata into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_open_graph_into(const char *html,
+                                       const char *base_url,
+                                       char *buf,
+                                       size_t cap,
+                                       size_t *needed);
+
+/**
+ * Extract Twitter Card metadata
+ *
+ * # Returns
+ * JSON string or NULL on error
+ */
+char *meta_oxide_extract_twitter(const char *html, const char *base_url);
+
+/**
+ * Extract Twitter Card metadata from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_twitter_n(const char *html,
+                                   size_t len,
+                                   const char *base_url,
+                                   size_t base_len,
+                                   uint32_t flags);
+
+/**
+ * Extract Twitter Card metadata into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_twitter_into(const char *html,
+                                    const char *base_url,
+                                    char *buf,
+                                    size_t cap,
+                                    size_t *needed);
+
+/**
+ * Extract JSON-LD structured data
+ *
+ * # Returns
+ * JSON array string or NULL on error
+ */
+char *meta_oxide_extract_json_ld(const char *html, const char *base_url);
+
+/**
+ * Extract the JSON-LD objects of the given `@type`s
+ *
+ * Returns what `meta_oxide_extract_json_ld()` would with only the objects
+ * whose `@type` (or one of them) is in `types`, and on those only the listed
+ * `properties`. Scripts are scanned without building the objects that are
+ * dropped, so unwanted `@graph` members such as large `ItemList`s cost no
+ * allocation.
+ *
+ * # Arguments
+ * * `html` - HTML content (must not be NULL)
+ * * `_base_url` - Base URL (may be NULL; not used for JSON-LD)
+ * * `types` - Array of `types_len` `@type` values to keep; an empty array
+ *   keeps every object
+ * * `properties` - Array of `properties_len` property names to keep, or NULL
+ *   to keep them all; `@context`, `@type` and `@id` are always kept
+ *
+ * # Returns
+ * JSON array string or NULL on error
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `types` must point to `types_len` valid null-terminated C strings
+ * - `properties` may be NULL or must point to `properties_len` valid
+ *   null-terminated C strings
+ */
+char *meta_oxide_extract_json_ld_filtered(const char *html,
+                                          const char *_base_url,
+                                          const char *const *types,
+                                          size_t types_len,
+                                          const char *const *properties,
+                                          size_t properties_len);
+
+/**
+ * Extract JSON-LD structured data from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_json_ld_n(const char *html,
+                                   size_t len,
+                                   const char *base_url,
+                                   size_t base_len,
+                                   uint32_t flags);
+
+/**
+ * Extract JSON-LD structured data into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_json_ld_into(const char *html,
+                                    const char *base_url,
+                                    char *buf,
+                                    size_t cap,
+                                    size_t *needed);
+
+/**
+ * Extract Microdata
+ *
+ * # Returns
+ * JSON array string or NULL on error
+ */
+char *meta_oxide_extract_microdata(const char *html, const char *base_url);
+
+/**
+ * Extract Microdata items from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_microdata_n(const char *html,
+                                     size_t len,
+                                     const char *base_url,
+                                     size_t base_len,
+                                     uint32_t flags);
+
+/**
+ * Extract Microdata items into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_microdata_into(const char *html,
+                                      const char *base_url,
+                                      char *buf,
+                                      size_t cap,
+                                      size_t *needed);
+
+/**
+ * Extract Microformats (all 9 types: h-card, h-entry, h-event, etc.)
+ *
+ * # Returns
+ * JSON object string with format types as keys, or NULL on error
+ */
+char *meta_oxide_extract_microformats(const char *html, const char *base_url);
+
+/**
+ * Extract all Microformats from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_microformats_n(const char *html,
+                                        size_t len,
+                                        const char *base_url,
+                                        size_t base_len,
+                                        uint32_t flags);
+
+/**
+ * Extract all Microformats into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_microformats_into(const char *html,
+                                         const char *base_url,
+                                         char *buf,
+                                         size_t cap,
+                                         size_t *needed);
+
+/**
+ * Extract RDFa structured data
+ *
+ * # Returns
+ * JSON array string or NULL on error
+ */
+char *meta_oxide_extract_rdfa(const char *html, const char *base_url);
+
+/**
+ * Extract RDFa structured data from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_rdfa_n(const char *html,
+                                size_t len,
+                                const char *base_url,
+                                size_t base_len,
+                                uint32_t flags);
+
+/**
+ * Extract RDFa structured data into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_rdfa_into(const char *html,
+                                 const char *base_url,
+                                 char *buf,
+                                 size_t cap,
+                                 size_t *needed);
+
+/**
+ * Extract Dublin Core metadata
+ *
+ * # Returns
+ * JSON object string or NULL on error
+ */
+char *meta_oxide_extract_dublin_core(const char *html);
+
+/**
+ * Extract Dublin Core metadata from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ */
+char *meta_oxide_extract_dublin_core_n(const char *html,
+                                       size_t len,
+                                       uint32_t flags);
+
+/**
+ * Extract Dublin Core metadata into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_dublin_core_into(const char *html,
+                                        char *buf,
+                                        size_t cap,
+                                        size_t *needed);
 
 /**
  * Extract Web App Manifest link
@@ -231,6 +1890,44 @@ char *meta_oxide_extract_dublin_core(const char *html);
  */
 char *meta_oxide_extract_manifest(const char *html, const char *base_url);
 
+/**
+ * Extract Web App Manifest link from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_manifest_n(const char *html,
+                                    size_t len,
+                                    const char *base_url,
+                                    size_t base_len,
+                                    uint32_t flags);
+
+/**
+ * Extract Web App Manifest link into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_manifest_into(const char *html,
+                                     const char *base_url,
+                                     char *buf,
+                                     size_t cap,
+                                     size_t *needed);
+
 /**
  * Parse Web App Manifest JSON content
  *
@@ -247,6 +1944,44 @@ char *meta_oxide_parse_manifest(const char *json, const char *base_url);
  */
 char *meta_oxide_extract_oembed(const char *html, const char *base_url);
 
+/**
+ * Extract oEmbed endpoints from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_oembed_n(const char *html,
+                                  size_t len,
+                                  const char *base_url,
+                                  size_t base_len,
+                                  uint32_t flags);
+
+/**
+ * Extract oEmbed endpoints into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_oembed_into(const char *html,
+                                   const char *base_url,
+                                   char *buf,
+                                   size_t cap,
+                                   size_t *needed);
+
 /**
  * Extract rel-* link relationships
  *
@@ -255,6 +1990,44 @@ char *meta_oxide_extract_oembed(const char *html, const char *base_url);
  */
 char *meta_oxide_extract_rel_links(const char *html, const char *base_url);
 
+/**
+ * Extract rel-* link relationships from a length-delimited HTML buffer
+ *
+ * See `meta_oxide_extract_all_n()` for the input conventions.
+ *
+ * # Returns
+ * JSON string or NULL on error
+ *
+ * # Safety
+ * - `html` must point to `len` readable bytes
+ * - `base_url` may be NULL or must point to `base_len` readable bytes
+ */
+char *meta_oxide_extract_rel_links_n(const char *html,
+                                     size_t len,
+                                     const char *base_url,
+                                     size_t base_len,
+                                     uint32_t flags);
+
+/**
+ * Extract rel-* link relationships into a caller-provided buffer
+ *
+ * See `meta_oxide_extract_meta_into()` for the buffer conventions.
+ *
+ * # Returns
+ * 0 on success, or an error code
+ *
+ * # Safety
+ * - `html` must be a valid null-terminated C string
+ * - `base_url` may be NULL or a valid null-terminated C string
+ * - `buf` must point to `cap` writable bytes
+ * - `needed` may be NULL or must point to a writable `size_t`
+ */
+int meta_oxide_extract_rel_links_into(const char *html,
+                                      const char *base_url,
+                                      char *buf,
+                                      size_t cap,
+                                      size_t *needed);
+
 /**
  * Get the last error code
  *
@@ -0,0 +1,107 @@
+//! Bump arena for strings handed out to C callers
+//!
+//! Bytes are copied into large chunks that are never reallocated, so every
+//! pointer returned by [`Arena::alloc_c_str`] stays valid until the next
+//! [`Arena::reset`]. Reset rewinds the arena without freeing its chunks, so a
+//! long-lived arena stops allocating once it has grown to its peak size.
+
+use std::os::raw::c_char;
+
+/// Default chunk size; larger strings get a chunk of their own size
+const CHUNK_SIZE: usize = 64 * 1024;
+
+/// A chunked bump allocator for NUL-terminated strings
+#[derive(Debug, Default)]
+pub struct Arena {
+    chunks: Vec<Vec<u8>>,
+    /// Index of the chunk currently being filled
+    current: usize,
+}
+
+impl Arena {
+    /// Create an empty arena; no memory is allocated until first use
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Copy `bytes` into the arena followed by a NUL byte
+    ///
+    /// The returned pointer is valid until [`reset`](Self::reset) is called or
+    /// the arena is dropped.
+    pub fn alloc_c_str(&mut self, bytes: &[u8]) -> *mut c_char {
+        let needed = bytes.len() + 1;
+        let chunk = self.chunk_with_room(needed);
+
+        let start = chunk.len();
+        chunk.extend_from_slice(bytes);
+        chunk.push(0);
+        // SAFETY: `start` is in bounds, and the chunk never grows past its
+        // capacity, so its buffer is never moved
+        unsafe { chunk.as_mut_ptr().add(start).cast() }
+    }
+
+    /// Release everything allocated so far, keeping the chunks for reuse
+    pub fn reset(&mut self) {
+        for chunk in &mut self.chunks {
+            chunk.clear();
+        }
+        self.current = 0;
+    }
+
+    /// Total bytes reserved by the arena
+    pub fn capacity(&self) -> usize {
+        self.chunks.iter().map(Vec::capacity).sum()
+    }
+
+    /// A chunk with at least `needed` bytes of spare capacity
+    fn chunk_with_room(&mut self, needed: usize) -> &mut Vec<u8> {
+        while let Some(chunk) = self.chunks.get(self.current) {
+            if chunk.capacity() - chunk.len() >= needed {
+                break;
+            }
+            self.current += 1;
+        }
+
+        if self.current == self.chunks.len() {
+            self.chunks.push(Vec::with_capacity(needed.max(CHUNK_SIZE)));
+        }
+        &mut self.chunks[self.current]
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::ffi::CStr;
+
+    #[test]
+    fn test_pointers_stable_across_chunks() {
+        let mut arena = Arena::new();
+        let first = arena.alloc_c_str(b"first");
+        let big = arena.alloc_c_str(&vec![b'x'; CHUNK_SIZE * 2]);
+        let last = arena.alloc_c_str(b"last");
+
+        unsafe {
+            assert_eq!(CStr::from_ptr(first).to_str().unwrap(), "first");
+            assert_eq!(CStr::from_ptr(big).to_bytes().len(), CHUNK_SIZE * 2);
+            assert_eq!(CStr::from_ptr(last).to_str().unwrap(), "last");
+        }
+    }
+
+    #[test]
+    fn test_reset_reuses_chunks() {
+        let mut arena = Arena::new();
+        for _ in 0..1000 {
+            arena.alloc_c_str(b"some metadata json");
+        }
+        let capacity = arena.capacity();
+
+        for _ in 0..10 {
+            arena.reset();
+            for _ in 0..1000 {
+                arena.alloc_c_str(b"some metadata json");
+            }
+        }
+        assert_eq!(arena.capacity(), capacity);
+    }
+}
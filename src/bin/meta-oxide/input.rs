@@ -0,0 +1,436 @@
+//! Input discovery, memory mapping and batching
+//!
+//! [`read`] walks the inputs on a thread of its own and hands the pages it
+//! finds to the extraction loop in batches over a bounded channel, so at most
+//! a few batches are in memory however large the corpus is. Plain WARC and
+//! HTML files are memory-mapped and their pages borrowed from the mapping;
+//! pages of a `.warc.gz` are decompressed and copied out one record at a time.
+
+use std::fs;
+use std::io::{self, BufReader};
+use std::ops::{Deref, Range};
+use std::path::{Path, PathBuf};
+use std::sync::mpsc::SyncSender;
+use std::sync::Arc;
+
+use flate2::bufread::MultiGzDecoder;
+
+use crate::warc;
+
+/// One input file
+pub enum Input {
+    /// An uncompressed WARC file
+    Warc(PathBuf),
+    /// A gzipped WARC file, one gzip member per record or one for the whole
+    Gzip(PathBuf),
+    /// A single HTML page
+    Html(PathBuf),
+}
+
+impl Input {
+    /// Path of the file
+    pub fn path(&self) -> &Path {
+        match self {
+            Self::Warc(path) | Self::Gzip(path) | Self::Html(path) => path,
+        }
+    }
+
+    // The kind of file at `path`, judged by its name; None if it is neither
+    // WARC nor HTML
+    fn classify(path: &Path) -> Option<Self> {
+        let name = path.file_name()?.to_str()?.to_ascii_lowercase();
+        if name.ends_with(".warc.gz") {
+            Some(Self::Gzip(path.to_path_buf()))
+        } else if name.ends_with(".warc") {
+            Some(Self::Warc(path.to_path_buf()))
+        } else if [".html", ".htm", ".xhtml"].iter().any(|ext| name.ends_with(ext)) {
+            Some(Self::Html(path.to_path_buf()))
+        } else {
+            None
+        }
+    }
+}
+
+/// Expand `paths` into input files
+///
+/// Directories are searched recursively for WARC and HTML files, in name
+/// order. A file named on the command line is read as HTML unless its name
+/// marks it as WARC.
+pub fn collect(paths: &[PathBuf]) -> io::Result<Vec<Input>> {
+    fn walk(dir: &Path, out: &mut Vec<Input>) -> io::Result<()> {
+        let mut entries =
+            fs::read_dir(dir)?.map(|e| e.map(|e| e.path())).collect::<Result<Vec<_>, _>>()?;
+        entries.sort();
+        for path in entries {
+            if path.is_dir() {
+                walk(&path, out)?;
+            } else if let Some(input) = Input::classify(&path) {
+                out.push(input);
+            }
+        }
+        Ok(())
+    }
+
+    let mut inputs = Vec::new();
+    for path in paths {
+        if path.is_dir() {
+            walk(path, &mut inputs)?;
+        } else {
+            inputs.push(Input::classify(path).unwrap_or_else(|| Input::Html(path.clone())));
+        }
+    }
+    Ok(inputs)
+}
+
+#[cfg(unix)]
+mod map {
+    use std::fs::File;
+    use std::io;
+    use std::os::unix::io::AsRawFd;
+    use std::path::Path;
+    use std::ptr;
+
+    /// A read-only memory mapping of a whole file
+    pub struct Mmap {
+        ptr: *mut libc::c_void,
+        len: usize,
+    }
+
+    // SAFETY: the mapping is private and read-only, and unmapped only on drop
+    unsafe impl Send for Mmap {}
+    unsafe impl Sync for Mmap {}
+
+    impl Mmap {
+        /// Map the file at `path`
+        ///
+        /// The file must not be truncated while it is mapped.
+        pub fn open(path: &Path) -> io::Result<Self> {
+            let file = File::open(path)?;
+            let len = usize::try_from(file.metadata()?.len()).map_err(|_| {
+                io::Error::new(io::ErrorKind::InvalidInput, "file too large to map")
+            })?;
+            if len == 0 {
+                return Ok(Self { ptr: ptr::null_mut(), len });
+            }
+
+            // SAFETY: a fresh private read-only mapping of an open file
+            let ptr = unsafe {
+                libc::mmap(
+                    ptr::null_mut(),
+                    len,
+                    libc::PROT_READ,
+                    libc::MAP_PRIVATE,
+                    file.as_raw_fd(),
+                    0,
+                )
+            };
+            if ptr == libc::MAP_FAILED {
+                return Err(io::Error::last_os_error());
+            }
+            // Advice only; a failure just means less read-ahead
+            // SAFETY: `ptr` and `len` describe the mapping made above
+            unsafe { libc::madvise(ptr, len, libc::MADV_SEQUENTIAL) };
+            Ok(Self { ptr, len })
+        }
+
+        pub fn bytes(&self) -> &[u8] {
+            if self.len == 0 {
+                return &[];
+            }
+            // SAFETY: the mapping is `len` readable bytes until `self` is dropped
+            unsafe { std::slice::from_raw_parts(self.ptr.cast::<u8>(), self.len) }
+        }
+    }
+
+    impl Drop for Mmap {
+        fn drop(&mut self) {
+            if self.len != 0 {
+                // SAFETY: unmaps the mapping made in `open`, which nothing borrows anymore
+                unsafe { libc::munmap(self.ptr, self.len) };
+            }
+        }
+    }
+}
+
+#[cfg(not(unix))]
+mod map {
+    use std::io;
+    use std::path::Path;
+
+    /// The contents of a whole file, read into memory where mapping is unsupported
+    pub struct Mmap(Vec<u8>);
+
+    impl Mmap {
+        /// Read the file at `path`
+        pub fn open(path: &Path) -> io::Result<Self> {
+            std::fs::read(path).map(Self)
+        }
+
+        pub fn bytes(&self) -> &[u8] {
+            &self.0
+        }
+    }
+}
+
+pub use map::Mmap;
+
+/// The raw HTML of a page
+pub enum Bytes {
+    /// Copied out of a compressed file
+    Owned(Vec<u8>),
+    /// A range of a mapped file
+    Mapped(Arc<Mmap>, Range<usize>),
+}
+
+impl Deref for Bytes {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        match self {
+            Self::Owned(bytes) => bytes,
+            Self::Mapped(map, range) => &map.bytes()[range.clone()],
+        }
+    }
+}
+
+/// One page to extract
+pub struct Doc {
+    /// Raw HTML, in whatever encoding it was served in
+    pub html: Bytes,
+    /// Target URI of the WARC record, used as the base URL
+    pub url: Option<String>,
+    /// Path of an HTML file
+    pub path: Option<String>,
+    /// `Content-Type` the page was served with
+    pub content_type: Option<String>,
+}
+
+/// What [`read`] saw besides the pages it sent
+#[derive(Debug, Default)]
+pub struct Summary {
+    /// Response and resource records skipped for not holding a readable HTML page
+    pub skipped: usize,
+}
+
+// Batches pages and sends them to the extraction loop
+struct Batcher {
+    tx: SyncSender<Vec<Doc>>,
+    batch: Vec<Doc>,
+    bytes: usize,
+    max_docs: usize,
+    max_bytes: usize,
+}
+
+impl Batcher {
+    /// Add a page; false once the extraction loop has hung up
+    fn push(&mut self, doc: Doc) -> bool {
+        self.bytes += doc.html.len();
+        self.batch.push(doc);
+        if self.batch.len() >= self.max_docs || self.bytes >= self.max_bytes {
+            return self.flush();
+        }
+        true
+    }
+
+    fn flush(&mut self) -> bool {
+        if self.batch.is_empty() {
+            return true;
+        }
+        self.bytes = 0;
+        let batch = std::mem::replace(&mut self.batch, Vec::with_capacity(self.max_docs));
+        self.tx.send(batch).is_ok()
+    }
+}
+
+// The HTML page a WARC record carries
+enum Page<'a> {
+    Html {
+        body: &'a [u8],
+        content_type: Option<&'a str>,
+    },
+    /// A response or resource that is not a readable HTML page
+    Skipped,
+    /// A request, metadata or other record that never holds a page
+    Other,
+}
+
+fn is_html(content_type: Option<&str>) -> bool {
+    let Some(content_type) = content_type else {
+        return false;
+    };
+    let mime = content_type.split(';').next().unwrap_or_default().trim();
+    mime.eq_ignore_ascii_case("text/html") || mime.eq_ignore_ascii_case("application/xhtml+xml")
+}
+
+fn page<'a>(record: &warc::Record<'a>) -> Page<'a> {
+    match record.warc_type {
+        "response" => match warc::http_response(record.block) {
+            Some(r) if (200..300).contains(&r.status) && !r.encoded && is_html(r.content_type) => {
+                Page::Html { body: r.body, content_type: r.content_type }
+            }
+            _ => Page::Skipped,
+        },
+        "resource" if is_html(record.content_type) => {
+            Page::Html { body: record.block, content_type: record.content_type }
+        }
+        "resource" => Page::Skipped,
+        _ => Page::Other,
+    }
+}
+
+/// Read every input and send its pages, `max_docs` or `max_bytes` of HTML at a time
+///
+/// Stops early, without an error, once the receiving end is dropped.
+pub fn read(
+    inputs: &[Input],
+    max_docs: usize,
+    max_bytes: usize,
+    tx: SyncSender<Vec<Doc>>,
+) -> io::Result<Summary> {
+    let mut batcher =
+        Batcher { tx, batch: Vec::with_capacity(max_docs), bytes: 0, max_docs, max_bytes };
+    let mut summary = Summary::default();
+
+    for input in inputs {
+        let open = read_input(input, &mut batcher, &mut summary)
+            .map_err(|e| io::Error::new(e.kind(), format!("{}: {e}", input.path().display())))?;
+        if !open {
+            return Ok(summary);
+        }
+    }
+    batcher.flush();
+    Ok(summary)
+}
+
+fn record_doc(html: Bytes, record: &warc::Record<'_>, content_type: Option<&str>) -> Doc {
+    Doc {
+        html,
+        url: record.target_uri.map(str::to_string),
+        path: None,
+        content_type: content_type.map(str::to_string),
+    }
+}
+
+// Send the pages of one input; Ok(false) once the extraction loop has hung up
+fn read_input(input: &Input, batcher: &mut Batcher, summary: &mut Summary) -> io::Result<bool> {
+    match input {
+        Input::Html(path) => {
+            let map = Arc::new(Mmap::open(path)?);
+            let len = map.bytes().len();
+            Ok(batcher.push(Doc {
+                html: Bytes::Mapped(map, 0..len),
+                url: None,
+                path: Some(path.display().to_string()),
+                content_type: None,
+            }))
+        }
+        Input::Warc(path) => {
+            let map = Arc::new(Mmap::open(path)?);
+            let data = map.bytes();
+            let mut pos = 0;
+            while let Some((record, used)) = warc::parse(&data[pos..])? {
+                match page(&record) {
+                    Page::Html { body, content_type } => {
+                        // `body` lies within `data`, so its offset is its range in the mapping
+                        let start = body.as_ptr() as usize - data.as_ptr() as usize;
+                        let html = Bytes::Mapped(Arc::clone(&map), start..start + body.len());
+                        if !batcher.push(record_doc(html, &record, content_type)) {
+                            return Ok(false);
+                        }
+                    }
+                    Page::Skipped => summary.skipped += 1,
+                    Page::Other => {}
+                }
+                pos += used;
+            }
+            Ok(true)
+        }
+        Input::Gzip(path) => {
+            let map = Mmap::open(path)?;
+            let mut reader = BufReader::with_capacity(1 << 16, MultiGzDecoder::new(map.bytes()));
+            let mut buf = Vec::new();
+            while warc::read_into(&mut reader, &mut buf)? {
+                let Some((record, _)) = warc::parse(&buf)? else {
+                    continue;
+                };
+                match page(&record) {
+                    Page::Html { body, content_type } => {
+                        let html = Bytes::Owned(body.to_vec());
+                        if !batcher.push(record_doc(html, &record, content_type)) {
+                            return Ok(false);
+                        }
+                    }
+                    Page::Skipped => summary.skipped += 1,
+                    Page::Other => {}
+                }
+            }
+            Ok(true)
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::io::Write;
+    use std::sync::mpsc;
+
+    use flate2::write::GzEncoder;
+    use flate2::Compression;
+
+    use super::*;
+
+    fn record(warc_type: &str, uri: &str, block: &str) -> String {
+        format!(
+            "WARC/1.0\r\nWARC-Type: {warc_type}\r\nWARC-Target-URI: {uri}\r\n\
+             Content-Type: application/http; msgtype=response\r\n\
+             Content-Length: {}\r\n\r\n{block}\r\n\r\n",
+            block.len()
+        )
+    }
+
+    #[test]
+    fn test_read_plain_and_gzipped_warc() {
+        let page = "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n\r\n<title>Hi</title>";
+        let image = "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\n\r\n\x7fPNG";
+        let records = [
+            record("request", "https://a.test/", "GET / HTTP/1.1\r\n\r\n"),
+            record("response", "https://a.test/", page),
+            record("response", "https://a.test/logo.png", image),
+            record("response", "https://b.test/", page),
+        ];
+
+        let dir = std::env::temp_dir().join(format!("meta-oxide-input-{}", std::process::id()));
+        fs::create_dir_all(&dir).unwrap();
+        fs::write(dir.join("a.warc"), records.concat()).unwrap();
+        // One gzip member per record, as crawlers write them
+        let mut gz = Vec::new();
+        for record in &records {
+            let mut encoder = GzEncoder::new(Vec::new(), Compression::fast());
+            encoder.write_all(record.as_bytes()).unwrap();
+            gz.extend(encoder.finish().unwrap());
+        }
+        fs::write(dir.join("b.warc.gz"), gz).unwrap();
+        fs::write(dir.join("notes.txt"), "ignored").unwrap();
+
+        let inputs = collect(std::slice::from_ref(&dir)).unwrap();
+        assert_eq!(inputs.len(), 2);
+
+        let (tx, rx) = mpsc::sync_channel(8);
+        let summary = read(&inputs, 3, usize::MAX, tx).unwrap();
+        let batches: Vec<Vec<Doc>> = rx.iter().collect();
+        fs::remove_dir_all(&dir).unwrap();
+
+        assert_eq!(summary.skipped, 2);
+        assert_eq!(batches.iter().map(Vec::len).collect::<Vec<_>>(), [3, 1]);
+        let docs: Vec<&Doc> = batches.iter().flatten().collect();
+        assert!(docs.iter().all(|doc| &*doc.html == b"<title>Hi</title>"));
+        let urls: Vec<_> = docs.iter().map(|doc| doc.url.as_deref().unwrap()).collect();
+        assert_eq!(
+            urls,
+            ["https://a.test/", "https://b.test/", "https://a.test/", "https://b.test/"]
+        );
+        assert!(
+            matches!(docs[0].html, Bytes::Mapped(..)) && matches!(docs[2].html, Bytes::Owned(_))
+        );
+    }
+}
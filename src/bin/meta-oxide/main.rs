@@ -0,0 +1,413 @@
+//! `meta-oxide`: bulk metadata extraction over WARC files and HTML pages
+//!
+//! Inputs are WARC files (`.warc`, `.warc.gz`), HTML files, or directories
+//! searched for both. A reader thread maps the files and cuts them into
+//! batches of bounded size; each batch is spread over the library's worker
+//! pool, which runs the parse-once [`extract_all`] path on every page, and
+//! the results are written in input order as NDJSON or as a stream of
+//! MessagePack maps. Pages are decoded in the charset of their HTTP
+//! `Content-Type` or `<meta>` tag before parsing.
+//!
+//! A throughput summary goes to stderr at the end; `--stats` adds the time
+//! spent per stage and per format.
+
+mod input;
+mod warc;
+
+use std::ffi::OsString;
+use std::fs::File;
+use std::io::{self, BufWriter, Write};
+use std::path::PathBuf;
+use std::process::ExitCode;
+use std::sync::mpsc;
+use std::thread;
+use std::time::{Duration, Instant};
+
+use meta_oxide::charset;
+use meta_oxide::extract::{self, extract_all, formats, ExtractOptions, Extraction, Stats};
+use meta_oxide::msgpack;
+use meta_oxide::pool;
+use serde::Serialize;
+
+use crate::input::Doc;
+
+const USAGE: &str = "\
+Usage: meta-oxide [OPTIONS] <INPUT>...
+
+Extract metadata from WARC files (.warc, .warc.gz), HTML files, or
+directories searched recursively for both. Writes one result per page.
+
+Options:
+  -f, --formats <LIST>   Comma-separated formats to extract [default: all]:
+                         meta, open-graph, twitter, json-ld, microdata,
+                         microformats, rdfa, dublin-core, manifest, oembed,
+                         rel-links, head (every head format), all
+      --head-only        Only parse the document head
+  -e, --encoding <ENC>   Output encoding: json (NDJSON) or msgpack [default: json]
+  -o, --output <FILE>    Write results to FILE instead of stdout
+  -j, --threads <N>      Worker threads [default: one per core]
+      --batch <N>        Pages per batch [default: 256]
+      --stats            Report time per stage and format
+  -q, --quiet            Do not print the summary
+  -h, --help             Print this help
+  -V, --version          Print the version";
+
+/// Format names accepted by `--formats`, indexed by [`formats::index`]
+const FORMAT_NAMES: [&str; formats::COUNT] = [
+    "meta",
+    "open-graph",
+    "twitter",
+    "json-ld",
+    "microdata",
+    "microformats",
+    "rdfa",
+    "dublin-core",
+    "manifest",
+    "oembed",
+    "rel-links",
+];
+
+/// HTML bytes per batch, whatever the page count
+const BATCH_BYTES: usize = 64 << 20;
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Encoding {
+    Json,
+    Msgpack,
+}
+
+#[derive(Debug)]
+struct Args {
+    inputs: Vec<PathBuf>,
+    options: ExtractOptions,
+    encoding: Encoding,
+    output: Option<PathBuf>,
+    threads: usize,
+    batch: usize,
+    stats: bool,
+    quiet: bool,
+}
+
+#[derive(Debug)]
+enum Command {
+    Run(Args),
+    Help,
+    Version,
+}
+
+fn parse_formats(list: &str) -> Result<u32, String> {
+    list.split(',').map(str::trim).filter(|name| !name.is_empty()).try_fold(0, |mask, name| {
+        let format = match name {
+            "all" => formats::ALL,
+            "head" => formats::HEAD,
+            _ => match FORMAT_NAMES.iter().position(|&known| known == name) {
+                Some(index) => 1 << index,
+                None => return Err(format!("unknown format '{name}'")),
+            },
+        };
+        Ok(mask | format)
+    })
+}
+
+fn parse_args(args: impl IntoIterator<Item = OsString>) -> Result<Command, String> {
+    let mut parsed = Args {
+        inputs: Vec::new(),
+        options: ExtractOptions::default(),
+        encoding: Encoding::Json,
+        output: None,
+        threads: 0,
+        batch: 256,
+        stats: false,
+        quiet: false,
+    };
+
+    let mut args = args.into_iter();
+    let mut only_inputs = false;
+    while let Some(arg) = args.next() {
+        let text = arg.to_string_lossy();
+        if only_inputs || !text.starts_with('-') {
+            parsed.inputs.push(PathBuf::from(arg));
+            continue;
+        }
+        if text == "-" {
+            return Err("reading from stdin is not supported; pass file paths".to_string());
+        }
+
+        // `--name=value` or `--name value`
+        let (name, inline) = match text.split_once('=') {
+            Some((name, value)) if name.starts_with("--") => {
+                (name.to_string(), Some(value.to_string()))
+            }
+            _ => (text.to_string(), None),
+        };
+        let mut value = || {
+            inline
+                .clone()
+                .or_else(|| args.next().map(|v| v.to_string_lossy().into_owned()))
+                .ok_or_else(|| format!("{name} needs a value"))
+        };
+        let number = |value: String| {
+            value.parse::<usize>().map_err(|_| format!("{name} expects a number, got '{value}'"))
+        };
+
+        match name.as_str() {
+            "--" => only_inputs = true,
+            "-f" | "--formats" => parsed.options.formats = parse_formats(&value()?)?,
+            "--head-only" => parsed.options.head_only = true,
+            "-e" | "--encoding" => {
+                parsed.encoding = match value()?.as_str() {
+                    "json" | "ndjson" => Encoding::Json,
+                    "msgpack" => Encoding::Msgpack,
+                    other => return Err(format!("unknown encoding '{other}'")),
+                }
+            }
+            "-o" | "--output" => parsed.output = Some(PathBuf::from(value()?)),
+            "-j" | "--threads" => parsed.threads = number(value()?)?,
+            "--batch" => parsed.batch = number(value()?)?.max(1),
+            "--stats" => parsed.stats = true,
+            "-q" | "--quiet" => parsed.quiet = true,
+            "-h" | "--help" => return Ok(Command::Help),
+            "-V" | "--version" => return Ok(Command::Version),
+            _ => return Err(format!("unknown option '{name}'")),
+        }
+    }
+
+    if parsed.inputs.is_empty() {
+        return Err("no inputs given".to_string());
+    }
+    Ok(Command::Run(parsed))
+}
+
+/// One line (or map) of output
+#[derive(Serialize)]
+struct Record<'a> {
+    #[serde(skip_serializing_if = "Option::is_none")]
+    url: Option<&'a str>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    path: Option<&'a str>,
+    #[serde(flatten)]
+    extraction: &'a Extraction,
+}
+
+/// What extracting one page produced
+struct Output {
+    bytes: Vec<u8>,
+    stats: Option<Stats>,
+}
+
+fn process(doc: &Doc, args: &Args) -> io::Result<Output> {
+    let html = charset::decode(&doc.html, doc.content_type.as_deref()).text;
+    let base_url = doc.url.as_deref();
+    let mut stats = args.stats.then(Stats::default);
+    let extraction = match stats.as_mut() {
+        Some(stats) => extract::extract_all_with_stats(&html, base_url, &args.options, stats),
+        None => extract_all(&html, base_url, &args.options),
+    };
+
+    let record =
+        Record { url: doc.url.as_deref(), path: doc.path.as_deref(), extraction: &extraction };
+    let mut bytes = Vec::new();
+    match args.encoding {
+        Encoding::Json => {
+            serde_json::to_writer(&mut bytes, &record)?;
+            bytes.push(b'\n');
+        }
+        Encoding::Msgpack => {
+            msgpack::write(&mut bytes, &record)
+                .map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))?;
+        }
+    }
+    Ok(Output { bytes, stats })
+}
+
+/// Running totals over every page
+#[derive(Debug, Default)]
+struct Totals {
+    docs: usize,
+    input_bytes: u64,
+    output_bytes: u64,
+    parse: Duration,
+    head_scan: Duration,
+    formats: [Duration; formats::COUNT],
+}
+
+impl Totals {
+    fn add(&mut self, doc: &Doc, output: &Output) {
+        self.docs += 1;
+        self.input_bytes += doc.html.len() as u64;
+        self.output_bytes += output.bytes.len() as u64;
+        if let Some(stats) = &output.stats {
+            self.parse += stats.parse;
+            self.head_scan += stats.head_scan;
+            for (total, time) in self.formats.iter_mut().zip(stats.formats) {
+                *total += time;
+            }
+        }
+    }
+}
+
+fn run(args: &Args) -> io::Result<()> {
+    let inputs = input::collect(&args.inputs)?;
+    if args.threads != 0 {
+        pool::set_global_threads(args.threads);
+    }
+    let pool = pool::global();
+
+    let mut out: Box<dyn Write> = match &args.output {
+        Some(path) => Box::new(BufWriter::with_capacity(1 << 20, File::create(path)?)),
+        None => Box::new(BufWriter::with_capacity(1 << 20, io::stdout().lock())),
+    };
+    let mut totals = Totals::default();
+    let start = Instant::now();
+
+    let summary = thread::scope(|scope| {
+        // One batch queued while one is extracted bounds the pages in memory
+        let (tx, rx) = mpsc::sync_channel(1);
+        let inputs = &inputs;
+        let reader = thread::Builder::new()
+            .name("meta-oxide-reader".to_string())
+            .spawn_scoped(scope, move || input::read(inputs, args.batch, BATCH_BYTES, tx))?;
+
+        let written = rx.iter().try_for_each(|batch| {
+            let outputs = pool.map(batch.len(), |i| process(&batch[i], args));
+            for (doc, output) in batch.iter().zip(outputs) {
+                let output = output?;
+                out.write_all(&output.bytes)?;
+                totals.add(doc, &output);
+            }
+            io::Result::Ok(())
+        });
+        // Hang up first, so a reader blocked on a full channel returns
+        drop(rx);
+        let summary = reader.join().expect("reader thread panicked")?;
+        written.and_then(|()| out.flush()).map(|()| summary)
+    })?;
+
+    if !args.quiet {
+        report(&totals, summary.skipped, start.elapsed(), args.stats);
+    }
+    Ok(())
+}
+
+fn report(totals: &Totals, skipped: usize, elapsed: Duration, stages: bool) {
+    let secs = elapsed.as_secs_f64().max(1e-9);
+    let mb = |bytes: u64| bytes as f64 / 1e6;
+    eprintln!(
+        "meta-oxide: {} documents ({skipped} skipped), {:.1} MB in {secs:.2} s: \
+         {:.1} docs/s, {:.1} MB/s in, {:.1} MB/s out",
+        totals.docs,
+        mb(totals.input_bytes),
+        totals.docs as f64 / secs,
+        mb(totals.input_bytes) / secs,
+        mb(totals.output_bytes) / secs,
+    );
+
+    if !stages {
+        return;
+    }
+    // Stage times are summed over every worker thread
+    let rows = [("parse", totals.parse), ("head scan", totals.head_scan)]
+        .into_iter()
+        .chain(FORMAT_NAMES.iter().copied().zip(totals.formats))
+        .filter(|(_, time)| !time.is_zero())
+        .collect::<Vec<_>>();
+    let total: Duration = rows.iter().map(|(_, time)| *time).sum();
+    eprintln!("  {:<14}{:>12}{:>8}{:>12}", "stage", "thread-s", "share", "us/doc");
+    for (name, time) in rows {
+        eprintln!(
+            "  {name:<14}{:>12.3}{:>7.1}%{:>12.1}",
+            time.as_secs_f64(),
+            100.0 * time.as_secs_f64() / total.as_secs_f64().max(1e-9),
+            time.as_secs_f64() * 1e6 / totals.docs.max(1) as f64,
+        );
+    }
+}
+
+fn main() -> ExitCode {
+    let args = match parse_args(std::env::args_os().skip(1)) {
+        Ok(Command::Run(args)) => args,
+        Ok(Command::Help) => {
+            println!("{USAGE}");
+            return ExitCode::SUCCESS;
+        }
+        Ok(Command::Version) => {
+            println!("meta-oxide {}", env!("CARGO_PKG_VERSION"));
+            return ExitCode::SUCCESS;
+        }
+        Err(message) => {
+            eprintln!("meta-oxide: {message}\n\n{USAGE}");
+            return ExitCode::from(2);
+        }
+    };
+
+    match run(&args) {
+        Ok(()) => ExitCode::SUCCESS,
+        // A closed pipe (`| head`) is not a failure
+        Err(e) if e.kind() == io::ErrorKind::BrokenPipe => ExitCode::SUCCESS,
+        Err(e) => {
+            eprintln!("meta-oxide: {e}");
+            ExitCode::FAILURE
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn parse(args: &[&str]) -> Result<Command, String> {
+        parse_args(args.iter().map(OsString::from))
+    }
+
+    #[test]
+    fn test_format_names_follow_bits() {
+        assert_eq!(parse_formats("meta").unwrap(), formats::META);
+        assert_eq!(
+            parse_formats("json-ld, rel-links").unwrap(),
+            formats::JSON_LD | formats::REL_LINKS
+        );
+        assert_eq!(parse_formats("head").unwrap(), formats::HEAD);
+        assert_eq!(parse_formats("all").unwrap(), formats::ALL);
+        assert!(parse_formats("jsonld").is_err());
+    }
+
+    #[test]
+    fn test_parse_args() {
+        let Ok(Command::Run(args)) = parse(&[
+            "-f",
+            "meta,json-ld",
+            "--encoding=msgpack",
+            "-j",
+            "4",
+            "--head-only",
+            "a.warc.gz",
+            "--",
+            "-b",
+        ]) else {
+            panic!("expected a run");
+        };
+        assert_eq!(args.options.formats, formats::META | formats::JSON_LD);
+        assert!(args.options.head_only);
+        assert_eq!(args.encoding, Encoding::Msgpack);
+        assert_eq!(args.threads, 4);
+        assert_eq!(args.inputs, [PathBuf::from("a.warc.gz"), PathBuf::from("-b")]);
+
+        assert!(matches!(parse(&["--help"]), Ok(Command::Help)));
+        assert!(parse(&[]).is_err());
+        assert!(parse(&["-j", "many", "x"]).is_err());
+        assert!(parse(&["--bogus", "x"]).is_err());
+        assert!(parse(&["-"]).is_err());
+    }
+
+    #[test]
+    fn test_record_flattens_extraction() {
+        let extraction = Extraction { rel_links: Some(Default::default()), ..Default::default() };
+        let record =
+            Record { url: Some("https://example.com/"), path: None, extraction: &extraction };
+        assert_eq!(
+            serde_json::to_string(&record).unwrap(),
+            r#"{"url":"https://example.com/","relLinks":{}}"#
+        );
+        assert!(msgpack::to_vec(&record).is_ok());
+    }
+}
@@ -0,0 +1,258 @@
+//! WARC record and HTTP response parsing
+//!
+//! Only what extraction needs is read: the type, target URI and block of each
+//! record, and the status, content type and body of an HTTP response block.
+//! [`parse`] works in place on a byte slice, so records of a memory-mapped
+//! file borrow from the mapping; [`read_into`] fills a buffer from a stream
+//! (a decompressed `.warc.gz`) for [`parse`] to read.
+
+use std::io::{self, BufRead, Read};
+
+use memchr::memmem;
+
+/// One WARC record
+#[derive(Debug)]
+pub struct Record<'a> {
+    /// `WARC-Type`: `response`, `resource`, `request`, `metadata`, ...
+    pub warc_type: &'a str,
+    /// `WARC-Target-URI`
+    pub target_uri: Option<&'a str>,
+    /// `Content-Type` of the block
+    pub content_type: Option<&'a str>,
+    /// The record block, `Content-Length` bytes
+    pub block: &'a [u8],
+}
+
+/// The parts of an HTTP response that extraction needs
+#[derive(Debug)]
+pub struct Response<'a> {
+    /// Status code
+    pub status: u16,
+    /// `Content-Type` header
+    pub content_type: Option<&'a str>,
+    /// Whether a `Content-Encoding` or `Transfer-Encoding` other than
+    /// `identity` was applied, so the body cannot be read as it is
+    pub encoded: bool,
+    /// Payload
+    pub body: &'a [u8],
+}
+
+/// Largest record block [`read_into`] accepts
+///
+/// A stream has no length to check `Content-Length` against, so a corrupt
+/// header could otherwise ask for any amount of memory.
+pub const MAX_RECORD_BYTES: usize = 1 << 30;
+
+fn invalid(message: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, message)
+}
+
+// Number of CR and LF bytes at the start of `data`; records are separated
+// by two CRLFs and some writers add more
+fn blank_prefix(data: &[u8]) -> usize {
+    data.iter().take_while(|&&b| b == b'\r' || b == b'\n').count()
+}
+
+// Length of the header block at the start of `data`, blank line included
+fn header_len(data: &[u8]) -> Option<usize> {
+    let crlf = memmem::find(data, b"\r\n\r\n").map(|i| i + 4);
+    let lf = memmem::find(data, b"\n\n").map(|i| i + 2);
+    match (crlf, lf) {
+        (Some(a), Some(b)) => Some(a.min(b)),
+        (a, b) => a.or(b),
+    }
+}
+
+// `name: value` pairs of a header block, after its first line
+fn fields(header: &[u8]) -> impl Iterator<Item = (&str, &str)> {
+    header.split(|&b| b == b'\n').skip(1).filter_map(|line| {
+        let line = std::str::from_utf8(line).ok()?;
+        let (name, value) = line.split_once(':')?;
+        Some((name.trim(), value.trim()))
+    })
+}
+
+/// Parse the record at the start of `data`
+///
+/// Returns the record and the number of bytes it took, or None once only
+/// blank lines are left. Malformed or truncated records are errors.
+pub fn parse(data: &[u8]) -> io::Result<Option<(Record<'_>, usize)>> {
+    let start = blank_prefix(data);
+    if start == data.len() {
+        return Ok(None);
+    }
+    let data = &data[start..];
+    if !data.starts_with(b"WARC/") {
+        return Err(invalid("expected a WARC record"));
+    }
+    let header_len = header_len(data).ok_or_else(|| invalid("truncated WARC header"))?;
+
+    let mut record = Record { warc_type: "", target_uri: None, content_type: None, block: &[] };
+    let mut length = None;
+    for (name, value) in fields(&data[..header_len]) {
+        if name.eq_ignore_ascii_case("WARC-Type") {
+            record.warc_type = value;
+        } else if name.eq_ignore_ascii_case("WARC-Target-URI") {
+            // WARC 1.0 allowed the URI in angle brackets
+            record.target_uri = Some(value.trim_start_matches('<').trim_end_matches('>'));
+        } else if name.eq_ignore_ascii_case("Content-Type") {
+            record.content_type = Some(value);
+        } else if name.eq_ignore_ascii_case("Content-Length") {
+            length = value.parse::<usize>().ok();
+        }
+    }
+
+    let length = length.ok_or_else(|| invalid("WARC record without a Content-Length"))?;
+    let end = header_len.checked_add(length).filter(|&end| end <= data.len());
+    let end = end.ok_or_else(|| invalid("truncated WARC record"))?;
+    record.block = &data[header_len..end];
+    Ok(Some((record, start + end)))
+}
+
+/// Read the next record from `reader` into `buf`, replacing its contents
+///
+/// For input that cannot be mapped; the record is then read back with
+/// [`parse`]. Returns false at the end of the input.
+pub fn read_into<R: BufRead>(reader: &mut R, buf: &mut Vec<u8>) -> io::Result<bool> {
+    buf.clear();
+    loop {
+        let line_start = buf.len();
+        if reader.read_until(b'\n', buf)? == 0 {
+            return match line_start {
+                0 => Ok(false),
+                _ => Err(invalid("truncated WARC header")),
+            };
+        }
+        if blank_prefix(&buf[line_start..]) == buf.len() - line_start {
+            if line_start == 0 {
+                // Separator lines before a record
+                buf.clear();
+                continue;
+            }
+            break;
+        }
+    }
+
+    let length = fields(buf)
+        .find(|(name, _)| name.eq_ignore_ascii_case("Content-Length"))
+        .and_then(|(_, value)| value.parse::<usize>().ok())
+        .ok_or_else(|| invalid("WARC record without a Content-Length"))?;
+
+    if length > MAX_RECORD_BYTES {
+        return Err(invalid("WARC record too large"));
+    }
+
+    // Grow the buffer as the block arrives rather than trusting the length
+    let header_len = buf.len();
+    if reader.by_ref().take(length as u64).read_to_end(buf)? < length {
+        return Err(invalid("truncated WARC record"));
+    }
+    debug_assert_eq!(buf.len(), header_len + length);
+    Ok(true)
+}
+
+/// Split an `application/http` response block into status, headers and body
+///
+/// Returns None if the block does not start with an HTTP status line.
+pub fn http_response(block: &[u8]) -> Option<Response<'_>> {
+    if !block.starts_with(b"HTTP/") {
+        return None;
+    }
+    let header_len = header_len(block)?;
+    let header = &block[..header_len];
+
+    let status_line = header.split(|&b| b == b'\n').next()?;
+    let status = std::str::from_utf8(status_line).ok()?.split_whitespace().nth(1)?.parse().ok()?;
+
+    let mut response = Response { status, content_type: None, encoded: false, body: &[] };
+    for (name, value) in fields(header) {
+        if name.eq_ignore_ascii_case("Content-Type") {
+            response.content_type = Some(value);
+        } else if name.eq_ignore_ascii_case("Content-Encoding")
+            || name.eq_ignore_ascii_case("Transfer-Encoding")
+        {
+            response.encoded |= !value.eq_ignore_ascii_case("identity");
+        }
+    }
+    response.body = &block[header_len..];
+    Some(response)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn record(headers: &str, block: &str) -> String {
+        format!("WARC/1.0\r\n{headers}Content-Length: {}\r\n\r\n{block}\r\n\r\n", block.len())
+    }
+
+    const PAGE: &str =
+        "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=utf-8\r\n\r\n<title>T</title>";
+
+    #[test]
+    fn test_parse_records_in_sequence() {
+        let data = record("WARC-Type: warcinfo\r\n", "software: x")
+            + &record(
+                "WARC-Type: response\r\nWARC-Target-URI: <https://example.com/>\r\n\
+                 Content-Type: application/http; msgtype=response\r\n",
+                PAGE,
+            );
+
+        let (info, used) = parse(data.as_bytes()).unwrap().unwrap();
+        assert_eq!(info.warc_type, "warcinfo");
+        assert_eq!(info.block, b"software: x");
+
+        let (page, rest) = parse(&data.as_bytes()[used..]).unwrap().unwrap();
+        assert_eq!(page.warc_type, "response");
+        assert_eq!(page.target_uri, Some("https://example.com/"));
+        assert_eq!(page.block, PAGE.as_bytes());
+        assert!(parse(&data.as_bytes()[used + rest..]).unwrap().is_none());
+    }
+
+    #[test]
+    fn test_parse_rejects_broken_records() {
+        assert!(parse(b"GET / HTTP/1.1\r\n\r\n").is_err());
+        assert!(parse(b"WARC/1.0\r\nWARC-Type: response\r\n\r\n").is_err());
+        assert!(parse(b"WARC/1.0\r\nContent-Length: 10\r\n\r\nshort").is_err());
+    }
+
+    #[test]
+    fn test_read_into_matches_parse() {
+        let data = record("WARC-Type: resource\r\nContent-Type: text/html\r\n", "<p>x</p>");
+        let data = format!("{data}{data}");
+        let mut reader = io::BufReader::new(data.as_bytes());
+        let mut buf = Vec::new();
+
+        for _ in 0..2 {
+            assert!(read_into(&mut reader, &mut buf).unwrap());
+            let (parsed, _) = parse(&buf).unwrap().unwrap();
+            assert_eq!(parsed.content_type, Some("text/html"));
+            assert_eq!(parsed.block, b"<p>x</p>");
+        }
+        assert!(!read_into(&mut reader, &mut buf).unwrap());
+    }
+
+    #[test]
+    fn test_read_into_rejects_oversized_records() {
+        let huge = format!("WARC/1.0\r\nContent-Length: {}\r\n\r\nshort", MAX_RECORD_BYTES + 1);
+        let mut buf = Vec::new();
+        assert!(read_into(&mut io::BufReader::new(huge.as_bytes()), &mut buf).is_err());
+
+        let truncated = "WARC/1.0\r\nContent-Length: 1000000\r\n\r\nshort";
+        assert!(read_into(&mut io::BufReader::new(truncated.as_bytes()), &mut buf).is_err());
+        assert!(buf.capacity() < 1000000);
+    }
+
+    #[test]
+    fn test_http_response() {
+        let response = http_response(PAGE.as_bytes()).unwrap();
+        assert_eq!(response.status, 200);
+        assert_eq!(response.content_type, Some("text/html; charset=utf-8"));
+        assert!(!response.encoded);
+        assert_eq!(response.body, b"<title>T</title>");
+
+        let gzipped = http_response(b"HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\n\r\n\x1f\x8b");
+        assert!(gzipped.unwrap().encoded);
+        assert!(http_response(b"not http").is_none());
+    }
+}
@@ -0,0 +1,705 @@
+//! Content-addressed cache of extraction results
+//!
+//! Crawlers see the same bytes again and again: a page fetched twice, or a
+//! site whose thousands of pages share one templated `<head>`. When enabled
+//! with [`configure`], [`extract_all`](crate::extract::extract_all) looks up
+//! each call by an xxh3 hash of its input, base URL and options before doing
+//! any work, and stores what it extracts.
+//!
+//! There are two caches. Full-document calls are keyed on the whole HTML.
+//! Head-only calls only ever read the head section, so they are keyed on that
+//! section alone, and pages that differ only below `</head>` share one entry.
+//! Head-level formats of a full-document call cannot be shared that way, as
+//! `<meta>` and `<link rel>` tags in the body count too.
+//!
+//! Each cache is split into shards, each its own LRU list behind a mutex, so
+//! threads rarely wait on one another. An entry's size is estimated from the
+//! lengths of the strings and collections in its results, and the least
+//! recently used entries are dropped once a shard goes over its share of the
+//! byte budget. Results cut short by a deadline are never stored, since the
+//! next call may get further.
+//!
+//! Entries are shared as `Arc<Extraction>`: a hit costs a hash of the input
+//! and a reference count increment, plus a deep copy only for callers of
+//! [`extract_all`](crate::extract::extract_all) that take the results by
+//! value while the cache still holds them.
+
+use std::collections::HashMap;
+use std::mem;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, MutexGuard, PoisonError, RwLock};
+
+use serde::ser::{self, Serialize};
+use xxhash_rust::xxh3::Xxh3;
+
+use crate::extract::{ExtractOptions, Extraction};
+use crate::extractors::head;
+use crate::limits::Limit;
+
+/// Shards per cache
+const SHARDS: usize = 16;
+
+/// Sentinel for "no slot" in the LRU lists
+const NIL: usize = usize::MAX;
+
+/// Hit, miss and size counters of the result caches
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub struct CacheStats {
+    /// Full-document calls answered from the cache
+    pub hits: u64,
+    /// Full-document calls that had to be extracted
+    pub misses: u64,
+    /// Head-only calls answered from the cache
+    pub head_hits: u64,
+    /// Head-only calls that had to be extracted
+    pub head_misses: u64,
+    /// Entries dropped to make room for newer ones
+    pub evictions: u64,
+    /// Entries currently stored in both caches
+    pub entries: usize,
+    /// Bytes currently accounted to both caches
+    pub bytes: usize,
+}
+
+struct Node {
+    key: u128,
+    value: Option<Arc<Extraction>>,
+    bytes: usize,
+    prev: usize,
+    next: usize,
+}
+
+// One LRU list; `head` is the most recently used slot
+struct Shard {
+    map: HashMap<u128, usize>,
+    nodes: Vec<Node>,
+    free: Vec<usize>,
+    head: usize,
+    tail: usize,
+    bytes: usize,
+    capacity: usize,
+}
+
+impl Shard {
+    fn new(capacity: usize) -> Self {
+        Self {
+            map: HashMap::new(),
+            nodes: Vec::new(),
+            free: Vec::new(),
+            head: NIL,
+            tail: NIL,
+            bytes: 0,
+            capacity,
+        }
+    }
+
+    fn unlink(&mut self, slot: usize) {
+        let Node { prev, next, .. } = self.nodes[slot];
+        match prev {
+            NIL => self.head = next,
+            prev => self.nodes[prev].next = next,
+        }
+        match next {
+            NIL => self.tail = prev,
+            next => self.nodes[next].prev = prev,
+        }
+    }
+
+    fn push_front(&mut self, slot: usize) {
+        self.nodes[slot].prev = NIL;
+        self.nodes[slot].next = self.head;
+        match self.head {
+            NIL => self.tail = slot,
+            head => self.nodes[head].prev = slot,
+        }
+        self.head = slot;
+    }
+
+    fn get(&mut self, key: u128) -> Option<Arc<Extraction>> {
+        let slot = *self.map.get(&key)?;
+        if self.head != slot {
+            self.unlink(slot);
+            self.push_front(slot);
+        }
+        self.nodes[slot].value.clone()
+    }
+
+    // Store `value`, returning how many entries were evicted for it
+    fn insert(&mut self, key: u128, value: Arc<Extraction>, bytes: usize) -> u64 {
+        if bytes > self.capacity || self.map.contains_key(&key) {
+            return 0;
+        }
+
+        let mut evicted = 0;
+        while self.bytes + bytes > self.capacity && self.tail != NIL {
+            let slot = self.tail;
+            self.unlink(slot);
+            let node = &mut self.nodes[slot];
+            node.value = None;
+            self.bytes -= node.bytes;
+            self.map.remove(&node.key);
+            self.free.push(slot);
+            evicted += 1;
+        }
+
+        let node = Node { key, value: Some(value), bytes, prev: NIL, next: NIL };
+        let slot = match self.free.pop() {
+            Some(slot) => {
+                self.nodes[slot] = node;
+                slot
+            }
+            None => {
+                self.nodes.push(node);
+                self.nodes.len() - 1
+            }
+        };
+        self.push_front(slot);
+        self.map.insert(key, slot);
+        self.bytes += bytes;
+        evicted
+    }
+}
+
+// A sharded LRU with its hit and miss counters
+struct Lru {
+    shards: Box<[Mutex<Shard>]>,
+    hits: AtomicU64,
+    misses: AtomicU64,
+    evictions: AtomicU64,
+}
+
+impl Lru {
+    fn new(max_bytes: usize) -> Self {
+        let capacity = max_bytes / SHARDS;
+        Self {
+            shards: (0..SHARDS).map(|_| Mutex::new(Shard::new(capacity))).collect(),
+            hits: AtomicU64::new(0),
+            misses: AtomicU64::new(0),
+            evictions: AtomicU64::new(0),
+        }
+    }
+
+    fn shard(&self, key: u128) -> MutexGuard<'_, Shard> {
+        // The top bits pick the shard; the map hashes the whole key again
+        lock(&self.shards[(key >> 124) as usize % SHARDS])
+    }
+
+    fn get_or_insert(&self, key: u128, extract: impl FnOnce() -> Extraction) -> Arc<Extraction> {
+        let cached = self.shard(key).get(key);
+        if let Some(value) = cached {
+            self.hits.fetch_add(1, Ordering::Relaxed);
+            return value;
+        }
+        self.misses.fetch_add(1, Ordering::Relaxed);
+
+        // Weighed before the shard lock is taken
+        let out = Arc::new(extract());
+        if out.limit != Some(Limit::Deadline) {
+            let bytes = weight(&out);
+            let evicted = self.shard(key).insert(key, Arc::clone(&out), bytes);
+            self.evictions.fetch_add(evicted, Ordering::Relaxed);
+        }
+        out
+    }
+
+    fn size(&self) -> (usize, usize) {
+        self.shards
+            .iter()
+            .map(|s| lock(s))
+            .map(|s| (s.map.len(), s.bytes))
+            .fold((0, 0), |(entries, bytes), (e, b)| (entries + e, bytes + b))
+    }
+}
+
+/// The two caches behind [`configure`]
+struct ResultCache {
+    documents: Lru,
+    heads: Lru,
+}
+
+impl ResultCache {
+    fn new(max_bytes: usize) -> Self {
+        Self { documents: Lru::new(max_bytes / 2), heads: Lru::new(max_bytes / 2) }
+    }
+
+    fn get_or_extract(
+        &self,
+        html: &str,
+        base_url: Option<&str>,
+        options: &ExtractOptions,
+        extract: impl FnOnce() -> Extraction,
+    ) -> Arc<Extraction> {
+        if options.head_only {
+            let key = key(head::head_section(html), base_url, options);
+            self.heads.get_or_insert(key, extract)
+        } else {
+            self.documents.get_or_insert(key(html, base_url, options), extract)
+        }
+    }
+
+    fn stats(&self) -> CacheStats {
+        let (doc_entries, doc_bytes) = self.documents.size();
+        let (head_entries, head_bytes) = self.heads.size();
+        CacheStats {
+            hits: self.documents.hits.load(Ordering::Relaxed),
+            misses: self.documents.misses.load(Ordering::Relaxed),
+            head_hits: self.heads.hits.load(Ordering::Relaxed),
+            head_misses: self.heads.misses.load(Ordering::Relaxed),
+            evictions: self.documents.evictions.load(Ordering::Relaxed)
+                + self.heads.evictions.load(Ordering::Relaxed),
+            entries: doc_entries + head_entries,
+            bytes: doc_bytes + head_bytes,
+        }
+    }
+}
+
+static GLOBAL: RwLock<Option<Arc<ResultCache>>> = RwLock::new(None);
+
+/// Enable the result caches with a total budget of `max_bytes`, or disable
+/// them with 0
+///
+/// The budget is split evenly between the full-document and head-only
+/// caches. Every call replaces both caches, dropping their entries and
+/// resetting the counters.
+pub fn configure(max_bytes: usize) {
+    let cache = (max_bytes > 0).then(|| Arc::new(ResultCache::new(max_bytes)));
+    *GLOBAL.write().unwrap_or_else(PoisonError::into_inner) = cache;
+}
+
+/// Counters of the current caches; all zero while caching is disabled
+pub fn stats() -> CacheStats {
+    global().map_or_else(CacheStats::default, |cache| cache.stats())
+}
+
+fn global() -> Option<Arc<ResultCache>> {
+    GLOBAL.read().unwrap_or_else(PoisonError::into_inner).clone()
+}
+
+// `extract()`, or a stored copy of what it returned for the same input
+pub(crate) fn extract_cached(
+    html: &str,
+    base_url: Option<&str>,
+    options: &ExtractOptions,
+    extract: impl FnOnce() -> Extraction,
+) -> Arc<Extraction> {
+    match global() {
+        Some(cache) => cache.get_or_extract(html, base_url, options, extract),
+        None => Arc::new(extract()),
+    }
+}
+
+// Hash of everything that decides the result of one call
+fn key(html: &str, base_url: Option<&str>, options: &ExtractOptions) -> u128 {
+    fn limit(value: Option<usize>) -> u64 {
+        value.map_or(u64::MAX, |v| v as u64)
+    }
+
+    let mut hasher = Xxh3::new();
+    hasher.update(html.as_bytes());
+    hasher.update(&(html.len() as u64).to_le_bytes());
+    match base_url {
+        Some(url) => {
+            hasher.update(url.as_bytes());
+            hasher.update(&(url.len() as u64).to_le_bytes());
+        }
+        None => hasher.update(&u64::MAX.to_le_bytes()),
+    }
+
+    let limits = &options.limits;
+    let words = [
+        u64::from(options.head_only),
+        u64::from(options.formats),
+        limit(limits.max_input_bytes),
+        limit(limits.max_tags),
+        limit(limits.max_json_ld_bytes),
+        limit(limits.max_items),
+        limit(limits.max_depth),
+        limits.deadline.map_or(u64::MAX, |d| d.as_nanos() as u64),
+        u64::from(options.typed_microformats),
+    ];
+    for word in words {
+        hasher.update(&word.to_le_bytes());
+    }
+    hasher.digest128()
+}
+
+// Estimated memory held by an extraction, plus the struct itself
+fn weight(out: &Extraction) -> usize {
+    let mut weigher = Weigher(mem::size_of::<Extraction>());
+    let _ = out.serialize(&mut weigher);
+    let _ = out.typed_microformats.serialize(&mut weigher);
+    weigher.0
+}
+
+// Cost of a scalar, or of an element or entry slot in a collection
+const SLOT: usize = mem::size_of::<u64>();
+
+// Sums the bytes of every string and a fixed cost per scalar and collection
+// while walking a value, without formatting or allocating anything
+struct Weigher(usize);
+
+impl Weigher {
+    fn add_str(&mut self, len: usize) -> Result<(), serde_json::Error> {
+        self.0 += mem::size_of::<String>() + len;
+        Ok(())
+    }
+
+    fn add_slot(&mut self) -> Result<(), serde_json::Error> {
+        self.0 += SLOT;
+        Ok(())
+    }
+
+    fn add_collection(&mut self) -> Result<&mut Self, serde_json::Error> {
+        self.0 += mem::size_of::<Vec<u8>>();
+        Ok(self)
+    }
+}
+
+impl ser::Serializer for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+    type SerializeSeq = Self;
+    type SerializeTuple = Self;
+    type SerializeTupleStruct = Self;
+    type SerializeTupleVariant = Self;
+    type SerializeMap = Self;
+    type SerializeStruct = Self;
+    type SerializeStructVariant = Self;
+
+    fn serialize_bool(self, _: bool) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_i8(self, _: i8) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_i16(self, _: i16) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_i32(self, _: i32) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_i64(self, _: i64) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_u8(self, _: u8) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_u16(self, _: u16) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_u32(self, _: u32) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_u64(self, _: u64) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_f32(self, _: f32) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_f64(self, _: f64) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_char(self, _: char) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_str(self, v: &str) -> Result<(), Self::Error> {
+        self.add_str(v.len())
+    }
+    fn serialize_bytes(self, v: &[u8]) -> Result<(), Self::Error> {
+        self.add_str(v.len())
+    }
+    fn serialize_none(self) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_some<T: ?Sized + Serialize>(self, value: &T) -> Result<(), Self::Error> {
+        value.serialize(self)
+    }
+    fn serialize_unit(self) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_unit_struct(self, _: &'static str) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_unit_variant(
+        self,
+        _: &'static str,
+        _: u32,
+        _: &'static str,
+    ) -> Result<(), Self::Error> {
+        self.add_slot()
+    }
+    fn serialize_newtype_struct<T: ?Sized + Serialize>(
+        self,
+        _: &'static str,
+        value: &T,
+    ) -> Result<(), Self::Error> {
+        value.serialize(self)
+    }
+    fn serialize_newtype_variant<T: ?Sized + Serialize>(
+        self,
+        _: &'static str,
+        _: u32,
+        _: &'static str,
+        value: &T,
+    ) -> Result<(), Self::Error> {
+        value.serialize(self)
+    }
+    fn serialize_seq(self, _: Option<usize>) -> Result<Self, Self::Error> {
+        self.add_collection()
+    }
+    fn serialize_tuple(self, _: usize) -> Result<Self, Self::Error> {
+        Ok(self)
+    }
+    fn serialize_tuple_struct(self, _: &'static str, _: usize) -> Result<Self, Self::Error> {
+        Ok(self)
+    }
+    fn serialize_tuple_variant(
+        self,
+        _: &'static str,
+        _: u32,
+        _: &'static str,
+        _: usize,
+    ) -> Result<Self, Self::Error> {
+        Ok(self)
+    }
+    fn serialize_map(self, _: Option<usize>) -> Result<Self, Self::Error> {
+        self.add_collection()
+    }
+    fn serialize_struct(self, _: &'static str, _: usize) -> Result<Self, Self::Error> {
+        Ok(self)
+    }
+    fn serialize_struct_variant(
+        self,
+        _: &'static str,
+        _: u32,
+        _: &'static str,
+        _: usize,
+    ) -> Result<Self, Self::Error> {
+        Ok(self)
+    }
+}
+
+impl ser::SerializeSeq for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_element<T: ?Sized + Serialize>(&mut self, value: &T) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTuple for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_element<T: ?Sized + Serialize>(&mut self, value: &T) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTupleStruct for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T: ?Sized + Serialize>(&mut self, value: &T) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTupleVariant for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T: ?Sized + Serialize>(&mut self, value: &T) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeMap for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_key<T: ?Sized + Serialize>(&mut self, key: &T) -> Result<(), Self::Error> {
+        key.serialize(&mut **self)
+    }
+    fn serialize_value<T: ?Sized + Serialize>(&mut self, value: &T) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeStruct for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T: ?Sized + Serialize>(
+        &mut self,
+        _: &'static str,
+        value: &T,
+    ) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeStructVariant for &mut Weigher {
+    type Ok = ();
+    type Error = serde_json::Error;
+
+    fn serialize_field<T: ?Sized + Serialize>(
+        &mut self,
+        _: &'static str,
+        value: &T,
+    ) -> Result<(), Self::Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Self::Error> {
+        Ok(())
+    }
+}
+
+/// Lock a mutex, ignoring poisoning (nothing panics while a shard is locked)
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::types::meta::MetaTags;
+
+    fn page(title: &str) -> Extraction {
+        let meta = MetaTags { title: Some(title.to_string()), ..Default::default() };
+        Extraction { meta: Some(meta), ..Default::default() }
+    }
+
+    #[test]
+    fn test_lru_evicts_least_recently_used() {
+        let size = weight(&page("a"));
+        let mut shard = Shard::new(2 * size);
+        shard.insert(1, Arc::new(page("a")), size);
+        shard.insert(2, Arc::new(page("b")), size);
+        assert!(shard.get(1).is_some());
+
+        assert_eq!(shard.insert(3, Arc::new(page("c")), size), 1);
+        assert!(shard.get(2).is_none());
+        assert!(shard.get(1).is_some());
+        assert!(shard.get(3).is_some());
+        assert_eq!(shard.bytes, 2 * size);
+    }
+
+    #[test]
+    fn test_weight_follows_contents() {
+        let small = weight(&page("a"));
+        assert!(small > mem::size_of::<Extraction>());
+        assert_eq!(weight(&page(&"x".repeat(1001))), small + 1000);
+
+        let mut listed = page("a");
+        listed.json_ld = Some(vec![]);
+        let empty = weight(&listed);
+        listed.rel_links = Some(HashMap::from([("me".to_string(), vec!["u".to_string(); 4])]));
+        assert!(weight(&listed) > empty + 4 * mem::size_of::<String>());
+    }
+
+    #[test]
+    fn test_hits_share_the_stored_entry() {
+        let lru = Lru::new(1 << 20);
+        let stored = lru.get_or_insert(1, || page("a"));
+        let hit = lru.get_or_insert(1, || unreachable!());
+        assert!(Arc::ptr_eq(&stored, &hit));
+    }
+
+    #[test]
+    fn test_lru_skips_oversized_entries() {
+        let mut shard = Shard::new(10);
+        assert_eq!(shard.insert(1, Arc::new(page("a")), 11), 0);
+        assert!(shard.get(1).is_none());
+        assert_eq!(shard.bytes, 0);
+    }
+
+    #[test]
+    fn test_lru_reuses_freed_slots() {
+        let mut shard = Shard::new(1);
+        for key in 0..100 {
+            shard.insert(key, Arc::new(page("a")), 1);
+        }
+        assert_eq!(shard.nodes.len(), 1);
+        assert_eq!(shard.map.len(), 1);
+        assert!(shard.get(99).is_some());
+    }
+
+    #[test]
+    fn test_key_covers_inputs_and_options() {
+        let options = ExtractOptions::default();
+        let base = key("<p>", None, &options);
+        assert_eq!(base, key("<p>", None, &options));
+        assert_ne!(base, key("<p >", None, &options));
+        assert_ne!(base, key("<p>", Some(""), &options));
+        assert_ne!(key("<p>", Some("a"), &options), key("<p>", Some("b"), &options));
+
+        let head_only = ExtractOptions { head_only: true, ..Default::default() };
+        assert_ne!(base, key("<p>", None, &head_only));
+        let mut limited = ExtractOptions::default();
+        limited.limits.max_depth = Some(3);
+        assert_ne!(base, key("<p>", None, &limited));
+        let typed = ExtractOptions { typed_microformats: true, ..Default::default() };
+        assert_ne!(base, key("<p>", None, &typed));
+    }
+
+    #[test]
+    fn test_deadline_results_are_not_stored() {
+        let lru = Lru::new(1 << 20);
+        let mut calls = 0;
+        for _ in 0..2 {
+            lru.get_or_insert(7, || {
+                calls += 1;
+                Extraction { limit: Some(Limit::Deadline), ..page("a") }
+            });
+        }
+        assert_eq!(calls, 2);
+
+        lru.get_or_insert(8, || page("b"));
+        let hit = lru.get_or_insert(8, || unreachable!());
+        assert_eq!(hit.meta.as_ref().and_then(|m| m.title.as_deref()), Some("b"));
+        assert_eq!(lru.hits.load(Ordering::Relaxed), 1);
+        assert_eq!(lru.misses.load(Ordering::Relaxed), 3);
+    }
+
+    #[test]
+    fn test_result_cache() {
+        // A cache of its own: other tests may run extractions meanwhile
+        let cache = ResultCache::new(1 << 20);
+        let html = "<html><head><title>T</title></head><body>1</body></html>";
+        let options = ExtractOptions::default();
+        cache.get_or_extract(html, None, &options, || page("a"));
+        let hit = cache.get_or_extract(html, None, &options, || unreachable!());
+        assert_eq!(hit.meta, page("a").meta);
+
+        let head_only = ExtractOptions { head_only: true, ..Default::default() };
+        let other = html.replace("<body>1", "<body>2");
+        cache.get_or_extract(html, None, &head_only, || page("b"));
+        let shared = cache.get_or_extract(&other, None, &head_only, || unreachable!());
+        assert_eq!(shared.meta, page("b").meta);
+        cache.get_or_extract(&other, None, &options, || page("c"));
+
+        let stats = cache.stats();
+        assert_eq!((stats.hits, stats.misses, stats.head_hits, stats.head_misses), (1, 2, 1, 1));
+        assert_eq!(stats.entries, 3);
+    }
+}
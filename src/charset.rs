@@ -0,0 +1,330 @@
+//! Character encoding detection for raw HTML bytes
+//!
+//! The extractors work on `&str`, so pages served in Shift_JIS, windows-1251,
+//! GBK and the like have to be decoded first. [`decode`] picks the encoding
+//! the way browsers do, in order of authority:
+//!
+//! 1. a byte order mark,
+//! 2. the `charset` of the HTTP `Content-Type` header, when the caller has one,
+//! 3. a `<meta charset>` or `<meta http-equiv="Content-Type">` within the
+//!    first 1024 bytes, found by a byte-level prescan,
+//! 4. otherwise UTF-8 if the bytes are valid UTF-8, and windows-1252 if not.
+//!
+//! UTF-8 input, and ASCII input in any ASCII-compatible encoding, is borrowed
+//! as is; only other input is transcoded, in one pass.
+
+use std::borrow::Cow;
+
+use encoding_rs::{Encoding, UTF_8, WINDOWS_1252};
+
+/// Bytes searched for a `<meta>` charset declaration, as in the HTML standard
+const PRESCAN_BYTES: usize = 1024;
+
+/// HTML decoded to UTF-8, and the encoding it was read in
+#[derive(Debug)]
+pub struct Decoded<'a> {
+    /// The text, borrowed from the input when no transcoding was needed
+    pub text: Cow<'a, str>,
+    /// The encoding that was used
+    pub encoding: &'static Encoding,
+    /// Whether some bytes were malformed and replaced with U+FFFD
+    pub had_errors: bool,
+}
+
+/// Decode raw HTML bytes, detecting their encoding
+///
+/// `content_type` is the HTTP `Content-Type` header value
+/// (`text/html; charset=Shift_JIS`) or a bare charset label; unknown labels
+/// are ignored, as browsers ignore them.
+pub fn decode<'a>(bytes: &'a [u8], content_type: Option<&str>) -> Decoded<'a> {
+    let (encoding, bom) = match declared(bytes, content_type) {
+        Some(found) => found,
+        // Undeclared: validating as UTF-8 is also the decode
+        None => match std::str::from_utf8(bytes) {
+            Ok(text) => {
+                return Decoded { text: Cow::Borrowed(text), encoding: UTF_8, had_errors: false }
+            }
+            Err(_) => (WINDOWS_1252, 0),
+        },
+    };
+    let (text, had_errors) = encoding.decode_without_bom_handling(&bytes[bom..]);
+    Decoded { text, encoding, had_errors }
+}
+
+/// The encoding [`decode`] would use for `bytes`, and the length of the
+/// byte order mark it would skip
+pub fn sniff(bytes: &[u8], content_type: Option<&str>) -> (&'static Encoding, usize) {
+    declared(bytes, content_type).unwrap_or_else(|| match std::str::from_utf8(bytes) {
+        Ok(_) => (UTF_8, 0),
+        Err(_) => (WINDOWS_1252, 0),
+    })
+}
+
+// The encoding given by a BOM, the HTTP header or a `<meta>` tag, if any
+fn declared(bytes: &[u8], content_type: Option<&str>) -> Option<(&'static Encoding, usize)> {
+    if let Some(found) = Encoding::for_bom(bytes) {
+        return Some(found);
+    }
+
+    let http = content_type
+        .and_then(|value| Encoding::for_label(charset_param(value).unwrap_or(value).as_bytes()));
+    let encoding = http.or_else(|| {
+        prescan(&bytes[..bytes.len().min(PRESCAN_BYTES)]).map(|encoding| {
+            // A document cannot declare itself UTF-16 from inside ASCII-compatible
+            // bytes, so that (and the replacement encoding) means UTF-8
+            if encoding.output_encoding() == UTF_8 {
+                UTF_8
+            } else if encoding.name() == "x-user-defined" {
+                WINDOWS_1252
+            } else {
+                encoding
+            }
+        })
+    })?;
+    Some((encoding, 0))
+}
+
+/// The `charset` parameter of a `Content-Type` value, unquoted
+///
+/// Also used for the `content` of `<meta http-equiv="Content-Type">`.
+pub fn charset_param(value: &str) -> Option<&str> {
+    let bytes = value.as_bytes();
+    let mut from = 0;
+    while let Some(pos) = find_ignore_case(&bytes[from..], b"charset") {
+        let mut i = from + pos + b"charset".len();
+        while bytes.get(i).is_some_and(u8::is_ascii_whitespace) {
+            i += 1;
+        }
+        if bytes.get(i) != Some(&b'=') {
+            from = i;
+            continue;
+        }
+        i += 1;
+        while bytes.get(i).is_some_and(u8::is_ascii_whitespace) {
+            i += 1;
+        }
+
+        let rest = &value[i..];
+        return match rest.as_bytes().first() {
+            Some(&quote @ (b'"' | b'\'')) => {
+                rest[1..].find(quote as char).map(|end| &rest[1..=end])
+            }
+            Some(_) => {
+                let end = rest.find(|c: char| c == ';' || c.is_ascii_whitespace());
+                Some(&rest[..end.unwrap_or(rest.len())])
+            }
+            None => None,
+        };
+    }
+    None
+}
+
+// The encoding declared by the first `<meta>` tag that declares one
+//
+// A simplified form of the prescan in the HTML standard: comments, other
+// tags and their attributes are skipped so that a `<meta` inside them is not
+// mistaken for a tag.
+fn prescan(bytes: &[u8]) -> Option<&'static Encoding> {
+    let mut i = 0;
+    while let Some(lt) = memchr::memchr(b'<', &bytes[i..]) {
+        i += lt;
+        let rest = &bytes[i..];
+        if rest.starts_with(b"<!--") {
+            i += find(&rest[4..], b"-->").map_or(rest.len(), |end| 4 + end + 3);
+        } else if starts_with_ignore_case(rest, b"<meta")
+            && rest.get(5).is_some_and(|&b| b.is_ascii_whitespace() || b == b'/')
+        {
+            let mut attributes = Attributes { bytes, pos: i + 5 };
+            if let Some(encoding) = meta_encoding(&mut attributes) {
+                return Some(encoding);
+            }
+            i = attributes.pos;
+        } else if rest.len() > 1 && (rest[1].is_ascii_alphabetic() || rest.starts_with(b"</")) {
+            // Skip the tag name, then its attributes
+            let mut end = 1;
+            while rest.get(end).is_some_and(|&b| !b.is_ascii_whitespace() && b != b'>') {
+                end += 1;
+            }
+            let mut attributes = Attributes { bytes, pos: i + end };
+            while attributes.next().is_some() {}
+            i = attributes.pos;
+        } else if rest.starts_with(b"<!") || rest.starts_with(b"<?") {
+            i += find(rest, b">").map_or(rest.len(), |end| end + 1);
+        } else {
+            i += 1;
+        }
+    }
+    None
+}
+
+// The encoding declared by the attributes of one `<meta>` tag
+fn meta_encoding(attributes: &mut Attributes<'_>) -> Option<&'static Encoding> {
+    let mut charset = None;
+    let mut pragma = false;
+    let mut content = None;
+    for (name, value) in attributes.by_ref() {
+        match name.to_ascii_lowercase().as_slice() {
+            b"charset" if charset.is_none() => charset = Some(value),
+            b"http-equiv" => pragma |= value.eq_ignore_ascii_case(b"content-type"),
+            b"content" if content.is_none() => content = Some(value),
+            _ => {}
+        }
+    }
+
+    let label = match (charset, content) {
+        (Some(label), _) => label,
+        (None, Some(content)) if pragma => {
+            let content = std::str::from_utf8(content).ok()?;
+            charset_param(content)?.as_bytes()
+        }
+        _ => return None,
+    };
+    Encoding::for_label(label)
+}
+
+// Attributes of a tag, read from just after its name up to its `>`
+struct Attributes<'a> {
+    bytes: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Iterator for Attributes<'a> {
+    type Item = (&'a [u8], &'a [u8]);
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let bytes = self.bytes;
+        let skip = |pos: &mut usize, f: fn(u8) -> bool| {
+            while bytes.get(*pos).is_some_and(|&b| f(b)) {
+                *pos += 1;
+            }
+        };
+
+        skip(&mut self.pos, |b| b.is_ascii_whitespace() || b == b'/');
+        match bytes.get(self.pos) {
+            None => return None,
+            Some(b'>') => {
+                self.pos += 1;
+                return None;
+            }
+            Some(_) => {}
+        }
+
+        let start = self.pos;
+        self.pos += 1;
+        skip(&mut self.pos, |b| !b.is_ascii_whitespace() && !matches!(b, b'=' | b'/' | b'>'));
+        let name = &bytes[start..self.pos];
+
+        skip(&mut self.pos, |b| b.is_ascii_whitespace());
+        if bytes.get(self.pos) != Some(&b'=') {
+            return Some((name, &[]));
+        }
+        self.pos += 1;
+        skip(&mut self.pos, |b| b.is_ascii_whitespace());
+
+        let value = match bytes.get(self.pos) {
+            Some(&quote @ (b'"' | b'\'')) => {
+                let start = self.pos + 1;
+                let end = bytes[start..].iter().position(|&b| b == quote).map(|n| start + n);
+                let end = end.unwrap_or(bytes.len());
+                self.pos = (end + 1).min(bytes.len());
+                &bytes[start..end]
+            }
+            _ => {
+                let start = self.pos;
+                skip(&mut self.pos, |b| !b.is_ascii_whitespace() && b != b'>');
+                &bytes[start..self.pos]
+            }
+        };
+        Some((name, value))
+    }
+}
+
+fn find(haystack: &[u8], needle: &[u8]) -> Option<usize> {
+    memchr::memmem::find(haystack, needle)
+}
+
+fn find_ignore_case(haystack: &[u8], needle: &[u8]) -> Option<usize> {
+    haystack.windows(needle.len()).position(|w| w.eq_ignore_ascii_case(needle))
+}
+
+fn starts_with_ignore_case(bytes: &[u8], prefix: &[u8]) -> bool {
+    bytes.get(..prefix.len()).is_some_and(|start| start.eq_ignore_ascii_case(prefix))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_utf8_is_borrowed() {
+        let html = "<meta charset=utf-8><title>Café</title>".as_bytes();
+        let decoded = decode(html, None);
+        assert_eq!(decoded.encoding, UTF_8);
+        assert!(matches!(decoded.text, Cow::Borrowed(_)));
+        assert!(!decoded.had_errors);
+
+        let plain = decode(b"<title>Plain</title>", None);
+        assert_eq!(plain.encoding, UTF_8);
+        assert!(matches!(plain.text, Cow::Borrowed(_)));
+    }
+
+    #[test]
+    fn test_meta_charset_is_used() {
+        let html = b"<html><head><meta charset=\"windows-1251\"><title>\xcf\xf0\xe8</title>";
+        let decoded = decode(html, None);
+        assert_eq!(decoded.encoding.name(), "windows-1251");
+        assert!(decoded.text.contains("<title>При</title>"));
+
+        let html = b"<meta http-equiv=Content-Type content='text/html; charset=windows-1251'>\xcf";
+        assert_eq!(sniff(html, None).0.name(), "windows-1251");
+    }
+
+    #[test]
+    fn test_authority_order() {
+        let html = b"<meta charset=windows-1251>\xe9";
+        // The HTTP header beats the document
+        assert_eq!(sniff(html, Some("text/html; charset=ISO-8859-1")).0, WINDOWS_1252);
+        assert_eq!(sniff(html, Some("windows-1252")).0, WINDOWS_1252);
+        // Unknown labels are ignored
+        assert_eq!(sniff(html, Some("text/html; charset=bogus")).0.name(), "windows-1251");
+
+        // And a BOM beats both
+        let bom = b"\xef\xbb\xbf<meta charset=windows-1251>";
+        assert_eq!(sniff(bom, Some("charset=windows-1251")), (UTF_8, 3));
+        assert_eq!(decode(bom, None).text, "<meta charset=windows-1251>");
+    }
+
+    #[test]
+    fn test_invalid_utf8_without_declaration() {
+        let decoded = decode(b"<title>caf\xe9</title>", None);
+        assert_eq!(decoded.encoding, WINDOWS_1252);
+        assert_eq!(decoded.text, "<title>café</title>");
+    }
+
+    #[test]
+    fn test_utf16_declaration_means_utf8() {
+        let html = "<meta charset=utf-16le><p>é".as_bytes();
+        assert_eq!(sniff(html, None).0, UTF_8);
+    }
+
+    #[test]
+    fn test_prescan_skips_comments_and_attributes() {
+        let html =
+            b"<!-- <meta charset=windows-1251> --><div title='<meta charset=windows-1251>'>\xe9";
+        assert_eq!(sniff(html, None).0, WINDOWS_1252);
+
+        // Declarations past the first 1024 bytes are not looked for
+        let mut late = vec![b' '; PRESCAN_BYTES];
+        late.extend_from_slice(b"<meta charset=windows-1251>\xe9");
+        assert_eq!(sniff(&late, None).0, WINDOWS_1252);
+    }
+
+    #[test]
+    fn test_charset_param() {
+        assert_eq!(charset_param("text/html; charset=Shift_JIS"), Some("Shift_JIS"));
+        assert_eq!(charset_param("text/html;charset=\"gbk\"; q=1"), Some("gbk"));
+        assert_eq!(charset_param("text/html; CHARSET = koi8-r"), Some("koi8-r"));
+        assert_eq!(charset_param("text/html"), None);
+        assert_eq!(charset_param("text/html; charset="), None);
+    }
+}
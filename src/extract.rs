@@ -0,0 +1,755 @@
+//! Parse-once extraction of several formats
+//!
+//! This is the engine behind `meta_oxide_extract_all` and friends: the HTML is
+//! parsed once, the head-level tags are scanned once, and only the formats
+//! selected in [`ExtractOptions::formats`] are run over the shared document.
+//!
+//! [`extract_all_with_stats`] additionally reports where the time went. With
+//! the `tracing` feature every stage also runs inside a `meta_oxide` span.
+//! [`ExtractOptions::limits`] bounds the work done per call.
+
+use std::collections::HashMap;
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+use scraper::Html;
+use serde::Serialize;
+
+use crate::cache;
+use crate::extractors;
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
+use crate::extractors::head;
+use crate::limits::{Budget, Limit, Limits};
+use crate::parser;
+use crate::pool;
+use crate::prefilter;
+use crate::types::dublin_core::DublinCore;
+use crate::types::jsonld::JsonLdObject;
+use crate::types::manifest::ManifestDiscovery;
+use crate::types::meta::MetaTags;
+use crate::types::microdata::MicrodataItem;
+use crate::types::oembed::OEmbedDiscovery;
+use crate::types::rdfa::RdfaItem;
+use crate::types::social::{OpenGraph, TwitterCard};
+use crate::types::{
+    HAdr, HCard, HEntry, HEvent, HFeed, HGeo, HProduct, HRecipe, HReview, MicroformatItem,
+};
+
+/// Format selection bits for [`ExtractOptions::formats`]
+pub mod formats {
+    /// Standard HTML meta tags
+    pub const META: u32 = 1 << 0;
+    /// Open Graph
+    pub const OPEN_GRAPH: u32 = 1 << 1;
+    /// Twitter Cards (with Open Graph fallback)
+    pub const TWITTER: u32 = 1 << 2;
+    /// JSON-LD
+    pub const JSON_LD: u32 = 1 << 3;
+    /// Microdata
+    pub const MICRODATA: u32 = 1 << 4;
+    /// Microformats (all h-* types)
+    pub const MICROFORMATS: u32 = 1 << 5;
+    /// RDFa
+    pub const RDFA: u32 = 1 << 6;
+    /// Dublin Core
+    pub const DUBLIN_CORE: u32 = 1 << 7;
+    /// Web App Manifest link
+    pub const MANIFEST: u32 = 1 << 8;
+    /// oEmbed endpoint discovery
+    pub const OEMBED: u32 = 1 << 9;
+    /// rel-* link relationships
+    pub const REL_LINKS: u32 = 1 << 10;
+
+    /// Formats read from `<title>`, `<meta>` and `<link>` tags
+    pub const HEAD: u32 = META | OPEN_GRAPH | TWITTER | DUBLIN_CORE | MANIFEST | OEMBED | REL_LINKS;
+    /// Every supported format
+    pub const ALL: u32 = HEAD | JSON_LD | MICRODATA | MICROFORMATS | RDFA;
+
+    /// Number of format bits
+    pub const COUNT: usize = 11;
+
+    /// Position of a single format bit, for indexing per-format arrays
+    pub const fn index(format: u32) -> usize {
+        format.trailing_zeros() as usize
+    }
+
+    /// A mask as the bindings take it, where 0 selects every format
+    pub const fn or_all(mask: u32) -> u32 {
+        if mask == 0 {
+            ALL
+        } else {
+            mask
+        }
+    }
+}
+
+/// Options controlling [`extract_all`]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ExtractOptions {
+    /// Only parse the document head (see [`head::head_section`])
+    pub head_only: bool,
+    /// Bitmask of [`formats`] to extract
+    pub formats: u32,
+    /// Resource limits for the call
+    pub limits: Limits,
+    /// Report microformats as [`TypedMicroformats`] in
+    /// [`Extraction::typed_microformats`] instead of generic items, as the
+    /// Python `extract_all()` does
+    pub typed_microformats: bool,
+}
+
+impl Default for ExtractOptions {
+    fn default() -> Self {
+        Self {
+            head_only: false,
+            formats: formats::ALL,
+            limits: Limits::default(),
+            typed_microformats: false,
+        }
+    }
+}
+
+/// Results of a multi-format extraction
+///
+/// A field is `None` when its format was not selected, failed, or found
+/// nothing worth reporting (no JSON-LD objects, no manifest link, ...).
+///
+/// Serializes to the combined document of the C API: a map keyed `meta`,
+/// `openGraph`, `twitter`, `jsonLd`, ... with absent formats left out.
+#[derive(Debug, Clone, Default, Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct Extraction {
+    /// Standard HTML meta tags
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub meta: Option<MetaTags>,
+    /// Open Graph metadata
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub open_graph: Option<OpenGraph>,
+    /// Twitter Card metadata
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub twitter: Option<TwitterCard>,
+    /// JSON-LD objects
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub json_ld: Option<Vec<JsonLdObject>>,
+    /// Microdata items
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub microdata: Option<Vec<MicrodataItem>>,
+    /// Microformats keyed by type (h-card, h-entry, ...)
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub microformats: Option<HashMap<String, Vec<MicroformatItem>>>,
+    /// RDFa items
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub rdfa: Option<Vec<RdfaItem>>,
+    /// Dublin Core metadata
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub dublin_core: Option<DublinCore>,
+    /// Web App Manifest discovery
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub manifest: Option<ManifestDiscovery>,
+    /// oEmbed endpoint discovery
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub oembed: Option<OEmbedDiscovery>,
+    /// rel-* link relationships
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub rel_links: Option<HashMap<String, Vec<String>>>,
+    /// Microformats as typed values, in place of `microformats` when
+    /// [`ExtractOptions::typed_microformats`] is set
+    #[serde(skip)]
+    pub typed_microformats: Option<TypedMicroformats>,
+    /// The first of [`ExtractOptions::limits`] that was hit, in which case
+    /// the other fields hold partial results
+    #[serde(skip)]
+    pub limit: Option<Limit>,
+}
+
+/// Microformats read with the typed per-type extractors, one list per h-* type
+#[derive(Debug, Clone, Default, Serialize)]
+pub struct TypedMicroformats {
+    /// h-card items
+    pub hcard: Vec<HCard>,
+    /// h-entry items
+    pub hentry: Vec<HEntry>,
+    /// h-event items
+    pub hevent: Vec<HEvent>,
+    /// h-review items
+    pub hreview: Vec<HReview>,
+    /// h-recipe items
+    pub hrecipe: Vec<HRecipe>,
+    /// h-product items
+    pub hproduct: Vec<HProduct>,
+    /// h-feed items
+    pub hfeed: Vec<HFeed>,
+    /// h-adr items
+    pub hadr: Vec<HAdr>,
+    /// h-geo items
+    pub hgeo: Vec<HGeo>,
+}
+
+impl TypedMicroformats {
+    // Every type whose extractor fails is left empty
+    fn extract(document: &Html, base: &BaseUrl) -> Self {
+        use extractors::microformats as mf;
+
+        Self {
+            hcard: mf::hcard::extract_with_base(document, base).unwrap_or_default(),
+            hentry: mf::hentry::extract_with_base(document, base).unwrap_or_default(),
+            hevent: mf::hevent::extract_with_base(document, base).unwrap_or_default(),
+            hreview: mf::hreview::extract_with_base(document, base).unwrap_or_default(),
+            hrecipe: mf::hrecipe::extract_with_base(document, base).unwrap_or_default(),
+            hproduct: mf::hproduct::extract_with_base(document, base).unwrap_or_default(),
+            hfeed: mf::hfeed::extract_with_base(document, base).unwrap_or_default(),
+            hadr: mf::hadr::extract_with_base(document, base).unwrap_or_default(),
+            hgeo: mf::hgeo::extract_with_base(document, base).unwrap_or_default(),
+        }
+    }
+
+    /// Number of items of all types
+    pub fn len(&self) -> usize {
+        self.hcard.len()
+            + self.hentry.len()
+            + self.hevent.len()
+            + self.hreview.len()
+            + self.hrecipe.len()
+            + self.hproduct.len()
+            + self.hfeed.len()
+            + self.hadr.len()
+            + self.hgeo.len()
+    }
+
+    /// Whether no items of any type were found
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    // Keep at most `max` items of each type, reporting whether any were dropped
+    pub(crate) fn truncate(&mut self, max: usize) -> bool {
+        fn cap<T>(items: &mut Vec<T>, max: usize) -> bool {
+            let over = items.len() > max;
+            items.truncate(max);
+            over
+        }
+
+        let mut over = cap(&mut self.hcard, max);
+        over |= cap(&mut self.hentry, max);
+        over |= cap(&mut self.hevent, max);
+        over |= cap(&mut self.hreview, max);
+        over |= cap(&mut self.hrecipe, max);
+        over |= cap(&mut self.hproduct, max);
+        over |= cap(&mut self.hfeed, max);
+        over |= cap(&mut self.hadr, max);
+        over |= cap(&mut self.hgeo, max);
+        over
+    }
+}
+
+/// Where the time went in one [`extract_all_with_stats`] call
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct Stats {
+    /// Bytes of HTML parsed (the head section alone in head-only mode)
+    pub input_bytes: usize,
+    /// Nodes in the parsed DOM, not counting those dropped by `max_depth`
+    pub dom_nodes: usize,
+    /// Time spent building the DOM
+    pub parse: Duration,
+    /// Time spent collecting `<title>`, `<meta>` and `<link>` tags
+    pub head_scan: Duration,
+    /// Extraction time per format, indexed by [`formats::index`]
+    ///
+    /// Open Graph run only for the Twitter fallback is booked to Twitter.
+    pub formats: [Duration; formats::COUNT],
+    /// Items found per format, indexed by [`formats::index`]
+    ///
+    /// Objects for JSON-LD, microdata and RDFa, root items for microformats,
+    /// relation types for rel-* links, and 1 for the single-object formats.
+    pub items: [usize; formats::COUNT],
+    /// JSON-LD scripts skipped because they did not parse
+    pub json_ld_errors: usize,
+}
+
+impl Stats {
+    /// Extraction time of a single format
+    pub fn format(&self, format: u32) -> Duration {
+        self.formats[formats::index(format)]
+    }
+}
+
+// Per-call instrumentation; only reads the clock when stats were requested
+struct Probe<'a> {
+    stats: Option<&'a mut Stats>,
+}
+
+impl Probe<'_> {
+    fn time<T>(
+        &mut self,
+        stage: &'static str,
+        slot: impl FnOnce(&mut Stats) -> &mut Duration,
+        f: impl FnOnce() -> T,
+    ) -> T {
+        #[cfg(feature = "tracing")]
+        let _span = tracing::debug_span!("meta_oxide", stage).entered();
+        #[cfg(not(feature = "tracing"))]
+        let _ = stage;
+
+        let Some(stats) = self.stats.as_deref_mut() else {
+            return f();
+        };
+        let start = Instant::now();
+        let out = f();
+        *slot(stats) += start.elapsed();
+        out
+    }
+
+    fn format<T>(&mut self, stage: &'static str, format: u32, f: impl FnOnce() -> T) -> T {
+        self.time(stage, |s| &mut s.formats[formats::index(format)], f)
+    }
+}
+
+/// Extract the selected formats from HTML, parsing it once
+///
+/// Served from the result cache when one is enabled (see [`cache::configure`]).
+///
+/// # Arguments
+/// * `html` - The HTML content
+/// * `base_url` - Optional base URL for resolving relative URLs
+/// * `options` - Format selection and parsing options
+///
+/// # Returns
+/// * `Extraction` - One optional result per format; a copy of the cached
+///   entry when the cache holds it
+pub fn extract_all(html: &str, base_url: Option<&str>, options: &ExtractOptions) -> Extraction {
+    Arc::try_unwrap(extract_shared(html, base_url, options))
+        .unwrap_or_else(|shared| Extraction::clone(&shared))
+}
+
+// `extract_all()`, sharing the results with the cache instead of copying them
+pub(crate) fn extract_shared(
+    html: &str,
+    base_url: Option<&str>,
+    options: &ExtractOptions,
+) -> Arc<Extraction> {
+    cache::extract_cached(html, base_url, options, || {
+        extract_probed(html, base_url, options, &mut Probe { stats: None }).0
+    })
+}
+
+/// [`extract_all`], also reporting timings and counts in `stats`
+///
+/// `stats` is overwritten. Timing costs two clock reads per stage; nothing
+/// is measured by the plain entry points.
+pub fn extract_all_with_stats(
+    html: &str,
+    base_url: Option<&str>,
+    options: &ExtractOptions,
+    stats: &mut Stats,
+) -> Extraction {
+    *stats = Stats::default();
+    let (out, document) =
+        extract_probed(html, base_url, options, &mut Probe { stats: Some(stats) });
+
+    stats.dom_nodes = document.tree.root().descendants().count();
+    stats.items = item_counts(&out);
+    out
+}
+
+fn extract_probed(
+    html: &str,
+    base_url: Option<&str>,
+    options: &ExtractOptions,
+    probe: &mut Probe,
+) -> (Extraction, Html) {
+    let mut budget = Budget::new(&options.limits);
+
+    // In head-only mode the body is never tokenized or built into the DOM
+    let html = if options.head_only { head::head_section(html) } else { html };
+    let html = budget.cut_input(html);
+    if let Some(stats) = probe.stats.as_deref_mut() {
+        stats.input_bytes = html.len();
+    }
+
+    let mut document = probe.time("parse", |s| &mut s.parse, || html_utils::parse_html(html));
+    budget.prune(&mut document);
+
+    // Formats whose markers are absent from the HTML would only find nothing
+    let selected = prefilter::formats_present(html, options.formats);
+    let typed = options.typed_microformats;
+    let mut out = extract_document(&document, base_url, selected, typed, probe, &mut budget);
+    budget.cap_items(&mut out);
+    out.limit = budget.hit;
+    (out, document)
+}
+
+// Number of items per format, as reported in `Stats::items`
+fn item_counts(out: &Extraction) -> [usize; formats::COUNT] {
+    fn present<T>(value: &Option<T>) -> usize {
+        usize::from(value.is_some())
+    }
+    fn len<T>(value: &Option<Vec<T>>) -> usize {
+        value.as_ref().map_or(0, Vec::len)
+    }
+
+    let mut items = [0; formats::COUNT];
+    items[formats::index(formats::META)] = present(&out.meta);
+    items[formats::index(formats::OPEN_GRAPH)] = present(&out.open_graph);
+    items[formats::index(formats::TWITTER)] = present(&out.twitter);
+    items[formats::index(formats::JSON_LD)] = len(&out.json_ld);
+    items[formats::index(formats::MICRODATA)] = len(&out.microdata);
+    items[formats::index(formats::MICROFORMATS)] =
+        out.microformats.as_ref().map_or(0, |mf| mf.values().map(Vec::len).sum())
+            + out.typed_microformats.as_ref().map_or(0, TypedMicroformats::len);
+    items[formats::index(formats::RDFA)] = len(&out.rdfa);
+    items[formats::index(formats::DUBLIN_CORE)] = present(&out.dublin_core);
+    items[formats::index(formats::MANIFEST)] = present(&out.manifest);
+    items[formats::index(formats::OEMBED)] = present(&out.oembed);
+    items[formats::index(formats::REL_LINKS)] = out.rel_links.as_ref().map_or(0, HashMap::len);
+    items
+}
+
+/// Extract the selected formats from many documents in parallel
+///
+/// Documents are spread over the process-wide [`pool`](crate::pool). Each
+/// entry is an HTML string and its optional base URL.
+///
+/// # Returns
+/// * `Vec<Extraction>` - One extraction per document, in input order
+pub fn extract_batch(
+    documents: &[(&str, Option<&str>)],
+    options: &ExtractOptions,
+) -> Vec<Extraction> {
+    pool::global().map(documents.len(), |i| {
+        let (html, base_url) = documents[i];
+        extract_all(html, base_url, options)
+    })
+}
+
+/// Extract the selected formats from an already parsed document
+///
+/// No [`Limits`] apply here; the document has already been parsed.
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+/// * `selected` - Bitmask of [`formats`] to extract
+///
+/// # Returns
+/// * `Extraction` - One optional result per format
+pub fn extract_from_document(document: &Html, base_url: Option<&str>, selected: u32) -> Extraction {
+    extract_document(
+        document,
+        base_url,
+        selected,
+        false,
+        &mut Probe { stats: None },
+        &mut Budget::unlimited(),
+    )
+}
+
+// Format whose time the Open Graph stage is booked to: Twitter's when Open
+// Graph only runs for the Twitter fallback
+fn open_graph_slot(selected: u32) -> u32 {
+    if selected & formats::OPEN_GRAPH != 0 {
+        formats::OPEN_GRAPH
+    } else {
+        formats::TWITTER
+    }
+}
+
+fn extract_document(
+    document: &Html,
+    base_url: Option<&str>,
+    selected: u32,
+    typed_microformats: bool,
+    probe: &mut Probe,
+    budget: &mut Budget,
+) -> Extraction {
+    let wants = |format: u32| selected & format != 0;
+    let mut out = Extraction::default();
+
+    // Relative URLs resolve against the document's <base href> when it has one
+    let base = BaseUrl::for_document(document, base_url);
+
+    // The head-level formats are all fed from a single scan of the tree
+    if selected & formats::HEAD != 0 && budget.allows() {
+        let head = probe.time("head_scan", |s| &mut s.head_scan, || head::scan(document));
+
+        if wants(formats::META) && budget.allows() {
+            out.meta = probe.format("meta", formats::META, || {
+                extractors::meta::extract_from_head(&head, &base).ok()
+            });
+        }
+
+        // Open Graph also backs the Twitter fallback, so run it for either
+        let og = if wants(formats::OPEN_GRAPH | formats::TWITTER) && budget.allows() {
+            probe.format("open_graph", open_graph_slot(selected), || {
+                extractors::social::extract_opengraph_from_head(&head, &base).ok()
+            })
+        } else {
+            None
+        };
+
+        if wants(formats::TWITTER) && budget.allows() {
+            out.twitter = probe.format("twitter", formats::TWITTER, || {
+                extractors::social::extract_twitter_from_head(&head, &base).ok().map(|mut tw| {
+                    if let Some(ref og) = og {
+                        extractors::social::twitter::apply_fallback(&mut tw, og);
+                    }
+                    tw
+                })
+            });
+        }
+
+        if wants(formats::OPEN_GRAPH) {
+            out.open_graph = og;
+        }
+
+        if wants(formats::DUBLIN_CORE) && budget.allows() {
+            out.dublin_core = probe.format("dublin_core", formats::DUBLIN_CORE, || {
+                extractors::dublin_core::extract_from_head(&head).ok()
+            });
+        }
+
+        if wants(formats::MANIFEST) && budget.allows() {
+            out.manifest = probe.format("manifest", formats::MANIFEST, || {
+                extractors::manifest::extract_from_head(&head, &base)
+                    .ok()
+                    .filter(|m| m.href.is_some())
+            });
+        }
+
+        if wants(formats::OEMBED) && budget.allows() {
+            out.oembed = probe.format("oembed", formats::OEMBED, || {
+                extractors::oembed::extract_from_head(&head, &base)
+                    .ok()
+                    .filter(|o| o.has_endpoints())
+            });
+        }
+
+        if wants(formats::REL_LINKS) && budget.allows() {
+            out.rel_links = probe.format("rel_links", formats::REL_LINKS, || {
+                extractors::rel_links::extract_from_head(&head, &base)
+                    .ok()
+                    .filter(|r| !r.is_empty())
+            });
+        }
+    }
+
+    if wants(formats::JSON_LD) && budget.allows() {
+        let max_bytes = budget.limits.max_json_ld_bytes.unwrap_or(usize::MAX);
+        let found = probe.format("json_ld", formats::JSON_LD, || {
+            extractors::jsonld::extract_from_document_limited(document, max_bytes).ok()
+        });
+        if let Some(found) = found {
+            if found.oversized > 0 {
+                budget.hit(Limit::JsonLdBytes);
+            }
+            if let Some(stats) = probe.stats.as_deref_mut() {
+                stats.json_ld_errors = found.invalid;
+            }
+            out.json_ld = Some(found.objects).filter(|v| !v.is_empty());
+        }
+    }
+
+    if wants(formats::MICRODATA) && budget.allows() {
+        out.microdata = probe.format("microdata", formats::MICRODATA, || {
+            extractors::microdata::extract_with_base(document, &base).ok().filter(|v| !v.is_empty())
+        });
+    }
+
+    if wants(formats::MICROFORMATS) && budget.allows() && typed_microformats {
+        out.typed_microformats = probe.format("microformats", formats::MICROFORMATS, || {
+            Some(TypedMicroformats::extract(document, &base)).filter(|mf| !mf.is_empty())
+        });
+    } else if wants(formats::MICROFORMATS) && budget.allows() {
+        out.microformats = probe.format("microformats", formats::MICROFORMATS, || {
+            parser::parse_document_with_base(document, &base).ok().filter(|mf| !mf.is_empty())
+        });
+    }
+
+    if wants(formats::RDFA) && budget.allows() {
+        out.rdfa = probe.format("rdfa", formats::RDFA, || {
+            extractors::rdfa::extract_with_base(document, &base).ok().filter(|v| !v.is_empty())
+        });
+    }
+
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const HTML: &str = r#"
+        <html>
+        <head>
+            <title>Page</title>
+            <meta property="og:title" content="OG Title">
+            <script type="application/ld+json">{"@type": "Article"}</script>
+        </head>
+        <body>
+            <div itemscope itemtype="https://schema.org/Person">
+                <span itemprop="name">Jane</span>
+            </div>
+        </body>
+        </html>
+    "#;
+
+    #[test]
+    fn test_extract_all_default_runs_everything() {
+        let out = extract_all(HTML, None, &ExtractOptions::default());
+        assert!(out.meta.is_some());
+        assert!(out.open_graph.is_some());
+        assert!(out.json_ld.is_some());
+        assert!(out.microdata.is_some());
+        assert!(out.manifest.is_none());
+    }
+
+    #[test]
+    fn test_extract_all_honors_base_href() {
+        let html = r#"<html><head><base href="/docs/">
+            <meta property="og:image" content="img.png"></head></html>"#;
+        let options = ExtractOptions { formats: formats::OPEN_GRAPH, ..Default::default() };
+        let out = extract_all(html, Some("https://example.com/page"), &options);
+        assert_eq!(
+            out.open_graph.unwrap().image,
+            Some("https://example.com/docs/img.png".to_string())
+        );
+    }
+
+    #[test]
+    fn test_extract_all_selected_formats_only() {
+        let options = ExtractOptions {
+            formats: formats::OPEN_GRAPH | formats::JSON_LD,
+            ..Default::default()
+        };
+        let out = extract_all(HTML, None, &options);
+        assert_eq!(out.open_graph.unwrap().title, Some("OG Title".to_string()));
+        assert!(out.json_ld.is_some());
+        assert!(out.meta.is_none());
+        assert!(out.microdata.is_none());
+    }
+
+    #[test]
+    fn test_twitter_fallback_without_open_graph_selected() {
+        let options = ExtractOptions { formats: formats::TWITTER, ..Default::default() };
+        let out = extract_all(HTML, None, &options);
+        assert_eq!(out.twitter.unwrap().title, Some("OG Title".to_string()));
+        assert!(out.open_graph.is_none());
+    }
+
+    #[test]
+    fn test_typed_microformats() {
+        let html = r#"<div class="h-card"><span class="p-name">Jane</span></div>
+            <article class="h-entry"><div class="p-author h-card">Jane</div></article>"#;
+        let options = ExtractOptions { typed_microformats: true, ..Default::default() };
+        let out = extract_all(html, None, &options);
+        assert!(out.microformats.is_none());
+        let typed = out.typed_microformats.unwrap();
+        assert_eq!((typed.hcard.len(), typed.hentry.len()), (2, 1));
+        assert_eq!(typed.hcard[0].name, Some("Jane".to_string()));
+
+        let generic = extract_all(html, None, &ExtractOptions::default());
+        assert!(generic.typed_microformats.is_none() && generic.microformats.is_some());
+    }
+
+    #[test]
+    fn test_twitter_fallback_time_is_booked_to_twitter() {
+        let options = ExtractOptions { formats: formats::TWITTER, ..Default::default() };
+        let mut stats = Stats::default();
+        extract_all_with_stats(HTML, None, &options, &mut stats);
+        assert_eq!(stats.format(formats::OPEN_GRAPH), Duration::ZERO);
+
+        // Elapsed time can read as zero on a coarse clock, so check the slot
+        // chosen rather than the time found in it
+        assert_eq!(open_graph_slot(formats::TWITTER), formats::TWITTER);
+        assert_eq!(open_graph_slot(formats::OPEN_GRAPH | formats::TWITTER), formats::OPEN_GRAPH);
+    }
+
+    #[test]
+    fn test_extract_batch_matches_extract_all() {
+        let documents = [(HTML, None), ("<title>Second</title>", Some("https://example.com"))];
+        let out = extract_batch(&documents, &ExtractOptions::default());
+        assert_eq!(out.len(), 2);
+        assert!(out[0].json_ld.is_some());
+        assert_eq!(out[1].meta.as_ref().unwrap().title, Some("Second".to_string()));
+    }
+
+    #[test]
+    fn test_extract_all_no_formats() {
+        let options = ExtractOptions { formats: 0, ..Default::default() };
+        let out = extract_all(HTML, None, &options);
+        assert!(out.meta.is_none() && out.json_ld.is_none() && out.microdata.is_none());
+    }
+
+    #[test]
+    fn test_extract_all_with_stats() {
+        let mut stats = Stats::default();
+        let out = extract_all_with_stats(HTML, None, &ExtractOptions::default(), &mut stats);
+        assert!(out.meta.is_some() && out.json_ld.is_some());
+
+        assert_eq!(stats.input_bytes, HTML.len());
+        assert!(stats.dom_nodes > 0);
+        assert_eq!(stats.items[formats::index(formats::JSON_LD)], 1);
+        assert_eq!(stats.items[formats::index(formats::MICRODATA)], 1);
+        assert_eq!(stats.items[formats::index(formats::MANIFEST)], 0);
+    }
+
+    #[test]
+    fn test_limits_return_partial_results() {
+        let options = ExtractOptions {
+            limits: Limits { max_json_ld_bytes: Some(8), ..Default::default() },
+            ..Default::default()
+        };
+        let out = extract_all(HTML, None, &options);
+        assert_eq!(out.limit, Some(Limit::JsonLdBytes));
+        assert!(out.json_ld.is_none());
+        assert!(out.microdata.is_some() && out.open_graph.is_some());
+
+        let nested =
+            format!("{}<span itemscope><b itemprop=name>Deep</b></span>", "<div>".repeat(50));
+        let options = ExtractOptions {
+            limits: Limits { max_depth: Some(20), ..Default::default() },
+            ..Default::default()
+        };
+        let out = extract_all(&nested, None, &options);
+        assert_eq!(out.limit, Some(Limit::Depth));
+        assert!(out.microdata.is_none());
+
+        let nested = format!(
+            "{}<meta name=description content=Deep>\
+             <script type=application/ld+json>{{\"@type\": \"Thing\"}}</script>",
+            "<div>".repeat(50)
+        );
+        let out = extract_all(&nested, None, &options);
+        assert_eq!(out.limit, Some(Limit::Depth));
+        assert!(out.meta.is_none_or(|meta| meta.description.is_none()));
+        assert!(out.json_ld.is_none_or(|objects| objects.is_empty()));
+
+        assert_eq!(extract_all(HTML, None, &ExtractOptions::default()).limit, None);
+    }
+
+    #[test]
+    fn test_format_index_covers_every_bit() {
+        assert_eq!(formats::index(formats::META), 0);
+        assert_eq!(formats::index(formats::REL_LINKS), formats::COUNT - 1);
+        assert_eq!(formats::ALL, (1 << formats::COUNT) - 1);
+    }
+
+    #[test]
+    fn test_extraction_serializes_like_combined_document() {
+        let extraction = Extraction {
+            oembed: Some(OEmbedDiscovery::default()),
+            rel_links: Some(HashMap::from([("me".to_string(), vec!["/a".to_string()])])),
+            limit: Some(Limit::Items),
+            ..Default::default()
+        };
+
+        let json = serde_json::to_string(&extraction).unwrap();
+        assert_eq!(
+            json,
+            r#"{"oembed":{"json_endpoints":[],"xml_endpoints":[]},"relLinks":{"me":["/a"]}}"#
+        );
+
+        let packed = crate::msgpack::extraction_to_vec(&extraction).unwrap();
+        assert_eq!(crate::msgpack::to_vec(&extraction).unwrap(), packed);
+    }
+}
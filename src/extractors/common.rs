@@ -25,18 +25,112 @@ pub trait Extractor: Debug {
 
 /// Utility functions for URL resolution
 pub mod url_utils {
+    use crate::extractors::head;
+    use scraper::Html;
+    use std::borrow::Cow;
+    use std::cell::RefCell;
+    use std::collections::HashMap;
     use url::{ParseError, Url};
 
     /// Resolve a URL (possibly relative) against a base URL
+    ///
+    /// Parses `base_url` on every call; extractors resolve the links of a
+    /// document through its [`BaseUrl`] instead. Absolute `scheme://` URLs are
+    /// parsed on their own, without the base.
     pub fn resolve_url(base_url: Option<&str>, url: &str) -> Result<String, ParseError> {
-        if let Some(base) = base_url {
-            let base_parsed = Url::parse(base)?;
-            let resolved = base_parsed.join(url)?;
-            Ok(resolved.to_string())
-        } else {
+        match base_url {
+            Some(base) if !has_authority(url) => Ok(Url::parse(base)?.join(url)?.into()),
             // If no base URL, try parsing as absolute
-            let parsed = Url::parse(url)?;
-            Ok(parsed.to_string())
+            _ => Url::parse(url).map(Into::into),
+        }
+    }
+
+    /// Most resolved URLs a [`BaseUrl`] remembers, bounding its memory on
+    /// pages with many distinct links
+    pub const MEMO_ENTRIES: usize = 512;
+
+    /// The base URL of one document, parsed once for all of its links
+    ///
+    /// Every relative URL of a page resolves against the same base, so the
+    /// base is parsed when the extraction of the document starts, and the
+    /// results for the first [`MEMO_ENTRIES`] relative URLs resolved are kept
+    /// alongside it.
+    #[derive(Debug, Default)]
+    pub struct BaseUrl {
+        base: Option<(String, Result<Url, ParseError>)>,
+        memo: RefCell<HashMap<String, String>>,
+    }
+
+    impl BaseUrl {
+        /// Use `base_url` as given
+        pub fn new(base_url: Option<&str>) -> Self {
+            Self {
+                base: base_url.map(|base| (base.to_string(), Url::parse(base))),
+                memo: RefCell::default(),
+            }
+        }
+
+        /// The base URL of `document`, see [`document_base`]
+        pub fn for_document(document: &Html, base_url: Option<&str>) -> Self {
+            Self::new(document_base(base_url, head::base_href(document)).as_deref())
+        }
+
+        /// The base URL, if there is one
+        pub fn as_str(&self) -> Option<&str> {
+            self.base.as_ref().map(|(base, _)| base.as_str())
+        }
+
+        /// Resolve a URL (possibly relative) against this base, like
+        /// [`resolve_url`]
+        pub fn resolve(&self, url: &str) -> Result<String, ParseError> {
+            let parsed = match &self.base {
+                Some((_, parsed)) if !has_authority(url) => parsed.as_ref().map_err(|e| *e)?,
+                _ => return Url::parse(url).map(Into::into),
+            };
+
+            if let Some(resolved) = self.memo.borrow().get(url) {
+                return Ok(resolved.clone());
+            }
+            let resolved: String = parsed.join(url)?.into();
+            let mut memo = self.memo.borrow_mut();
+            if memo.len() < MEMO_ENTRIES {
+                memo.insert(url.to_string(), resolved.clone());
+            }
+            Ok(resolved)
+        }
+    }
+
+    // Whether `url` starts with `scheme://`, so joining it to any base gives
+    // the URL itself
+    fn has_authority(url: &str) -> bool {
+        let Some((scheme, rest)) = url.split_once(':') else {
+            return false;
+        };
+        rest.starts_with("//")
+            && scheme.starts_with(|c: char| c.is_ascii_alphabetic())
+            && scheme.bytes().all(|b| b.is_ascii_alphanumeric() || matches!(b, b'+' | b'-' | b'.'))
+    }
+
+    /// The base URL of a document
+    ///
+    /// The document's `<base href>`, resolved against `base_url`, when it has
+    /// a valid one that other URLs can be resolved against (not, say,
+    /// `javascript:void(0)`); otherwise `base_url` itself.
+    pub fn document_base<'a>(
+        base_url: Option<&'a str>,
+        base_href: Option<&str>,
+    ) -> Option<Cow<'a, str>> {
+        let usable = |href: &str| {
+            let base = match base_url {
+                Some(base) if !has_authority(href) => Url::parse(base).ok()?.join(href).ok()?,
+                _ => Url::parse(href).ok()?,
+            };
+            (!base.cannot_be_a_base()).then(|| String::from(base))
+        };
+
+        match base_href.and_then(|href| usable(href.trim())) {
+            Some(base) => Some(Cow::Owned(base)),
+            None => base_url.map(Cow::Borrowed),
         }
     }
 
@@ -50,34 +144,126 @@ pub mod url_utils {
 /// Utility functions for HTML parsing
 pub mod html_utils {
     use crate::errors::{MicroformatError, Result};
-    use scraper::{Html, Selector};
+    use html5ever::driver::{self, ParseOpts, Parser};
+    use html5ever::tendril::{StrTendril, TendrilSink};
+    pub use scraper::{ElementRef, Html, Selector};
+    use std::borrow::Cow;
+    use std::sync::OnceLock;
 
     /// Parse HTML and return a document
     pub fn parse_html(html: &str) -> Html {
         Html::parse_document(html)
     }
 
+    /// A document parsed from text that arrives in pieces
+    ///
+    /// Each piece goes straight to the tokenizer and tree builder, so the
+    /// caller does not have to hold the whole text. The finished document is
+    /// the one [`parse_html`] builds from the pieces joined together.
+    pub struct IncrementalParser(Parser<Html>);
+
+    impl IncrementalParser {
+        /// Start an empty document
+        pub fn new() -> Self {
+            Self(driver::parse_document(Html::new_document(), ParseOpts::default()))
+        }
+
+        /// Parse the next piece of the document
+        pub fn push(&mut self, text: &str) {
+            if !text.is_empty() {
+                self.0.process(StrTendril::from_slice(text));
+            }
+        }
+
+        /// End the input and return the document
+        pub fn finish(self) -> Html {
+            self.0.finish()
+        }
+    }
+
+    impl Default for IncrementalParser {
+        fn default() -> Self {
+            Self::new()
+        }
+    }
+
     /// Create a CSS selector, returning error if invalid
     pub fn create_selector(selector: &str) -> Result<Selector> {
-        Selector::parse(selector).map_err(|e| {
-            MicroformatError::ParseError(format!("Invalid selector '{}': {:?}", selector, e))
-        })
+        compile_selector(selector).map_err(MicroformatError::ParseError)
+    }
+
+    /// Compiled selector (or compile error) stored by [`static_selector!`](crate::static_selector)
+    pub type SelectorCell = OnceLock<std::result::Result<Selector, String>>;
+
+    /// Get a selector from a process-wide cell, compiling it on first use
+    ///
+    /// Used through the [`static_selector!`](crate::static_selector) macro so each
+    /// selector literal is parsed once per process rather than once per document.
+    pub fn cached_selector(
+        cell: &'static SelectorCell,
+        selector: &'static str,
+    ) -> Result<&'static Selector> {
+        cell.get_or_init(|| compile_selector(selector))
+            .as_ref()
+            .map_err(|e| MicroformatError::ParseError(e.clone()))
+    }
+
+    fn compile_selector(selector: &str) -> std::result::Result<Selector, String> {
+        Selector::parse(selector).map_err(|e| format!("Invalid selector '{}': {:?}", selector, e))
     }
 
     /// Extract text content from an element, trimming whitespace
     pub fn extract_text(element: &scraper::ElementRef) -> Option<String> {
-        let text = element.text().collect::<String>();
-        let trimmed = text.trim();
-        if trimmed.is_empty() {
+        text(element).map(Cow::into_owned)
+    }
+
+    /// Text content of an element, trimmed, borrowed from the document when possible
+    ///
+    /// An element with a single text node (the common case for `<title>`,
+    /// `<span itemprop>` and the like) is returned as a slice of the document
+    /// without copying; text spread over several nodes is concatenated.
+    pub fn text<'a>(element: &scraper::ElementRef<'a>) -> Option<Cow<'a, str>> {
+        let mut nodes = element.text();
+        let first = nodes.next()?;
+        let text = match nodes.next() {
+            None => Cow::Borrowed(first.trim()),
+            Some(second) => {
+                let mut text = String::from(first);
+                text.push_str(second);
+                text.extend(nodes);
+                match text.trim() {
+                    trimmed if trimmed.len() == text.len() => Cow::Owned(text),
+                    trimmed => Cow::Owned(trimmed.to_string()),
+                }
+            }
+        };
+        if text.is_empty() {
             None
         } else {
-            Some(trimmed.to_string())
+            Some(text)
         }
     }
 
     /// Get attribute value from an element
     pub fn get_attr(element: &scraper::ElementRef, attr: &str) -> Option<String> {
-        element.value().attr(attr).map(|s| s.to_string())
+        self::attr(element, attr).map(str::to_string)
+    }
+
+    /// Get attribute value from an element, borrowed from the document
+    pub fn attr<'a>(element: &scraper::ElementRef<'a>, name: &str) -> Option<&'a str> {
+        element.value().attr(name)
+    }
+
+    /// ASCII-lowercase `s`, allocating only if it contains an uppercase letter
+    ///
+    /// Attribute values that are matched against lowercase keywords are almost
+    /// always lowercase already, so this usually borrows.
+    pub fn ascii_lowercase(s: &str) -> Cow<'_, str> {
+        if s.bytes().any(|b| b.is_ascii_uppercase()) {
+            Cow::Owned(s.to_ascii_lowercase())
+        } else {
+            Cow::Borrowed(s)
+        }
     }
 }
 
@@ -135,6 +321,22 @@ mod tests {
         assert_eq!(html_utils::get_attr(&element, "href"), Some("https://example.com".to_string()));
     }
 
+    #[test]
+    fn test_text_borrows_single_node() {
+        let html = html_utils::parse_html("<p>  Hello <b>World</b> </p><i> One </i>");
+        let p = html.select(&html_utils::create_selector("p").unwrap()).next().unwrap();
+        let i = html.select(&html_utils::create_selector("i").unwrap()).next().unwrap();
+
+        assert_eq!(html_utils::text(&p).as_deref(), Some("Hello World"));
+        assert!(matches!(html_utils::text(&i), Some(std::borrow::Cow::Borrowed("One"))));
+    }
+
+    #[test]
+    fn test_ascii_lowercase() {
+        assert!(matches!(html_utils::ascii_lowercase("canonical"), std::borrow::Cow::Borrowed(_)));
+        assert_eq!(html_utils::ascii_lowercase("Apple-Touch-Icon"), "apple-touch-icon");
+    }
+
     #[test]
     fn test_get_attr_missing() {
         let html = html_utils::parse_html(r#"<a>Link</a>"#);
@@ -179,6 +381,59 @@ mod tests {
         assert_eq!(result, "https://example.com/page#section");
     }
 
+    #[test]
+    fn test_base_url_resolves_like_resolve_url() {
+        let base = url_utils::BaseUrl::new(Some("https://a.example/x/"));
+        assert_eq!(base.as_str(), Some("https://a.example/x/"));
+        assert_eq!(base.resolve("page").unwrap(), "https://a.example/x/page");
+        // A second lookup is answered from the memo
+        assert_eq!(base.resolve("page").unwrap(), "https://a.example/x/page");
+        assert_eq!(base.resolve("https://b.example").unwrap(), "https://b.example/");
+
+        // Past the memo's bound URLs are still resolved, just not remembered
+        for i in 0..url_utils::MEMO_ENTRIES + 10 {
+            assert_eq!(
+                base.resolve(&format!("p{i}")).unwrap(),
+                format!("https://a.example/x/p{i}")
+            );
+        }
+
+        let invalid = url_utils::BaseUrl::new(Some("not-a-url"));
+        assert!(invalid.resolve("/path").is_err());
+        assert_eq!(invalid.resolve("https://b.example").unwrap(), "https://b.example/");
+
+        let none = url_utils::BaseUrl::new(None);
+        assert_eq!(none.as_str(), None);
+        assert!(none.resolve("/path").is_err());
+    }
+
+    #[test]
+    fn test_resolve_url_absolute_skips_base() {
+        let result = url_utils::resolve_url(Some("not-a-url"), "https://example.com").unwrap();
+        assert_eq!(result, "https://example.com/");
+        // A scheme without `//` is still resolved against the base
+        let result = url_utils::resolve_url(Some("https://example.com/a/b"), "https:c").unwrap();
+        assert_eq!(result, "https://example.com/a/c");
+    }
+
+    #[test]
+    fn test_document_base() {
+        let base = url_utils::document_base(Some("https://example.com/a/"), Some(" /static/ "));
+        assert_eq!(base.as_deref(), Some("https://example.com/static/"));
+
+        let base = url_utils::document_base(Some("https://example.com/"), None);
+        assert_eq!(base.as_deref(), Some("https://example.com/"));
+
+        // An unusable <base href> is ignored
+        let base = url_utils::document_base(None, Some("/relative/"));
+        assert_eq!(base, None);
+        let base =
+            url_utils::document_base(Some("https://example.com/"), Some("javascript:void(0)"));
+        assert_eq!(base.as_deref(), Some("https://example.com/"));
+        let base = url_utils::document_base(None, Some("data:text/html,x"));
+        assert_eq!(base, None);
+    }
+
     #[test]
     fn test_resolve_url_parent_directory() {
         let result =
@@ -204,6 +459,22 @@ mod tests {
         assert!(result.is_err());
     }
 
+    #[test]
+    fn test_static_selector_is_compiled_once() {
+        fn selector() -> &'static html_utils::Selector {
+            crate::static_selector!("p.lead").unwrap()
+        }
+        assert!(std::ptr::eq(selector(), selector()));
+
+        let html = html_utils::parse_html(r#"<p class="lead">Hi</p>"#);
+        assert_eq!(html.select(selector()).count(), 1);
+    }
+
+    #[test]
+    fn test_static_selector_invalid_syntax() {
+        assert!(crate::static_selector!("div[[[invalid").is_err());
+    }
+
     #[test]
     fn test_create_selector_empty() {
         let result = html_utils::create_selector("");
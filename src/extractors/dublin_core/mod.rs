@@ -4,7 +4,9 @@
 
 use crate::errors::Result;
 use crate::extractors::common::html_utils;
+use crate::extractors::head::{self, HeadTags};
 use crate::types::dublin_core::DublinCore;
+use scraper::Html;
 
 #[cfg(test)]
 mod tests;
@@ -17,65 +19,81 @@ mod tests;
 /// # Returns
 /// * `Result<DublinCore>` - Extracted Dublin Core metadata or error
 pub fn extract(html: &str) -> Result<DublinCore> {
-    let document = html_utils::parse_html(html);
+    extract_from_document(&html_utils::parse_html(html))
+}
+
+/// Extract Dublin Core metadata from an already parsed document
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+///
+/// # Returns
+/// * `Result<DublinCore>` - Extracted Dublin Core metadata or error
+pub fn extract_from_document(document: &Html) -> Result<DublinCore> {
+    extract_from_head(&head::scan(document))
+}
+
+/// Extract Dublin Core metadata from pre-scanned head tags
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+///
+/// # Returns
+/// * `Result<DublinCore>` - Extracted Dublin Core metadata or error
+pub fn extract_from_head(head: &HeadTags) -> Result<DublinCore> {
     let mut dc = DublinCore::default();
 
-    // Extract Dublin Core meta tags (both DC. and dc. prefixes)
-    if let Ok(selector) = html_utils::create_selector("meta[name][content]") {
-        for element in document.select(&selector) {
-            if let (Some(name), Some(content)) =
-                (html_utils::get_attr(&element, "name"), html_utils::get_attr(&element, "content"))
-            {
-                let content = content.trim().to_string();
-                if content.is_empty() {
-                    continue;
-                }
+    // Dublin Core meta tags (both DC. and dc. prefixes)
+    for tag in &head.dublin_core {
+        let name = tag.key;
+        let content = tag.content.trim();
+        if content.is_empty() {
+            continue;
+        }
 
-                // Handle both DC. and dc. prefixes (case-insensitive)
-                let name_lower = name.to_lowercase();
-                let dc_name = if let Some(stripped) = name_lower.strip_prefix("dc.") {
-                    stripped
-                } else if let Some(stripped) = name_lower.strip_prefix("dcterms.") {
-                    stripped
-                } else {
-                    continue;
-                };
+        // Handle both DC. and dc. prefixes (case-insensitive)
+        let name_lower = html_utils::ascii_lowercase(name);
+        let dc_name = if let Some(stripped) = name_lower.strip_prefix("dc.") {
+            stripped
+        } else if let Some(stripped) = name_lower.strip_prefix("dcterms.") {
+            stripped
+        } else {
+            continue;
+        };
 
-                match dc_name {
-                    "title" => dc.title = Some(content),
-                    "creator" => dc.creator = Some(content),
-                    "subject" => {
-                        // Split by comma or semicolon
-                        let subjects: Vec<String> = content
-                            .split(&[',', ';'][..])
-                            .map(|s| s.trim().to_string())
-                            .filter(|s| !s.is_empty())
-                            .collect();
-                        dc.subject = Some(subjects);
-                    }
-                    "description" => dc.description = Some(content),
-                    "publisher" => dc.publisher = Some(content),
-                    "contributor" => {
-                        // Split by comma or semicolon
-                        let contributors: Vec<String> = content
-                            .split(&[',', ';'][..])
-                            .map(|s| s.trim().to_string())
-                            .filter(|s| !s.is_empty())
-                            .collect();
-                        dc.contributor = Some(contributors);
-                    }
-                    "date" => dc.date = Some(content),
-                    "type" => dc.type_ = Some(content),
-                    "format" => dc.format = Some(content),
-                    "identifier" => dc.identifier = Some(content),
-                    "source" => dc.source = Some(content),
-                    "language" => dc.language = Some(content),
-                    "relation" => dc.relation = Some(content),
-                    "coverage" => dc.coverage = Some(content),
-                    "rights" => dc.rights = Some(content),
-                    _ => {}
-                }
+        match dc_name {
+            "title" => dc.title = Some(content.to_string()),
+            "creator" => dc.creator = Some(content.to_string()),
+            "subject" => {
+                // Split by comma or semicolon
+                let subjects: Vec<String> = content
+                    .split(&[',', ';'][..])
+                    .map(|s| s.trim().to_string())
+                    .filter(|s| !s.is_empty())
+                    .collect();
+                dc.subject = Some(subjects);
+            }
+            "description" => dc.description = Some(content.to_string()),
+            "publisher" => dc.publisher = Some(content.to_string()),
+            "contributor" => {
+                // Split by comma or semicolon
+                let contributors: Vec<String> = content
+                    .split(&[',', ';'][..])
+                    .map(|s| s.trim().to_string())
+                    .filter(|s| !s.is_empty())
+                    .collect();
+                dc.contributor = Some(contributors);
             }
+            "date" => dc.date = Some(content.to_string()),
+            "type" => dc.type_ = Some(content.to_string()),
+            "format" => dc.format = Some(content.to_string()),
+            "identifier" => dc.identifier = Some(content.to_string()),
+            "source" => dc.source = Some(content.to_string()),
+            "language" => dc.language = Some(content.to_string()),
+            "relation" => dc.relation = Some(content.to_string()),
+            "coverage" => dc.coverage = Some(content.to_string()),
+            "rights" => dc.rights = Some(content.to_string()),
+            _ => {}
         }
     }
 
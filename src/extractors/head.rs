@@ -0,0 +1,497 @@
+//! Single-pass scanner for head-level tags
+//!
+//! Standard meta tags, Open Graph, Twitter Cards, Dublin Core, the Web App
+//! Manifest link, oEmbed discovery and rel-* links are all read from a small
+//! set of `<title>`, `<meta>` and `[rel][href]` elements. Rather than letting
+//! each extractor run its own selectors over the whole document, [`scan`]
+//! walks the tree once and buckets every interesting tag by its lowercased
+//! name/property prefix. Each bucket preserves document order.
+
+use memchr::memmem;
+use scraper::{ElementRef, Html};
+
+/// A `<meta>` tag with its key (`name` or `property`) and `content`
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct MetaTag<'a> {
+    /// Value of the `name` or `property` attribute, as written
+    pub key: &'a str,
+    /// Value of the `content` attribute, untrimmed
+    pub content: &'a str,
+}
+
+/// Head-level tags collected by a single walk over a document
+#[derive(Debug, Default)]
+pub struct HeadTags<'a> {
+    /// First `<title>` element
+    pub title: Option<ElementRef<'a>>,
+    /// `lang` attribute of the first `<html lang>` element
+    pub lang: Option<&'a str>,
+    /// First `<meta charset>` value
+    pub charset: Option<&'a str>,
+    /// `content` of the first `<meta http-equiv="Content-Type">`, if it has one
+    pub content_type: Option<Option<&'a str>>,
+    /// Every `<meta name content>` tag
+    pub names: Vec<MetaTag<'a>>,
+    /// `<meta name content>` tags whose name starts with `twitter:`
+    pub twitter: Vec<MetaTag<'a>>,
+    /// `<meta name content>` tags whose name starts with `dc.` or `dcterms.`
+    pub dublin_core: Vec<MetaTag<'a>>,
+    /// `<meta property content>` tags whose property starts with `og:`,
+    /// `article:`, `book:`, `profile:` or `fb:`
+    pub open_graph: Vec<MetaTag<'a>>,
+    /// Every element carrying both `rel` and `href` (`<link>`, `<a>`, `<area>`, ...)
+    pub rel: Vec<ElementRef<'a>>,
+}
+
+impl<'a> HeadTags<'a> {
+    /// `<link rel href>` elements, in document order
+    pub fn links(&self) -> impl Iterator<Item = &ElementRef<'a>> + '_ {
+        self.rel.iter().filter(|e| e.value().name() == "link")
+    }
+}
+
+/// Property prefixes handled by the Open Graph extractor (and `fb:*` by meta)
+const OPEN_GRAPH_PREFIXES: &[&str] = &["og:", "article:", "book:", "profile:", "fb:"];
+
+/// Dublin Core name prefixes
+const DUBLIN_CORE_PREFIXES: &[&str] = &["dc.", "dcterms."];
+
+/// Walk the document once and collect all head-level tags
+///
+/// Elements are visited in document order from the root, so subtrees detached
+/// by [`Limits::max_depth`](crate::limits::Limits::max_depth) are never seen.
+pub fn scan(document: &Html) -> HeadTags<'_> {
+    let mut head = HeadTags::default();
+
+    for element in document.tree.root().descendants().filter_map(ElementRef::wrap) {
+        let value = element.value();
+
+        if value.attr("rel").is_some() && value.attr("href").is_some() {
+            head.rel.push(element);
+        }
+
+        match value.name() {
+            "meta" => {
+                if head.charset.is_none() {
+                    head.charset = value.attr("charset");
+                }
+
+                if head.content_type.is_none()
+                    && value
+                        .attr("http-equiv")
+                        .is_some_and(|v| v.eq_ignore_ascii_case("Content-Type"))
+                {
+                    head.content_type = Some(value.attr("content"));
+                }
+
+                let Some(content) = value.attr("content") else {
+                    continue;
+                };
+
+                if let Some(name) = value.attr("name") {
+                    let tag = MetaTag { key: name, content };
+                    if has_prefix(name, &["twitter:"]) {
+                        head.twitter.push(tag);
+                    } else if has_prefix(name, DUBLIN_CORE_PREFIXES) {
+                        head.dublin_core.push(tag);
+                    }
+                    head.names.push(tag);
+                }
+
+                if let Some(property) = value.attr("property") {
+                    if has_prefix(property, OPEN_GRAPH_PREFIXES) {
+                        head.open_graph.push(MetaTag { key: property, content });
+                    }
+                }
+            }
+            "title" if head.title.is_none() => head.title = Some(element),
+            "html" if head.lang.is_none() => head.lang = value.attr("lang"),
+            _ => {}
+        }
+    }
+
+    head
+}
+
+/// `href` of the first `<base href>` in the document head
+///
+/// Only the `<head>` element's children are looked at, so this costs a few
+/// node visits however large the body is.
+pub fn base_href(document: &Html) -> Option<&str> {
+    let head = document
+        .root_element()
+        .children()
+        .filter_map(ElementRef::wrap)
+        .find(|e| e.value().name() == "head")?;
+
+    head.children()
+        .filter_map(ElementRef::wrap)
+        .filter(|e| e.value().name() == "base")
+        .find_map(|e| e.value().attr("href"))
+}
+
+/// Elements allowed before `<body>`; anything else starts body content
+const HEAD_ELEMENTS: &[&str] =
+    &["html", "head", "title", "base", "link", "meta", "style", "script", "noscript", "template"];
+
+/// Head elements whose content is skipped verbatim up to the matching end tag
+const RAW_TEXT_ELEMENTS: &[&str] = &["title", "style", "script", "noscript", "template"];
+
+/// Cut an HTML document down to its head section
+///
+/// Returns the prefix of `html` that ends right after `</head>`, or right before
+/// the first start tag that cannot appear in `<head>` (such as `<body>` or a
+/// `<div>`), whichever comes first. Comments and the contents of `<script>`,
+/// `<style>`, `<title>`, `<noscript>` and `<template>` are skipped, so markup
+/// inside them does not end the head early and `<script type="application/ld+json">`
+/// blocks in the head are kept whole. If no boundary is found the whole input
+/// is returned.
+///
+/// Parsing only this prefix is enough for the head-level formats and keeps the
+/// tokenizer and DOM from ever touching the body.
+pub fn head_section(html: &str) -> &str {
+    match find_head_end(html.as_bytes(), HeadScan::default()) {
+        HeadEnd::Found(end) => &html[..end],
+        HeadEnd::Pending(_) => html,
+    }
+}
+
+/// Outcome of [`find_head_end`]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum HeadEnd {
+    /// The head ends at this byte offset (see [`head_section`])
+    Found(usize),
+    /// No boundary yet; scanning can resume from this state once more input
+    /// has been appended
+    Pending(HeadScan),
+}
+
+/// Where [`find_head_end`] stopped in a document that is still coming in
+///
+/// The default value starts a scan at the beginning of the document.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct HeadScan {
+    pos: usize,
+    open: Option<Open>,
+}
+
+/// A construct left open by the end of the input, whose contents before
+/// [`HeadScan::pos`] have already been searched for its end
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Open {
+    Comment,
+    RawText(&'static str),
+}
+
+/// Find where the head section of a possibly incomplete document ends
+///
+/// Applies the same rules as [`head_section`] to `bytes`, starting from
+/// `scan`, which must be [`HeadScan::default`] or a state previously returned
+/// as [`HeadEnd::Pending`] for a prefix of the same input. A tag, comment or
+/// raw-text element cut off by the end of `bytes` is reported as pending
+/// rather than as a boundary, so the scan can be repeated as a document
+/// streams in. Comments and raw-text elements resume from where the last
+/// search for their end stopped, so a long inline script is only scanned
+/// once however many chunks it spans.
+pub fn find_head_end(bytes: &[u8], scan: HeadScan) -> HeadEnd {
+    let mut pos = scan.pos;
+
+    match scan.open {
+        Some(Open::Comment) => match find(bytes, pos, b"-->") {
+            Some(end) => pos = end + 3,
+            None => return pending_comment(bytes, pos),
+        },
+        Some(Open::RawText(name)) => match scan_end_tag(bytes, pos, name) {
+            Ok(after) => pos = after,
+            Err(resume) => return HeadEnd::Pending(HeadScan { pos: resume, open: scan.open }),
+        },
+        None => {}
+    }
+
+    while let Some(offset) = memchr::memchr(b'<', &bytes[pos..]) {
+        let start = pos + offset;
+        let rest = &bytes[start..];
+
+        // Comments, doctype and processing instructions
+        if rest.starts_with(b"<!--") {
+            match find(bytes, start + 4, b"-->") {
+                Some(end) => pos = end + 3,
+                None => return pending_comment(bytes, start + 4),
+            }
+            continue;
+        }
+        if rest.len() < 4 && b"<!--".starts_with(rest) {
+            // Could still become a comment
+            return HeadEnd::Pending(HeadScan { pos: start, open: None });
+        }
+        if rest.starts_with(b"<!") || rest.starts_with(b"<?") {
+            match tag_end(bytes, start + 2) {
+                Some(end) => pos = end,
+                None => return HeadEnd::Pending(HeadScan { pos: start, open: None }),
+            }
+            continue;
+        }
+
+        let closing = rest.get(1) == Some(&b'/');
+        let name_start = start + 1 + closing as usize;
+        let name_len = bytes[name_start.min(bytes.len())..]
+            .iter()
+            .take_while(|b| b.is_ascii_alphanumeric())
+            .count();
+        if name_start + name_len >= bytes.len() {
+            // The tag name may continue in the next chunk
+            return HeadEnd::Pending(HeadScan { pos: start, open: None });
+        }
+        if name_len == 0 || !bytes[name_start].is_ascii_alphabetic() {
+            // A stray '<' in text
+            pos = start + 1;
+            continue;
+        }
+        let name = &bytes[name_start..name_start + name_len];
+
+        let Some(end) = tag_end(bytes, name_start + name_len) else {
+            return HeadEnd::Pending(HeadScan { pos: start, open: None });
+        };
+
+        if closing {
+            if name.eq_ignore_ascii_case(b"head") {
+                return HeadEnd::Found(end);
+            }
+            pos = end;
+            continue;
+        }
+
+        if !HEAD_ELEMENTS.iter().any(|e| name.eq_ignore_ascii_case(e.as_bytes())) {
+            return HeadEnd::Found(start);
+        }
+
+        if let Some(&raw) =
+            RAW_TEXT_ELEMENTS.iter().find(|e| name.eq_ignore_ascii_case(e.as_bytes()))
+        {
+            match scan_end_tag(bytes, end, raw) {
+                Ok(after) => pos = after,
+                Err(resume) => {
+                    return HeadEnd::Pending(HeadScan {
+                        pos: resume,
+                        open: Some(Open::RawText(raw)),
+                    })
+                }
+            }
+        } else {
+            pos = end;
+        }
+    }
+
+    HeadEnd::Pending(HeadScan { pos: bytes.len(), open: None })
+}
+
+// Pending inside a comment whose `-->` was searched for from `from`; the
+// last two bytes may be the start of it
+fn pending_comment(bytes: &[u8], from: usize) -> HeadEnd {
+    let pos = bytes.len().saturating_sub(2).max(from);
+    HeadEnd::Pending(HeadScan { pos, open: Some(Open::Comment) })
+}
+
+/// Position just past the `>` closing a tag, honouring quoted attribute values
+pub(crate) fn tag_end(bytes: &[u8], from: usize) -> Option<usize> {
+    let mut quote = None;
+    for (i, &b) in bytes.iter().enumerate().skip(from) {
+        match quote {
+            Some(q) if b == q => quote = None,
+            Some(_) => {}
+            None if b == b'"' || b == b'\'' => quote = Some(b),
+            None if b == b'>' => return Some(i + 1),
+            None => {}
+        }
+    }
+    None
+}
+
+/// Position just past the `</name ...>` end tag starting the search at `from`
+pub(crate) fn find_end_tag(bytes: &[u8], from: usize, name: &str) -> Option<usize> {
+    scan_end_tag(bytes, from, name).ok()
+}
+
+// As `find_end_tag`, but on failure returns the offset to search again from
+// once more input has been appended: the start of an end tag cut off by the
+// end of `bytes`, or else the last byte, which may be the `<` of one
+fn scan_end_tag(bytes: &[u8], from: usize, name: &str) -> Result<usize, usize> {
+    let finder = memmem::Finder::new(b"</");
+    let mut pos = from;
+    while let Some(offset) = finder.find(&bytes[pos..]) {
+        let start = pos + offset;
+        let name_start = start + 2;
+        let name_end = name_start + name.len();
+        if bytes.len() <= name_end {
+            return Err(start);
+        }
+        if bytes[name_start..name_end].eq_ignore_ascii_case(name.as_bytes())
+            && !bytes[name_end].is_ascii_alphanumeric()
+        {
+            return tag_end(bytes, name_end).ok_or(start);
+        }
+        pos = name_start;
+    }
+    Err(bytes.len().saturating_sub(1).max(from))
+}
+
+/// Find `needle` in `bytes` at or after `from`
+pub(crate) fn find(bytes: &[u8], from: usize, needle: &[u8]) -> Option<usize> {
+    memmem::find(bytes.get(from..)?, needle).map(|i| from + i)
+}
+
+/// Check whether `key` starts with any of `prefixes`, ignoring ASCII case
+fn has_prefix(key: &str, prefixes: &[&str]) -> bool {
+    prefixes.iter().any(|prefix| {
+        key.len() >= prefix.len()
+            && key.as_bytes()[..prefix.len()].eq_ignore_ascii_case(prefix.as_bytes())
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::extractors::common::html_utils;
+
+    #[test]
+    fn test_base_href() {
+        let doc = html_utils::parse_html(
+            r#"<head><base target="_top"><base href="/a/"><base href="/b/"></head>"#,
+        );
+        assert_eq!(base_href(&doc), Some("/a/"));
+
+        let doc = html_utils::parse_html(r#"<body><p>No base</p></body>"#);
+        assert_eq!(base_href(&doc), None);
+    }
+
+    #[test]
+    fn test_scan_buckets_by_prefix() {
+        let doc = html_utils::parse_html(
+            r#"<html lang="en"><head>
+            <title>Page</title>
+            <meta charset="utf-8">
+            <meta name="description" content="Desc">
+            <meta name="Twitter:card" content="summary">
+            <meta name="DC.title" content="DC Title">
+            <meta property="og:title" content="OG Title">
+            <meta property="article:author" content="Jane">
+            <meta property="custom:thing" content="ignored">
+            <link rel="canonical" href="/page">
+            </head><body><a rel="me" href="/me">Me</a></body></html>"#,
+        );
+        let head = scan(&doc);
+
+        assert_eq!(head.lang, Some("en"));
+        assert_eq!(head.charset, Some("utf-8"));
+        assert!(head.title.is_some());
+        assert_eq!(head.names.len(), 3);
+        assert_eq!(head.twitter, vec![MetaTag { key: "Twitter:card", content: "summary" }]);
+        assert_eq!(head.dublin_core.len(), 1);
+        assert_eq!(head.open_graph.len(), 2);
+        assert_eq!(head.rel.len(), 2);
+        assert_eq!(head.links().count(), 1);
+    }
+
+    #[test]
+    fn test_scan_first_content_type_wins() {
+        let doc = html_utils::parse_html(
+            r#"<meta http-equiv="content-type">
+            <meta http-equiv="Content-Type" content="text/html; charset=UTF-8">"#,
+        );
+        assert_eq!(scan(&doc).content_type, Some(None));
+    }
+
+    #[test]
+    fn test_head_section_stops_after_head() {
+        let html = "<html><head><title>T</title></head><body><p>Big body</p></body></html>";
+        assert_eq!(head_section(html), "<html><head><title>T</title></head>");
+    }
+
+    #[test]
+    fn test_head_section_stops_at_body_content() {
+        let html = r#"<meta name="a" content="b"><div>Content</div>"#;
+        assert_eq!(head_section(html), r#"<meta name="a" content="b">"#);
+    }
+
+    #[test]
+    fn test_head_section_skips_raw_text_and_comments() {
+        let html = r#"<head><!-- <body> -->
+            <script type="application/ld+json">{"x": "</div><body>"}</script>
+            <meta content="a > b" name="c">
+            </HEAD><body>"#;
+        let head = head_section(html);
+        assert!(head.ends_with("</HEAD>"));
+        assert!(head.contains("application/ld+json"));
+        assert!(head.contains(r#"name="c""#));
+    }
+
+    #[test]
+    fn test_head_section_without_boundary() {
+        let html = r#"<meta property="og:title" content="Only head">"#;
+        assert_eq!(head_section(html), html);
+        assert_eq!(head_section(""), "");
+        assert_eq!(head_section("a < b"), "a < b");
+    }
+
+    #[test]
+    fn test_find_head_end_incremental() {
+        let html =
+            br#"<html><head><title>T</title><!-- c --><meta name="a" content="b"></head><body>"#;
+        let expected = head_section(std::str::from_utf8(html).unwrap()).len();
+
+        // Every split point must either find the same boundary or resume correctly
+        for split in 0..html.len() {
+            let resumed = match find_head_end(&html[..split], HeadScan::default()) {
+                HeadEnd::Found(end) => end,
+                HeadEnd::Pending(scan) => match find_head_end(html, scan) {
+                    HeadEnd::Found(end) => end,
+                    HeadEnd::Pending(_) => panic!("no boundary after split at {split}"),
+                },
+            };
+            assert_eq!(resumed, expected, "split at {split}");
+        }
+    }
+
+    #[test]
+    fn test_find_head_end_resumes_inside_raw_text() {
+        let html: &[u8] =
+            br#"<head><!-- a -- b --><script>if (a</b) s = "</scr";</script></head><p>"#;
+        let expected = head_section(std::str::from_utf8(html).unwrap()).len();
+        assert_eq!(&html[..expected], &html[..html.len() - 3]);
+
+        // Feeding one byte at a time must never move the scan backwards
+        let mut scan = HeadScan::default();
+        let mut found = None;
+        for len in 1..=html.len() {
+            match find_head_end(&html[..len], scan) {
+                HeadEnd::Found(end) => {
+                    found = Some(end);
+                    break;
+                }
+                HeadEnd::Pending(next) => {
+                    assert!(next.pos >= scan.pos || next.open != scan.open, "at {len}");
+                    scan = next;
+                }
+            }
+        }
+        assert_eq!(found, Some(expected));
+
+        let script = b"<head><script>var x = 1;";
+        match find_head_end(script, HeadScan::default()) {
+            HeadEnd::Pending(scan) => {
+                assert_eq!(scan.open, Some(Open::RawText("script")));
+                assert_eq!(scan.pos, script.len() - 1);
+            }
+            other => panic!("unexpected {other:?}"),
+        }
+    }
+
+    #[test]
+    fn test_scan_empty_document() {
+        let doc = html_utils::parse_html("");
+        let head = scan(&doc);
+        assert!(head.title.is_none());
+        assert!(head.names.is_empty());
+        assert!(head.rel.is_empty());
+    }
+}
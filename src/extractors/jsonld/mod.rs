@@ -3,10 +3,17 @@
 //! Extracts structured data from <script type="application/ld+json"> tags.
 //! Enables Google Rich Results, AI/LLM training data, and rich metadata.
 
+use std::borrow::Cow;
+use std::collections::HashMap;
+use std::fmt;
+
 use crate::errors::Result;
 use crate::extractors::common::html_utils;
 use crate::types::jsonld::JsonLdObject;
-use scraper::Selector;
+use scraper::Html;
+use serde::de::{self, Deserialize, Deserializer, MapAccess, Visitor};
+use serde_json::value::RawValue;
+use serde_json::Value;
 
 #[cfg(test)]
 mod tests;
@@ -17,43 +24,151 @@ mod tests;
 ///
 /// # Arguments
 /// * `html` - The HTML content
+/// * `base_url` - Optional base URL (not used for JSON-LD)
+///
+/// # Returns
+/// * `Result<Vec<JsonLdObject>>` - All JSON-LD objects found
+pub fn extract(html: &str, base_url: Option<&str>) -> Result<Vec<JsonLdObject>> {
+    extract_from_document(&html_utils::parse_html(html), base_url)
+}
+
+/// Extract all JSON-LD objects from an already parsed document
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
 /// * `_base_url` - Optional base URL (not used for JSON-LD)
 ///
 /// # Returns
 /// * `Result<Vec<JsonLdObject>>` - All JSON-LD objects found
-pub fn extract(html: &str, _base_url: Option<&str>) -> Result<Vec<JsonLdObject>> {
-    let document = html_utils::parse_html(html);
-    let mut objects = Vec::new();
+pub fn extract_from_document(
+    document: &Html,
+    _base_url: Option<&str>,
+) -> Result<Vec<JsonLdObject>> {
+    extract_from_document_limited(document, usize::MAX).map(|found| found.objects)
+}
+
+/// What the JSON-LD scripts of a document yielded
+#[derive(Debug, Default)]
+pub struct Scripts {
+    /// Objects found, with `@graph` members in place of their container
+    pub objects: Vec<JsonLdObject>,
+    /// Scripts skipped for being over the size limit
+    pub oversized: usize,
+    /// Scripts skipped because they were not a valid JSON-LD object
+    pub invalid: usize,
+}
+
+/// Extract JSON-LD objects, skipping scripts longer than `max_script_bytes`
+///
+/// Each script is parsed straight from the document text, without copying
+/// it. The members of a top-level array or a `@graph` are moved out as
+/// separate objects rather than cloned.
+/// Oversized scripts are never parsed. Scripts that fail to parse are
+/// counted in [`Scripts::invalid`] and otherwise ignored.
+///
+/// # Returns
+/// * `Result<Scripts>` - The objects found and the scripts skipped
+pub fn extract_from_document_limited(document: &Html, max_script_bytes: usize) -> Result<Scripts> {
+    let mut found = Scripts::default();
 
     // Find all <script type="application/ld+json"> tags
-    let selector = match Selector::parse("script[type='application/ld+json']") {
+    let selector = match crate::static_selector!("script[type='application/ld+json']") {
         Ok(s) => s,
-        Err(_) => return Ok(objects),
+        Err(_) => return Ok(found),
     };
 
-    for script in document.select(&selector) {
-        // Get the text content of the script tag
-        let json_text: String = script.text().collect();
-        let json_text = json_text.trim();
+    for script in document.root_element().select(selector) {
+        if script.text().map(str::len).sum::<usize>() > max_script_bytes {
+            found.oversized += 1;
+            continue;
+        }
 
-        if json_text.is_empty() {
+        // Script content is a single text node, so this borrows
+        let Some(json_text) = html_utils::text(&script) else {
             continue;
+        };
+
+        // A script holds one object or a top-level array of them
+        let parsed = if json_text.starts_with('[') {
+            serde_json::from_str::<Vec<JsonLdObject>>(&json_text)
+        } else {
+            serde_json::from_str::<JsonLdObject>(&json_text).map(|obj| vec![obj])
+        };
+
+        match parsed {
+            Ok(parsed) => {
+                for mut obj in parsed {
+                    // If object has @graph, extract all items from graph
+                    match obj.graph.take() {
+                        Some(graph) => found.objects.extend(graph),
+                        None => found.objects.push(obj),
+                    }
+                }
+            }
+            Err(_) => found.invalid += 1,
         }
+    }
+
+    Ok(found)
+}
 
-        // Parse JSON
-        match serde_json::from_str::<JsonLdObject>(json_text) {
-            Ok(obj) => {
-                // If object has @graph, extract all items from graph
-                if let Some(ref graph) = obj.graph {
-                    objects.extend(graph.clone());
-                } else {
-                    objects.push(obj);
+/// Which JSON-LD objects [`extract_filtered`] returns, and how much of them
+#[derive(Debug, Clone, Copy, Default)]
+pub struct Filter<'a> {
+    /// `@type` values to keep; an object is kept when any of its types is
+    /// listed. Empty keeps every object.
+    pub types: &'a [&'a str],
+    /// Properties to keep on the objects returned, or None for all of them
+    ///
+    /// `@context`, `@type` and `@id` are always kept.
+    pub properties: Option<&'a [&'a str]>,
+}
+
+impl Filter<'_> {
+    fn wants_type(&self, type_: Option<&Value>) -> bool {
+        self.types.is_empty()
+            || match type_ {
+                Some(Value::String(s)) => self.types.contains(&s.as_str()),
+                Some(Value::Array(types)) => {
+                    types.iter().filter_map(Value::as_str).any(|t| self.types.contains(&t))
                 }
+                _ => false,
             }
-            Err(e) => {
-                // Log parse error but continue with other scripts
-                eprintln!("JSON-LD parse error: {}", e);
-                continue;
+    }
+
+    fn wants_property(&self, name: &str) -> bool {
+        self.properties.is_none_or(|names| names.contains(&name))
+    }
+}
+
+/// Extract the JSON-LD objects of the types `filter` selects
+///
+/// Returns what [`extract`] followed by a filter on `@type` would, without
+/// first building every object: each script is scanned with its values left
+/// as unparsed slices of the document text, and only the objects that match,
+/// and only the properties asked for, are ever deserialized. Large `ItemList`
+/// graphs and other unwanted objects cost a validating scan and no
+/// allocation. Scripts that fail to parse are ignored.
+pub fn extract_filtered(html: &str, filter: &Filter) -> Result<Vec<JsonLdObject>> {
+    extract_filtered_from_document(&html_utils::parse_html(html), filter)
+}
+
+/// Extract the JSON-LD objects `filter` selects from an already parsed document
+pub fn extract_filtered_from_document(
+    document: &Html,
+    filter: &Filter,
+) -> Result<Vec<JsonLdObject>> {
+    let mut objects = Vec::new();
+
+    let selector = match crate::static_selector!("script[type='application/ld+json']") {
+        Ok(s) => s,
+        Err(_) => return Ok(objects),
+    };
+
+    for script in document.root_element().select(selector) {
+        if let Some(json_text) = html_utils::text(&script) {
+            if let Ok(found) = filter_script(&json_text, filter) {
+                objects.extend(found);
             }
         }
     }
@@ -69,26 +184,127 @@ pub fn extract(html: &str, _base_url: Option<&str>) -> Result<Vec<JsonLdObject>>
 ///
 /// # Returns
 /// * `Result<Vec<JsonLdObject>>` - Filtered JSON-LD objects
-#[allow(dead_code)]
 pub fn extract_by_type(html: &str, type_name: &str) -> Result<Vec<JsonLdObject>> {
-    let all_objects = extract(html, None)?;
-
-    let filtered: Vec<JsonLdObject> = all_objects
-        .into_iter()
-        .filter(|obj| {
-            if let Some(ref type_) = obj.type_ {
-                match type_ {
-                    serde_json::Value::String(s) => s == type_name,
-                    serde_json::Value::Array(arr) => {
-                        arr.iter().any(|v| v.as_str() == Some(type_name))
+    extract_filtered(html, &Filter { types: &[type_name], properties: None })
+}
+
+// The objects of one script that `filter` selects
+fn filter_script(json_text: &str, filter: &Filter) -> serde_json::Result<Vec<JsonLdObject>> {
+    // A script holds one object or a top-level array of them
+    let scanned = if json_text.starts_with('[') {
+        serde_json::from_str::<Vec<LazyObject>>(json_text)?
+    } else {
+        vec![serde_json::from_str::<LazyObject>(json_text)?]
+    };
+
+    let mut objects = Vec::new();
+    for object in scanned {
+        // As in `extract`, a `@graph` stands in for its container
+        match object.graph {
+            Some(graph) => {
+                for member in graph {
+                    if filter.wants_type(member.type_.as_ref()) {
+                        objects.push(member.materialize(filter)?);
+                    }
+                }
+            }
+            None if filter.wants_type(object.type_.as_ref()) => {
+                objects.push(object.materialize(filter)?)
+            }
+            None => {}
+        }
+    }
+    Ok(objects)
+}
+
+/// A JSON-LD object with everything but its `@type` and `@graph` unparsed
+struct LazyObject<'a> {
+    type_: Option<Value>,
+    graph: Option<Vec<LazyObject<'a>>>,
+    entries: Vec<(Cow<'a, str>, &'a RawValue)>,
+}
+
+impl LazyObject<'_> {
+    /// Deserialize the entries `filter` keeps into a [`JsonLdObject`]
+    fn materialize(self, filter: &Filter) -> serde_json::Result<JsonLdObject> {
+        let mut object = JsonLdObject {
+            context: None,
+            type_: self.type_,
+            id: None,
+            graph: None,
+            properties: HashMap::new(),
+        };
+        for (key, value) in self.entries {
+            match &*key {
+                "@context" => object.context = serde_json::from_str(value.get())?,
+                "@id" => object.id = serde_json::from_str(value.get())?,
+                name if filter.wants_property(name) => {
+                    object.properties.insert(key.into_owned(), serde_json::from_str(value.get())?);
+                }
+                _ => {}
+            }
+        }
+        Ok(object)
+    }
+}
+
+impl<'de> Deserialize<'de> for LazyObject<'de> {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> std::result::Result<Self, D::Error> {
+        struct LazyVisitor;
+
+        impl<'de> Visitor<'de> for LazyVisitor {
+            type Value = LazyObject<'de>;
+
+            fn expecting(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                f.write_str("a JSON-LD object")
+            }
+
+            fn visit_map<A: MapAccess<'de>>(
+                self,
+                mut map: A,
+            ) -> std::result::Result<LazyObject<'de>, A::Error> {
+                let mut object = LazyObject { type_: None, graph: None, entries: Vec::new() };
+                while let Some(Key(key)) = map.next_key()? {
+                    match &*key {
+                        "@type" => object.type_ = map.next_value()?,
+                        "@graph" => object.graph = map.next_value()?,
+                        _ => object.entries.push((key, map.next_value()?)),
                     }
-                    _ => false,
                 }
-            } else {
-                false
+                Ok(object)
             }
-        })
-        .collect();
+        }
+
+        deserializer.deserialize_map(LazyVisitor)
+    }
+}
+
+/// An object key, borrowed from the input unless it contains escapes
+struct Key<'a>(Cow<'a, str>);
 
-    Ok(filtered)
+impl<'de> Deserialize<'de> for Key<'de> {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> std::result::Result<Self, D::Error> {
+        struct KeyVisitor;
+
+        impl<'de> Visitor<'de> for KeyVisitor {
+            type Value = Key<'de>;
+
+            fn expecting(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                f.write_str("a string")
+            }
+
+            fn visit_borrowed_str<E: de::Error>(
+                self,
+                s: &'de str,
+            ) -> std::result::Result<Key<'de>, E> {
+                Ok(Key(Cow::Borrowed(s)))
+            }
+
+            fn visit_str<E: de::Error>(self, s: &str) -> std::result::Result<Key<'de>, E> {
+                Ok(Key(Cow::Owned(s.to_string())))
+            }
+        }
+
+        deserializer.deserialize_str(KeyVisitor)
+    }
 }
@@ -1,6 +1,9 @@
 //! Tests for JSON-LD extraction
 
-use crate::extractors::jsonld::{extract, extract_by_type};
+use crate::extractors::common::html_utils;
+use crate::extractors::jsonld::{
+    extract, extract_by_type, extract_from_document_limited, filter_script, Filter,
+};
 
 #[cfg(test)]
 mod jsonld_tests {
@@ -752,4 +755,77 @@ mod jsonld_tests {
         let objects = extract(html, None).unwrap();
         assert_eq!(objects.len(), 1);
     }
+
+    #[test]
+    fn test_extract_top_level_array() {
+        let html = r#"
+            <script type="application/ld+json">
+            [{"@type": "Organization"}, {"@graph": [{"@type": "A"}, {"@type": "B"}]}]
+            </script>
+        "#;
+
+        let objects = extract(html, None).unwrap();
+        assert_eq!(objects.len(), 3);
+        assert!(objects.iter().all(|o| o.graph.is_none()));
+    }
+
+    #[test]
+    fn test_extract_counts_invalid_scripts() {
+        let html = r#"
+            <script type="application/ld+json">{"@type": "Article"}</script>
+            <script type="application/ld+json">{ broken</script>
+            <script type="application/ld+json">"just a string"</script>
+        "#;
+
+        let found =
+            extract_from_document_limited(&html_utils::parse_html(html), usize::MAX).unwrap();
+        assert_eq!(found.objects.len(), 1);
+        assert_eq!(found.invalid, 2);
+        assert_eq!(found.oversized, 0);
+    }
+
+    #[test]
+    fn test_filter_keeps_matching_graph_members() {
+        let json = r##"{"@context": "https://schema.org", "@graph": [
+            {"@type": "ItemList", "itemListElement": [{"@type": "Product", "name": "Nested"}]},
+            {"@type": ["Product", "Thing"], "@id": "#p", "name": "Shoe", "sku": "S1"},
+            {"@type": "BreadcrumbList", "itemListElement": []}
+        ]}"##;
+
+        let filter = Filter { types: &["Product", "BreadcrumbList"], properties: None };
+        let objects = filter_script(json, &filter).unwrap();
+        assert_eq!(objects.len(), 2);
+        assert_eq!(objects[0].id.as_deref(), Some("#p"));
+        assert_eq!(objects[0].properties.len(), 2);
+        assert_eq!(objects[1].type_.as_ref().unwrap(), "BreadcrumbList");
+    }
+
+    #[test]
+    fn test_filter_projects_properties() {
+        let json = r#"[{"@context": "https://schema.org", "@type": "Product",
+            "name": "Shoe", "offers": {"price": 10}, "review": [1, 2, 3]},
+            {"@type": "Article", "headline": "Skipped"}]"#;
+
+        let filter = Filter { types: &["Product"], properties: Some(&["name", "offers"]) };
+        let objects = filter_script(json, &filter).unwrap();
+        assert_eq!(objects.len(), 1);
+        let product = &objects[0];
+        assert!(product.context.is_some());
+        assert_eq!(product.properties["name"], "Shoe");
+        assert_eq!(product.properties["offers"]["price"], 10);
+        assert!(!product.properties.contains_key("review"));
+    }
+
+    #[test]
+    fn test_filter_empty_types_keeps_everything() {
+        let json = r#"{"@type": "Article", "headl\u0069ne": "Escaped key"}"#;
+
+        let objects = filter_script(json, &Filter::default()).unwrap();
+        assert_eq!(objects.len(), 1);
+        assert_eq!(objects[0].properties["headline"], "Escaped key");
+
+        let none = filter_script(json, &Filter { types: &["Product"], properties: None });
+        assert!(none.unwrap().is_empty());
+        assert!(filter_script("{ broken", &Filter::default()).is_err());
+    }
 }
@@ -4,8 +4,11 @@
 //! Handles link discovery and JSON parsing with URL resolution.
 
 use crate::errors::{MicroformatError, Result};
-use crate::extractors::common::{html_utils, url_utils};
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
+use crate::extractors::head::{self, HeadTags};
 use crate::types::manifest::{ManifestDiscovery, WebAppManifest};
+use scraper::Html;
 
 #[cfg(test)]
 mod tests;
@@ -30,18 +33,42 @@ mod tests;
 /// assert_eq!(discovery.href, Some("https://example.com/manifest.json".to_string()));
 /// ```
 pub fn extract_link(html: &str, base_url: Option<&str>) -> Result<ManifestDiscovery> {
-    let doc = html_utils::parse_html(html);
+    extract_link_from_document(&html_utils::parse_html(html), base_url)
+}
 
+/// Extract manifest link from an already parsed document
+///
+/// # Arguments
+/// * `doc` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<ManifestDiscovery>` - Discovery result with href or error
+pub fn extract_link_from_document(doc: &Html, base_url: Option<&str>) -> Result<ManifestDiscovery> {
+    extract_link_from_head(&head::scan(doc), &BaseUrl::for_document(doc, base_url))
+}
+
+/// Extract manifest link from pre-scanned head tags
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<ManifestDiscovery>` - Discovery result with href or error
+pub fn extract_link_from_head(head: &HeadTags, base: &BaseUrl) -> Result<ManifestDiscovery> {
     // Find <link rel="manifest" href="...">
-    let selector = html_utils::create_selector("link[rel=manifest][href]")?;
+    let manifest_link = head
+        .links()
+        .find(|e| e.value().attr("rel").is_some_and(|rel| rel.eq_ignore_ascii_case("manifest")));
 
-    if let Some(link) = doc.select(&selector).next() {
-        if let Some(href) = html_utils::get_attr(&link, "href") {
-            // Resolve URL if base_url is provided
-            let resolved = if let Some(base) = base_url {
-                url_utils::resolve_url(Some(base), &href).map_err(MicroformatError::InvalidUrl)?
+    if let Some(link) = manifest_link {
+        if let Some(href) = html_utils::attr(link, "href") {
+            // Resolve URL if a base URL is known
+            let resolved = if base.as_str().is_some() {
+                base.resolve(href).map_err(MicroformatError::InvalidUrl)?
             } else {
-                href
+                href.to_string()
             };
 
             return Ok(ManifestDiscovery { href: Some(resolved), manifest: None });
@@ -77,42 +104,44 @@ pub fn parse_manifest(json: &str, base_url: Option<&str>) -> Result<WebAppManife
         .map_err(|e| MicroformatError::ParseError(format!("Invalid manifest JSON: {}", e)))?;
 
     // Resolve relative URLs in the manifest
-    if let Some(base) = base_url {
+    if base_url.is_some() {
+        let base = BaseUrl::new(base_url);
+
         // Resolve start_url
         if let Some(ref start_url) = manifest.start_url {
-            if let Ok(resolved) = url_utils::resolve_url(Some(base), start_url) {
+            if let Ok(resolved) = base.resolve(start_url) {
                 manifest.start_url = Some(resolved);
             }
         }
 
         // Resolve scope
         if let Some(ref scope) = manifest.scope {
-            if let Ok(resolved) = url_utils::resolve_url(Some(base), scope) {
+            if let Ok(resolved) = base.resolve(scope) {
                 manifest.scope = Some(resolved);
             }
         }
 
         // Resolve icon URLs
         for icon in &mut manifest.icons {
-            if let Ok(resolved) = url_utils::resolve_url(Some(base), &icon.src) {
+            if let Ok(resolved) = base.resolve(&icon.src) {
                 icon.src = resolved;
             }
         }
 
         // Resolve screenshot URLs
         for screenshot in &mut manifest.screenshots {
-            if let Ok(resolved) = url_utils::resolve_url(Some(base), &screenshot.src) {
+            if let Ok(resolved) = base.resolve(&screenshot.src) {
                 screenshot.src = resolved;
             }
         }
 
         // Resolve shortcut URLs and icons
         for shortcut in &mut manifest.shortcuts {
-            if let Ok(resolved) = url_utils::resolve_url(Some(base), &shortcut.url) {
+            if let Ok(resolved) = base.resolve(&shortcut.url) {
                 shortcut.url = resolved;
             }
             for icon in &mut shortcut.icons {
-                if let Ok(resolved) = url_utils::resolve_url(Some(base), &icon.src) {
+                if let Ok(resolved) = base.resolve(&icon.src) {
                     icon.src = resolved;
                 }
             }
@@ -121,7 +150,7 @@ pub fn parse_manifest(json: &str, base_url: Option<&str>) -> Result<WebAppManife
         // Resolve related application URLs
         for app in &mut manifest.related_applications {
             if let Some(ref url) = app.url {
-                if let Ok(resolved) = url_utils::resolve_url(Some(base), url) {
+                if let Ok(resolved) = base.resolve(url) {
                     app.url = Some(resolved);
                 }
             }
@@ -146,6 +175,30 @@ pub fn extract(html: &str, base_url: Option<&str>) -> Result<ManifestDiscovery>
     extract_link(html, base_url)
 }
 
+/// Extract manifest link from an already parsed document (alias for extract_link_from_document)
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<ManifestDiscovery>` - Discovery result with href
+pub fn extract_from_document(document: &Html, base_url: Option<&str>) -> Result<ManifestDiscovery> {
+    extract_link_from_document(document, base_url)
+}
+
+/// Extract manifest link from pre-scanned head tags (alias for extract_link_from_head)
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<ManifestDiscovery>` - Discovery result with href
+pub fn extract_from_head(head: &HeadTags, base: &BaseUrl) -> Result<ManifestDiscovery> {
+    extract_link_from_head(head, base)
+}
+
 #[cfg(test)]
 mod unit_tests {
     use super::*;
@@ -72,6 +72,13 @@ mod meta_extraction_tests {
         assert_eq!(meta.canonical, Some("https://example.com/page".to_string()));
     }
 
+    #[test]
+    fn test_extract_canonical_against_base_href() {
+        let html = r#"<head><base href="/docs/"><link rel="canonical" href="page"></head>"#;
+        let meta = extract(html, Some("https://example.com/a/b")).unwrap();
+        assert_eq!(meta.canonical, Some("https://example.com/docs/page".to_string()));
+    }
+
     #[test]
     fn test_extract_alternate_link() {
         let html = r#"<link rel="alternate" href="https://example.com/es" hreflang="es">"#;
@@ -4,9 +4,11 @@
 //! with Schema.org vocabulary.
 
 use crate::errors::Result;
-use crate::extractors::common::{html_utils, url_utils};
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
 use crate::types::microdata::MicrodataItem;
-use scraper::{ElementRef, Selector};
+use scraper::{ElementRef, Html};
+use std::collections::{HashMap, HashSet};
 
 #[cfg(test)]
 mod tests;
@@ -22,130 +24,202 @@ mod tests;
 /// # Returns
 /// * `Result<Vec<MicrodataItem>>` - All microdata items found
 pub fn extract(html: &str, base_url: Option<&str>) -> Result<Vec<MicrodataItem>> {
-    let document = html_utils::parse_html(html);
-    let mut items = Vec::new();
+    extract_from_document(&html_utils::parse_html(html), base_url)
+}
 
-    // Find all top-level itemscope elements (not nested)
-    let itemscope_selector = Selector::parse("[itemscope]").unwrap();
+/// Extract all microdata items from an already parsed document
+///
+/// Properties are assigned to scopes in one pass over the document (see
+/// [`ScopeTree`]), so the cost is linear in the document size however deeply
+/// the items are nested.
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<Vec<MicrodataItem>>` - All microdata items found
+pub fn extract_from_document(
+    document: &Html,
+    base_url: Option<&str>,
+) -> Result<Vec<MicrodataItem>> {
+    extract_with_base(document, &BaseUrl::for_document(document, base_url))
+}
 
-    for element in document.select(&itemscope_selector) {
-        // Skip if this is a nested itemscope (will be handled as property)
-        if !is_top_level_itemscope(&element) {
-            continue;
-        }
+/// Extract all microdata items from an already parsed document whose base
+/// URL is known
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<Vec<MicrodataItem>>` - All microdata items found
+pub fn extract_with_base(document: &Html, base: &BaseUrl) -> Result<Vec<MicrodataItem>> {
+    let tree = ScopeTree::build(document);
+    let mut building = vec![false; tree.scopes.len()];
 
-        if let Ok(item) = extract_item(&element, base_url) {
-            items.push(item);
-        }
-    }
+    Ok(tree.roots.iter().map(|&scope| tree.item(scope, base, &mut building)).collect())
+}
 
-    Ok(items)
+/// Every `itemscope` of a document with the properties assigned to it
+///
+/// An `itemprop` belongs to its nearest enclosing `itemscope`, plus any scope
+/// whose `itemref` names it or one of its ancestors. An `itemscope` that is
+/// not itself a property of another scope is a top-level item.
+struct ScopeTree<'a> {
+    scopes: Vec<Scope<'a>>,
+    /// Top-level scopes in document order
+    roots: Vec<usize>,
 }
 
-/// Check if an itemscope element is top-level (not nested in another itemscope)
-fn is_top_level_itemscope(element: &ElementRef) -> bool {
-    // Check if any ancestor has itemscope attribute and this element has itemprop
-    // If so, this is a nested item and should not be extracted at top level
-    if element.value().attr("itemprop").is_some() {
-        // This element has itemprop, check if there's a parent itemscope
-        let mut parent = element.parent();
-        while let Some(node) = parent {
-            if let Some(parent_element) = ElementRef::wrap(node) {
-                if parent_element.value().attr("itemscope").is_some() {
-                    // Found parent with itemscope, this is nested
-                    return false;
-                }
-            }
-            parent = node.parent();
-        }
-    }
-    true
+struct Scope<'a> {
+    element: ElementRef<'a>,
+    /// Properties in document order
+    props: Vec<Prop<'a>>,
 }
 
-/// Extract a single microdata item from an element
-fn extract_item(element: &ElementRef, base_url: Option<&str>) -> Result<MicrodataItem> {
-    let mut item = MicrodataItem::new();
+struct Prop<'a> {
+    element: ElementRef<'a>,
+    /// The element's own scope when the property is a nested item
+    scope: Option<usize>,
+}
 
-    // Extract itemtype
-    if let Some(itemtype_str) = element.value().attr("itemtype") {
-        let types: Vec<String> = itemtype_str.split_whitespace().map(|s| s.to_string()).collect();
-        if !types.is_empty() {
-            item.item_type = Some(types);
-        }
-    }
+impl<'a> ScopeTree<'a> {
+    fn build(document: &'a Html) -> Self {
+        let mut tree = ScopeTree { scopes: Vec::new(), roots: Vec::new() };
+        let mut has_refs = false;
 
-    // Extract itemid
-    if let Some(itemid) = element.value().attr("itemid") {
-        item.id = Some(itemid.to_string());
-    }
+        // Depth-first in document order, carrying the innermost enclosing scope
+        let mut stack = vec![(document.tree.root(), None::<usize>)];
+        while let Some((node, owner)) = stack.pop() {
+            let mut inner = owner;
 
-    // Extract properties (itemprop children)
-    extract_properties(element, &mut item, base_url)?;
+            if let Some(element) = ElementRef::wrap(node) {
+                let is_prop = element.value().attr("itemprop").is_some();
 
-    Ok(item)
-}
+                if element.value().attr("itemscope").is_some() {
+                    let index = tree.scopes.len();
+                    tree.scopes.push(Scope { element, props: Vec::new() });
+                    has_refs |= element.value().attr("itemref").is_some();
 
-/// Extract all properties from an itemscope element
-fn extract_properties(
-    scope: &ElementRef,
-    item: &mut MicrodataItem,
-    base_url: Option<&str>,
-) -> Result<()> {
-    // Find all descendants with itemprop attribute within this scope
-    for descendant in scope.descendants() {
-        if let Some(element) = ElementRef::wrap(descendant) {
-            if let Some(prop_name) = element.value().attr("itemprop") {
-                // Check if this property belongs to this scope or a nested scope
-                if belongs_to_scope(scope, &element) {
-                    // Extract property value
-                    if element.value().attr("itemscope").is_some() {
-                        // This is a nested item
-                        if let Ok(nested_item) = extract_item(&element, base_url) {
-                            item.add_item_property(prop_name.to_string(), nested_item);
-                        }
-                    } else {
-                        // This is a text/URL property
-                        if let Some(value) = extract_property_value(&element, base_url) {
-                            item.add_text_property(prop_name.to_string(), value);
+                    match owner {
+                        Some(owner) if is_prop => {
+                            tree.scopes[owner].props.push(Prop { element, scope: Some(index) })
                         }
+                        _ => tree.roots.push(index),
                     }
+                    inner = Some(index);
+                } else if let (true, Some(owner)) = (is_prop, owner) {
+                    tree.scopes[owner].props.push(Prop { element, scope: None });
                 }
             }
+
+            stack.extend(node.children().rev().map(|child| (child, inner)));
+        }
+
+        if has_refs {
+            tree.resolve_refs(document);
         }
+        tree
     }
 
-    Ok(())
-}
+    /// Add the properties found under the elements named by `itemref`
+    fn resolve_refs(&mut self, document: &'a Html) {
+        let scope_of: HashMap<_, usize> =
+            self.scopes.iter().enumerate().map(|(i, scope)| (scope.element.id(), i)).collect();
+
+        // Element ids, and the document position of every property
+        let mut ids = HashMap::new();
+        let mut position = HashMap::new();
+        for (pos, node) in document.tree.root().descendants().enumerate() {
+            if let Some(element) = ElementRef::wrap(node) {
+                if let Some(id) = element.value().id() {
+                    ids.entry(id).or_insert(element);
+                }
+                if element.value().attr("itemprop").is_some() {
+                    position.insert(node.id(), pos);
+                }
+            }
+        }
 
-/// Check if an itemprop element belongs to the given scope
-fn belongs_to_scope(scope: &ElementRef, prop_element: &ElementRef) -> bool {
-    // The property belongs to this scope if there's no intervening itemscope
-    // between scope and prop_element
+        for index in 0..self.scopes.len() {
+            let scope = &self.scopes[index];
+            let Some(refs) = scope.element.value().attr("itemref") else {
+                continue;
+            };
+
+            let mut seen: HashSet<_> = scope.props.iter().map(|p| p.element.id()).collect();
+            seen.insert(scope.element.id());
+            let mut found = Vec::new();
+
+            for target in refs.split_whitespace().filter_map(|id| ids.get(id)) {
+                let mut stack = vec![*target];
+                while let Some(element) = stack.pop() {
+                    if element.value().attr("itemprop").is_some() && seen.insert(element.id()) {
+                        let scope = scope_of.get(&element.id()).copied();
+                        found.push(Prop { element, scope });
+                    }
+                    // A nested scope's own properties belong to it
+                    if element.value().attr("itemscope").is_none() {
+                        stack.extend(element.children().rev().filter_map(ElementRef::wrap));
+                    }
+                }
+            }
 
-    let scope_id = scope.id();
-    let mut current = prop_element.parent();
+            if !found.is_empty() {
+                let props = &mut self.scopes[index].props;
+                props.extend(found);
+                props.sort_by_key(|p| position.get(&p.element.id()).copied());
+            }
+        }
+    }
 
-    while let Some(node) = current {
-        if let Some(element) = ElementRef::wrap(node) {
-            // If we reached the scope, property belongs to it
-            if element.id() == scope_id {
-                return true;
+    /// Build the item of one scope; `building` breaks `itemref` cycles
+    fn item(&self, index: usize, base: &BaseUrl, building: &mut [bool]) -> MicrodataItem {
+        let scope = &self.scopes[index];
+        let mut item = MicrodataItem::new();
+        building[index] = true;
+
+        // Extract itemtype
+        if let Some(itemtype_str) = scope.element.value().attr("itemtype") {
+            let types: Vec<String> =
+                itemtype_str.split_whitespace().map(|s| s.to_string()).collect();
+            if !types.is_empty() {
+                item.item_type = Some(types);
             }
+        }
 
-            // If we hit another itemscope before reaching our scope,
-            // this property belongs to that nested scope instead
-            if element.value().attr("itemscope").is_some() && element.id() != scope_id {
-                return false;
+        // Extract itemid
+        if let Some(itemid) = scope.element.value().attr("itemid") {
+            item.id = Some(itemid.to_string());
+        }
+
+        for prop in &scope.props {
+            let Some(prop_name) = prop.element.value().attr("itemprop") else {
+                continue;
+            };
+            match prop.scope {
+                Some(nested) if !building[nested] => {
+                    let nested_item = self.item(nested, base, building);
+                    item.add_item_property(prop_name.to_string(), nested_item);
+                }
+                Some(_) => {}
+                None => {
+                    if let Some(value) = extract_property_value(&prop.element, base) {
+                        item.add_text_property(prop_name.to_string(), value);
+                    }
+                }
             }
         }
-        current = node.parent();
-    }
 
-    false
+        building[index] = false;
+        item
+    }
 }
 
 /// Extract the value of a property element
-fn extract_property_value(element: &ElementRef, base_url: Option<&str>) -> Option<String> {
+fn extract_property_value(element: &ElementRef, base: &BaseUrl) -> Option<String> {
     let tag_name = element.value().name();
 
     // Get value based on element type
@@ -187,7 +261,7 @@ fn extract_property_value(element: &ElementRef, base_url: Option<&str>) -> Optio
 
     // Resolve relative URLs if needed
     if is_url_property(tag_name, element) {
-        if let Ok(resolved) = url_utils::resolve_url(base_url, &value) {
+        if let Ok(resolved) = base.resolve(&value) {
             return Some(resolved);
         }
     }
@@ -206,6 +280,7 @@ fn is_url_property(tag_name: &str, element: &ElementRef) -> bool {
 #[cfg(test)]
 mod unit_tests {
     use super::*;
+    use scraper::Selector;
 
     #[test]
     fn test_is_url_property() {
@@ -223,7 +298,7 @@ mod unit_tests {
         let selector = Selector::parse("span").unwrap();
         let element = html.select(&selector).next().unwrap();
 
-        let value = extract_property_value(&element, None);
+        let value = extract_property_value(&element, &BaseUrl::default());
         assert_eq!(value, Some("Test Value".to_string()));
     }
 
@@ -233,7 +308,7 @@ mod unit_tests {
         let selector = Selector::parse("meta").unwrap();
         let element = html.select(&selector).next().unwrap();
 
-        let value = extract_property_value(&element, None);
+        let value = extract_property_value(&element, &BaseUrl::default());
         assert_eq!(value, Some("test".to_string()));
     }
 
@@ -243,7 +318,7 @@ mod unit_tests {
         let selector = Selector::parse("link").unwrap();
         let element = html.select(&selector).next().unwrap();
 
-        let value = extract_property_value(&element, None);
+        let value = extract_property_value(&element, &BaseUrl::default());
         assert_eq!(value, Some("https://example.com/".to_string()));
     }
 }
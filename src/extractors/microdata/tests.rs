@@ -391,3 +391,74 @@ fn test_extract_mixed_with_regular_content() {
     let items = extract(html, None).unwrap();
     assert_eq!(items.len(), 1);
 }
+
+#[test]
+fn test_extract_itemref() {
+    let html = r#"
+    <div itemscope itemtype="https://schema.org/Product" itemref="brand offer">
+        <span itemprop="name">Widget</span>
+    </div>
+    <div itemscope itemtype="https://schema.org/Product" itemref="brand">
+        <span itemprop="name">Gadget</span>
+    </div>
+    <p id="brand">Made by <span itemprop="brand">Acme</span></p>
+    <div id="offer" itemprop="offers" itemscope itemtype="https://schema.org/Offer">
+        <span itemprop="price">9.99</span>
+    </div>
+    "#;
+
+    let items = extract(html, None).unwrap();
+    // The referenced offer is not nested in another scope, so it is also top-level
+    assert_eq!(items.len(), 3);
+
+    for item in &items[..2] {
+        match &item.properties.get("brand").unwrap()[0] {
+            PropertyValue::Text(s) => assert_eq!(s, "Acme"),
+            _ => panic!("Expected text"),
+        }
+    }
+    match &items[0].properties.get("offers").unwrap()[0] {
+        PropertyValue::Item(offer) => assert!(offer.properties.contains_key("price")),
+        _ => panic!("Expected nested item"),
+    }
+    assert!(!items[1].properties.contains_key("offers"));
+}
+
+#[test]
+fn test_extract_itemref_cycle() {
+    let html = r#"
+    <div id="a" itemscope itemprop="child" itemref="b"><span itemprop="name">A</span></div>
+    <div id="b" itemscope itemprop="child" itemref="a"><span itemprop="name">B</span></div>
+    "#;
+
+    let items = extract(html, None).unwrap();
+    assert_eq!(items.len(), 2);
+    match &items[0].properties.get("child").unwrap()[0] {
+        PropertyValue::Item(b) => assert!(!b.properties.contains_key("child")),
+        _ => panic!("Expected nested item"),
+    }
+}
+
+#[test]
+fn test_extract_many_nested_scopes() {
+    let offer = r#"<li itemprop="itemListElement" itemscope itemtype="https://schema.org/Product">
+        <span itemprop="name">P</span>
+        <div itemprop="offers" itemscope><span itemprop="price">1</span></div>
+    </li>"#;
+    let html = format!(
+        r#"<ul itemscope itemtype="https://schema.org/ItemList">{}</ul>"#,
+        offer.repeat(500)
+    );
+
+    let items = extract(&html, None).unwrap();
+    assert_eq!(items.len(), 1);
+    let products = items[0].properties.get("itemListElement").unwrap();
+    assert_eq!(products.len(), 500);
+    match &products[499] {
+        PropertyValue::Item(product) => {
+            assert!(product.properties.contains_key("offers"));
+            assert!(!product.properties.contains_key("price"));
+        }
+        _ => panic!("Expected nested item"),
+    }
+}
@@ -11,6 +11,9 @@
 
 pub mod common;
 
+// Single-pass scanner shared by the head-level extractors
+pub mod head;
+
 // Phase 1: Standard Meta Tags (100% adoption) - IMPLEMENTED
 pub mod meta;
 
@@ -4,8 +4,11 @@
 //! oEmbed is used by platforms like YouTube, Vimeo, Twitter, etc.
 
 use crate::errors::Result;
-use crate::extractors::common::{html_utils, url_utils};
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
+use crate::extractors::head::{self, HeadTags};
 use crate::types::oembed::{OEmbedDiscovery, OEmbedEndpoint, OEmbedFormat};
+use scraper::{ElementRef, Html};
 
 #[cfg(test)]
 mod tests;
@@ -19,43 +22,61 @@ mod tests;
 /// # Returns
 /// * `Result<OEmbedDiscovery>` - Discovered oEmbed endpoints or error
 pub fn extract(html: &str, base_url: Option<&str>) -> Result<OEmbedDiscovery> {
-    let document = html_utils::parse_html(html);
+    extract_from_document(&html_utils::parse_html(html), base_url)
+}
+
+/// Discover oEmbed endpoints from an already parsed document
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<OEmbedDiscovery>` - Discovered oEmbed endpoints or error
+pub fn extract_from_document(document: &Html, base_url: Option<&str>) -> Result<OEmbedDiscovery> {
+    extract_from_head(&head::scan(document), &BaseUrl::for_document(document, base_url))
+}
+
+/// Discover oEmbed endpoints from pre-scanned head tags
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<OEmbedDiscovery>` - Discovered oEmbed endpoints or error
+pub fn extract_from_head(head: &HeadTags, base: &BaseUrl) -> Result<OEmbedDiscovery> {
     let mut discovery = OEmbedDiscovery::default();
 
     // Look for link tags with rel="alternate" and type containing "oembed"
-    if let Ok(selector) = html_utils::create_selector("link[rel~=\"alternate\"][type][href]") {
-        for element in document.select(&selector) {
-            if let (Some(link_type), Some(href)) =
-                (html_utils::get_attr(&element, "type"), html_utils::get_attr(&element, "href"))
-            {
-                // Skip empty href attributes
-                if href.trim().is_empty() {
-                    continue;
-                }
-
-                let resolved_href = url_utils::resolve_url(base_url, &href).unwrap_or(href.clone());
-                let title = html_utils::get_attr(&element, "title");
+    for element in head.links().filter(|e| is_alternate(e)) {
+        if let (Some(link_type), Some(href)) =
+            (html_utils::attr(element, "type"), html_utils::attr(element, "href"))
+        {
+            // Skip empty href attributes
+            if href.trim().is_empty() {
+                continue;
+            }
 
-                // Check for oEmbed types
-                let link_type_lower = link_type.to_lowercase();
-                if link_type_lower.contains("oembed") {
-                    let endpoint = OEmbedEndpoint {
-                        href: resolved_href,
-                        format: if link_type_lower.contains("json") {
-                            OEmbedFormat::Json
-                        } else if link_type_lower.contains("xml") {
-                            OEmbedFormat::Xml
-                        } else {
-                            // Default to JSON if ambiguous
-                            OEmbedFormat::Json
-                        },
-                        title,
-                    };
+            // Check for oEmbed types
+            let link_type_lower = html_utils::ascii_lowercase(link_type);
+            if link_type_lower.contains("oembed") {
+                let endpoint = OEmbedEndpoint {
+                    href: base.resolve(href).unwrap_or_else(|_| href.to_string()),
+                    format: if link_type_lower.contains("json") {
+                        OEmbedFormat::Json
+                    } else if link_type_lower.contains("xml") {
+                        OEmbedFormat::Xml
+                    } else {
+                        // Default to JSON if ambiguous
+                        OEmbedFormat::Json
+                    },
+                    title: html_utils::get_attr(element, "title"),
+                };
 
-                    match endpoint.format {
-                        OEmbedFormat::Json => discovery.json_endpoints.push(endpoint),
-                        OEmbedFormat::Xml => discovery.xml_endpoints.push(endpoint),
-                    }
+                match endpoint.format {
+                    OEmbedFormat::Json => discovery.json_endpoints.push(endpoint),
+                    OEmbedFormat::Xml => discovery.xml_endpoints.push(endpoint),
                 }
             }
         }
@@ -63,3 +84,10 @@ pub fn extract(html: &str, base_url: Option<&str>) -> Result<OEmbedDiscovery> {
 
     Ok(discovery)
 }
+
+/// Check whether a link's `rel` contains the `alternate` token (`[rel~="alternate"]`)
+fn is_alternate(element: &ElementRef) -> bool {
+    element.value().attr("rel").is_some_and(|rel| {
+        rel.split_ascii_whitespace().any(|t| t.eq_ignore_ascii_case("alternate"))
+    })
+}
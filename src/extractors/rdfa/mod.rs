@@ -4,10 +4,12 @@
 //! RDFa is a W3C standard with 62% desktop adoption.
 
 use crate::errors::Result;
-use crate::extractors::common::{html_utils, url_utils};
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
 use crate::types::rdfa::{RdfaItem, RdfaValue};
 use scraper::{ElementRef, Html};
 use std::collections::HashMap;
+use std::rc::Rc;
 
 #[cfg(test)]
 mod tests;
@@ -100,173 +102,197 @@ impl PrefixContext {
 /// assert_eq!(items.len(), 1);
 /// ```
 pub fn extract(html: &str, base_url: Option<&str>) -> Result<Vec<RdfaItem>> {
-    let doc = html_utils::parse_html(html);
-    let mut items = Vec::new();
+    extract_from_document(&html_utils::parse_html(html), base_url)
+}
+
+/// Extract all RDFa items from an already parsed document
+///
+/// The document is walked once, depth first, carrying the prefixes and
+/// vocabulary in scope and the innermost enclosing item, so the cost is
+/// linear in the document size however deeply the items are nested.
+///
+/// # Arguments
+/// * `doc` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<Vec<RdfaItem>>` - List of extracted RDFa items or error
+pub fn extract_from_document(doc: &Html, base_url: Option<&str>) -> Result<Vec<RdfaItem>> {
+    extract_with_base(doc, &BaseUrl::for_document(doc, base_url))
+}
 
-    // Create prefix context with default prefixes
-    let mut prefix_ctx = PrefixContext::new();
+/// Extract all RDFa items from an already parsed document whose base URL is
+/// known
+///
+/// # Arguments
+/// * `doc` - The parsed HTML document
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<Vec<RdfaItem>>` - List of extracted RDFa items or error
+pub fn extract_with_base(doc: &Html, base: &BaseUrl) -> Result<Vec<RdfaItem>> {
+    // Top-level items in document order; a slot is reserved when an item
+    // opens and filled when it closes
+    let mut roots: Vec<Option<RdfaItem>> = Vec::new();
+    let mut open: Vec<OpenItem> = Vec::new();
+
+    let mut stack = vec![Step::Enter(doc.root_element(), Rc::new(PrefixContext::new()), None)];
+    while let Some(step) = stack.pop() {
+        let (element, mut prefixes, mut vocab) = match step {
+            Step::Enter(element, prefixes, vocab) => (element, prefixes, vocab),
+            Step::Leave => {
+                if let Some(done) = open.pop() {
+                    close(done, &mut open, &mut roots);
+                }
+                continue;
+            }
+        };
 
-    // Collect all prefix definitions from the document
-    let prefix_selector = html_utils::create_selector("[prefix]")?;
-    for element in doc.select(&prefix_selector) {
-        if let Some(prefix_attr) = html_utils::get_attr(&element, "prefix") {
-            prefix_ctx.parse_prefix_attr(&prefix_attr);
+        // Prefixes declared here apply to this element and its descendants
+        if let Some(prefix_attr) = html_utils::attr(&element, "prefix") {
+            Rc::make_mut(&mut prefixes).parse_prefix_attr(prefix_attr);
         }
-    }
+        let own_vocab = html_utils::attr(&element, "vocab");
+        vocab = own_vocab.or(vocab);
+        let property = html_utils::attr(&element, "property");
+
+        if let Some(type_attr) = html_utils::attr(&element, "typeof") {
+            // With a property inside another item this item is that
+            // property's value, otherwise it is a top-level item
+            let property = property.filter(|_| !open.is_empty());
+            let slot = property.is_none().then(|| {
+                roots.push(None);
+                roots.len() - 1
+            });
+            open.push(OpenItem {
+                item: new_item(&element, type_attr, vocab, base, &prefixes),
+                property: property.map(|name| prefixes.expand_curie(name)),
+                slot,
+                typed: true,
+            });
+            stack.push(Step::Leave);
+        } else {
+            if let (Some(name), Some(owner)) = (property, open.last_mut()) {
+                let value = extract_property_value_with_context(&element, base, &prefixes);
+                owner.item.properties.entry(prefixes.expand_curie(name)).or_default().push(value);
+            }
 
-    // Find all RDFa root elements (elements with typeof or vocab)
-    let roots = find_rdfa_roots(&doc)?;
+            // A vocabulary outside any item gathers the properties below
+            // it into an untyped item, dropped if it finds none
+            if let (Some(vocab), true) = (own_vocab, open.is_empty()) {
+                roots.push(None);
+                open.push(OpenItem {
+                    item: RdfaItem::new().with_vocab(vocab.to_string()),
+                    property: None,
+                    slot: Some(roots.len() - 1),
+                    typed: false,
+                });
+                stack.push(Step::Leave);
+            }
+        }
 
-    for root in roots {
-        let item = extract_item_with_context(&root, base_url, &prefix_ctx)?;
-        items.push(item);
+        let children = element.children().rev().filter_map(ElementRef::wrap);
+        stack.extend(children.map(|child| Step::Enter(child, prefixes.clone(), vocab)));
     }
 
-    Ok(items)
+    Ok(roots.into_iter().flatten().collect())
 }
 
-/// Find all RDFa root elements in the document
-///
-/// Root elements are those with `typeof` or `vocab` attributes
-fn find_rdfa_roots(doc: &Html) -> Result<Vec<ElementRef<'_>>> {
-    let mut roots = Vec::new();
-
-    // Find elements with typeof attribute (type declaration)
-    let typeof_selector = html_utils::create_selector("[typeof]")?;
-    for element in doc.select(&typeof_selector) {
-        // Only add if not nested within another typeof (we'll handle nesting later)
-        if !is_nested_typeof(&element) {
-            roots.push(element);
-        }
-    }
-
-    // Find elements with vocab attribute that don't have typeof
-    let vocab_selector = html_utils::create_selector("[vocab]:not([typeof])")?;
-    for element in doc.select(&vocab_selector) {
-        // Only add if not already in roots
-        if !roots.iter().any(|r| r.id() == element.id()) {
-            roots.push(element);
-        }
-    }
+/// One step of the document walk
+enum Step<'a> {
+    /// Visit an element with the prefixes and vocabulary in scope at it
+    Enter(ElementRef<'a>, Rc<PrefixContext>, Option<&'a str>),
+    /// Close the innermost open item once its subtree has been visited
+    Leave,
+}
 
-    Ok(roots)
+/// An item whose element is still being walked
+struct OpenItem {
+    item: RdfaItem,
+    /// Property of the enclosing item this item is the value of
+    property: Option<String>,
+    /// Position among the top-level items
+    slot: Option<usize>,
+    /// Whether the item comes from `typeof` rather than a bare `vocab`
+    typed: bool,
 }
 
-/// Check if an element is nested within another typeof element
-fn is_nested_typeof(element: &ElementRef) -> bool {
-    let mut current = element.parent();
-    while let Some(parent) = current {
-        if let Some(parent_elem) = parent.value().as_element() {
-            if parent_elem.attr("typeof").is_some() {
-                return true;
-            }
+/// Attach a finished item to its enclosing item or to its top-level slot
+fn close(done: OpenItem, open: &mut [OpenItem], roots: &mut [Option<RdfaItem>]) {
+    match (done.property, open.last_mut(), done.slot) {
+        (Some(name), Some(owner), _) => {
+            owner
+                .item
+                .properties
+                .entry(name)
+                .or_default()
+                .push(RdfaValue::Item(Box::new(done.item)));
+        }
+        (_, _, Some(slot)) if done.typed || !done.item.properties.is_empty() => {
+            roots[slot] = Some(done.item);
         }
-        current = parent.parent();
+        _ => {}
     }
-    false
 }
 
-/// Extract a single RDFa item from a root element with prefix context
-fn extract_item_with_context(
+/// Create the item declared by an element's `typeof` attribute, without its properties
+fn new_item(
     element: &ElementRef,
-    base_url: Option<&str>,
+    type_attr: &str,
+    vocab: Option<&str>,
+    base: &BaseUrl,
     prefix_ctx: &PrefixContext,
-) -> Result<RdfaItem> {
+) -> RdfaItem {
     let mut item = RdfaItem::new();
 
-    // Extract vocab attribute
-    if let Some(vocab) = html_utils::get_attr(element, "vocab") {
-        item = item.with_vocab(vocab);
+    // Vocabulary in scope, declared here or on an ancestor
+    if let Some(vocab) = vocab {
+        item = item.with_vocab(vocab.to_string());
     }
 
-    // Extract typeof attribute (can be space-separated list of types with CURIEs)
-    if let Some(type_attr) = html_utils::get_attr(element, "typeof") {
-        let types = prefix_ctx.expand_curie_list(&type_attr);
-        if !types.is_empty() {
-            item = item.with_type(types);
-        }
+    // typeof can be a space-separated list of types with CURIEs
+    let types = prefix_ctx.expand_curie_list(type_attr);
+    if !types.is_empty() {
+        item = item.with_type(types);
     }
 
     // Extract about attribute (subject URI, can be CURIE)
-    if let Some(about) = html_utils::get_attr(element, "about") {
+    if let Some(about) = html_utils::attr(element, "about") {
         // First expand CURIE if applicable
-        let expanded = prefix_ctx.expand_curie(&about);
-        // Then resolve URL if base_url is provided
-        let resolved = if let Some(base) = base_url {
-            url_utils::resolve_url(Some(base), &expanded).unwrap_or(expanded)
+        let expanded = prefix_ctx.expand_curie(about);
+        // Then resolve URL if a base URL is known
+        let resolved = if base.as_str().is_some() {
+            base.resolve(&expanded).unwrap_or(expanded)
         } else {
             expanded
         };
         item = item.with_about(resolved);
     }
 
-    // Extract properties from this element and descendants
-    let properties = extract_properties_with_context(element, base_url, prefix_ctx)?;
-    item.properties = properties;
-
-    Ok(item)
-}
-
-/// Extract all properties from an element and its descendants with prefix context
-fn extract_properties_with_context(
-    element: &ElementRef,
-    base_url: Option<&str>,
-    prefix_ctx: &PrefixContext,
-) -> Result<HashMap<String, Vec<RdfaValue>>> {
-    let mut properties: HashMap<String, Vec<RdfaValue>> = HashMap::new();
-
-    // Check if this element has a property attribute (can be CURIE)
-    if let Some(property_name) = html_utils::get_attr(element, "property") {
-        // Expand CURIE in property name
-        let expanded_name = prefix_ctx.expand_curie(&property_name);
-        let value = extract_property_value_with_context(element, base_url, prefix_ctx)?;
-        properties.entry(expanded_name).or_default().push(value);
-    }
-
-    // Recursively extract from children
-    for child in element.children() {
-        if let Some(child_element) = ElementRef::wrap(child) {
-            // Skip nested typeof elements - they will be extracted as separate items
-            if html_utils::get_attr(&child_element, "typeof").is_some() {
-                // This is a nested item
-                if html_utils::get_attr(element, "property").is_some() {
-                    // Parent has property, so this nested item is the value
-                    continue; // Will be handled by extract_property_value_with_context
-                }
-            }
-
-            // Extract properties from child
-            let child_properties =
-                extract_properties_with_context(&child_element, base_url, prefix_ctx)?;
-            for (key, values) in child_properties {
-                properties.entry(key).or_default().extend(values);
-            }
-        }
-    }
-
-    Ok(properties)
+    item
 }
 
 /// Extract the value of a property from an element with prefix context
+///
+/// Elements that also carry `typeof` are nested items and never get here.
 fn extract_property_value_with_context(
     element: &ElementRef,
-    base_url: Option<&str>,
+    base: &BaseUrl,
     prefix_ctx: &PrefixContext,
-) -> Result<RdfaValue> {
+) -> RdfaValue {
     // Priority order for value extraction:
     // 1. content attribute (highest priority)
     // 2. resource, href, src attributes (for URIs, can be CURIEs)
-    // 3. Check for nested typeof (nested item)
-    // 4. Text content (lowest priority)
+    // 3. Text content (lowest priority)
 
     // 1. Check for content attribute override
     if let Some(content) = html_utils::get_attr(element, "content") {
         // Check if there's a datatype attribute (can be CURIE like xsd:integer)
         if let Some(datatype) = html_utils::get_attr(element, "datatype") {
             let expanded_datatype = prefix_ctx.expand_curie(&datatype);
-            return Ok(RdfaValue::TypedLiteral { value: content, datatype: expanded_datatype });
+            return RdfaValue::TypedLiteral { value: content, datatype: expanded_datatype };
         }
-        return Ok(RdfaValue::Literal(content));
+        return RdfaValue::Literal(content);
     }
 
     // 2. Check for resource/href/src attributes (URI values, can be CURIEs)
@@ -274,34 +300,28 @@ fn extract_property_value_with_context(
         if let Some(uri) = html_utils::get_attr(element, attr) {
             // First expand CURIE if applicable
             let expanded = prefix_ctx.expand_curie(&uri);
-            // Then resolve URL if base_url is provided
-            let resolved = if let Some(base) = base_url {
-                url_utils::resolve_url(Some(base), &expanded).unwrap_or(expanded)
+            // Then resolve URL if a base URL is known
+            let resolved = if base.as_str().is_some() {
+                base.resolve(&expanded).unwrap_or(expanded)
             } else {
                 expanded
             };
-            return Ok(RdfaValue::Resource(resolved));
+            return RdfaValue::Resource(resolved);
         }
     }
 
-    // 3. Check for nested typeof (nested RDFa item)
-    if html_utils::get_attr(element, "typeof").is_some() {
-        let nested_item = extract_item_with_context(element, base_url, prefix_ctx)?;
-        return Ok(RdfaValue::Item(Box::new(nested_item)));
-    }
-
-    // 4. Extract text content
+    // 3. Extract text content
     if let Some(text) = html_utils::extract_text(element) {
         // Check if there's a datatype attribute (can be CURIE)
         if let Some(datatype) = html_utils::get_attr(element, "datatype") {
             let expanded_datatype = prefix_ctx.expand_curie(&datatype);
-            return Ok(RdfaValue::TypedLiteral { value: text, datatype: expanded_datatype });
+            return RdfaValue::TypedLiteral { value: text, datatype: expanded_datatype };
         }
-        return Ok(RdfaValue::Literal(text));
+        return RdfaValue::Literal(text);
     }
 
     // Fallback to empty literal
-    Ok(RdfaValue::Literal(String::new()))
+    RdfaValue::Literal(String::new())
 }
 
 #[cfg(test)]
@@ -333,7 +353,6 @@ mod unit_tests {
     }
 
     #[test]
-    #[ignore] // TODO: Fix stack overflow in deeply nested RDFa items
     fn test_extract_multiple_types() {
         let html = r#"<div typeof="Person Employee" property="name">Jane</div>"#;
         let result = extract(html, None).unwrap();
@@ -441,7 +460,6 @@ mod unit_tests {
     }
 
     #[test]
-    #[ignore] // TODO: Fix stack overflow in deeply nested RDFa items
     fn test_extract_nested_typeof() {
         let html = r#"
             <div typeof="Person">
@@ -492,24 +510,61 @@ mod unit_tests {
     }
 
     #[test]
-    fn test_is_nested_typeof() {
+    fn test_nested_typeof_without_property_is_top_level() {
         let html = r#"
             <div typeof="Person">
-                <div typeof="Address" id="nested">Test</div>
+                <span property="name">Jane</span>
+                <div typeof="Place"><span property="name">Springfield</span></div>
             </div>
         "#;
-        let doc = html_utils::parse_html(html);
-        let selector = html_utils::create_selector("#nested").unwrap();
-        let element = doc.select(&selector).next().unwrap();
-        assert!(is_nested_typeof(&element));
+        let result = extract(html, None).unwrap();
+        assert_eq!(result.len(), 2);
+        assert_eq!(result[0].type_of, Some(vec!["Person".to_string()]));
+        assert_eq!(result[0].properties.get("name").unwrap().len(), 1);
+        assert_eq!(result[1].type_of, Some(vec!["Place".to_string()]));
     }
 
     #[test]
-    fn test_is_not_nested_typeof() {
-        let html = r#"<div typeof="Person" id="root">Test</div>"#;
-        let doc = html_utils::parse_html(html);
-        let selector = html_utils::create_selector("#root").unwrap();
-        let element = doc.select(&selector).next().unwrap();
-        assert!(!is_nested_typeof(&element));
+    fn test_prefix_scoped_to_subtree() {
+        let html = r#"
+            <div prefix="ex: http://example.com/" typeof="ex:Thing"></div>
+            <div typeof="ex:Thing"></div>
+        "#;
+        let result = extract(html, None).unwrap();
+        assert_eq!(result[0].type_of, Some(vec!["http://example.com/Thing".to_string()]));
+        assert_eq!(result[1].type_of, Some(vec!["ex:Thing".to_string()]));
+    }
+
+    #[test]
+    fn test_vocab_inherited_by_nested_items() {
+        let html = r#"
+            <div vocab="https://schema.org/">
+                <div typeof="Person"><span property="name">Jane</span></div>
+            </div>
+        "#;
+        let result = extract(html, None).unwrap();
+        assert_eq!(result.len(), 1);
+        assert_eq!(result[0].vocab, Some("https://schema.org/".to_string()));
+    }
+
+    #[test]
+    fn test_extract_deeply_nested_items() {
+        let depth = 200;
+        let html = format!(
+            "{}<span property=\"name\">Leaf</span>{}",
+            r#"<div property="part" typeof="Thing">"#.repeat(depth),
+            "</div>".repeat(depth)
+        );
+        let result = extract(&html, None).unwrap();
+        assert_eq!(result.len(), 1);
+
+        let mut item = &result[0];
+        for _ in 1..depth {
+            match &item.properties.get("part").unwrap()[0] {
+                RdfaValue::Item(nested) => item = nested,
+                _ => panic!("Expected nested item"),
+            }
+        }
+        assert!(item.properties.contains_key("name"));
     }
 }
@@ -17,7 +17,10 @@
 //! - rel-noopener: Security for external links
 
 use crate::errors::Result;
-use crate::extractors::common::{html_utils, url_utils};
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
+use crate::extractors::head::{self, HeadTags};
+use scraper::Html;
 use std::collections::HashMap;
 
 /// Extract rel-* link relationships from HTML
@@ -31,38 +34,65 @@ use std::collections::HashMap;
 /// # Returns
 /// * `Result<HashMap<String, Vec<String>>>` - Map of rel type to URLs
 pub fn extract(html: &str, base_url: Option<&str>) -> Result<HashMap<String, Vec<String>>> {
-    let document = html_utils::parse_html(html);
-    let mut rel_links: HashMap<String, Vec<String>> = HashMap::new();
+    extract_from_document(&html_utils::parse_html(html), base_url)
+}
 
-    // Find all elements with rel and href attributes (link and a tags)
-    let selector = html_utils::create_selector("[rel][href]")?;
+/// Extract rel-* link relationships from an already parsed document
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<HashMap<String, Vec<String>>>` - Map of rel type to URLs
+pub fn extract_from_document(
+    document: &Html,
+    base_url: Option<&str>,
+) -> Result<HashMap<String, Vec<String>>> {
+    extract_from_head(&head::scan(document), &BaseUrl::for_document(document, base_url))
+}
 
-    for element in document.select(&selector) {
+/// Extract rel-* link relationships from pre-scanned head tags
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<HashMap<String, Vec<String>>>` - Map of rel type to URLs
+pub fn extract_from_head(head: &HeadTags, base: &BaseUrl) -> Result<HashMap<String, Vec<String>>> {
+    let mut rel_links: HashMap<String, Vec<String>> = HashMap::new();
+
+    // All elements with rel and href attributes (link and a tags)
+    for element in &head.rel {
         if let (Some(rel), Some(href)) =
-            (html_utils::get_attr(&element, "rel"), html_utils::get_attr(&element, "href"))
+            (html_utils::attr(element, "rel"), html_utils::attr(element, "href"))
         {
             // Skip empty rel or href
             if rel.trim().is_empty() || href.trim().is_empty() {
                 continue;
             }
 
-            // Resolve URL if base_url is provided
-            let url = if let Some(base) = base_url {
-                match url_utils::resolve_url(Some(base), &href) {
+            // Resolve URL if a base URL is known
+            let url = if base.as_str().is_some() {
+                match base.resolve(href) {
                     Ok(resolved) => resolved,
-                    Err(_) => href.clone(), // Fall back to original if resolution fails
+                    Err(_) => href.to_string(), // Fall back to original if resolution fails
                 }
             } else {
-                href.clone()
+                href.to_string()
             };
 
-            // Handle multiple space-separated rel values
+            // Handle multiple space-separated rel values; a key is only
+            // allocated the first time a rel type is seen
             for rel_value in rel.split_whitespace() {
-                if rel_value.is_empty() {
-                    continue;
+                let rel_type = html_utils::ascii_lowercase(rel_value);
+                match rel_links.get_mut(rel_type.as_ref()) {
+                    Some(urls) => urls.push(url.clone()),
+                    None => {
+                        rel_links.insert(rel_type.into_owned(), vec![url.clone()]);
+                    }
                 }
-                let rel_type = rel_value.to_lowercase();
-                rel_links.entry(rel_type).or_default().push(url.clone());
             }
         }
     }
@@ -136,6 +166,13 @@ mod tests {
         assert!(links.is_empty());
     }
 
+    #[test]
+    fn test_base_href() {
+        let html = r#"<head><base href="https://cdn.example/x/"></head><a rel="me" href="me">"#;
+        let links = extract(html, Some("https://example.com/")).unwrap();
+        assert_eq!(links["me"], vec!["https://cdn.example/x/me".to_string()]);
+    }
+
     #[test]
     fn test_multiple_same_rel() {
         let html = r#"
@@ -14,7 +14,14 @@ mod opengraph_tests;
 #[cfg(test)]
 mod twitter_tests;
 
-pub use opengraph::extract as extract_opengraph;
+pub use opengraph::{
+    extract as extract_opengraph, extract_from_document as extract_opengraph_from_document,
+    extract_from_head as extract_opengraph_from_head,
+};
 pub use twitter::{
-    extract as extract_twitter, extract_with_fallback as extract_twitter_with_fallback,
+    extract as extract_twitter, extract_from_document as extract_twitter_from_document,
+    extract_from_head as extract_twitter_from_head,
+    extract_with_fallback as extract_twitter_with_fallback,
+    extract_with_fallback_from_document as extract_twitter_with_fallback_from_document,
+    extract_with_fallback_from_head as extract_twitter_with_fallback_from_head,
 };
@@ -4,8 +4,11 @@
 //! Specification: https://developer.twitter.com/en/docs/twitter-for-websites/cards/overview/abouts-cards
 
 use crate::errors::Result;
-use crate::extractors::common::{html_utils, url_utils};
-use crate::types::social::{TwitterApp, TwitterCard, TwitterPlayer};
+use crate::extractors::common::html_utils;
+use crate::extractors::common::url_utils::BaseUrl;
+use crate::extractors::head::{self, HeadTags};
+use crate::types::social::{OpenGraph, TwitterApp, TwitterCard, TwitterPlayer};
+use scraper::Html;
 
 /// Extract Twitter Card metadata from HTML
 ///
@@ -16,7 +19,30 @@ use crate::types::social::{TwitterApp, TwitterCard, TwitterPlayer};
 /// # Returns
 /// * `Result<TwitterCard>` - Extracted Twitter Card data
 pub fn extract(html: &str, base_url: Option<&str>) -> Result<TwitterCard> {
-    let document = html_utils::parse_html(html);
+    extract_from_document(&html_utils::parse_html(html), base_url)
+}
+
+/// Extract Twitter Card metadata from an already parsed document
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<TwitterCard>` - Extracted Twitter Card data
+pub fn extract_from_document(document: &Html, base_url: Option<&str>) -> Result<TwitterCard> {
+    extract_from_head(&head::scan(document), &BaseUrl::for_document(document, base_url))
+}
+
+/// Extract Twitter Card metadata from pre-scanned head tags
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<TwitterCard>` - Extracted Twitter Card data
+pub fn extract_from_head(head: &HeadTags, base: &BaseUrl) -> Result<TwitterCard> {
     let mut card = TwitterCard::default();
 
     // Track player/app metadata
@@ -28,97 +54,89 @@ pub fn extract(html: &str, base_url: Option<&str>) -> Result<TwitterCard> {
     let mut app_data = TwitterApp::default();
     let mut has_app_data = false;
 
-    // Extract meta tags with name="twitter:*"
-    if let Ok(selector) = html_utils::create_selector("meta[name]") {
-        for element in document.select(&selector) {
-            if let (Some(name), Some(content)) =
-                (html_utils::get_attr(&element, "name"), html_utils::get_attr(&element, "content"))
-            {
-                let content = content.trim().to_string();
-                if content.is_empty() {
-                    continue;
-                }
+    // Meta tags with name="twitter:*"
+    for tag in &head.twitter {
+        let name = tag.key;
+        let content = tag.content.trim();
+        if content.is_empty() {
+            continue;
+        }
 
-                // Parse name attribute
-                if let Some(prop) = name.strip_prefix("twitter:") {
-                    match prop {
-                        "card" => card.card = Some(content),
-                        "title" => card.title = Some(content),
-                        "description" => card.description = Some(content),
-                        "image" => {
-                            card.image =
-                                Some(url_utils::resolve_url(base_url, &content).unwrap_or(content))
-                        }
-                        "site" => card.site = Some(content),
-                        "creator" => card.creator = Some(content),
+        // Parse name attribute
+        if let Some(prop) = name.strip_prefix("twitter:") {
+            match prop {
+                "card" => card.card = Some(content.to_string()),
+                "title" => card.title = Some(content.to_string()),
+                "description" => card.description = Some(content.to_string()),
+                "image" => {
+                    card.image = Some(base.resolve(content).unwrap_or_else(|_| content.to_string()))
+                }
+                "site" => card.site = Some(content.to_string()),
+                "creator" => card.creator = Some(content.to_string()),
 
-                        // Handle nested properties
-                        _ if prop.starts_with("image:") => {
-                            if &prop[6..] == "alt" {
-                                card.image_alt = Some(content);
+                // Handle nested properties
+                _ if prop.starts_with("image:") => {
+                    if &prop[6..] == "alt" {
+                        card.image_alt = Some(content.to_string());
+                    }
+                }
+                _ if prop.starts_with("site:") => {
+                    if &prop[5..] == "id" {
+                        card.site_id = Some(content.to_string());
+                    }
+                }
+                _ if prop.starts_with("creator:") => {
+                    if &prop[8..] == "id" {
+                        card.creator_id = Some(content.to_string());
+                    }
+                }
+                _ if prop.starts_with("player") => {
+                    if prop == "player" {
+                        player_url =
+                            Some(base.resolve(content).unwrap_or_else(|_| content.to_string()));
+                    } else if let Some(subprop) = prop.strip_prefix("player:") {
+                        match subprop {
+                            "width" => player_width = content.parse().ok(),
+                            "height" => player_height = content.parse().ok(),
+                            "stream" => {
+                                player_stream = Some(
+                                    base.resolve(content).unwrap_or_else(|_| content.to_string()),
+                                )
                             }
+                            _ => {}
                         }
-                        _ if prop.starts_with("site:") => {
-                            if &prop[5..] == "id" {
-                                card.site_id = Some(content);
-                            }
+                    }
+                }
+                _ if prop.starts_with("app:") => {
+                    has_app_data = true;
+                    let subprop = &prop[4..];
+
+                    if let Some(platform_prop) = subprop.strip_prefix("name:") {
+                        match platform_prop {
+                            "iphone" => app_data.name_iphone = Some(content.to_string()),
+                            "ipad" => app_data.name_ipad = Some(content.to_string()),
+                            "googleplay" => app_data.name_googleplay = Some(content.to_string()),
+                            _ => {}
                         }
-                        _ if prop.starts_with("creator:") => {
-                            if &prop[8..] == "id" {
-                                card.creator_id = Some(content);
-                            }
+                    } else if let Some(platform_prop) = subprop.strip_prefix("id:") {
+                        match platform_prop {
+                            "iphone" => app_data.id_iphone = Some(content.to_string()),
+                            "ipad" => app_data.id_ipad = Some(content.to_string()),
+                            "googleplay" => app_data.id_googleplay = Some(content.to_string()),
+                            _ => {}
                         }
-                        _ if prop.starts_with("player") => {
-                            if prop == "player" {
-                                player_url = Some(
-                                    url_utils::resolve_url(base_url, &content).unwrap_or(content),
-                                );
-                            } else if let Some(subprop) = prop.strip_prefix("player:") {
-                                match subprop {
-                                    "width" => player_width = content.parse().ok(),
-                                    "height" => player_height = content.parse().ok(),
-                                    "stream" => {
-                                        player_stream = Some(
-                                            url_utils::resolve_url(base_url, &content)
-                                                .unwrap_or(content),
-                                        )
-                                    }
-                                    _ => {}
-                                }
-                            }
+                    } else if let Some(platform_prop) = subprop.strip_prefix("url:") {
+                        match platform_prop {
+                            "iphone" => app_data.url_iphone = Some(content.to_string()),
+                            "ipad" => app_data.url_ipad = Some(content.to_string()),
+                            "googleplay" => app_data.url_googleplay = Some(content.to_string()),
+                            _ => {}
                         }
-                        _ if prop.starts_with("app:") => {
-                            has_app_data = true;
-                            let subprop = &prop[4..];
-
-                            if let Some(platform_prop) = subprop.strip_prefix("name:") {
-                                match platform_prop {
-                                    "iphone" => app_data.name_iphone = Some(content),
-                                    "ipad" => app_data.name_ipad = Some(content),
-                                    "googleplay" => app_data.name_googleplay = Some(content),
-                                    _ => {}
-                                }
-                            } else if let Some(platform_prop) = subprop.strip_prefix("id:") {
-                                match platform_prop {
-                                    "iphone" => app_data.id_iphone = Some(content),
-                                    "ipad" => app_data.id_ipad = Some(content),
-                                    "googleplay" => app_data.id_googleplay = Some(content),
-                                    _ => {}
-                                }
-                            } else if let Some(platform_prop) = subprop.strip_prefix("url:") {
-                                match platform_prop {
-                                    "iphone" => app_data.url_iphone = Some(content),
-                                    "ipad" => app_data.url_ipad = Some(content),
-                                    "googleplay" => app_data.url_googleplay = Some(content),
-                                    _ => {}
-                                }
-                            } else if subprop == "country" {
-                                app_data.country = Some(content);
-                            }
-                        }
-                        _ => {}
+                    } else if subprop == "country" {
+                        app_data.country = Some(content.to_string());
                     }
                 }
+                _ => {}
             }
         }
     }
@@ -153,26 +171,70 @@ pub fn extract(html: &str, base_url: Option<&str>) -> Result<TwitterCard> {
 /// # Returns
 /// * `Result<TwitterCard>` - Extracted Twitter Card data with OG fallback
 pub fn extract_with_fallback(html: &str, base_url: Option<&str>) -> Result<TwitterCard> {
-    let mut card = extract(html, base_url)?;
+    extract_with_fallback_from_document(&html_utils::parse_html(html), base_url)
+}
 
-    // If critical Twitter fields are missing, try Open Graph
-    if card.title.is_none() || card.description.is_none() || card.image.is_none() {
-        let og = super::opengraph::extract(html, base_url)?;
+/// Extract Twitter Card with fallback to Open Graph from an already parsed document
+///
+/// The Open Graph fallback reads the same document, so the HTML is parsed only once.
+///
+/// # Arguments
+/// * `document` - The parsed HTML document
+/// * `base_url` - Optional base URL for resolving relative URLs
+///
+/// # Returns
+/// * `Result<TwitterCard>` - Extracted Twitter Card data with OG fallback
+pub fn extract_with_fallback_from_document(
+    document: &Html,
+    base_url: Option<&str>,
+) -> Result<TwitterCard> {
+    extract_with_fallback_from_head(
+        &head::scan(document),
+        &BaseUrl::for_document(document, base_url),
+    )
+}
 
-        if card.title.is_none() {
-            card.title = og.title;
-        }
-        if card.description.is_none() {
-            card.description = og.description;
-        }
-        if card.image.is_none() {
-            card.image = og.image;
-        }
+/// Extract Twitter Card with fallback to Open Graph from pre-scanned head tags
+///
+/// # Arguments
+/// * `head` - Tags collected by [`head::scan`]
+/// * `base` - Base URL of the document, from [`BaseUrl::for_document`]
+///
+/// # Returns
+/// * `Result<TwitterCard>` - Extracted Twitter Card data with OG fallback
+pub fn extract_with_fallback_from_head(head: &HeadTags, base: &BaseUrl) -> Result<TwitterCard> {
+    let mut card = extract_from_head(head, base)?;
+
+    // If critical Twitter fields are missing, try Open Graph
+    if needs_fallback(&card) {
+        let og = super::opengraph::extract_from_head(head, base)?;
+        apply_fallback(&mut card, &og);
     }
 
     Ok(card)
 }
 
+/// Check whether any field covered by the Open Graph fallback is missing
+pub fn needs_fallback(card: &TwitterCard) -> bool {
+    card.title.is_none() || card.description.is_none() || card.image.is_none()
+}
+
+/// Fill missing Twitter Card fields from already extracted Open Graph data
+///
+/// Use this when Open Graph has been extracted anyway (e.g. in `extract_all`)
+/// to avoid running the Open Graph extractor a second time.
+pub fn apply_fallback(card: &mut TwitterCard, og: &OpenGraph) {
+    if card.title.is_none() {
+        card.title = og.title.clone();
+    }
+    if card.description.is_none() {
+        card.description = og.description.clone();
+    }
+    if card.image.is_none() {
+        card.image = og.image.clone();
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -2,7 +2,11 @@
 
 #[cfg(test)]
 mod tests {
-    use crate::extractors::social::twitter::{extract, extract_with_fallback};
+    use crate::extractors::common::html_utils;
+    use crate::extractors::social::opengraph;
+    use crate::extractors::social::twitter::{
+        apply_fallback, extract, extract_from_document, extract_with_fallback,
+    };
 
     #[test]
     fn test_basic_twitter_card() {
@@ -491,4 +495,24 @@ mod tests {
         // Should handle malformed URL gracefully
         assert!(card.player.is_some());
     }
+
+    #[test]
+    fn test_apply_fallback_matches_extract_with_fallback() {
+        let html = r#"
+            <meta name="twitter:card" content="summary">
+            <meta property="og:title" content="OG Title">
+            <meta property="og:description" content="OG Description">
+            <meta property="og:image" content="https://example.com/og.jpg">
+        "#;
+        let doc = html_utils::parse_html(html);
+        let og = opengraph::extract_from_document(&doc, None).unwrap();
+        let mut card = extract_from_document(&doc, None).unwrap();
+        apply_fallback(&mut card, &og);
+
+        let expected = extract_with_fallback(html, None).unwrap();
+        assert_eq!(card.title, expected.title);
+        assert_eq!(card.description, expected.description);
+        assert_eq!(card.image, expected.image);
+        assert_eq!(card.title, Some("OG Title".to_string()));
+    }
 }
@@ -8,6 +8,13 @@
 //!
 //! All strings and structs returned by FFI functions are allocated on the heap
 //! and must be freed by the caller using the appropriate `*_free()` functions.
+//! `meta_oxide_set_allocator()` routes returned strings through caller hooks,
+//! and the `_into` variants write into caller-provided buffers instead.
+//!
+//! # Instrumentation
+//!
+//! Setting `MetaOxideOptions::stats` makes a call report parse, per-format
+//! and serialization timings along with input, output and item counts.
 //!
 //! # Error Handling
 //!
@@ -17,15 +24,35 @@
 //!
 //! # Thread Safety
 //!
-//! All functions are stateless and thread-safe. Error state is thread-local.
+//! All functions are stateless and thread-safe, except that a single stream
+//! session or context must not be used from two threads at once. Error state is thread-local.
 
+use std::borrow::Cow;
 use std::cell::Cell;
-use std::ffi::{CStr, CString};
+use std::ffi::CStr;
+use std::io::{self, Write};
 use std::os::raw::{c_char, c_int};
 use std::ptr;
+use std::sync::Arc;
+use std::time::Duration;
 
+use crate::arena::Arena;
+use crate::cache;
+use crate::charset;
+use crate::extract::{self, formats, ExtractOptions, Extraction};
 use crate::extractors;
+use crate::limits::{Limit, Limits};
+use crate::msgpack;
 use crate::parser;
+use crate::pool;
+use crate::stream::StreamExtractor;
+
+mod alloc;
+mod stats;
+mod typed;
+pub use alloc::*;
+pub use stats::*;
+pub use typed::*;
 
 /// Error codes returned by FFI functions
 #[repr(C)]
@@ -46,6 +73,10 @@ pub enum MetaOxideError {
     JsonError = 5,
     /// NULL pointer passed as argument
     NullPointer = 6,
+    /// Caller-provided output buffer is too small
+    BufferTooSmall = 7,
+    /// A `MetaOxideLimits` limit was hit; the results are partial
+    LimitExceeded = 8,
 }
 
 // Thread-local storage for the last error that occurred
@@ -96,6 +127,200 @@ pub struct MetaOxideResult {
     pub rel_links: *mut c_char,
 }
 
+/// Select standard HTML meta tags
+pub const META_OXIDE_FMT_META: u32 = formats::META;
+/// Select Open Graph
+pub const META_OXIDE_FMT_OPEN_GRAPH: u32 = formats::OPEN_GRAPH;
+/// Select Twitter Cards
+pub const META_OXIDE_FMT_TWITTER: u32 = formats::TWITTER;
+/// Select JSON-LD
+pub const META_OXIDE_FMT_JSON_LD: u32 = formats::JSON_LD;
+/// Select Microdata
+pub const META_OXIDE_FMT_MICRODATA: u32 = formats::MICRODATA;
+/// Select Microformats
+pub const META_OXIDE_FMT_MICROFORMATS: u32 = formats::MICROFORMATS;
+/// Select RDFa
+pub const META_OXIDE_FMT_RDFA: u32 = formats::RDFA;
+/// Select Dublin Core
+pub const META_OXIDE_FMT_DUBLIN_CORE: u32 = formats::DUBLIN_CORE;
+/// Select Web App Manifest discovery
+pub const META_OXIDE_FMT_MANIFEST: u32 = formats::MANIFEST;
+/// Select oEmbed discovery
+pub const META_OXIDE_FMT_OEMBED: u32 = formats::OEMBED;
+/// Select rel-* links
+pub const META_OXIDE_FMT_REL_LINKS: u32 = formats::REL_LINKS;
+/// Select every format
+pub const META_OXIDE_FMT_ALL: u32 = formats::ALL;
+
+/// Replace invalid UTF-8 sequences in `_n` inputs with U+FFFD instead of failing
+pub const META_OXIDE_INPUT_LOSSY: u32 = 1 << 0;
+/// Skip UTF-8 validation of `_n` inputs; the caller guarantees they are valid
+/// UTF-8 (invalid input is undefined behaviour)
+pub const META_OXIDE_INPUT_TRUSTED_UTF8: u32 = 1 << 1;
+/// Decode `_n` HTML in the encoding declared by a byte order mark,
+/// `MetaOxideOptions::content_type` or a `<meta>` charset in the first 1024
+/// bytes, falling back to UTF-8 or windows-1252
+///
+/// Takes precedence over the other flags for the HTML; valid UTF-8 is still
+/// borrowed without a copy. The base URL is read as UTF-8.
+pub const META_OXIDE_INPUT_DETECT_ENCODING: u32 = 1 << 2;
+
+/// Write `MetaOxideBuffer` documents as JSON text (the default)
+pub const META_OXIDE_ENCODING_JSON: u32 = 0;
+/// Write `MetaOxideBuffer` documents as MessagePack
+pub const META_OXIDE_ENCODING_MSGPACK: u32 = 1;
+
+/// Resource limits for one extraction call
+///
+/// A field left at 0 means no limit. When a limit is hit the call still
+/// returns the results found within it and reports
+/// `MetaOxideError::LimitExceeded` (8): functions returning a result pointer
+/// set the error state but return the result, and functions returning a
+/// status code return 8 with their output filled in.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MetaOxideLimits {
+    /// Parse at most this many bytes of HTML
+    pub max_input_bytes: usize,
+    /// Parse at most this many start tags; the document is cut before the next
+    /// one. A `<` in text, comments and `<script>`/`<style>` contents does
+    /// not count
+    pub max_tags: usize,
+    /// Skip JSON-LD scripts longer than this many bytes without parsing them
+    pub max_json_ld_bytes: usize,
+    /// Keep at most this many JSON-LD objects, microdata items and RDFa items,
+    /// and this many microformat items of each type
+    pub max_items: usize,
+    /// Drop every node nested more than this many levels deep
+    ///
+    /// Applied after parsing, so it bounds extraction but not the parse itself;
+    /// pair it with `max_input_bytes` or `max_tags`.
+    pub max_depth: usize,
+    /// Skip the formats not yet started after this many microseconds
+    ///
+    /// Checked between stages, so a single slow stage can overrun it.
+    pub deadline_us: u64,
+}
+
+impl MetaOxideLimits {
+    fn to_limits(self) -> Limits {
+        let limit = |value: usize| Some(value).filter(|&v| v != 0);
+        Limits {
+            max_input_bytes: limit(self.max_input_bytes),
+            max_tags: limit(self.max_tags),
+            max_json_ld_bytes: limit(self.max_json_ld_bytes),
+            max_items: limit(self.max_items),
+            max_depth: limit(self.max_depth),
+            deadline: Some(self.deadline_us).filter(|&us| us != 0).map(Duration::from_micros),
+        }
+    }
+}
+
+/// Options controlling `meta_oxide_extract_all_with_options()`
+///
+/// Zero-initialize the struct to get the default behaviour.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct MetaOxideOptions {
+    /// Only parse the document head
+    ///
+    /// Tokenizing stops after `</head>` or at the first element that cannot
+    /// appear in the head (such as `<body>`). Meta tags, Open Graph, Twitter,
+    /// Dublin Core, manifest, oEmbed, rel-links and JSON-LD scripts in the head
+    /// are still extracted; anything in the body is ignored.
+    pub head_only: bool,
+    /// Bitmask of `META_OXIDE_FMT_*` flags selecting the formats to extract
+    ///
+    /// 0 selects every format. Fields of unselected formats are left NULL and
+    /// their extractors are never run.
+    pub formats: u32,
+    /// `META_OXIDE_INPUT_*` flags for `meta_oxide_extract_all_with_options_n()`
+    /// and each document of `meta_oxide_extract_batch()`
+    ///
+    /// Ignored by the other NUL-terminated entry points.
+    pub input_flags: u32,
+    /// Statistics to fill in for this call (NULL to skip measuring)
+    ///
+    /// Ignored by `meta_oxide_extract_batch()` and stream sessions.
+    pub stats: *mut MetaOxideStats,
+    /// Resource limits for the call (NULL for none)
+    ///
+    /// Ignored by stream sessions.
+    pub limits: *const MetaOxideLimits,
+    /// `META_OXIDE_ENCODING_*` value selecting the document format of
+    /// `meta_oxide_extract_all_buffer()` and `meta_oxide_extract_all_into()`
+    ///
+    /// Ignored by every other entry point, whose results are JSON strings.
+    pub encoding: u32,
+    /// HTTP `Content-Type` header value or charset label of the HTML
+    /// (NULL for none)
+    ///
+    /// Only used with `META_OXIDE_INPUT_DETECT_ENCODING`, where it overrides a
+    /// `<meta>` declaration but not a byte order mark.
+    pub content_type: *const c_char,
+}
+
+impl Default for MetaOxideOptions {
+    fn default() -> Self {
+        Self {
+            head_only: false,
+            formats: 0,
+            input_flags: 0,
+            stats: ptr::null_mut(),
+            limits: ptr::null(),
+            encoding: META_OXIDE_ENCODING_JSON,
+            content_type: ptr::null(),
+        }
+    }
+}
+
+impl MetaOxideOptions {
+    // SAFETY: `limits` must be NULL or point to a valid `MetaOxideLimits`
+    unsafe fn to_extract_options(self) -> ExtractOptions {
+        ExtractOptions {
+            head_only: self.head_only,
+            formats: formats::or_all(self.formats),
+            limits: self.limits.as_ref().map_or_else(Limits::default, |l| l.to_limits()),
+            ..Default::default()
+        }
+    }
+}
+
+// Run one options-driven extraction, reporting a hit limit in the error state
+unsafe fn run(html: &str, base_url: Option<&str>, options: &MetaOxideOptions) -> Arc<Extraction> {
+    let extraction = stats::extract(html, base_url, options);
+    if let Some(limit) = extraction.limit {
+        set_last_error(MetaOxideError::LimitExceeded, Some(limit_message(limit)));
+    }
+    extraction
+}
+
+fn limit_message(limit: Limit) -> String {
+    format!("Resource limit exceeded: {}", limit.name())
+}
+
+// Status of a completed extraction for the functions returning a code
+fn status(extraction: &Extraction) -> c_int {
+    match extraction.limit {
+        Some(_) => MetaOxideError::LimitExceeded as c_int,
+        None => MetaOxideError::Ok as c_int,
+    }
+}
+
+/// One document of a `meta_oxide_extract_batch()` call
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct MetaOxideInput {
+    /// HTML content (must not be NULL)
+    pub html: *const c_char,
+    /// Base URL for resolving relative URLs (may be NULL)
+    pub base_url: *const c_char,
+}
+
+// SAFETY: the library only ever reads through these pointers, and the caller
+// keeps them valid for the duration of the batch call.
+unsafe impl Sync for MetaOxideInput {}
+
 /// Manifest discovery result with URL and parsed content
 #[repr(C)]
 pub struct ManifestDiscovery {
@@ -107,8 +332,15 @@ pub struct ManifestDiscovery {
 
 // Helper function to convert Rust string to owned C string
 fn to_c_string(s: String) -> *mut c_char {
-    match CString::new(s) {
-        Ok(c_str) => c_str.into_raw(),
+    match alloc::c_string(s) {
+        Ok(c_str) => c_str,
+        Err(MetaOxideError::MemoryError) => {
+            set_last_error(
+                MetaOxideError::MemoryError,
+                Some("Allocator hook returned NULL".to_string()),
+            );
+            ptr::null_mut()
+        }
         Err(_) => {
             set_last_error(
                 MetaOxideError::InvalidUtf8,
@@ -147,6 +379,184 @@ unsafe fn from_c_string_opt<'a>(s: *const c_char) -> Option<&'a str> {
     }
 }
 
+// Helper function to convert a length-delimited byte buffer to a string
+//
+// Unlike `from_c_string` this does not scan for a terminator, so the buffer may
+// be a slice of a larger one and may contain NUL bytes. `content_type` is the
+// charset hint used with `META_OXIDE_INPUT_DETECT_ENCODING`.
+unsafe fn from_c_bytes<'a>(
+    s: *const c_char,
+    len: usize,
+    flags: u32,
+    content_type: Option<&str>,
+) -> Result<Cow<'a, str>, MetaOxideError> {
+    if s.is_null() {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return Err(MetaOxideError::NullPointer);
+    }
+
+    let bytes = std::slice::from_raw_parts(s.cast::<u8>(), len);
+    decode_input(bytes, flags, content_type).ok_or_else(|| {
+        set_last_error(
+            MetaOxideError::InvalidUtf8,
+            Some("Invalid UTF-8 in input string".to_string()),
+        );
+        MetaOxideError::InvalidUtf8
+    })
+}
+
+// Read input bytes as the `META_OXIDE_INPUT_*` flags say, without touching
+// the error state; None if strict UTF-8 was asked for and not found
+//
+// SAFETY: with `META_OXIDE_INPUT_TRUSTED_UTF8` the bytes must be valid UTF-8
+unsafe fn decode_input<'a>(
+    bytes: &'a [u8],
+    flags: u32,
+    content_type: Option<&str>,
+) -> Option<Cow<'a, str>> {
+    if flags & META_OXIDE_INPUT_DETECT_ENCODING != 0 {
+        return Some(charset::decode(bytes, content_type).text);
+    }
+    if flags & META_OXIDE_INPUT_TRUSTED_UTF8 != 0 {
+        return Some(Cow::Borrowed(std::str::from_utf8_unchecked(bytes)));
+    }
+    if flags & META_OXIDE_INPUT_LOSSY != 0 {
+        return Some(String::from_utf8_lossy(bytes));
+    }
+    std::str::from_utf8(bytes).ok().map(Cow::Borrowed)
+}
+
+// Helper function to convert an optional length-delimited byte buffer
+unsafe fn from_c_bytes_opt<'a>(s: *const c_char, len: usize, flags: u32) -> Option<Cow<'a, str>> {
+    if s.is_null() {
+        None
+    } else {
+        let bytes = std::slice::from_raw_parts(s.cast::<u8>(), len);
+        if flags & META_OXIDE_INPUT_TRUSTED_UTF8 != 0 {
+            Some(Cow::Borrowed(std::str::from_utf8_unchecked(bytes)))
+        } else if flags & META_OXIDE_INPUT_LOSSY != 0 {
+            Some(String::from_utf8_lossy(bytes))
+        } else {
+            std::str::from_utf8(bytes).ok().map(Cow::Borrowed)
+        }
+    }
+}
+
+// Helper function to convert an array of `n` C strings
+//
+// NULL is accepted only for an empty array; NULL entries and invalid UTF-8
+// fail as they do for single strings.
+unsafe fn from_c_string_array<'a>(
+    s: *const *const c_char,
+    n: usize,
+) -> Result<Vec<&'a str>, MetaOxideError> {
+    if n == 0 {
+        return Ok(Vec::new());
+    }
+    if s.is_null() {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return Err(MetaOxideError::NullPointer);
+    }
+    std::slice::from_raw_parts(s, n).iter().map(|&entry| from_c_string(entry)).collect()
+}
+
+// Helper to run a single-format extractor over length-delimited input
+unsafe fn extract_json_n<T, E>(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+    extract: impl FnOnce(&str, Option<&str>) -> Result<T, E>,
+) -> *mut c_char
+where
+    T: serde::Serialize,
+    E: std::fmt::Display,
+{
+    clear_last_error();
+
+    let html_str = match from_c_bytes(html, len, flags, None) {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+    let base_url_str = from_c_bytes_opt(base_url, base_len, flags);
+
+    match extract(&html_str, base_url_str.as_deref()) {
+        Ok(value) => to_json_c_string(&value),
+        Err(e) => {
+            set_last_error(MetaOxideError::ParseError, Some(e.to_string()));
+            ptr::null_mut()
+        }
+    }
+}
+
+// Helper to run a single-format extractor and write its JSON into a caller buffer
+unsafe fn extract_json_into<T, E>(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+    extract: impl FnOnce(&str, Option<&str>) -> Result<T, E>,
+) -> c_int
+where
+    T: serde::Serialize,
+    E: std::fmt::Display,
+{
+    clear_last_error();
+
+    if buf.is_null() && cap != 0 {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return MetaOxideError::NullPointer as c_int;
+    }
+
+    let html_str = match from_c_string(html) {
+        Ok(s) => s,
+        Err(error) => return error as c_int,
+    };
+    let value = match extract(html_str, from_c_string_opt(base_url)) {
+        Ok(value) => value,
+        Err(e) => {
+            set_last_error(MetaOxideError::ParseError, Some(e.to_string()));
+            return MetaOxideError::ParseError as c_int;
+        }
+    };
+
+    let buf_slice: &mut [u8] =
+        if cap == 0 { &mut [] } else { std::slice::from_raw_parts_mut(buf.cast(), cap) };
+    let mut writer = SliceWriter { buf: buf_slice, pos: 0 };
+    if serde_json::to_writer(&mut writer, &value).is_err() {
+        return json_error();
+    }
+    writer.pos += 1;
+
+    if let Some(needed) = needed.as_mut() {
+        *needed = writer.pos;
+    }
+    if writer.pos > cap {
+        // Leave a terminated prefix rather than an unterminated one
+        if cap != 0 {
+            *buf.add(cap - 1) = 0;
+        }
+        set_last_error(
+            MetaOxideError::BufferTooSmall,
+            Some(format!("Output needs {} bytes, buffer has {}", writer.pos, cap)),
+        );
+        return MetaOxideError::BufferTooSmall as c_int;
+    }
+    *buf.add(writer.pos - 1) = 0;
+    MetaOxideError::Ok as c_int
+}
+
 // Helper to serialize to JSON and return C string
 fn to_json_c_string<T: serde::Serialize>(value: &T) -> *mut c_char {
     match serde_json::to_string(value) {
@@ -180,6 +590,160 @@ fn to_json_c_string<T: serde::Serialize>(value: &T) -> *mut c_char {
 pub unsafe extern "C" fn meta_oxide_extract_all(
     html: *const c_char,
     base_url: *const c_char,
+) -> *mut MetaOxideResult {
+    meta_oxide_extract_all_with_options(html, base_url, ptr::null())
+}
+
+/// Extract ALL metadata from HTML with extraction options
+///
+/// Same as `meta_oxide_extract_all()`, with behaviour controlled by `options`.
+/// Passing NULL for `options` is equivalent to `meta_oxide_extract_all()`.
+///
+/// # Arguments
+/// * `html` - HTML content (must not be NULL)
+/// * `base_url` - Base URL for resolving relative URLs (may be NULL)
+/// * `options` - Extraction options (may be NULL for defaults)
+///
+/// # Memory
+/// The caller must free the returned struct using `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_all_with_options(
+    html: *const c_char,
+    base_url: *const c_char,
+    options: *const MetaOxideOptions,
+) -> *mut MetaOxideResult {
+    clear_last_error();
+
+    let html_str = match from_c_string(html) {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let base_url_str = from_c_string_opt(base_url);
+    let options = if options.is_null() { MetaOxideOptions::default() } else { *options };
+
+    let extraction = run(html_str, base_url_str, &options);
+    stats::serialize(&options, || to_result(&extraction), |&r| stats::result_len(r))
+}
+
+/// Extract ALL metadata from a length-delimited HTML buffer
+///
+/// Same as `meta_oxide_extract_all()`, but `html` and `base_url` are byte
+/// buffers with explicit lengths rather than NUL-terminated strings. The HTML
+/// may be a slice of a larger buffer and may contain NUL bytes; no copy is made
+/// unless `META_OXIDE_INPUT_LOSSY` has to replace invalid sequences or
+/// `META_OXIDE_INPUT_DETECT_ENCODING` finds a non-UTF-8 page.
+///
+/// # Arguments
+/// * `html` - HTML bytes (must not be NULL)
+/// * `len` - Length of `html` in bytes
+/// * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+/// * `base_len` - Length of `base_url` in bytes
+/// * `flags` - `META_OXIDE_INPUT_*` flags (0 to reject invalid UTF-8)
+///
+/// # Memory
+/// The caller must free the returned struct using `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+/// - with `META_OXIDE_INPUT_TRUSTED_UTF8`, both buffers must be valid UTF-8
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_all_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut MetaOxideResult {
+    let options = MetaOxideOptions { input_flags: flags, ..Default::default() };
+    meta_oxide_extract_all_with_options_n(html, len, base_url, base_len, &options)
+}
+
+/// Extract ALL metadata from a length-delimited HTML buffer with options
+///
+/// Same as `meta_oxide_extract_all_with_options()` for length-delimited input;
+/// `options->input_flags` controls UTF-8 handling as in `meta_oxide_extract_all_n()`,
+/// and `options->content_type` gives the charset hint for
+/// `META_OXIDE_INPUT_DETECT_ENCODING`.
+///
+/// # Arguments
+/// * `html` - HTML bytes (must not be NULL)
+/// * `len` - Length of `html` in bytes
+/// * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+/// * `base_len` - Length of `base_url` in bytes
+/// * `options` - Extraction options (may be NULL for defaults)
+///
+/// # Memory
+/// The caller must free the returned struct using `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+/// - with `META_OXIDE_INPUT_TRUSTED_UTF8`, both buffers must be valid UTF-8
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_all_with_options_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    options: *const MetaOxideOptions,
+) -> *mut MetaOxideResult {
+    clear_last_error();
+
+    match extract_n(html, len, base_url, base_len, options) {
+        Ok((extraction, options)) => {
+            stats::serialize(&options, || to_result(&extraction), |&r| stats::result_len(r))
+        }
+        Err(_) => ptr::null_mut(),
+    }
+}
+
+// Helper to run every selected extractor over length-delimited input
+unsafe fn extract_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    options: *const MetaOxideOptions,
+) -> Result<(Arc<Extraction>, MetaOxideOptions), MetaOxideError> {
+    let options = if options.is_null() { MetaOxideOptions::default() } else { *options };
+
+    let content_type = from_c_string_opt(options.content_type);
+    let html_str = from_c_bytes(html, len, options.input_flags, content_type)?;
+    let base_url_str = from_c_bytes_opt(base_url, base_len, options.input_flags);
+
+    Ok((run(&html_str, base_url_str.as_deref(), &options), options))
+}
+
+/// Extract only the selected metadata formats from HTML
+///
+/// Runs just the extractors whose `META_OXIDE_FMT_*` bit is set in
+/// `formats`; the fields of unselected formats are left NULL. As in
+/// `MetaOxideOptions.formats`, a mask of 0 selects every format.
+///
+/// # Arguments
+/// * `html` - HTML content (must not be NULL)
+/// * `base_url` - Base URL for resolving relative URLs (may be NULL)
+/// * `formats` - Bitmask of `META_OXIDE_FMT_*` flags
+///
+/// # Memory
+/// The caller must free the returned struct using `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_selected(
+    html: *const c_char,
+    base_url: *const c_char,
+    formats: u32,
 ) -> *mut MetaOxideResult {
     clear_last_error();
 
@@ -189,94 +753,979 @@ pub unsafe extern "C" fn meta_oxide_extract_all(
     };
 
     let base_url_str = from_c_string_opt(base_url);
+    let options = ExtractOptions { formats: formats::or_all(formats), ..Default::default() };
+
+    let extraction = extract::extract_shared(html_str, base_url_str, &options);
+    to_result(&extraction)
+}
+
+// Helper to convert an extraction into a heap-allocated MetaOxideResult
+fn to_result(extraction: &Extraction) -> *mut MetaOxideResult {
+    Box::into_raw(Box::new(to_result_with(extraction, &mut HeapStrings)))
+}
+
+// Where the JSON strings of a MetaOxideResult are allocated
+trait JsonSink {
+    fn json<T: serde::Serialize>(&mut self, value: &T) -> *mut c_char;
+
+    fn field<T: serde::Serialize>(&mut self, value: &Option<T>) -> *mut c_char {
+        value.as_ref().map_or(ptr::null_mut(), |v| self.json(v))
+    }
+}
+
+// One CString per field, released by meta_oxide_result_free()
+struct HeapStrings;
 
-    // Allocate result structure
-    let result = Box::new(MetaOxideResult {
-        meta: ptr::null_mut(),
-        open_graph: ptr::null_mut(),
-        twitter: ptr::null_mut(),
-        json_ld: ptr::null_mut(),
-        microdata: ptr::null_mut(),
-        microformats: ptr::null_mut(),
-        rdfa: ptr::null_mut(),
-        dublin_core: ptr::null_mut(),
-        manifest: ptr::null_mut(),
-        oembed: ptr::null_mut(),
-        rel_links: ptr::null_mut(),
+impl JsonSink for HeapStrings {
+    fn json<T: serde::Serialize>(&mut self, value: &T) -> *mut c_char {
+        to_json_c_string(value)
+    }
+}
+
+// Strings bump-allocated from a context arena, released by meta_oxide_context_reset()
+struct ArenaStrings<'a> {
+    arena: &'a mut Arena,
+    scratch: &'a mut Vec<u8>,
+}
+
+impl JsonSink for ArenaStrings<'_> {
+    fn json<T: serde::Serialize>(&mut self, value: &T) -> *mut c_char {
+        self.scratch.clear();
+        match serde_json::to_writer(&mut *self.scratch, value) {
+            Ok(()) => self.arena.alloc_c_str(self.scratch),
+            Err(_) => {
+                set_last_error(
+                    MetaOxideError::JsonError,
+                    Some("Failed to serialize to JSON".to_string()),
+                );
+                ptr::null_mut()
+            }
+        }
+    }
+}
+
+// Helper to build a MetaOxideResult whose strings come from `sink`
+fn to_result_with<S: JsonSink>(extraction: &Extraction, sink: &mut S) -> MetaOxideResult {
+    MetaOxideResult {
+        meta: sink.field(&extraction.meta),
+        open_graph: sink.field(&extraction.open_graph),
+        twitter: sink.field(&extraction.twitter),
+        json_ld: sink.field(&extraction.json_ld),
+        microdata: sink.field(&extraction.microdata),
+        microformats: sink.field(&extraction.microformats),
+        rdfa: sink.field(&extraction.rdfa),
+        dublin_core: sink.field(&extraction.dublin_core),
+        manifest: sink.field(&extraction.manifest),
+        oembed: sink.field(&extraction.oembed),
+        rel_links: sink.field(&extraction.rel_links),
+    }
+}
+
+/// Extract ALL metadata from many documents in parallel
+///
+/// The documents are spread over an internal pool of worker threads that is
+/// started on first use and reused by later calls (see
+/// `meta_oxide_set_thread_count()`). The calling thread takes part in the work.
+///
+/// Every document gets its own result and error code; the thread-local error
+/// state is only set for errors in the arguments themselves.
+///
+/// # Arguments
+/// * `docs` - Array of `n` documents
+/// * `n` - Number of documents
+/// * `options` - Extraction options applied to every document (may be NULL);
+///   `input_flags` and `content_type` say how each document's bytes are read
+/// * `out` - Array of `n` result pointers, filled in input order; an entry is
+///   NULL if its document could not be read
+/// * `errors` - Optional array of `n` error codes (`MetaOxideError` values),
+///   filled in input order (may be NULL); `LimitExceeded` marks a partial
+///   result
+///
+/// # Returns
+/// 0 on success, or an error code if `docs` or `out` is NULL
+///
+/// # Memory
+/// The caller must free every non-NULL entry of `out` using
+/// `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `docs` must point to `n` valid `MetaOxideInput` entries whose strings are
+///   NULL or valid null-terminated C strings
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+/// - `out` must point to space for `n` pointers
+/// - `errors` may be NULL or must point to space for `n` ints
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_batch(
+    docs: *const MetaOxideInput,
+    n: usize,
+    options: *const MetaOxideOptions,
+    out: *mut *mut MetaOxideResult,
+    errors: *mut c_int,
+) -> c_int {
+    clear_last_error();
+
+    if n == 0 {
+        return MetaOxideError::Ok as c_int;
+    }
+    if docs.is_null() || out.is_null() {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return MetaOxideError::NullPointer as c_int;
+    }
+
+    let docs = std::slice::from_raw_parts(docs, n);
+    let options = if options.is_null() { MetaOxideOptions::default() } else { *options };
+    let flags = options.input_flags;
+    let content_type = from_c_string_opt(options.content_type);
+    let options = options.to_extract_options();
+
+    // Raw result pointers own their strings, so they may move between threads
+    struct Owned(*mut MetaOxideResult);
+    unsafe impl Send for Owned {}
+
+    let results = pool::global().map(n, |i| {
+        let doc = docs[i];
+        if doc.html.is_null() {
+            return (MetaOxideError::NullPointer, Owned(ptr::null_mut()));
+        }
+        let bytes = CStr::from_ptr(doc.html).to_bytes();
+        let Some(html) = decode_input(bytes, flags, content_type) else {
+            return (MetaOxideError::InvalidUtf8, Owned(ptr::null_mut()));
+        };
+
+        let extraction = extract::extract_shared(&html, from_c_string_opt(doc.base_url), &options);
+        let error = match extraction.limit {
+            Some(_) => MetaOxideError::LimitExceeded,
+            None => MetaOxideError::Ok,
+        };
+        (error, Owned(to_result(&extraction)))
     });
 
-    let result = Box::into_raw(result);
+    for (i, (error, result)) in results.into_iter().enumerate() {
+        *out.add(i) = result.0;
+        if !errors.is_null() {
+            *errors.add(i) = error as c_int;
+        }
+    }
+
+    MetaOxideError::Ok as c_int
+}
+
+/// Set the number of worker threads used by `meta_oxide_extract_batch()`
+///
+/// 0 selects one thread per available core, which is also the default. The
+/// pool is replaced for later calls; batches already running finish first.
+#[no_mangle]
+pub extern "C" fn meta_oxide_set_thread_count(threads: usize) {
+    pool::set_global_threads(threads);
+}
+
+/// Get the number of worker threads used by `meta_oxide_extract_batch()`
+#[no_mangle]
+pub extern "C" fn meta_oxide_thread_count() -> usize {
+    pool::global().threads()
+}
+
+/// Hit, miss and size counters of the result caches
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MetaOxideCacheStats {
+    /// Full-document calls answered from the cache
+    pub hits: u64,
+    /// Full-document calls that had to be extracted
+    pub misses: u64,
+    /// `head_only` calls answered from the cache
+    pub head_hits: u64,
+    /// `head_only` calls that had to be extracted
+    pub head_misses: u64,
+    /// Entries dropped to make room for newer ones
+    pub evictions: u64,
+    /// Entries currently stored
+    pub entries: usize,
+    /// Bytes currently accounted to the caches
+    pub bytes: usize,
+}
+
+/// Enable the result caches with a total budget of `max_bytes`, or disable
+/// them with 0 (the default)
+///
+/// While enabled, the multi-format entry points (`meta_oxide_extract_all()`
+/// and its variants, `meta_oxide_extract_batch()`) first look the call up by
+/// a hash of its HTML, base URL and options, and skip the work entirely on a
+/// hit. `head_only` calls are keyed on the head section alone, so pages that
+/// share a templated `<head>` share one entry. Calls with a `MetaOxideStats`
+/// pointer are always extracted. Every call replaces the caches, dropping
+/// their entries and resetting the counters.
+#[no_mangle]
+pub extern "C" fn meta_oxide_cache_configure(max_bytes: usize) {
+    cache::configure(max_bytes);
+}
+
+/// Get the counters of the result caches; all zero while caching is disabled
+#[no_mangle]
+pub extern "C" fn meta_oxide_cache_stats() -> MetaOxideCacheStats {
+    let stats = cache::stats();
+    MetaOxideCacheStats {
+        hits: stats.hits,
+        misses: stats.misses,
+        head_hits: stats.head_hits,
+        head_misses: stats.head_misses,
+        evictions: stats.evictions,
+        entries: stats.entries,
+        bytes: stats.bytes,
+    }
+}
+
+/// A reusable extraction context (see `meta_oxide_context_new()`)
+pub struct MetaOxideContext {
+    /// Backing storage for every result string handed out since the last reset
+    arena: Arena,
+    /// JSON serialization buffer reused for every field
+    scratch: Vec<u8>,
+    /// Result structs handed out since the last reset, followed by spares
+    results: Vec<Box<MetaOxideResult>>,
+    /// Number of entries of `results` in use
+    used: usize,
+}
+
+/// Create a reusable extraction context
+///
+/// A context owns the memory behind the results of
+/// `meta_oxide_context_extract_all()`: every JSON string is bump-allocated
+/// from an arena, and the arena and result structs are recycled by
+/// `meta_oxide_context_reset()`. A worker that processes many documents with
+/// one context stops allocating result memory once the arena has grown to
+/// its peak size.
+///
+/// A context must not be used from two threads at once; give each worker
+/// thread its own.
+///
+/// # Memory
+/// The caller must free the context using `meta_oxide_context_free()`.
+#[no_mangle]
+pub extern "C" fn meta_oxide_context_new() -> *mut MetaOxideContext {
+    Box::into_raw(Box::new(MetaOxideContext {
+        arena: Arena::new(),
+        scratch: Vec::new(),
+        results: Vec::new(),
+        used: 0,
+    }))
+}
+
+/// Extract ALL metadata from HTML into a context
+///
+/// Same as `meta_oxide_extract_all_with_options()`, but the result and its
+/// strings are owned by `ctx`. Results from several calls stay valid together
+/// until the next `meta_oxide_context_reset()` or `meta_oxide_context_free()`.
+///
+/// # Arguments
+/// * `ctx` - Context from `meta_oxide_context_new()` (must not be NULL)
+/// * `html` - HTML content (must not be NULL)
+/// * `base_url` - Base URL for resolving relative URLs (may be NULL)
+/// * `options` - Extraction options (may be NULL for defaults)
+///
+/// # Returns
+/// A result owned by the context, or NULL on error
+///
+/// # Memory
+/// Do NOT pass the result to `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `ctx` must be a live context
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_context_extract_all(
+    ctx: *mut MetaOxideContext,
+    html: *const c_char,
+    base_url: *const c_char,
+    options: *const MetaOxideOptions,
+) -> *const MetaOxideResult {
+    clear_last_error();
 
-    // Extract meta tags
-    if let Ok(meta) = extractors::meta::extract(html_str, base_url_str) {
-        (*result).meta = to_json_c_string(&meta);
+    if ctx.is_null() {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return ptr::null();
     }
+    let ctx = &mut *ctx;
+
+    let html_str = match from_c_string(html) {
+        Ok(s) => s,
+        Err(_) => return ptr::null(),
+    };
 
-    // Extract Open Graph
-    if let Ok(og) = extractors::social::extract_opengraph(html_str, base_url_str) {
-        (*result).open_graph = to_json_c_string(&og);
+    let base_url_str = from_c_string_opt(base_url);
+    let options = if options.is_null() { MetaOxideOptions::default() } else { *options };
+
+    let extraction = run(html_str, base_url_str, &options);
+    let result = stats::serialize(
+        &options,
+        || {
+            to_result_with(
+                &extraction,
+                &mut ArenaStrings { arena: &mut ctx.arena, scratch: &mut ctx.scratch },
+            )
+        },
+        |r| stats::result_len(r),
+    );
+
+    // Reuse a spare struct from before the last reset when there is one
+    match ctx.results.get_mut(ctx.used) {
+        Some(slot) => **slot = result,
+        None => ctx.results.push(Box::new(result)),
     }
+    ctx.used += 1;
+    &*ctx.results[ctx.used - 1]
+}
 
-    // Extract Twitter Cards
-    if let Ok(twitter) = extractors::social::extract_twitter_with_fallback(html_str, base_url_str) {
-        (*result).twitter = to_json_c_string(&twitter);
+/// Release every result of a context in one step
+///
+/// All results returned by `meta_oxide_context_extract_all()` since the last
+/// reset become invalid. The memory is kept for reuse by later calls.
+///
+/// # Safety
+/// - `ctx` must be NULL or a live context
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_context_reset(ctx: *mut MetaOxideContext) {
+    if let Some(ctx) = ctx.as_mut() {
+        ctx.arena.reset();
+        ctx.used = 0;
     }
+}
 
-    // Extract JSON-LD
-    if let Ok(json_ld) = extractors::jsonld::extract(html_str, base_url_str) {
-        if !json_ld.is_empty() {
-            (*result).json_ld = to_json_c_string(&json_ld);
+/// Free a context and every result it owns
+///
+/// # Safety
+/// - `ctx` must be NULL or a live context; it must not be used afterwards
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_context_free(ctx: *mut MetaOxideContext) {
+    if !ctx.is_null() {
+        drop(Box::from_raw(ctx));
+    }
+}
+
+/// Location of one format's JSON value inside a `MetaOxideBuffer`
+///
+/// `len` is 0 when the format was not selected or not found.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct MetaOxideSpan {
+    /// Byte offset of the value from the start of the buffer
+    pub offset: usize,
+    /// Length of the value in bytes
+    pub len: usize,
+}
+
+/// A complete extraction result in one contiguous buffer
+///
+/// `data` holds a single NUL-terminated JSON object keyed by the format names
+/// used by the language bindings: `meta`, `openGraph`, `twitter`, `jsonLd`,
+/// `microdata`, `microformats`, `rdfa`, `dublinCore`, `manifest`, `oembed` and
+/// `relLinks`. Formats that were not selected or not found are left out.
+///
+/// Each span locates one format's JSON value inside `data`, so a single format
+/// can be read without parsing the whole document. Values are not
+/// NUL-terminated; use the span length.
+///
+/// With `META_OXIDE_ENCODING_MSGPACK` in `MetaOxideOptions::encoding`, `data`
+/// holds a MessagePack map with the same keys and values instead, and each
+/// span locates one MessagePack value. A NUL byte still follows the document
+/// but is not part of it, and the document itself may contain NUL bytes.
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideBuffer {
+    /// The combined JSON document (NUL-terminated)
+    pub data: *mut c_char,
+    /// Length of the document in bytes, excluding the terminator
+    pub len: usize,
+    /// Standard HTML meta tags (JSON object)
+    pub meta: MetaOxideSpan,
+    /// Open Graph metadata (JSON object)
+    pub open_graph: MetaOxideSpan,
+    /// Twitter Card metadata (JSON object)
+    pub twitter: MetaOxideSpan,
+    /// JSON-LD structured data (JSON array)
+    pub json_ld: MetaOxideSpan,
+    /// Microdata items (JSON array)
+    pub microdata: MetaOxideSpan,
+    /// Microformats data (JSON object with h-card, h-entry, etc.)
+    pub microformats: MetaOxideSpan,
+    /// RDFa structured data (JSON array)
+    pub rdfa: MetaOxideSpan,
+    /// Dublin Core metadata (JSON object)
+    pub dublin_core: MetaOxideSpan,
+    /// Web App Manifest discovery (JSON object)
+    pub manifest: MetaOxideSpan,
+    /// oEmbed endpoint discovery (JSON object)
+    pub oembed: MetaOxideSpan,
+    /// rel-* link relationships (JSON object)
+    pub rel_links: MetaOxideSpan,
+}
+
+impl MetaOxideBuffer {
+    fn empty() -> Self {
+        let none = MetaOxideSpan::default();
+        Self {
+            data: ptr::null_mut(),
+            len: 0,
+            meta: none,
+            open_graph: none,
+            twitter: none,
+            json_ld: none,
+            microdata: none,
+            microformats: none,
+            rdfa: none,
+            dublin_core: none,
+            manifest: none,
+            oembed: none,
+            rel_links: none,
         }
     }
+}
+
+// A writer that knows how many bytes it has been given
+trait Tell: Write {
+    fn tell(&self) -> usize;
+}
+
+impl Tell for Vec<u8> {
+    fn tell(&self) -> usize {
+        self.len()
+    }
+}
+
+// Writer over a caller-provided buffer
+//
+// Bytes past the end are dropped but still counted, so after an overflow
+// `pos` is the size the caller needs.
+struct SliceWriter<'a> {
+    buf: &'a mut [u8],
+    pos: usize,
+}
+
+impl Write for SliceWriter<'_> {
+    fn write(&mut self, bytes: &[u8]) -> io::Result<usize> {
+        if let Some(room) = self.buf.get_mut(self.pos..) {
+            let n = room.len().min(bytes.len());
+            room[..n].copy_from_slice(&bytes[..n]);
+        }
+        self.pos += bytes.len();
+        Ok(bytes.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+impl Tell for SliceWriter<'_> {
+    fn tell(&self) -> usize {
+        self.pos
+    }
+}
+
+// Helper to write the combined JSON document of an extraction, NUL included
+//
+// Returns the spans of every format; `data` and `len` are left for the caller.
+fn write_combined<W: Tell>(
+    extraction: &Extraction,
+    out: &mut W,
+) -> serde_json::Result<MetaOxideBuffer> {
+    fn entry<W: Tell, T: serde::Serialize>(
+        out: &mut W,
+        first: &mut bool,
+        key: &str,
+        value: &Option<T>,
+    ) -> serde_json::Result<MetaOxideSpan> {
+        let Some(value) = value else {
+            return Ok(MetaOxideSpan::default());
+        };
+        let sep: &[u8] = if *first { b"\"" } else { b",\"" };
+        *first = false;
+        out.write_all(sep).map_err(serde_json::Error::io)?;
+        out.write_all(key.as_bytes()).map_err(serde_json::Error::io)?;
+        out.write_all(b"\":").map_err(serde_json::Error::io)?;
+
+        let offset = out.tell();
+        serde_json::to_writer(&mut *out, value)?;
+        Ok(MetaOxideSpan { offset, len: out.tell() - offset })
+    }
+
+    let mut first = true;
+    out.write_all(b"{").map_err(serde_json::Error::io)?;
+    let buffer = MetaOxideBuffer {
+        meta: entry(out, &mut first, "meta", &extraction.meta)?,
+        open_graph: entry(out, &mut first, "openGraph", &extraction.open_graph)?,
+        twitter: entry(out, &mut first, "twitter", &extraction.twitter)?,
+        json_ld: entry(out, &mut first, "jsonLd", &extraction.json_ld)?,
+        microdata: entry(out, &mut first, "microdata", &extraction.microdata)?,
+        microformats: entry(out, &mut first, "microformats", &extraction.microformats)?,
+        rdfa: entry(out, &mut first, "rdfa", &extraction.rdfa)?,
+        dublin_core: entry(out, &mut first, "dublinCore", &extraction.dublin_core)?,
+        manifest: entry(out, &mut first, "manifest", &extraction.manifest)?,
+        oembed: entry(out, &mut first, "oembed", &extraction.oembed)?,
+        rel_links: entry(out, &mut first, "relLinks", &extraction.rel_links)?,
+        ..MetaOxideBuffer::empty()
+    };
+    out.write_all(b"}\0").map_err(serde_json::Error::io)?;
+    Ok(buffer)
+}
+
+// Helper to write the combined MessagePack document of an extraction, NUL included
+//
+// The same map as `write_combined()`, with the same spans.
+fn write_combined_msgpack(
+    extraction: &Extraction,
+    out: &mut Vec<u8>,
+) -> Result<MetaOxideBuffer, msgpack::Error> {
+    let spans = msgpack::write_extraction(out, extraction)?;
+    out.push(0);
+
+    // Absent formats have the empty range 0..0, matching `MetaOxideSpan::default()`
+    let span = |i: usize| MetaOxideSpan { offset: spans[i].start, len: spans[i].len() };
+    Ok(MetaOxideBuffer {
+        meta: span(0),
+        open_graph: span(1),
+        twitter: span(2),
+        json_ld: span(3),
+        microdata: span(4),
+        microformats: span(5),
+        rdfa: span(6),
+        dublin_core: span(7),
+        manifest: span(8),
+        oembed: span(9),
+        rel_links: span(10),
+        ..MetaOxideBuffer::empty()
+    })
+}
+
+// Helper to write the combined document in the encoding `options` selects
+fn encode_combined(
+    extraction: &Extraction,
+    options: &MetaOxideOptions,
+    out: &mut Vec<u8>,
+) -> Result<MetaOxideBuffer, MetaOxideError> {
+    match options.encoding {
+        META_OXIDE_ENCODING_JSON => {
+            write_combined(extraction, out).map_err(|_| encoding_error("JSON"))
+        }
+        META_OXIDE_ENCODING_MSGPACK => {
+            write_combined_msgpack(extraction, out).map_err(|_| encoding_error("MessagePack"))
+        }
+        other => {
+            set_last_error(
+                MetaOxideError::JsonError,
+                Some(format!("Unknown output encoding {other}")),
+            );
+            Err(MetaOxideError::JsonError)
+        }
+    }
+}
+
+fn encoding_error(encoding: &str) -> MetaOxideError {
+    set_last_error(MetaOxideError::JsonError, Some(format!("Failed to serialize to {encoding}")));
+    MetaOxideError::JsonError
+}
+
+// Helper to record a JSON serialization failure
+fn json_error() -> c_int {
+    encoding_error("JSON") as c_int
+}
+
+/// Extract ALL metadata into one library-owned buffer
+///
+/// Fills `out` with the combined JSON document and the span of every format
+/// (see `MetaOxideBuffer`). Everything lives in a single allocation, so a
+/// binding can hand `out->data` to its JSON parser as is.
+///
+/// # Arguments
+/// * `html` - HTML bytes (must not be NULL)
+/// * `len` - Length of `html` in bytes
+/// * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+/// * `base_len` - Length of `base_url` in bytes
+/// * `options` - Extraction options (may be NULL for defaults); `input_flags`
+///   controls UTF-8 handling as in `meta_oxide_extract_all_n()`
+/// * `out` - Buffer description to fill in (must not be NULL)
+///
+/// # Returns
+/// 0 on success, or an error code; on error `out->data` is NULL
+///
+/// # Memory
+/// The caller must release the buffer using `meta_oxide_buffer_free()`.
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+/// - `out` must point to writable space for a `MetaOxideBuffer`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_all_buffer(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    options: *const MetaOxideOptions,
+    out: *mut MetaOxideBuffer,
+) -> c_int {
+    clear_last_error();
+
+    let Some(out) = out.as_mut() else {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return MetaOxideError::NullPointer as c_int;
+    };
+    *out = MetaOxideBuffer::empty();
+
+    let (extraction, options) = match extract_n(html, len, base_url, base_len, options) {
+        Ok(extracted) => extracted,
+        Err(error) => return error as c_int,
+    };
+
+    let mut data = Vec::new();
+    // The written length excludes the NUL terminator
+    let (written, _) = stats::serialize(
+        &options,
+        || (encode_combined(&extraction, &options, &mut data), data.len().saturating_sub(1)),
+        |&(_, len)| len,
+    );
+    let buffer = match written {
+        Ok(buffer) => buffer,
+        Err(error) => return error as c_int,
+    };
+
+    let len = data.len() - 1;
+    match alloc::bytes(data) {
+        Ok(data) => {
+            *out = buffer;
+            out.len = len;
+            out.data = data;
+            status(&extraction)
+        }
+        Err(error) => {
+            set_last_error(error, Some("Allocator hook returned NULL".to_string()));
+            error as c_int
+        }
+    }
+}
+
+/// Extract ALL metadata into a caller-provided buffer
+///
+/// Same as `meta_oxide_extract_all_buffer()`, but the document is written to
+/// `buf` and nothing is allocated for the output. If it does not fit,
+/// `MetaOxideError::BufferTooSmall` (7) is returned and `out->len` is set to
+/// the document length; retry with at least `out->len + 1` bytes. Passing a
+/// NULL `buf` with `cap` 0 just measures the document.
+///
+/// # Arguments
+/// * `html` - HTML bytes (must not be NULL)
+/// * `len` - Length of `html` in bytes
+/// * `base_url` - Base URL bytes for resolving relative URLs (may be NULL)
+/// * `base_len` - Length of `base_url` in bytes
+/// * `options` - Extraction options (may be NULL for defaults)
+/// * `buf` - Output buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `out` - Buffer description to fill in (must not be NULL); on success
+///   `out->data` is `buf`
+///
+/// # Returns
+/// 0 on success, or an error code; spans are only valid on success
+///
+/// # Memory
+/// Do NOT pass `out` to `meta_oxide_buffer_free()`.
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+/// - `buf` must point to `cap` writable bytes
+/// - `out` must point to writable space for a `MetaOxideBuffer`
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn meta_oxide_extract_all_into(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    options: *const MetaOxideOptions,
+    buf: *mut c_char,
+    cap: usize,
+    out: *mut MetaOxideBuffer,
+) -> c_int {
+    clear_last_error();
+
+    let Some(out) = out.as_mut() else {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return MetaOxideError::NullPointer as c_int;
+    };
+    *out = MetaOxideBuffer::empty();
+
+    if buf.is_null() && cap != 0 {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return MetaOxideError::NullPointer as c_int;
+    }
+
+    let (extraction, options) = match extract_n(html, len, base_url, base_len, options) {
+        Ok(extracted) => extracted,
+        Err(error) => return error as c_int,
+    };
+
+    let buf_slice: &mut [u8] =
+        if cap == 0 { &mut [] } else { std::slice::from_raw_parts_mut(buf.cast(), cap) };
+    let mut writer = SliceWriter { buf: buf_slice, pos: 0 };
+    // The written length excludes the NUL terminator
+    let (written, _) = stats::serialize(
+        &options,
+        || {
+            let written = if options.encoding == META_OXIDE_ENCODING_JSON {
+                write_combined(&extraction, &mut writer).map_err(|_| encoding_error("JSON"))
+            } else {
+                // MessagePack headers are patched after the fact, so encode
+                // into scratch memory and copy; `SliceWriter` never fails
+                let mut data = Vec::new();
+                let encoded = encode_combined(&extraction, &options, &mut data);
+                let _ = writer.write_all(&data);
+                encoded
+            };
+            (written, writer.pos.saturating_sub(1))
+        },
+        |&(_, len)| len,
+    );
+    let buffer = match written {
+        Ok(buffer) => buffer,
+        Err(error) => return error as c_int,
+    };
+
+    if writer.pos > cap {
+        out.len = writer.pos - 1;
+        set_last_error(
+            MetaOxideError::BufferTooSmall,
+            Some(format!("Output needs {} bytes, buffer has {}", writer.pos, cap)),
+        );
+        return MetaOxideError::BufferTooSmall as c_int;
+    }
+
+    *out = buffer;
+    out.len = writer.pos - 1;
+    out.data = buf;
+    status(&extraction)
+}
+
+/// Free a buffer filled in by `meta_oxide_extract_all_buffer()`
+///
+/// `buffer->data` is released and reset to NULL; the struct itself belongs
+/// to the caller.
+///
+/// # Safety
+/// - `buffer` must be NULL or point to a buffer filled in by
+///   `meta_oxide_extract_all_buffer()`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_buffer_free(buffer: *mut MetaOxideBuffer) {
+    if let Some(buffer) = buffer.as_mut() {
+        if !buffer.data.is_null() {
+            alloc::free_bytes(buffer.data, buffer.len + 1);
+        }
+        *buffer = MetaOxideBuffer::empty();
+    }
+}
+
+/// Returned by `meta_oxide_stream_feed()` while more input is needed
+pub const META_OXIDE_STREAM_NEED_MORE: c_int = 0;
+
+/// Returned by `meta_oxide_stream_feed()` once every requested format is complete
+pub const META_OXIDE_STREAM_DONE: c_int = 1;
+
+/// An incremental extraction session (see `meta_oxide_stream_new()`)
+pub struct MetaOxideStream {
+    inner: StreamExtractor,
+}
+
+/// Start an incremental extraction session
+///
+/// Feed the document with `meta_oxide_stream_feed()` as it arrives (for example
+/// while reading an HTTP response body), then call `meta_oxide_stream_finish()`.
+/// Head-level results can be read early with `meta_oxide_stream_head()`.
+///
+/// # Arguments
+/// * `base_url` - Base URL for resolving relative URLs (may be NULL)
+/// * `options` - Extraction options (may be NULL for defaults); only
+///   `META_OXIDE_INPUT_LOSSY` is honoured in `input_flags`
+///
+/// # Memory
+/// The session must be released with `meta_oxide_stream_finish()` or
+/// `meta_oxide_stream_free()`.
+///
+/// # Safety
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_stream_new(
+    base_url: *const c_char,
+    options: *const MetaOxideOptions,
+) -> *mut MetaOxideStream {
+    clear_last_error();
+
+    let options = if options.is_null() { MetaOxideOptions::default() } else { *options };
+    let inner = StreamExtractor::new(from_c_string_opt(base_url), options.to_extract_options())
+        .lossy_utf8(options.input_flags & META_OXIDE_INPUT_LOSSY != 0);
+
+    Box::into_raw(Box::new(MetaOxideStream { inner }))
+}
+
+/// Append a chunk of the document to a stream session
+///
+/// Chunks may split tags and multi-byte characters anywhere; each one goes
+/// straight to the parser rather than being buffered. In head-only mode
+/// (`head_only` set in the options) this returns `META_OXIDE_STREAM_DONE` once
+/// `</head>` has arrived, later chunks are ignored and the caller can stop
+/// reading the document. Other sessions keep returning
+/// `META_OXIDE_STREAM_NEED_MORE`, since tags placed in the body still count.
+///
+/// # Arguments
+/// * `stream` - Session from `meta_oxide_stream_new()` (must not be NULL)
+/// * `chunk` - Chunk bytes (may be NULL if `len` is 0)
+/// * `len` - Length of `chunk` in bytes
+///
+/// # Returns
+/// `META_OXIDE_STREAM_NEED_MORE`, `META_OXIDE_STREAM_DONE`, or -1 on error
+///
+/// # Safety
+/// - `stream` must be a live session
+/// - `chunk` must point to `len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_stream_feed(
+    stream: *mut MetaOxideStream,
+    chunk: *const c_char,
+    len: usize,
+) -> c_int {
+    clear_last_error();
+
+    if stream.is_null() || (chunk.is_null() && len > 0) {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return -1;
+    }
+
+    let chunk =
+        if len == 0 { &[][..] } else { std::slice::from_raw_parts(chunk as *const u8, len) };
+    if (*stream).inner.feed(chunk) {
+        META_OXIDE_STREAM_DONE
+    } else {
+        META_OXIDE_STREAM_NEED_MORE
+    }
+}
+
+/// Get the head-level results of a stream session early
+///
+/// Available as soon as the end of the head section has been fed; the session
+/// stays usable. Only the selected head-level formats (meta, Open Graph,
+/// Twitter, Dublin Core, manifest, oEmbed, rel-links) are filled in, from the
+/// head section alone; the result of `meta_oxide_stream_finish()` also
+/// covers those tags placed in the body.
+///
+/// # Returns
+/// A result struct, or NULL if the head has not fully arrived yet (with
+/// `meta_oxide_last_error()` returning 0) or on error
+///
+/// # Memory
+/// The caller must free the returned struct using `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `stream` must be a live session
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_stream_head(
+    stream: *mut MetaOxideStream,
+) -> *mut MetaOxideResult {
+    clear_last_error();
 
-    // Extract Microdata
-    if let Ok(microdata) = extractors::microdata::extract(html_str, base_url_str) {
-        if !microdata.is_empty() {
-            (*result).microdata = to_json_c_string(&microdata);
-        }
+    if stream.is_null() {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return ptr::null_mut();
     }
 
-    // Extract Microformats (all 9 types)
-    if let Ok(microformats) = parser::parse_html(html_str, base_url_str) {
-        if !microformats.is_empty() {
-            (*result).microformats = to_json_c_string(&microformats);
-        }
+    let inner = &mut (*stream).inner;
+    if !inner.head_complete() {
+        return ptr::null_mut();
     }
-
-    // Extract RDFa
-    if let Ok(rdfa) = extractors::rdfa::extract(html_str, base_url_str) {
-        if !rdfa.is_empty() {
-            (*result).rdfa = to_json_c_string(&rdfa);
+    match inner.head() {
+        Some(extraction) => to_result(extraction),
+        None => {
+            set_last_error(
+                MetaOxideError::InvalidUtf8,
+                Some("Invalid UTF-8 in document head".to_string()),
+            );
+            ptr::null_mut()
         }
     }
+}
 
-    // Extract Dublin Core
-    if let Ok(dc) = extractors::dublin_core::extract(html_str) {
-        (*result).dublin_core = to_json_c_string(&dc);
-    }
+/// Finish a stream session and extract every requested format
+///
+/// Extracts the formats selected by the session's `head_only` and `formats`
+/// options from everything fed so far (the head section alone in head-only
+/// mode). Unlike `meta_oxide_extract_all_with_options()`, `limits` and
+/// `stats` are not honoured, nor any `input_flags` but
+/// `META_OXIDE_INPUT_LOSSY`. The session is freed whether or not this
+/// succeeds.
+///
+/// # Returns
+/// A result struct, or NULL on error
+///
+/// # Memory
+/// The caller must free the returned struct using `meta_oxide_result_free()`.
+///
+/// # Safety
+/// - `stream` must be a live session; it must not be used afterwards
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_stream_finish(
+    stream: *mut MetaOxideStream,
+) -> *mut MetaOxideResult {
+    clear_last_error();
 
-    // Extract Web App Manifest
-    if let Ok(manifest) = extractors::manifest::extract(html_str, base_url_str) {
-        if manifest.href.is_some() {
-            (*result).manifest = to_json_c_string(&manifest);
-        }
+    if stream.is_null() {
+        set_last_error(
+            MetaOxideError::NullPointer,
+            Some("NULL pointer passed as argument".to_string()),
+        );
+        return ptr::null_mut();
     }
 
-    // Extract oEmbed
-    if let Ok(oembed) = extractors::oembed::extract(html_str, base_url_str) {
-        if oembed.has_endpoints() {
-            (*result).oembed = to_json_c_string(&oembed);
+    match Box::from_raw(stream).inner.finish() {
+        Ok(extraction) => to_result(&extraction),
+        Err(err) => {
+            set_last_error(MetaOxideError::InvalidUtf8, Some(err.to_string()));
+            ptr::null_mut()
         }
     }
+}
 
-    // Extract rel-* links
-    if let Ok(rel_links) = extractors::rel_links::extract(html_str, base_url_str) {
-        if !rel_links.is_empty() {
-            (*result).rel_links = to_json_c_string(&rel_links);
-        }
+/// Free a stream session without extracting anything
+///
+/// # Safety
+/// - `stream` must be NULL or a live session; it must not be used afterwards
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_stream_free(stream: *mut MetaOxideStream) {
+    if !stream.is_null() {
+        drop(Box::from_raw(stream));
     }
-
-    result
 }
 
 /// Extract standard HTML meta tags
@@ -305,6 +1754,61 @@ pub unsafe extern "C" fn meta_oxide_extract_meta(
     }
 }
 
+/// Extract standard HTML meta tags from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_meta_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::meta::extract)
+}
+
+/// Extract standard HTML meta tags into a caller-provided buffer
+///
+/// Writes the same NUL-terminated JSON as `meta_oxide_extract_meta()` to
+/// `buf`, so the output lands in caller memory and can reuse one buffer
+/// across calls. If it does not fit, `MetaOxideError::BufferTooSmall` (7) is
+/// returned and `buf` holds a truncated, NUL-terminated prefix. Passing a
+/// NULL `buf` with `cap` 0 just measures the output.
+///
+/// # Arguments
+/// * `html` - HTML content (must not be NULL)
+/// * `base_url` - Base URL for resolving relative URLs (may be NULL)
+/// * `buf` - Output buffer (may be NULL if `cap` is 0)
+/// * `cap` - Size of `buf` in bytes
+/// * `needed` - Set to the output size in bytes, terminator included (may be NULL)
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_meta_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::meta::extract)
+}
+
 /// Extract Open Graph metadata
 ///
 /// # Returns
@@ -331,6 +1835,50 @@ pub unsafe extern "C" fn meta_oxide_extract_open_graph(
     }
 }
 
+/// Extract Open Graph metadata from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_open_graph_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::social::extract_opengraph)
+}
+
+/// Extract Open Graph metadata into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_open_graph_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::social::extract_opengraph)
+}
+
 /// Extract Twitter Card metadata
 ///
 /// # Returns
@@ -357,6 +1905,64 @@ pub unsafe extern "C" fn meta_oxide_extract_twitter(
     }
 }
 
+/// Extract Twitter Card metadata from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_twitter_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(
+        html,
+        len,
+        base_url,
+        base_len,
+        flags,
+        extractors::social::extract_twitter_with_fallback,
+    )
+}
+
+/// Extract Twitter Card metadata into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_twitter_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(
+        html,
+        base_url,
+        buf,
+        cap,
+        needed,
+        extractors::social::extract_twitter_with_fallback,
+    )
+}
+
 /// Extract JSON-LD structured data
 ///
 /// # Returns
@@ -383,6 +1989,112 @@ pub unsafe extern "C" fn meta_oxide_extract_json_ld(
     }
 }
 
+/// Extract the JSON-LD objects of the given `@type`s
+///
+/// Returns what `meta_oxide_extract_json_ld()` would with only the objects
+/// whose `@type` (or one of them) is in `types`, and on those only the listed
+/// `properties`. Scripts are scanned without building the objects that are
+/// dropped, so unwanted `@graph` members such as large `ItemList`s cost no
+/// allocation.
+///
+/// # Arguments
+/// * `html` - HTML content (must not be NULL)
+/// * `_base_url` - Base URL (may be NULL; not used for JSON-LD)
+/// * `types` - Array of `types_len` `@type` values to keep; an empty array
+///   keeps every object
+/// * `properties` - Array of `properties_len` property names to keep, or NULL
+///   to keep them all; `@context`, `@type` and `@id` are always kept
+///
+/// # Returns
+/// JSON array string or NULL on error
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `types` must point to `types_len` valid null-terminated C strings
+/// - `properties` may be NULL or must point to `properties_len` valid
+///   null-terminated C strings
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_json_ld_filtered(
+    html: *const c_char,
+    _base_url: *const c_char,
+    types: *const *const c_char,
+    types_len: usize,
+    properties: *const *const c_char,
+    properties_len: usize,
+) -> *mut c_char {
+    clear_last_error();
+
+    let html_str = match from_c_string(html) {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+    let Ok(types) = from_c_string_array(types, types_len) else {
+        return ptr::null_mut();
+    };
+    let properties = if properties.is_null() {
+        None
+    } else {
+        match from_c_string_array(properties, properties_len) {
+            Ok(names) => Some(names),
+            Err(_) => return ptr::null_mut(),
+        }
+    };
+
+    let filter = extractors::jsonld::Filter { types: &types, properties: properties.as_deref() };
+    match extractors::jsonld::extract_filtered(html_str, &filter) {
+        Ok(items) => to_json_c_string(&items),
+        Err(e) => {
+            set_last_error(MetaOxideError::ParseError, Some(e.to_string()));
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Extract JSON-LD structured data from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_json_ld_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::jsonld::extract)
+}
+
+/// Extract JSON-LD structured data into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_json_ld_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::jsonld::extract)
+}
+
 /// Extract Microdata
 ///
 /// # Returns
@@ -409,6 +2121,50 @@ pub unsafe extern "C" fn meta_oxide_extract_microdata(
     }
 }
 
+/// Extract Microdata items from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_microdata_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::microdata::extract)
+}
+
+/// Extract Microdata items into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_microdata_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::microdata::extract)
+}
+
 /// Extract Microformats (all 9 types: h-card, h-entry, h-event, etc.)
 ///
 /// # Returns
@@ -435,6 +2191,50 @@ pub unsafe extern "C" fn meta_oxide_extract_microformats(
     }
 }
 
+/// Extract all Microformats from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_microformats_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, parser::parse_html)
+}
+
+/// Extract all Microformats into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_microformats_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, parser::parse_html)
+}
+
 /// Extract RDFa structured data
 ///
 /// # Returns
@@ -461,6 +2261,50 @@ pub unsafe extern "C" fn meta_oxide_extract_rdfa(
     }
 }
 
+/// Extract RDFa structured data from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_rdfa_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::rdfa::extract)
+}
+
+/// Extract RDFa structured data into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_rdfa_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::rdfa::extract)
+}
+
 /// Extract Dublin Core metadata
 ///
 /// # Returns
@@ -483,6 +2327,49 @@ pub unsafe extern "C" fn meta_oxide_extract_dublin_core(html: *const c_char) ->
     }
 }
 
+/// Extract Dublin Core metadata from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_dublin_core_n(
+    html: *const c_char,
+    len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, ptr::null(), 0, flags, |html, _| {
+        extractors::dublin_core::extract(html)
+    })
+}
+
+/// Extract Dublin Core metadata into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_dublin_core_into(
+    html: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, ptr::null(), buf, cap, needed, |html, _| {
+        extractors::dublin_core::extract(html)
+    })
+}
+
 /// Extract Web App Manifest link
 ///
 /// # Returns
@@ -509,6 +2396,50 @@ pub unsafe extern "C" fn meta_oxide_extract_manifest(
     }
 }
 
+/// Extract Web App Manifest link from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_manifest_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::manifest::extract)
+}
+
+/// Extract Web App Manifest link into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_manifest_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::manifest::extract)
+}
+
 /// Parse Web App Manifest JSON content
 ///
 /// # Returns
@@ -561,6 +2492,50 @@ pub unsafe extern "C" fn meta_oxide_extract_oembed(
     }
 }
 
+/// Extract oEmbed endpoints from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_oembed_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::oembed::extract)
+}
+
+/// Extract oEmbed endpoints into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_oembed_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::oembed::extract)
+}
+
 /// Extract rel-* link relationships
 ///
 /// # Returns
@@ -587,6 +2562,50 @@ pub unsafe extern "C" fn meta_oxide_extract_rel_links(
     }
 }
 
+/// Extract rel-* link relationships from a length-delimited HTML buffer
+///
+/// See `meta_oxide_extract_all_n()` for the input conventions.
+///
+/// # Returns
+/// JSON string or NULL on error
+///
+/// # Safety
+/// - `html` must point to `len` readable bytes
+/// - `base_url` may be NULL or must point to `base_len` readable bytes
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_rel_links_n(
+    html: *const c_char,
+    len: usize,
+    base_url: *const c_char,
+    base_len: usize,
+    flags: u32,
+) -> *mut c_char {
+    extract_json_n(html, len, base_url, base_len, flags, extractors::rel_links::extract)
+}
+
+/// Extract rel-* link relationships into a caller-provided buffer
+///
+/// See `meta_oxide_extract_meta_into()` for the buffer conventions.
+///
+/// # Returns
+/// 0 on success, or an error code
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `buf` must point to `cap` writable bytes
+/// - `needed` may be NULL or must point to a writable `size_t`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_rel_links_into(
+    html: *const c_char,
+    base_url: *const c_char,
+    buf: *mut c_char,
+    cap: usize,
+    needed: *mut usize,
+) -> c_int {
+    extract_json_into(html, base_url, buf, cap, needed, extractors::rel_links::extract)
+}
+
 /// Get the last error code
 ///
 /// Returns MetaOxideError::Ok (0) if no error occurred
@@ -619,6 +2638,8 @@ pub extern "C" fn meta_oxide_error_message() -> *const c_char {
             MetaOxideError::MemoryError => "Memory allocation error\0",
             MetaOxideError::JsonError => "JSON serialization error\0",
             MetaOxideError::NullPointer => "NULL pointer passed as argument\0",
+            MetaOxideError::BufferTooSmall => "Output buffer too small\0",
+            MetaOxideError::LimitExceeded => "Resource limit exceeded\0",
         };
 
         // If there's a detailed message, we'd need to store it in thread-local storage
@@ -644,37 +2665,37 @@ pub unsafe extern "C" fn meta_oxide_result_free(result: *mut MetaOxideResult) {
 
     // Free all individual strings
     if !result.meta.is_null() {
-        let _ = CString::from_raw(result.meta);
+        alloc::free_c_string(result.meta);
     }
     if !result.open_graph.is_null() {
-        let _ = CString::from_raw(result.open_graph);
+        alloc::free_c_string(result.open_graph);
     }
     if !result.twitter.is_null() {
-        let _ = CString::from_raw(result.twitter);
+        alloc::free_c_string(result.twitter);
     }
     if !result.json_ld.is_null() {
-        let _ = CString::from_raw(result.json_ld);
+        alloc::free_c_string(result.json_ld);
     }
     if !result.microdata.is_null() {
-        let _ = CString::from_raw(result.microdata);
+        alloc::free_c_string(result.microdata);
     }
     if !result.microformats.is_null() {
-        let _ = CString::from_raw(result.microformats);
+        alloc::free_c_string(result.microformats);
     }
     if !result.rdfa.is_null() {
-        let _ = CString::from_raw(result.rdfa);
+        alloc::free_c_string(result.rdfa);
     }
     if !result.dublin_core.is_null() {
-        let _ = CString::from_raw(result.dublin_core);
+        alloc::free_c_string(result.dublin_core);
     }
     if !result.manifest.is_null() {
-        let _ = CString::from_raw(result.manifest);
+        alloc::free_c_string(result.manifest);
     }
     if !result.oembed.is_null() {
-        let _ = CString::from_raw(result.oembed);
+        alloc::free_c_string(result.oembed);
     }
     if !result.rel_links.is_null() {
-        let _ = CString::from_raw(result.rel_links);
+        alloc::free_c_string(result.rel_links);
     }
 
     // Box is dropped automatically here
@@ -689,7 +2710,7 @@ pub unsafe extern "C" fn meta_oxide_result_free(result: *mut MetaOxideResult) {
 #[no_mangle]
 pub unsafe extern "C" fn meta_oxide_string_free(s: *mut c_char) {
     if !s.is_null() {
-        let _ = CString::from_raw(s);
+        alloc::free_c_string(s);
     }
 }
 
@@ -708,10 +2729,10 @@ pub unsafe extern "C" fn meta_oxide_manifest_discovery_free(discovery: *mut Mani
     let discovery = Box::from_raw(discovery);
 
     if !discovery.href.is_null() {
-        let _ = CString::from_raw(discovery.href);
+        alloc::free_c_string(discovery.href);
     }
     if !discovery.manifest.is_null() {
-        let _ = CString::from_raw(discovery.manifest);
+        alloc::free_c_string(discovery.manifest);
     }
 }
 
@@ -750,6 +2771,572 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_extract_all_head_only() {
+        let html = CString::new(
+            r#"
+            <html>
+                <head>
+                    <title>Test Page</title>
+                    <script type="application/ld+json">{"@type": "Article"}</script>
+                </head>
+                <body>
+                    <div itemscope itemtype="https://schema.org/Person">
+                        <span itemprop="name">Jane</span>
+                    </div>
+                    <a rel="me" href="https://example.com/me">Me</a>
+                </body>
+            </html>
+        "#,
+        )
+        .unwrap();
+        let options = MetaOxideOptions { head_only: true, ..Default::default() };
+
+        unsafe {
+            let result = meta_oxide_extract_all_with_options(html.as_ptr(), ptr::null(), &options);
+            assert!(!result.is_null());
+            assert!(!(*result).meta.is_null());
+            assert!(!(*result).json_ld.is_null());
+            assert!((*result).microdata.is_null());
+            assert!((*result).rel_links.is_null());
+            meta_oxide_result_free(result);
+
+            let result =
+                meta_oxide_extract_all_with_options(html.as_ptr(), ptr::null(), ptr::null());
+            assert!(!(*result).microdata.is_null());
+            assert!(!(*result).rel_links.is_null());
+            meta_oxide_result_free(result);
+        }
+    }
+
+    #[test]
+    fn test_extract_selected_formats() {
+        let html = CString::new(
+            r#"
+            <html>
+                <head>
+                    <title>Test Page</title>
+                    <meta property="og:title" content="OG Title">
+                </head>
+                <body>
+                    <div itemscope itemtype="https://schema.org/Person">
+                        <span itemprop="name">Jane</span>
+                    </div>
+                </body>
+            </html>
+        "#,
+        )
+        .unwrap();
+
+        unsafe {
+            let result = meta_oxide_extract_selected(
+                html.as_ptr(),
+                ptr::null(),
+                META_OXIDE_FMT_OPEN_GRAPH | META_OXIDE_FMT_MICRODATA,
+            );
+            assert!(!result.is_null());
+            assert!(!(*result).open_graph.is_null());
+            assert!(!(*result).microdata.is_null());
+            assert!((*result).meta.is_null());
+            assert!((*result).twitter.is_null());
+            meta_oxide_result_free(result);
+
+            // A mask of 0 selects everything, here and in the options struct
+            let result = meta_oxide_extract_selected(html.as_ptr(), ptr::null(), 0);
+            assert!(!result.is_null());
+            assert!(!(*result).meta.is_null());
+            assert!(!(*result).open_graph.is_null());
+            assert!(!(*result).microdata.is_null());
+            meta_oxide_result_free(result);
+
+            let options = MetaOxideOptions { formats: 0, ..Default::default() };
+            let result = meta_oxide_extract_all_with_options(html.as_ptr(), ptr::null(), &options);
+            assert!(!(*result).meta.is_null());
+            assert!(!(*result).microdata.is_null());
+            meta_oxide_result_free(result);
+        }
+    }
+
+    #[test]
+    fn test_extract_batch() {
+        let first = CString::new("<title>First</title>").unwrap();
+        let second = CString::new(r#"<meta property="og:title" content="Second">"#).unwrap();
+        let base = CString::new("https://example.com").unwrap();
+        let docs = [
+            MetaOxideInput { html: first.as_ptr(), base_url: ptr::null() },
+            MetaOxideInput { html: ptr::null(), base_url: ptr::null() },
+            MetaOxideInput { html: second.as_ptr(), base_url: base.as_ptr() },
+        ];
+        let mut out = [ptr::null_mut(); 3];
+        let mut errors = [-1; 3];
+
+        unsafe {
+            let status = meta_oxide_extract_batch(
+                docs.as_ptr(),
+                docs.len(),
+                ptr::null(),
+                out.as_mut_ptr(),
+                errors.as_mut_ptr(),
+            );
+            assert_eq!(status, MetaOxideError::Ok as c_int);
+            assert_eq!(errors, [0, MetaOxideError::NullPointer as c_int, 0]);
+
+            assert!(!(*out[0]).meta.is_null());
+            assert!(out[1].is_null());
+            assert!(!(*out[2]).open_graph.is_null());
+
+            for result in out {
+                meta_oxide_result_free(result);
+            }
+
+            let status = meta_oxide_extract_batch(
+                ptr::null(),
+                1,
+                ptr::null(),
+                out.as_mut_ptr(),
+                ptr::null_mut(),
+            );
+            assert_eq!(status, MetaOxideError::NullPointer as c_int);
+        }
+    }
+
+    #[test]
+    fn test_extract_batch_honours_input_flags() {
+        // Latin-1 "é", invalid as UTF-8
+        let html = CString::new(b"<title>Caf\xe9</title>".to_vec()).unwrap();
+        let docs = [MetaOxideInput { html: html.as_ptr(), base_url: ptr::null() }];
+        let mut out = [ptr::null_mut()];
+        let mut errors = [-1];
+
+        unsafe {
+            meta_oxide_extract_batch(
+                docs.as_ptr(),
+                1,
+                ptr::null(),
+                out.as_mut_ptr(),
+                errors.as_mut_ptr(),
+            );
+            assert_eq!(errors, [MetaOxideError::InvalidUtf8 as c_int]);
+            assert!(out[0].is_null());
+
+            for flags in [META_OXIDE_INPUT_LOSSY, META_OXIDE_INPUT_DETECT_ENCODING] {
+                let options = MetaOxideOptions { input_flags: flags, ..Default::default() };
+                meta_oxide_extract_batch(
+                    docs.as_ptr(),
+                    1,
+                    &options,
+                    out.as_mut_ptr(),
+                    errors.as_mut_ptr(),
+                );
+                assert_eq!(errors, [0]);
+                assert!(!(*out[0]).meta.is_null());
+                meta_oxide_result_free(out[0]);
+            }
+        }
+    }
+
+    #[test]
+    fn test_extract_all_n_length_delimited() {
+        // The document is a slice of a larger buffer and contains a NUL byte
+        let buffer =
+            b"<title>Slice\0Title</title><meta name=\"description\" content=\"D\">TRAILING";
+        let len = buffer.len() - b"TRAILING".len();
+        let base = b"https://example.com/ignored";
+
+        unsafe {
+            let result =
+                meta_oxide_extract_all_n(buffer.as_ptr().cast(), len, base.as_ptr().cast(), 19, 0);
+            assert!(!result.is_null());
+            let meta = CStr::from_ptr((*result).meta).to_str().unwrap();
+            assert!(meta.contains("Slice"));
+            assert!(!meta.contains("TRAILING"));
+            meta_oxide_result_free(result);
+        }
+    }
+
+    #[test]
+    fn test_extract_n_invalid_utf8() {
+        let html = b"<title>Caf\xE9</title>";
+
+        unsafe {
+            let json =
+                meta_oxide_extract_meta_n(html.as_ptr().cast(), html.len(), ptr::null(), 0, 0);
+            assert!(json.is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::InvalidUtf8 as c_int);
+
+            let json = meta_oxide_extract_meta_n(
+                html.as_ptr().cast(),
+                html.len(),
+                ptr::null(),
+                0,
+                META_OXIDE_INPUT_LOSSY,
+            );
+            assert!(!json.is_null());
+            assert!(CStr::from_ptr(json).to_str().unwrap().contains('\u{FFFD}'));
+            meta_oxide_string_free(json);
+
+            let json = meta_oxide_extract_dublin_core_n(ptr::null(), 0, 0);
+            assert!(json.is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::NullPointer as c_int);
+        }
+    }
+
+    #[test]
+    fn test_detect_encoding_input() {
+        let html = b"<meta charset=windows-1251><title>\xcf\xf0\xe8</title>";
+        let utf8 = "<title>При</title>";
+
+        unsafe {
+            let flags = META_OXIDE_INPUT_DETECT_ENCODING;
+            let text = from_c_bytes(html.as_ptr().cast(), html.len(), flags, None).unwrap();
+            assert!(text.contains("При"));
+
+            // The header hint outranks the <meta> declaration
+            let hint = Some("text/html; charset=iso-8859-1");
+            let text = from_c_bytes(html.as_ptr().cast(), html.len(), flags, hint).unwrap();
+            assert!(text.contains("\u{cf}"));
+
+            let text = from_c_bytes(utf8.as_ptr().cast(), utf8.len(), flags, None).unwrap();
+            assert!(matches!(text, Cow::Borrowed(s) if s == utf8));
+        }
+    }
+
+    #[test]
+    fn test_json_ld_filter_arguments() {
+        let product = CString::new("Product").unwrap();
+        let types = [product.as_ptr()];
+
+        unsafe {
+            assert_eq!(from_c_string_array(types.as_ptr(), 1).unwrap(), ["Product"]);
+            assert!(from_c_string_array(ptr::null(), 0).unwrap().is_empty());
+
+            let missing = [ptr::null()];
+            assert!(from_c_string_array(missing.as_ptr(), 1).is_err());
+
+            let json = meta_oxide_extract_json_ld_filtered(
+                ptr::null(),
+                ptr::null(),
+                types.as_ptr(),
+                1,
+                ptr::null(),
+                0,
+            );
+            assert!(json.is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::NullPointer as c_int);
+
+            let html = CString::new("<p>no scripts</p>").unwrap();
+            let json = meta_oxide_extract_json_ld_filtered(
+                html.as_ptr(),
+                ptr::null(),
+                ptr::null(),
+                1,
+                ptr::null(),
+                0,
+            );
+            assert!(json.is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::NullPointer as c_int);
+        }
+    }
+
+    #[test]
+    fn test_context_reuse() {
+        let first = CString::new("<title>First</title>").unwrap();
+        let second = CString::new(r#"<meta property="og:title" content="Second">"#).unwrap();
+
+        unsafe {
+            let ctx = meta_oxide_context_new();
+
+            let a = meta_oxide_context_extract_all(ctx, first.as_ptr(), ptr::null(), ptr::null());
+            let b = meta_oxide_context_extract_all(ctx, second.as_ptr(), ptr::null(), ptr::null());
+            assert!(!a.is_null() && !b.is_null());
+
+            // Both results stay valid until the reset
+            assert!(CStr::from_ptr((*a).meta).to_str().unwrap().contains("First"));
+            assert!(CStr::from_ptr((*b).open_graph).to_str().unwrap().contains("Second"));
+
+            meta_oxide_context_reset(ctx);
+            let c = meta_oxide_context_extract_all(ctx, second.as_ptr(), ptr::null(), ptr::null());
+            assert_eq!(c, a, "result structs are recycled after a reset");
+            assert!(CStr::from_ptr((*c).open_graph).to_str().unwrap().contains("Second"));
+
+            assert!(meta_oxide_context_extract_all(ctx, ptr::null(), ptr::null(), ptr::null())
+                .is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::NullPointer as c_int);
+
+            meta_oxide_context_free(ctx);
+        }
+    }
+
+    #[test]
+    fn test_combined_layout() {
+        let extraction = Extraction {
+            meta: Some(crate::types::meta::MetaTags {
+                title: Some("Combined".to_string()),
+                ..Default::default()
+            }),
+            json_ld: Some(Vec::new()),
+            ..Default::default()
+        };
+
+        let mut data = Vec::new();
+        let buffer = write_combined(&extraction, &mut data).unwrap();
+        assert_eq!(data.pop(), Some(0));
+
+        let doc: serde_json::Value = serde_json::from_slice(&data).unwrap();
+        assert_eq!(doc["meta"]["title"], "Combined");
+        assert_eq!(doc["jsonLd"], serde_json::json!([]));
+        assert!(doc.get("openGraph").is_none());
+
+        let span = |s: MetaOxideSpan| &data[s.offset..s.offset + s.len];
+        assert_eq!(span(buffer.json_ld), b"[]");
+        assert_eq!(
+            serde_json::from_slice::<serde_json::Value>(span(buffer.meta)).unwrap(),
+            doc["meta"]
+        );
+        assert_eq!(buffer.open_graph, MetaOxideSpan::default());
+
+        // A short buffer keeps what fits and reports the full size
+        let mut small = [0u8; 8];
+        let mut writer = SliceWriter { buf: &mut small, pos: 0 };
+        write_combined(&extraction, &mut writer).unwrap();
+        assert_eq!(writer.pos, data.len() + 1);
+        assert_eq!(&small, &data[..8]);
+    }
+
+    #[test]
+    fn test_combined_msgpack_layout() {
+        let extraction = Extraction {
+            meta: Some(crate::types::meta::MetaTags {
+                title: Some("Packed".to_string()),
+                ..Default::default()
+            }),
+            json_ld: Some(Vec::new()),
+            ..Default::default()
+        };
+
+        let mut data = Vec::new();
+        let buffer = write_combined_msgpack(&extraction, &mut data).unwrap();
+        assert_eq!(data.pop(), Some(0));
+
+        // A two-entry map, "meta" first
+        assert_eq!(&data[..6], &[0x82, 0xa4, b'm', b'e', b't', b'a']);
+        let span = |s: MetaOxideSpan| &data[s.offset..s.offset + s.len];
+        let meta = extraction.meta.as_ref().unwrap();
+        assert_eq!(span(buffer.meta), msgpack::to_vec(meta).unwrap());
+        assert_eq!(span(buffer.json_ld), &[0x90]);
+        assert_eq!(buffer.open_graph, MetaOxideSpan::default());
+        assert_eq!(buffer.json_ld.offset + 1, data.len());
+
+        let mut json = Vec::new();
+        write_combined(&extraction, &mut json).unwrap();
+        assert!(data.len() < json.len());
+
+        let options = MetaOxideOptions { encoding: 7, ..Default::default() };
+        assert!(encode_combined(&extraction, &options, &mut Vec::new()).is_err());
+    }
+
+    #[test]
+    fn test_extract_all_buffer() {
+        let html = r#"<title>Buffered</title><meta property="og:title" content="OG">"#;
+
+        unsafe {
+            let mut out = MetaOxideBuffer::empty();
+            let status = meta_oxide_extract_all_buffer(
+                html.as_ptr().cast(),
+                html.len(),
+                ptr::null(),
+                0,
+                ptr::null(),
+                &mut out,
+            );
+            assert_eq!(status, MetaOxideError::Ok as c_int);
+            let doc = CStr::from_ptr(out.data).to_bytes();
+            assert_eq!(doc.len(), out.len);
+            let og = &doc[out.open_graph.offset..][..out.open_graph.len];
+            assert!(std::str::from_utf8(og).unwrap().contains("\"OG\""));
+
+            // Measure, then fill a caller buffer with the same document
+            let mut into = MetaOxideBuffer::empty();
+            let status = meta_oxide_extract_all_into(
+                html.as_ptr().cast(),
+                html.len(),
+                ptr::null(),
+                0,
+                ptr::null(),
+                ptr::null_mut(),
+                0,
+                &mut into,
+            );
+            assert_eq!(status, MetaOxideError::BufferTooSmall as c_int);
+            assert_eq!(into.len, out.len);
+
+            let mut storage = vec![0 as c_char; into.len + 1];
+            let status = meta_oxide_extract_all_into(
+                html.as_ptr().cast(),
+                html.len(),
+                ptr::null(),
+                0,
+                ptr::null(),
+                storage.as_mut_ptr(),
+                storage.len(),
+                &mut into,
+            );
+            assert_eq!(status, MetaOxideError::Ok as c_int);
+            assert_eq!(CStr::from_ptr(into.data).to_bytes(), doc);
+            assert_eq!(into.open_graph, out.open_graph);
+
+            meta_oxide_buffer_free(&mut out);
+            assert!(out.data.is_null());
+        }
+    }
+
+    #[test]
+    fn test_extract_meta_into() {
+        let html = CString::new("<title>Into</title>").unwrap();
+        let mut needed = 0;
+
+        unsafe {
+            let status = meta_oxide_extract_meta_into(
+                html.as_ptr(),
+                ptr::null(),
+                ptr::null_mut(),
+                0,
+                &mut needed,
+            );
+            assert_eq!(status, MetaOxideError::BufferTooSmall as c_int);
+
+            let mut small = [1 as c_char; 4];
+            let status = meta_oxide_extract_meta_into(
+                html.as_ptr(),
+                ptr::null(),
+                small.as_mut_ptr(),
+                4,
+                ptr::null_mut(),
+            );
+            assert_eq!(status, MetaOxideError::BufferTooSmall as c_int);
+            assert_eq!(small[3], 0, "truncated output stays terminated");
+
+            let mut buf = vec![0 as c_char; needed];
+            let status = meta_oxide_extract_meta_into(
+                html.as_ptr(),
+                ptr::null(),
+                buf.as_mut_ptr(),
+                buf.len(),
+                &mut needed,
+            );
+            assert_eq!(status, MetaOxideError::Ok as c_int);
+            let json = CStr::from_ptr(buf.as_ptr()).to_str().unwrap();
+            assert_eq!(json.len() + 1, needed);
+            assert!(json.contains("Into"));
+
+            let json_n = meta_oxide_extract_meta(html.as_ptr(), ptr::null());
+            assert_eq!(CStr::from_ptr(json_n).to_str().unwrap(), json);
+            meta_oxide_string_free(json_n);
+        }
+    }
+
+    #[test]
+    fn test_extract_with_stats() {
+        let html = CString::new(
+            r#"<title>Stats</title><script type="application/ld+json">[{"@type": "A"}, {"@type": "B"}]</script>"#,
+        )
+        .unwrap();
+        let mut stats = MetaOxideStats::default();
+        let options = MetaOxideOptions {
+            formats: META_OXIDE_FMT_META | META_OXIDE_FMT_JSON_LD,
+            stats: &mut stats,
+            ..Default::default()
+        };
+
+        unsafe {
+            let result = meta_oxide_extract_all_with_options(html.as_ptr(), ptr::null(), &options);
+            assert!(!result.is_null());
+            let output = CStr::from_ptr((*result).meta).to_bytes().len()
+                + CStr::from_ptr((*result).json_ld).to_bytes().len();
+            meta_oxide_result_free(result);
+
+            assert_eq!(stats.input_bytes, html.as_bytes().len());
+            assert_eq!(stats.output_bytes, output);
+            assert!(stats.dom_nodes > 0);
+            assert_eq!(stats.items[formats::index(formats::JSON_LD)], 2);
+            assert_eq!(stats.items[formats::index(formats::META)], 1);
+            assert_eq!(stats.format_ns[formats::index(formats::RDFA)], 0);
+            assert!(stats.total_ns >= stats.parse_ns + stats.serialize_ns);
+        }
+    }
+
+    #[test]
+    fn test_limit_exceeded_returns_partial_result() {
+        let html = CString::new(format!("<title>Kept</title>{}", "<p>x</p>".repeat(100))).unwrap();
+        let limits = MetaOxideLimits { max_tags: 4, ..Default::default() };
+        let options = MetaOxideOptions { limits: &limits, ..Default::default() };
+
+        unsafe {
+            let result = meta_oxide_extract_all_with_options(html.as_ptr(), ptr::null(), &options);
+            assert!(!result.is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::LimitExceeded as c_int);
+            assert!(CStr::from_ptr((*result).meta).to_str().unwrap().contains("Kept"));
+            meta_oxide_result_free(result);
+
+            let mut buffer = MetaOxideBuffer::empty();
+            let status = meta_oxide_extract_all_buffer(
+                html.as_ptr(),
+                html.as_bytes().len(),
+                ptr::null(),
+                0,
+                &options,
+                &mut buffer,
+            );
+            assert_eq!(status, MetaOxideError::LimitExceeded as c_int);
+            assert!(!buffer.data.is_null());
+            meta_oxide_buffer_free(&mut buffer);
+        }
+    }
+
+    #[test]
+    fn test_stream_session() {
+        let chunks: [&[u8]; 3] = [
+            b"<html><head><title>Stre",
+            b"amed</title><meta property=\"og:title\" content=\"OG\"></head>",
+            b"<body><p>never needed</p></body></html>",
+        ];
+        let options = MetaOxideOptions {
+            formats: META_OXIDE_FMT_META | META_OXIDE_FMT_OPEN_GRAPH,
+            head_only: true,
+            ..Default::default()
+        };
+
+        unsafe {
+            let stream = meta_oxide_stream_new(ptr::null(), &options);
+            assert!(!stream.is_null());
+
+            let feed =
+                |chunk: &[u8]| meta_oxide_stream_feed(stream, chunk.as_ptr().cast(), chunk.len());
+            assert_eq!(feed(chunks[0]), META_OXIDE_STREAM_NEED_MORE);
+            assert!(meta_oxide_stream_head(stream).is_null());
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::Ok as c_int);
+
+            // `</head>` ends the second chunk; the body is never needed
+            assert_eq!(feed(chunks[1]), META_OXIDE_STREAM_DONE);
+            assert_eq!(feed(chunks[2]), META_OXIDE_STREAM_DONE);
+
+            let head = meta_oxide_stream_head(stream);
+            assert!(!head.is_null());
+            assert!(CStr::from_ptr((*head).meta).to_str().unwrap().contains("Streamed"));
+            meta_oxide_result_free(head);
+
+            let result = meta_oxide_stream_finish(stream);
+            assert!(!result.is_null());
+            assert!(!(*result).open_graph.is_null());
+            assert!((*result).json_ld.is_null());
+            meta_oxide_result_free(result);
+
+            assert_eq!(meta_oxide_stream_feed(ptr::null_mut(), ptr::null(), 0), -1);
+            assert_eq!(meta_oxide_last_error(), MetaOxideError::NullPointer as c_int);
+            meta_oxide_stream_free(ptr::null_mut());
+        }
+    }
+
     #[test]
     fn test_extract_meta() {
         let html = CString::new(
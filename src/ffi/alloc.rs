@@ -0,0 +1,146 @@
+//! Allocator hooks for memory handed to C callers
+//!
+//! Strings returned through the C API (and the data of library-owned
+//! `MetaOxideBuffer`s) come from the Rust global allocator unless the caller
+//! installs its own functions with `meta_oxide_set_allocator()`. The matching
+//! `*_free()` functions release memory through the same hooks, so a caller
+//! never has to mix allocators. Result structs, contexts and typed results
+//! stay internal and are unaffected.
+
+use std::ffi::{c_void, CString};
+use std::os::raw::{c_char, c_int};
+use std::ptr;
+use std::sync::{PoisonError, RwLock};
+
+use super::{clear_last_error, set_last_error, MetaOxideError};
+
+/// Allocation hook: return at least `size` bytes, or NULL on failure
+pub type MetaOxideMallocFn =
+    unsafe extern "C" fn(size: usize, user_data: *mut c_void) -> *mut c_void;
+
+/// Release hook for memory returned by the matching `MetaOxideMallocFn`
+pub type MetaOxideFreeFn = unsafe extern "C" fn(ptr: *mut c_void, user_data: *mut c_void);
+
+#[derive(Clone, Copy)]
+struct Hooks {
+    malloc: MetaOxideMallocFn,
+    free: MetaOxideFreeFn,
+    user_data: *mut c_void,
+}
+
+// SAFETY: `user_data` is never dereferenced here, only passed back to the
+// caller's hooks, which `meta_oxide_set_allocator()` requires to be callable
+// from any thread.
+unsafe impl Send for Hooks {}
+unsafe impl Sync for Hooks {}
+
+static HOOKS: RwLock<Option<Hooks>> = RwLock::new(None);
+
+fn hooks() -> Option<Hooks> {
+    *HOOKS.read().unwrap_or_else(PoisonError::into_inner)
+}
+
+/// Route returned strings through caller-supplied allocation functions
+///
+/// Every string later returned by the library (the fields of a
+/// `MetaOxideResult`, single-format JSON strings, `ManifestDiscovery` fields
+/// and `meta_oxide_extract_all_buffer()` data) is allocated with `malloc_fn`
+/// and released with `free_fn` by the matching `*_free()` function. Passing
+/// NULL for both restores the Rust allocator.
+///
+/// Install the hooks once at startup. Memory obtained under one allocator
+/// must be freed before switching to another.
+///
+/// # Arguments
+/// * `malloc_fn` - Allocation function (NULL to restore the default)
+/// * `free_fn` - Release function (NULL to restore the default)
+/// * `user_data` - Passed unchanged to every call of both hooks (may be NULL)
+///
+/// # Returns
+/// 0 on success, or `MetaOxideError::NullPointer` (6) if only one hook is NULL
+///
+/// # Safety
+/// - the hooks must be callable from any thread, including the workers of
+///   `meta_oxide_extract_batch()`
+/// - `malloc_fn` must return NULL or memory that is valid until `free_fn` is
+///   called on it
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_set_allocator(
+    malloc_fn: Option<MetaOxideMallocFn>,
+    free_fn: Option<MetaOxideFreeFn>,
+    user_data: *mut c_void,
+) -> c_int {
+    clear_last_error();
+
+    let hooks = match (malloc_fn, free_fn) {
+        (Some(malloc), Some(free)) => Some(Hooks { malloc, free, user_data }),
+        (None, None) => None,
+        _ => {
+            set_last_error(
+                MetaOxideError::NullPointer,
+                Some("malloc_fn and free_fn must both be set or both be NULL".to_string()),
+            );
+            return MetaOxideError::NullPointer as c_int;
+        }
+    };
+
+    *HOOKS.write().unwrap_or_else(PoisonError::into_inner) = hooks;
+    MetaOxideError::Ok as c_int
+}
+
+// Hand `s` to C as a NUL-terminated string
+pub(super) fn c_string(s: String) -> Result<*mut c_char, MetaOxideError> {
+    if s.as_bytes().contains(&0) {
+        return Err(MetaOxideError::InvalidUtf8);
+    }
+
+    let Some(hooks) = hooks() else {
+        // SAFETY: checked for interior NUL bytes above
+        return Ok(unsafe { CString::from_vec_unchecked(s.into_bytes()) }.into_raw());
+    };
+
+    let len = s.len();
+    // SAFETY: the hook returns NULL or `len + 1` writable bytes
+    unsafe {
+        let p = (hooks.malloc)(len + 1, hooks.user_data).cast::<u8>();
+        if p.is_null() {
+            return Err(MetaOxideError::MemoryError);
+        }
+        ptr::copy_nonoverlapping(s.as_ptr(), p, len);
+        *p.add(len) = 0;
+        Ok(p.cast())
+    }
+}
+
+// Release a string from `c_string()`
+pub(super) unsafe fn free_c_string(s: *mut c_char) {
+    match hooks() {
+        Some(hooks) => (hooks.free)(s.cast(), hooks.user_data),
+        None => drop(CString::from_raw(s)),
+    }
+}
+
+// Hand `data` to C as one allocation of exactly `data.len()` bytes
+pub(super) fn bytes(data: Vec<u8>) -> Result<*mut c_char, MetaOxideError> {
+    let Some(hooks) = hooks() else {
+        return Ok(Box::into_raw(data.into_boxed_slice()).cast());
+    };
+
+    // SAFETY: the hook returns NULL or `data.len()` writable bytes
+    unsafe {
+        let p = (hooks.malloc)(data.len(), hooks.user_data).cast::<u8>();
+        if p.is_null() {
+            return Err(MetaOxideError::MemoryError);
+        }
+        ptr::copy_nonoverlapping(data.as_ptr(), p, data.len());
+        Ok(p.cast())
+    }
+}
+
+// Release `len` bytes from `bytes()`
+pub(super) unsafe fn free_bytes(data: *mut c_char, len: usize) {
+    match hooks() {
+        Some(hooks) => (hooks.free)(data.cast(), hooks.user_data),
+        None => drop(Box::from_raw(ptr::slice_from_raw_parts_mut(data.cast::<u8>(), len))),
+    }
+}
@@ -0,0 +1,131 @@
+//! Per-call timing and size statistics for the C API
+//!
+//! Pointing `MetaOxideOptions::stats` at a `MetaOxideStats` makes the
+//! extraction entry points that take options fill it in. With the default
+//! NULL pointer nothing is measured and the clock is never read.
+
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+use super::{MetaOxideOptions, MetaOxideResult};
+use crate::extract::{self, formats, Extraction, Stats};
+
+/// Number of entries in the per-format arrays of `MetaOxideStats`
+pub const META_OXIDE_FORMAT_COUNT: usize = 11;
+
+const _: () = assert!(META_OXIDE_FORMAT_COUNT == formats::COUNT);
+
+/// Where the time went in one extraction call
+///
+/// The per-format arrays are indexed by the bit position of the format's
+/// `META_OXIDE_FMT_*` flag, so `format_ns[3]` is JSON-LD (`1 << 3`). Formats
+/// that were not selected report 0; Open Graph parsed only for the Twitter
+/// fallback counts as Twitter time.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MetaOxideStats {
+    /// Bytes of HTML parsed (the head section alone with `head_only`)
+    pub input_bytes: usize,
+    /// Bytes of JSON produced, excluding NUL terminators
+    pub output_bytes: usize,
+    /// Nodes in the parsed DOM
+    pub dom_nodes: usize,
+    /// JSON-LD scripts skipped because they did not parse
+    pub json_ld_errors: usize,
+    /// Time spent building the DOM, in nanoseconds
+    pub parse_ns: u64,
+    /// Time spent collecting `<title>`, `<meta>` and `<link>` tags, in nanoseconds
+    pub head_scan_ns: u64,
+    /// Time spent serializing results to JSON, in nanoseconds
+    pub serialize_ns: u64,
+    /// Wall time of extraction and serialization together, in nanoseconds
+    pub total_ns: u64,
+    /// Extraction time per format, in nanoseconds
+    pub format_ns: [u64; META_OXIDE_FORMAT_COUNT],
+    /// Items found per format
+    ///
+    /// Objects for JSON-LD, microdata and RDFa, root items for microformats,
+    /// relation types for rel-* links, and 1 for the single-object formats.
+    pub items: [u32; META_OXIDE_FORMAT_COUNT],
+}
+
+impl MetaOxideStats {
+    fn new(stats: &Stats, elapsed: Duration) -> Self {
+        Self {
+            input_bytes: stats.input_bytes,
+            output_bytes: 0,
+            dom_nodes: stats.dom_nodes,
+            json_ld_errors: stats.json_ld_errors,
+            parse_ns: nanos(stats.parse),
+            head_scan_ns: nanos(stats.head_scan),
+            serialize_ns: 0,
+            total_ns: nanos(elapsed),
+            format_ns: stats.formats.map(nanos),
+            items: stats.items.map(|n| u32::try_from(n).unwrap_or(u32::MAX)),
+        }
+    }
+}
+
+fn nanos(duration: Duration) -> u64 {
+    u64::try_from(duration.as_nanos()).unwrap_or(u64::MAX)
+}
+
+// Run one extraction, filling in `options.stats` when the caller asked for it
+pub(super) unsafe fn extract(
+    html: &str,
+    base_url: Option<&str>,
+    options: &MetaOxideOptions,
+) -> Arc<Extraction> {
+    let extract_options = options.to_extract_options();
+    let Some(out) = options.stats.as_mut() else {
+        return extract::extract_shared(html, base_url, &extract_options);
+    };
+
+    let start = Instant::now();
+    let mut stats = Stats::default();
+    let extraction = extract::extract_all_with_stats(html, base_url, &extract_options, &mut stats);
+    *out = MetaOxideStats::new(&stats, start.elapsed());
+    Arc::new(extraction)
+}
+
+// Serialize with `f`, adding its time and output length to `options.stats`
+pub(super) unsafe fn serialize<T>(
+    options: &MetaOxideOptions,
+    f: impl FnOnce() -> T,
+    len: impl FnOnce(&T) -> usize,
+) -> T {
+    let Some(out) = options.stats.as_mut() else {
+        return f();
+    };
+
+    let start = Instant::now();
+    let value = f();
+    let elapsed = nanos(start.elapsed());
+    out.serialize_ns += elapsed;
+    out.total_ns += elapsed;
+    out.output_bytes += len(&value);
+    value
+}
+
+// Bytes of JSON in the fields of a result
+pub(super) unsafe fn result_len(result: *const MetaOxideResult) -> usize {
+    let Some(r) = result.as_ref() else {
+        return 0;
+    };
+    let fields: [*mut c_char; META_OXIDE_FORMAT_COUNT] = [
+        r.meta,
+        r.open_graph,
+        r.twitter,
+        r.json_ld,
+        r.microdata,
+        r.microformats,
+        r.rdfa,
+        r.dublin_core,
+        r.manifest,
+        r.oembed,
+        r.rel_links,
+    ];
+    fields.iter().filter(|p| !p.is_null()).map(|&p| CStr::from_ptr(p).to_bytes().len()).sum()
+}
@@ -0,0 +1,847 @@
+//! Typed result views for the C API
+//!
+//! `meta_oxide_extract_typed()` returns a handle that owns the extraction and
+//! exposes it as plain C structs instead of JSON strings. Every string is a
+//! [`MetaOxideStr`] slice pointing into the extracted data itself, so nothing
+//! is serialized, copied or re-parsed; all pointers stay valid until the
+//! handle is freed with `meta_oxide_typed_result_free()`.
+//!
+//! JSON-LD, microdata and microformats share one item model: an item has
+//! types, an optional id, properties sorted by name, and child items. A
+//! property value is either text or a nested item.
+
+use std::os::raw::c_char;
+use std::ptr;
+use std::sync::Arc;
+
+use serde_json::Value;
+
+use super::{clear_last_error, from_c_string, from_c_string_opt, run, MetaOxideOptions};
+use crate::extract::Extraction;
+use crate::types::jsonld::JsonLdObject;
+use crate::types::microdata::{self, MicrodataItem};
+use crate::types::microformats::{self, MicroformatItem};
+use crate::types::social::OgImage;
+
+/// A borrowed UTF-8 string slice (not NUL-terminated)
+///
+/// `ptr` is NULL when the value is absent.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct MetaOxideStr {
+    /// First byte of the string, or NULL if absent
+    pub ptr: *const c_char,
+    /// Length in bytes
+    pub len: usize,
+}
+
+impl MetaOxideStr {
+    const NONE: Self = Self { ptr: ptr::null(), len: 0 };
+
+    fn new(s: &str) -> Self {
+        Self { ptr: s.as_ptr().cast(), len: s.len() }
+    }
+
+    fn opt(s: &Option<String>) -> Self {
+        s.as_deref().map_or(Self::NONE, Self::new)
+    }
+}
+
+/// Standard HTML meta tags
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideMetaTags {
+    /// `<title>` text
+    pub title: MetaOxideStr,
+    /// `description` meta tag
+    pub description: MetaOxideStr,
+    /// `author` meta tag
+    pub author: MetaOxideStr,
+    /// `generator` meta tag
+    pub generator: MetaOxideStr,
+    /// Canonical URL
+    pub canonical: MetaOxideStr,
+    /// Short link URL
+    pub shortlink: MetaOxideStr,
+    /// Favicon URL
+    pub icon: MetaOxideStr,
+    /// Apple touch icon URL
+    pub apple_touch_icon: MetaOxideStr,
+    /// Web App Manifest URL
+    pub manifest: MetaOxideStr,
+    /// Previous page URL
+    pub prev: MetaOxideStr,
+    /// Next page URL
+    pub next: MetaOxideStr,
+    /// `viewport` meta tag
+    pub viewport: MetaOxideStr,
+    /// `theme-color` meta tag
+    pub theme_color: MetaOxideStr,
+    /// Document charset
+    pub charset: MetaOxideStr,
+    /// `lang` of the `<html>` element
+    pub language: MetaOxideStr,
+    /// `application-name` meta tag
+    pub application_name: MetaOxideStr,
+    /// `referrer` meta tag
+    pub referrer: MetaOxideStr,
+    /// Raw `robots` meta tag content
+    pub robots: MetaOxideStr,
+    /// Raw `googlebot` meta tag content
+    pub googlebot: MetaOxideStr,
+    /// Keywords, split on commas
+    pub keywords: *const MetaOxideStr,
+    /// Number of entries in `keywords`
+    pub keywords_len: usize,
+}
+
+/// One `og:image` with its structured properties
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideOgImage {
+    /// Image URL
+    pub url: MetaOxideStr,
+    /// `og:image:secure_url`
+    pub secure_url: MetaOxideStr,
+    /// `og:image:type`
+    pub r#type: MetaOxideStr,
+    /// `og:image:alt`
+    pub alt: MetaOxideStr,
+    /// `og:image:width`, or 0 if absent
+    pub width: u32,
+    /// `og:image:height`, or 0 if absent
+    pub height: u32,
+}
+
+/// Open Graph metadata
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideOpenGraph {
+    /// `og:title`
+    pub title: MetaOxideStr,
+    /// `og:type`
+    pub r#type: MetaOxideStr,
+    /// `og:url`
+    pub url: MetaOxideStr,
+    /// First `og:image` URL
+    pub image: MetaOxideStr,
+    /// `og:description`
+    pub description: MetaOxideStr,
+    /// `og:site_name`
+    pub site_name: MetaOxideStr,
+    /// `og:locale`
+    pub locale: MetaOxideStr,
+    /// Every `og:image`, in document order
+    pub images: *const MetaOxideOgImage,
+    /// Number of entries in `images`
+    pub images_len: usize,
+}
+
+/// Twitter Card metadata (with Open Graph fallback applied)
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideTwitterCard {
+    /// `twitter:card`
+    pub card: MetaOxideStr,
+    /// `twitter:title`
+    pub title: MetaOxideStr,
+    /// `twitter:description`
+    pub description: MetaOxideStr,
+    /// `twitter:image`
+    pub image: MetaOxideStr,
+    /// `twitter:image:alt`
+    pub image_alt: MetaOxideStr,
+    /// `twitter:site`
+    pub site: MetaOxideStr,
+    /// `twitter:site:id`
+    pub site_id: MetaOxideStr,
+    /// `twitter:creator`
+    pub creator: MetaOxideStr,
+    /// `twitter:creator:id`
+    pub creator_id: MetaOxideStr,
+}
+
+/// URLs for one rel-* relationship
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideRelLink {
+    /// Relationship, lowercased (`author`, `me`, ...)
+    pub rel: MetaOxideStr,
+    /// URLs in document order
+    pub urls: *const MetaOxideStr,
+    /// Number of entries in `urls`
+    pub urls_len: usize,
+}
+
+/// A property value: text, or a nested item
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideValue {
+    /// Text value (NULL `ptr` for a nested item)
+    pub text: MetaOxideStr,
+    /// Nested item (NULL for a text value)
+    pub item: *const MetaOxideItem,
+}
+
+/// A named property with one or more values
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideProperty {
+    /// Property name
+    pub name: MetaOxideStr,
+    /// Values in document order
+    pub values: *const MetaOxideValue,
+    /// Number of entries in `values`
+    pub values_len: usize,
+}
+
+/// A JSON-LD object, microdata item or microformat
+#[repr(C)]
+#[derive(Debug)]
+pub struct MetaOxideItem {
+    /// Types (`@type`, `itemtype` or `h-*` classes)
+    pub types: *const MetaOxideStr,
+    /// Number of entries in `types`
+    pub types_len: usize,
+    /// `@id` or `itemid` (NULL `ptr` if absent)
+    pub id: MetaOxideStr,
+    /// Properties sorted by name
+    pub props: *const MetaOxideProperty,
+    /// Number of entries in `props`
+    pub props_len: usize,
+    /// Child items (`@graph` objects or nested microformats)
+    pub children: *const MetaOxideItem,
+    /// Number of entries in `children`
+    pub children_len: usize,
+}
+
+/// Typed extraction results (see `meta_oxide_extract_typed()`)
+pub struct MetaOxideTypedResult {
+    meta: Option<MetaOxideMetaTags>,
+    open_graph: Option<MetaOxideOpenGraph>,
+    twitter: Option<MetaOxideTwitterCard>,
+    rel_links: Box<[MetaOxideRelLink]>,
+    json_ld: Box<[MetaOxideItem]>,
+    microdata: Box<[MetaOxideItem]>,
+    microformats: Box<[MetaOxideItem]>,
+    /// Backing storage for every pointer above
+    _storage: Storage,
+    /// Owns every string the views point into; its heap data never moves
+    _extraction: Arc<Extraction>,
+}
+
+/// Arrays and strings referenced by the views, kept alive with them
+#[derive(Default)]
+struct Storage {
+    strs: Vec<Box<[MetaOxideStr]>>,
+    images: Vec<Box<[MetaOxideOgImage]>>,
+    values: Vec<Box<[MetaOxideValue]>>,
+    props: Vec<Box<[MetaOxideProperty]>>,
+    items: Vec<Box<[MetaOxideItem]>>,
+    /// Boxed so nested items keep their address as the Vec grows
+    #[allow(clippy::vec_box)]
+    nested: Vec<Box<MetaOxideItem>>,
+    /// JSON-LD numbers and booleans rendered as text
+    scalars: Vec<Box<str>>,
+}
+
+/// Store `values` and return a pointer to its first element and its length
+fn keep<T>(store: &mut Vec<Box<[T]>>, values: Vec<T>) -> (*const T, usize) {
+    if values.is_empty() {
+        return (ptr::null(), 0);
+    }
+    let boxed = values.into_boxed_slice();
+    let out = (boxed.as_ptr(), boxed.len());
+    store.push(boxed);
+    out
+}
+
+impl Storage {
+    fn strs<'a>(
+        &mut self,
+        strings: impl IntoIterator<Item = &'a String>,
+    ) -> (*const MetaOxideStr, usize) {
+        let strs = strings.into_iter().map(|s| MetaOxideStr::new(s)).collect();
+        keep(&mut self.strs, strs)
+    }
+
+    fn scalar(&mut self, text: String) -> MetaOxideStr {
+        let text = text.into_boxed_str();
+        let out = MetaOxideStr::new(&text);
+        self.scalars.push(text);
+        out
+    }
+
+    fn nested(&mut self, item: MetaOxideItem) -> *const MetaOxideItem {
+        let item = Box::new(item);
+        let out: *const MetaOxideItem = &*item;
+        self.nested.push(item);
+        out
+    }
+
+    fn item(
+        &mut self,
+        types: (*const MetaOxideStr, usize),
+        id: MetaOxideStr,
+        mut props: Vec<MetaOxideProperty>,
+        children: Vec<MetaOxideItem>,
+    ) -> MetaOxideItem {
+        // Properties with only null values are dropped; the rest are sorted
+        // so that `meta_oxide_item_prop()` can binary search
+        props.retain(|p| p.values_len > 0);
+        props.sort_by(|a, b| str_bytes(&a.name).cmp(str_bytes(&b.name)));
+        let (props, props_len) = keep(&mut self.props, props);
+        let (children, children_len) = keep(&mut self.items, children);
+        MetaOxideItem {
+            types: types.0,
+            types_len: types.1,
+            id,
+            props,
+            props_len,
+            children,
+            children_len,
+        }
+    }
+
+    fn property(&mut self, name: &str, values: Vec<MetaOxideValue>) -> MetaOxideProperty {
+        let (values, values_len) = keep(&mut self.values, values);
+        MetaOxideProperty { name: MetaOxideStr::new(name), values, values_len }
+    }
+
+    fn microdata_item(&mut self, item: &MicrodataItem) -> MetaOxideItem {
+        let types = self.strs(item.item_type.iter().flatten());
+        let props = item
+            .properties
+            .iter()
+            .map(|(name, values)| {
+                let values = values
+                    .iter()
+                    .map(|value| match value {
+                        microdata::PropertyValue::Text(text) => text_value(text),
+                        microdata::PropertyValue::Item(nested) => {
+                            let nested = self.microdata_item(nested);
+                            item_value(self.nested(nested))
+                        }
+                    })
+                    .collect();
+                self.property(name, values)
+            })
+            .collect();
+        self.item(types, MetaOxideStr::opt(&item.id), props, Vec::new())
+    }
+
+    fn microformat_item(&mut self, item: &MicroformatItem) -> MetaOxideItem {
+        let types = self.strs(&item.type_);
+        let props = item
+            .properties
+            .iter()
+            .map(|(name, values)| {
+                let values = values
+                    .iter()
+                    .map(|value| match value {
+                        microformats::PropertyValue::Text(text)
+                        | microformats::PropertyValue::Url(text) => text_value(text),
+                        microformats::PropertyValue::Nested(nested) => {
+                            let nested = self.microformat_item(nested);
+                            item_value(self.nested(nested))
+                        }
+                    })
+                    .collect();
+                self.property(name, values)
+            })
+            .collect();
+        let children = item.children.iter().flatten().map(|c| self.microformat_item(c)).collect();
+        self.item(types, MetaOxideStr::NONE, props, children)
+    }
+
+    fn json_ld_item(&mut self, object: &JsonLdObject) -> MetaOxideItem {
+        let types = self.json_types(object.type_.as_ref());
+        let props = object
+            .properties
+            .iter()
+            .map(|(name, value)| {
+                let mut values = Vec::new();
+                self.json_values(value, &mut values);
+                self.property(name, values)
+            })
+            .collect();
+        let children = object.graph.iter().flatten().map(|o| self.json_ld_item(o)).collect();
+        self.item(types, MetaOxideStr::opt(&object.id), props, children)
+    }
+
+    /// A nested JSON-LD object, whose `@type` and `@id` are still plain keys
+    fn json_object_item(&mut self, object: &serde_json::Map<String, Value>) -> MetaOxideItem {
+        let types = self.json_types(object.get("@type"));
+        let id = match object.get("@id") {
+            Some(Value::String(id)) => MetaOxideStr::new(id),
+            _ => MetaOxideStr::NONE,
+        };
+        let props = object
+            .iter()
+            .filter(|(name, _)| !name.starts_with('@'))
+            .map(|(name, value)| {
+                let mut values = Vec::new();
+                self.json_values(value, &mut values);
+                self.property(name, values)
+            })
+            .collect();
+        self.item(types, id, props, Vec::new())
+    }
+
+    fn json_types(&mut self, value: Option<&Value>) -> (*const MetaOxideStr, usize) {
+        let strs = match value {
+            Some(Value::String(t)) => vec![MetaOxideStr::new(t)],
+            Some(Value::Array(ts)) => {
+                ts.iter().filter_map(Value::as_str).map(MetaOxideStr::new).collect()
+            }
+            _ => Vec::new(),
+        };
+        keep(&mut self.strs, strs)
+    }
+
+    /// Flatten a JSON value into property values (arrays become several)
+    fn json_values(&mut self, value: &Value, out: &mut Vec<MetaOxideValue>) {
+        match value {
+            Value::Null => {}
+            Value::String(text) => out.push(text_value(text)),
+            Value::Bool(b) => {
+                out.push(MetaOxideValue { text: self.scalar(b.to_string()), item: ptr::null() })
+            }
+            Value::Number(n) => {
+                out.push(MetaOxideValue { text: self.scalar(n.to_string()), item: ptr::null() })
+            }
+            Value::Array(values) => values.iter().for_each(|v| self.json_values(v, out)),
+            Value::Object(object) => {
+                let nested = self.json_object_item(object);
+                out.push(item_value(self.nested(nested)));
+            }
+        }
+    }
+
+    fn og_image(image: &OgImage) -> MetaOxideOgImage {
+        MetaOxideOgImage {
+            url: MetaOxideStr::new(&image.url),
+            secure_url: MetaOxideStr::opt(&image.secure_url),
+            r#type: MetaOxideStr::opt(&image.r#type),
+            alt: MetaOxideStr::opt(&image.alt),
+            width: image.width.unwrap_or(0),
+            height: image.height.unwrap_or(0),
+        }
+    }
+}
+
+fn text_value(text: &str) -> MetaOxideValue {
+    MetaOxideValue { text: MetaOxideStr::new(text), item: ptr::null() }
+}
+
+fn item_value(item: *const MetaOxideItem) -> MetaOxideValue {
+    MetaOxideValue { text: MetaOxideStr::NONE, item }
+}
+
+fn str_bytes(s: &MetaOxideStr) -> &[u8] {
+    if s.ptr.is_null() {
+        return &[];
+    }
+    // SAFETY: every non-null MetaOxideStr points into a live string
+    unsafe { std::slice::from_raw_parts(s.ptr.cast(), s.len) }
+}
+
+impl MetaOxideTypedResult {
+    fn new(extraction: Arc<Extraction>) -> Self {
+        let mut storage = Storage::default();
+
+        let meta = extraction.meta.as_ref().map(|m| {
+            let (keywords, keywords_len) = storage.strs(m.keywords.iter().flatten());
+            MetaOxideMetaTags {
+                title: MetaOxideStr::opt(&m.title),
+                description: MetaOxideStr::opt(&m.description),
+                author: MetaOxideStr::opt(&m.author),
+                generator: MetaOxideStr::opt(&m.generator),
+                canonical: MetaOxideStr::opt(&m.canonical),
+                shortlink: MetaOxideStr::opt(&m.shortlink),
+                icon: MetaOxideStr::opt(&m.icon),
+                apple_touch_icon: MetaOxideStr::opt(&m.apple_touch_icon),
+                manifest: MetaOxideStr::opt(&m.manifest),
+                prev: MetaOxideStr::opt(&m.prev),
+                next: MetaOxideStr::opt(&m.next),
+                viewport: MetaOxideStr::opt(&m.viewport),
+                theme_color: MetaOxideStr::opt(&m.theme_color),
+                charset: MetaOxideStr::opt(&m.charset),
+                language: MetaOxideStr::opt(&m.language),
+                application_name: MetaOxideStr::opt(&m.application_name),
+                referrer: MetaOxideStr::opt(&m.referrer),
+                robots: m.robots.as_ref().map_or(MetaOxideStr::NONE, |r| MetaOxideStr::new(&r.raw)),
+                googlebot: m
+                    .googlebot
+                    .as_ref()
+                    .map_or(MetaOxideStr::NONE, |r| MetaOxideStr::new(&r.raw)),
+                keywords,
+                keywords_len,
+            }
+        });
+
+        let open_graph = extraction.open_graph.as_ref().map(|og| {
+            let images = og.images.iter().map(Storage::og_image).collect();
+            let (images, images_len) = keep(&mut storage.images, images);
+            MetaOxideOpenGraph {
+                title: MetaOxideStr::opt(&og.title),
+                r#type: MetaOxideStr::opt(&og.r#type),
+                url: MetaOxideStr::opt(&og.url),
+                image: MetaOxideStr::opt(&og.image),
+                description: MetaOxideStr::opt(&og.description),
+                site_name: MetaOxideStr::opt(&og.site_name),
+                locale: MetaOxideStr::opt(&og.locale),
+                images,
+                images_len,
+            }
+        });
+
+        let twitter = extraction.twitter.as_ref().map(|tw| MetaOxideTwitterCard {
+            card: MetaOxideStr::opt(&tw.card),
+            title: MetaOxideStr::opt(&tw.title),
+            description: MetaOxideStr::opt(&tw.description),
+            image: MetaOxideStr::opt(&tw.image),
+            image_alt: MetaOxideStr::opt(&tw.image_alt),
+            site: MetaOxideStr::opt(&tw.site),
+            site_id: MetaOxideStr::opt(&tw.site_id),
+            creator: MetaOxideStr::opt(&tw.creator),
+            creator_id: MetaOxideStr::opt(&tw.creator_id),
+        });
+
+        let mut rel_links: Vec<_> = extraction.rel_links.iter().flatten().collect();
+        rel_links.sort_by(|a, b| a.0.cmp(b.0));
+        let rel_links = rel_links
+            .into_iter()
+            .map(|(rel, urls)| {
+                let (urls, urls_len) = storage.strs(urls);
+                MetaOxideRelLink { rel: MetaOxideStr::new(rel), urls, urls_len }
+            })
+            .collect();
+
+        let json_ld =
+            extraction.json_ld.iter().flatten().map(|o| storage.json_ld_item(o)).collect();
+        let microdata =
+            extraction.microdata.iter().flatten().map(|i| storage.microdata_item(i)).collect();
+
+        // Microformats are keyed by their root type; list them in type order
+        let mut roots: Vec<_> = extraction.microformats.iter().flatten().collect();
+        roots.sort_by(|a, b| a.0.cmp(b.0));
+        let microformats = roots
+            .into_iter()
+            .flat_map(|(_, items)| items)
+            .map(|i| storage.microformat_item(i))
+            .collect::<Vec<_>>();
+
+        Self {
+            meta,
+            open_graph,
+            twitter,
+            rel_links,
+            json_ld,
+            microdata,
+            microformats: microformats.into_boxed_slice(),
+            _storage: storage,
+            _extraction: extraction,
+        }
+    }
+
+    fn items(&self, format: u32) -> &[MetaOxideItem] {
+        match format {
+            super::META_OXIDE_FMT_JSON_LD => &self.json_ld,
+            super::META_OXIDE_FMT_MICRODATA => &self.microdata,
+            super::META_OXIDE_FMT_MICROFORMATS => &self.microformats,
+            _ => &[],
+        }
+    }
+}
+
+/// Extract metadata into typed C structs
+///
+/// Same extraction as `meta_oxide_extract_all_with_options()`, without
+/// converting anything to JSON. Read the results with the
+/// `meta_oxide_typed_*` and `meta_oxide_item_*` accessors; every pointer they
+/// return is borrowed from the handle.
+///
+/// # Arguments
+/// * `html` - HTML content (must not be NULL)
+/// * `base_url` - Base URL for resolving relative URLs (may be NULL)
+/// * `options` - Extraction options (may be NULL for defaults)
+///
+/// # Returns
+/// A handle, or NULL on error
+///
+/// # Memory
+/// The caller must free the handle using `meta_oxide_typed_result_free()`,
+/// which invalidates every pointer obtained from it.
+///
+/// # Safety
+/// - `html` must be a valid null-terminated C string
+/// - `base_url` may be NULL or a valid null-terminated C string
+/// - `options` may be NULL or must point to a valid `MetaOxideOptions`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_extract_typed(
+    html: *const c_char,
+    base_url: *const c_char,
+    options: *const MetaOxideOptions,
+) -> *mut MetaOxideTypedResult {
+    clear_last_error();
+
+    let html_str = match from_c_string(html) {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let base_url_str = from_c_string_opt(base_url);
+    let options = if options.is_null() { MetaOxideOptions::default() } else { *options };
+
+    let extraction = run(html_str, base_url_str, &options);
+    Box::into_raw(Box::new(MetaOxideTypedResult::new(extraction)))
+}
+
+/// Free a typed result and everything borrowed from it
+///
+/// # Safety
+/// - `result` must be NULL or a handle from `meta_oxide_extract_typed()`
+/// - `result` must not have been freed previously
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_typed_result_free(result: *mut MetaOxideTypedResult) {
+    if !result.is_null() {
+        drop(Box::from_raw(result));
+    }
+}
+
+/// Standard meta tags, or NULL if none were extracted
+///
+/// # Safety
+/// - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_typed_meta(
+    result: *const MetaOxideTypedResult,
+) -> *const MetaOxideMetaTags {
+    result.as_ref().and_then(|r| r.meta.as_ref()).map_or(ptr::null(), |m| m)
+}
+
+/// Open Graph metadata, or NULL if none was extracted
+///
+/// # Safety
+/// - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_typed_open_graph(
+    result: *const MetaOxideTypedResult,
+) -> *const MetaOxideOpenGraph {
+    result.as_ref().and_then(|r| r.open_graph.as_ref()).map_or(ptr::null(), |og| og)
+}
+
+/// Twitter Card metadata, or NULL if none was extracted
+///
+/// # Safety
+/// - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_typed_twitter(
+    result: *const MetaOxideTypedResult,
+) -> *const MetaOxideTwitterCard {
+    result.as_ref().and_then(|r| r.twitter.as_ref()).map_or(ptr::null(), |tw| tw)
+}
+
+/// rel-* link relationships, sorted by relationship
+///
+/// # Arguments
+/// * `result` - Typed result handle
+/// * `len` - Receives the number of entries (must not be NULL)
+///
+/// # Returns
+/// Array of `*len` entries, or NULL if there are none
+///
+/// # Safety
+/// - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+/// - `len` must point to writable memory
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_typed_rel_links(
+    result: *const MetaOxideTypedResult,
+    len: *mut usize,
+) -> *const MetaOxideRelLink {
+    let links = result.as_ref().map_or(&[][..], |r| &r.rel_links);
+    if !len.is_null() {
+        *len = links.len();
+    }
+    if links.is_empty() {
+        ptr::null()
+    } else {
+        links.as_ptr()
+    }
+}
+
+/// Number of top-level items of one format
+///
+/// # Arguments
+/// * `result` - Typed result handle
+/// * `format` - `META_OXIDE_FMT_JSON_LD`, `META_OXIDE_FMT_MICRODATA` or
+///   `META_OXIDE_FMT_MICROFORMATS`; anything else has no items
+///
+/// # Safety
+/// - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_item_count(
+    result: *const MetaOxideTypedResult,
+    format: u32,
+) -> usize {
+    result.as_ref().map_or(0, |r| r.items(format).len())
+}
+
+/// Top-level item `index` of one format, or NULL if out of range
+///
+/// # Safety
+/// - `result` must be NULL or a live handle from `meta_oxide_extract_typed()`
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_item(
+    result: *const MetaOxideTypedResult,
+    format: u32,
+    index: usize,
+) -> *const MetaOxideItem {
+    result.as_ref().and_then(|r| r.items(format).get(index)).map_or(ptr::null(), |i| i)
+}
+
+/// Value `index` of the property called `name`, or NULL if there is none
+///
+/// # Arguments
+/// * `item` - Item from `meta_oxide_item()` or a property value
+/// * `name` - Property name (NUL-terminated)
+/// * `index` - Which value of the property (0 for the first)
+///
+/// # Safety
+/// - `item` must be NULL or point to an item of a live typed result
+/// - `name` must be NULL or a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn meta_oxide_item_prop(
+    item: *const MetaOxideItem,
+    name: *const c_char,
+    index: usize,
+) -> *const MetaOxideValue {
+    let (Some(item), false) = (item.as_ref(), name.is_null()) else {
+        return ptr::null();
+    };
+    let name = std::ffi::CStr::from_ptr(name).to_bytes();
+
+    if item.props_len == 0 {
+        return ptr::null();
+    }
+    let props = std::slice::from_raw_parts(item.props, item.props_len);
+    let Ok(found) = props.binary_search_by(|p| str_bytes(&p.name).cmp(name)) else {
+        return ptr::null();
+    };
+
+    let prop = &props[found];
+    if index >= prop.values_len {
+        return ptr::null();
+    }
+    prop.values.add(index)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::ffi::{META_OXIDE_FMT_JSON_LD, META_OXIDE_FMT_MICRODATA};
+    use std::ffi::CString;
+
+    fn as_str(s: MetaOxideStr) -> &'static str {
+        assert!(!s.ptr.is_null());
+        unsafe { std::str::from_utf8(std::slice::from_raw_parts(s.ptr.cast(), s.len)).unwrap() }
+    }
+
+    #[test]
+    fn test_typed_views() {
+        let html = CString::new(
+            r#"<html><head>
+                <title>Typed</title>
+                <meta name="keywords" content="a, b">
+                <meta property="og:title" content="OG">
+                <meta property="og:image" content="https://example.com/a.png">
+                <meta property="og:image:width" content="640">
+                <link rel="author" href="https://example.com/me">
+                <script type="application/ld+json">
+                    {"@type": "Article", "headline": "H", "wordCount": 42,
+                     "author": {"@type": "Person", "name": "Jane"}}
+                </script>
+            </head><body>
+                <div itemscope itemtype="https://schema.org/Thing"><span itemprop="name">T</span></div>
+            </body></html>"#,
+        )
+        .unwrap();
+
+        unsafe {
+            let result = meta_oxide_extract_typed(html.as_ptr(), ptr::null(), ptr::null());
+            assert!(!result.is_null());
+
+            let meta = &*meta_oxide_typed_meta(result);
+            assert_eq!(as_str(meta.title), "Typed");
+            assert_eq!(meta.keywords_len, 2);
+            assert!(meta.description.ptr.is_null());
+
+            let og = &*meta_oxide_typed_open_graph(result);
+            assert_eq!(as_str(og.title), "OG");
+            assert_eq!(og.images_len, 1);
+            assert_eq!((*og.images).width, 640);
+
+            let mut len = 0;
+            let rel = meta_oxide_typed_rel_links(result, &mut len);
+            assert_eq!(len, 1);
+            assert_eq!(as_str((*rel).rel), "author");
+
+            assert_eq!(meta_oxide_item_count(result, META_OXIDE_FMT_JSON_LD), 1);
+            let article = meta_oxide_item(result, META_OXIDE_FMT_JSON_LD, 0);
+            assert_eq!(as_str(*(*article).types), "Article");
+
+            let name = CString::new("wordCount").unwrap();
+            assert_eq!(as_str((*meta_oxide_item_prop(article, name.as_ptr(), 0)).text), "42");
+
+            let name = CString::new("author").unwrap();
+            let author = (*meta_oxide_item_prop(article, name.as_ptr(), 0)).item;
+            let name = CString::new("name").unwrap();
+            assert_eq!(as_str((*meta_oxide_item_prop(author, name.as_ptr(), 0)).text), "Jane");
+            assert!(meta_oxide_item_prop(author, name.as_ptr(), 1).is_null());
+
+            let thing = meta_oxide_item(result, META_OXIDE_FMT_MICRODATA, 0);
+            assert_eq!(as_str((*(*thing).props).name), "name");
+            assert!(meta_oxide_item(result, META_OXIDE_FMT_MICRODATA, 1).is_null());
+
+            meta_oxide_typed_result_free(result);
+        }
+    }
+
+    #[test]
+    fn test_json_ld_item_model() {
+        let object: JsonLdObject = serde_json::from_str(
+            r##"{"@type": ["Product", "Thing"], "@id": "#p", "name": "Widget",
+                "offers": [{"@type": "Offer", "price": 9.5}, {"@type": "Offer", "price": 12}],
+                "inStock": true, "gtin": null}"##,
+        )
+        .unwrap();
+        let extraction = Extraction { json_ld: Some(vec![object]), ..Default::default() };
+        let result = Box::into_raw(Box::new(MetaOxideTypedResult::new(Arc::new(extraction))));
+
+        unsafe {
+            let product = &*meta_oxide_item(result, META_OXIDE_FMT_JSON_LD, 0);
+            assert_eq!(product.types_len, 2);
+            assert_eq!(as_str(product.id), "#p");
+
+            // Properties are sorted by name and nulls are dropped
+            let props = std::slice::from_raw_parts(product.props, product.props_len);
+            let names: Vec<_> = props.iter().map(|p| as_str(p.name)).collect();
+            assert_eq!(names, ["inStock", "name", "offers"]);
+
+            let name = CString::new("inStock").unwrap();
+            assert_eq!(as_str((*meta_oxide_item_prop(product, name.as_ptr(), 0)).text), "true");
+
+            let name = CString::new("offers").unwrap();
+            let second = (*meta_oxide_item_prop(product, name.as_ptr(), 1)).item;
+            let price = CString::new("price").unwrap();
+            assert_eq!(as_str((*meta_oxide_item_prop(second, price.as_ptr(), 0)).text), "12");
+
+            let missing = CString::new("sku").unwrap();
+            assert!(meta_oxide_item_prop(product, missing.as_ptr(), 0).is_null());
+            assert!(meta_oxide_typed_meta(result).is_null());
+
+            meta_oxide_typed_result_free(result);
+        }
+    }
+}
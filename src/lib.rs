@@ -1,19 +1,37 @@
 // PyO3 macro expansions can trigger false positive clippy warnings
 #![allow(clippy::useless_conversion)]
 
+#[cfg(feature = "python")]
+use pyo3::buffer::PyBuffer;
 #[cfg(feature = "python")]
 use pyo3::prelude::*;
 #[cfg(feature = "python")]
-use pyo3::types::{PyDict, PyList};
+use pyo3::types::{PyBytes, PyDict, PyList, PyString};
+#[cfg(feature = "python")]
+use std::borrow::Cow;
 #[cfg(feature = "python")]
 use std::collections::HashMap;
 
+pub mod arena;
+pub mod cache;
+pub mod charset;
 mod errors;
-mod extractors;
+pub mod extract;
+// The individual extractors and the parser are reachable for the WASM and
+// Node.js bindings and the benchmarks, but are not part of the supported API;
+// use `extract` instead
+#[doc(hidden)]
+pub mod extractors;
 pub mod ffi;
+pub mod limits;
 #[macro_use]
 mod macros;
-mod parser;
+pub mod msgpack;
+#[doc(hidden)]
+pub mod parser;
+pub mod pool;
+pub mod prefilter;
+pub mod stream;
 mod types;
 
 pub use errors::{MicroformatError, Result};
@@ -23,30 +41,108 @@ pub use types::*;
 #[doc(hidden)]
 pub use extractors::common::{html_utils, url_utils};
 
+/// HTML passed in from Python, borrowed from the object wherever possible
+///
+/// A `str` lends its cached UTF-8 form and `bytes` or a read-only buffer
+/// (`memoryview` of `bytes`, `mmap` opened read-only) lend their memory, so
+/// none of them is copied. Writable buffers such as `bytearray` are copied,
+/// since another thread could change them while the GIL is released.
+#[cfg(feature = "python")]
+enum HtmlArg<'a> {
+    Str(&'a str),
+    Bytes(&'a [u8]),
+    Buffer(PyBuffer<u8>),
+    Copied(Vec<u8>),
+}
+
+#[cfg(feature = "python")]
+impl<'a> HtmlArg<'a> {
+    fn new(obj: &'a Bound<'_, PyAny>) -> PyResult<Self> {
+        if let Ok(s) = obj.downcast::<PyString>() {
+            return Ok(Self::Str(s.to_str()?));
+        }
+        if let Ok(b) = obj.downcast::<PyBytes>() {
+            return Ok(Self::Bytes(b.as_bytes()));
+        }
+
+        let buffer = PyBuffer::<u8>::get_bound(obj).map_err(|_| {
+            PyErr::new::<pyo3::exceptions::PyTypeError, _>(
+                "html must be str, bytes or a bytes-like object",
+            )
+        })?;
+        if buffer.readonly() && buffer.is_c_contiguous() {
+            Ok(Self::Buffer(buffer))
+        } else {
+            Ok(Self::Copied(buffer.to_vec(obj.py())?))
+        }
+    }
+
+    /// The raw bytes of the argument; a `str` gives its UTF-8 form
+    fn bytes(&self) -> &[u8] {
+        match self {
+            Self::Str(s) => s.as_bytes(),
+            Self::Bytes(bytes) => bytes,
+            Self::Buffer(buffer) if buffer.len_bytes() == 0 => &[],
+            // SAFETY: the buffer is C-contiguous and read-only, and `buffer`
+            // keeps it exported, so it stays in place until `self` is dropped
+            Self::Buffer(buffer) => unsafe {
+                std::slice::from_raw_parts(buffer.buf_ptr().cast::<u8>(), buffer.len_bytes())
+            },
+            Self::Copied(bytes) => bytes,
+        }
+    }
+
+    /// The HTML as text; bytes are decoded as UTF-8, replacing invalid sequences
+    fn text(&self) -> Cow<'_, str> {
+        match self {
+            Self::Str(s) => Cow::Borrowed(*s),
+            _ => String::from_utf8_lossy(self.bytes()),
+        }
+    }
+
+    /// The HTML as text; bytes are decoded in their declared or sniffed
+    /// encoding, with `content_type` as the HTTP header hint
+    fn decode(&self, content_type: Option<&str>) -> Cow<'_, str> {
+        match self {
+            Self::Str(s) => Cow::Borrowed(*s),
+            _ => charset::decode(self.bytes(), content_type).text,
+        }
+    }
+}
+
+/// Run `f` on the HTML in `html` with the GIL released
+#[cfg(feature = "python")]
+fn with_html<T: Send>(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    f: impl FnOnce(&str) -> T + Send,
+) -> PyResult<T> {
+    let html = HtmlArg::new(html)?;
+    Ok(py.allow_threads(|| f(&html.text())))
+}
+
 #[cfg(feature = "python")]
 /// Extract microformats data from HTML content
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
 fn extract_microformats(
-    html: &str,
+    py: Python,
+    html: &Bound<'_, PyAny>,
     base_url: Option<&str>,
 ) -> PyResult<HashMap<String, Vec<PyObject>>> {
-    Python::with_gil(|py| {
-        let result = parser::parse_html(html, base_url)
-            .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
+    let result = with_html(py, html, |html| parser::parse_html(html, base_url))?
+        .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
 
-        let mut py_result = HashMap::new();
+    let mut py_result = HashMap::new();
 
-        // Convert Rust data structures to Python objects
-        for (format_type, items) in result.iter() {
-            let py_items: Vec<PyObject> =
-                items.iter().map(|item| item.to_py_dict(py).into()).collect();
-            py_result.insert(format_type.clone(), py_items);
-        }
+    // Convert Rust data structures to Python objects
+    for (format_type, items) in result.iter() {
+        let py_items: Vec<PyObject> = items.iter().map(|item| item.to_py_dict(py).into()).collect();
+        py_result.insert(format_type.clone(), py_items);
+    }
 
-        Ok(py_result)
-    })
+    Ok(py_result)
 }
 
 #[cfg(feature = "python")]
@@ -78,7 +174,7 @@ py_extractor_binding!(extract_hgeo, hgeo, HGeo);
 /// Extract standard HTML meta tags
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -103,8 +199,12 @@ py_extractor_binding!(extract_hgeo, hgeo, HGeo);
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_meta(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let meta = extractors::meta::extract(html, base_url)
+fn extract_meta(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<Py<PyDict>> {
+    let meta = with_html(py, html, |html| extractors::meta::extract(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(meta.to_py_dict(py))
 }
@@ -112,7 +212,7 @@ fn extract_meta(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<P
 /// Extract Open Graph metadata
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -126,8 +226,12 @@ fn extract_meta(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<P
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_opengraph(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let og = extractors::social::extract_opengraph(html, base_url)
+fn extract_opengraph(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<Py<PyDict>> {
+    let og = with_html(py, html, |html| extractors::social::extract_opengraph(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(og.to_py_dict(py))
 }
@@ -135,7 +239,7 @@ fn extract_opengraph(py: Python, html: &str, base_url: Option<&str>) -> PyResult
 /// Extract Twitter Card metadata
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -149,8 +253,12 @@ fn extract_opengraph(py: Python, html: &str, base_url: Option<&str>) -> PyResult
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_twitter(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let card = extractors::social::extract_twitter(html, base_url)
+fn extract_twitter(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<Py<PyDict>> {
+    let card = with_html(py, html, |html| extractors::social::extract_twitter(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(card.to_py_dict(py))
 }
@@ -158,7 +266,7 @@ fn extract_twitter(py: Python, html: &str, base_url: Option<&str>) -> PyResult<P
 /// Extract Twitter Card metadata with Open Graph fallback
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -173,19 +281,26 @@ fn extract_twitter(py: Python, html: &str, base_url: Option<&str>) -> PyResult<P
 #[pyo3(signature = (html, base_url=None))]
 fn extract_twitter_with_fallback(
     py: Python,
-    html: &str,
+    html: &Bound<'_, PyAny>,
     base_url: Option<&str>,
 ) -> PyResult<Py<PyDict>> {
-    let card = extractors::social::extract_twitter_with_fallback(html, base_url)
-        .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
+    let card = with_html(py, html, |html| {
+        extractors::social::extract_twitter_with_fallback(html, base_url)
+    })?
+    .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(card.to_py_dict(py))
 }
 
 /// Extract JSON-LD structured data
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL (not used for JSON-LD but included for consistency)
+///     types (list[str], optional): Only return objects with one of these
+///         @type values. Other objects, including @graph members, are
+///         scanned without being built.
+///     properties (list[str], optional): Only keep these properties on the
+///         objects returned; @context, @type and @id are always kept.
 ///
 /// Returns:
 ///     list: List of JSON-LD objects (dicts) found in the HTML
@@ -196,12 +311,29 @@ fn extract_twitter_with_fallback(
 ///     >>> for obj in jsonld:
 ///     ...     print(obj.get('@type'))
 ///     ...     print(obj.get('headline'))
+///     >>> products = meta_oxide.extract_jsonld(html, types=["Product"])
 #[cfg(feature = "python")]
 #[pyfunction]
-#[pyo3(signature = (html, base_url=None))]
-fn extract_jsonld(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyList>> {
-    let objects = extractors::jsonld::extract(html, base_url)
-        .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
+#[pyo3(signature = (html, base_url=None, types=None, properties=None))]
+fn extract_jsonld(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+    types: Option<Vec<String>>,
+    properties: Option<Vec<String>>,
+) -> PyResult<Py<PyList>> {
+    let objects = with_html(py, html, |html| {
+        if types.is_none() && properties.is_none() {
+            return extractors::jsonld::extract(html, base_url);
+        }
+        let types: Vec<&str> = types.iter().flatten().map(String::as_str).collect();
+        let properties: Option<Vec<&str>> =
+            properties.as_ref().map(|names| names.iter().map(String::as_str).collect());
+        let filter =
+            extractors::jsonld::Filter { types: &types, properties: properties.as_deref() };
+        extractors::jsonld::extract_filtered(html, &filter)
+    })?
+    .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
 
     let list = PyList::empty_bound(py);
     for obj in objects {
@@ -215,7 +347,7 @@ fn extract_jsonld(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py
 /// Extracts microdata using itemscope, itemtype, and itemprop attributes.
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -230,8 +362,12 @@ fn extract_jsonld(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_microdata(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyList>> {
-    let items = extractors::microdata::extract(html, base_url)
+fn extract_microdata(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<Py<PyList>> {
+    let items = with_html(py, html, |html| extractors::microdata::extract(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
 
     let list = PyList::empty_bound(py);
@@ -246,7 +382,7 @@ fn extract_microdata(py: Python, html: &str, base_url: Option<&str>) -> PyResult
 /// Extracts Dublin Core metadata elements commonly used in digital libraries and archives.
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///
 /// Returns:
 ///     dict: Dictionary containing Dublin Core elements (title, creator, subject, etc.)
@@ -259,8 +395,8 @@ fn extract_microdata(py: Python, html: &str, base_url: Option<&str>) -> PyResult
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html))]
-fn extract_dublin_core(py: Python, html: &str) -> PyResult<Py<PyDict>> {
-    let dc = extractors::dublin_core::extract(html)
+fn extract_dublin_core(py: Python, html: &Bound<'_, PyAny>) -> PyResult<Py<PyDict>> {
+    let dc = with_html(py, html, |html| extractors::dublin_core::extract(html))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(dc.to_py_dict(py))
 }
@@ -271,7 +407,7 @@ fn extract_dublin_core(py: Python, html: &str) -> PyResult<Py<PyDict>> {
 /// Supports common rel types like author, me, webmention, license, payment, etc.
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -285,8 +421,12 @@ fn extract_dublin_core(py: Python, html: &str) -> PyResult<Py<PyDict>> {
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_rel_links(html: &str, base_url: Option<&str>) -> PyResult<HashMap<String, Vec<String>>> {
-    let links = extractors::rel_links::extract(html, base_url)
+fn extract_rel_links(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<HashMap<String, Vec<String>>> {
+    let links = with_html(py, html, |html| extractors::rel_links::extract(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
     Ok(links)
 }
@@ -297,7 +437,7 @@ fn extract_rel_links(html: &str, base_url: Option<&str>) -> PyResult<HashMap<Str
 /// platforms like YouTube, Vimeo, Twitter for easy content embedding.
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -313,8 +453,12 @@ fn extract_rel_links(html: &str, base_url: Option<&str>) -> PyResult<HashMap<Str
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_oembed(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let oembed = extractors::oembed::extract(html, base_url)
+fn extract_oembed(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<Py<PyDict>> {
+    let oembed = with_html(py, html, |html| extractors::oembed::extract(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(oembed.to_py_dict(py))
 }
@@ -325,7 +469,7 @@ fn extract_oembed(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py
 /// for embedding structured data in HTML using attributes like typeof, property, vocab.
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -340,8 +484,8 @@ fn extract_oembed(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_rdfa(py: Python, html: &str, base_url: Option<&str>) -> PyResult<PyObject> {
-    let items = extractors::rdfa::extract(html, base_url)
+fn extract_rdfa(py: Python, html: &Bound<'_, PyAny>, base_url: Option<&str>) -> PyResult<PyObject> {
+    let items = with_html(py, html, |html| extractors::rdfa::extract(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
 
     let list = PyList::empty_bound(py);
@@ -357,7 +501,7 @@ fn extract_rdfa(py: Python, html: &str, base_url: Option<&str>) -> PyResult<PyOb
 /// Use parse_manifest() separately to parse the manifest JSON content.
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
 ///
 /// Returns:
@@ -370,8 +514,12 @@ fn extract_rdfa(py: Python, html: &str, base_url: Option<&str>) -> PyResult<PyOb
 #[cfg(feature = "python")]
 #[pyfunction]
 #[pyo3(signature = (html, base_url=None))]
-fn extract_manifest(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let discovery = extractors::manifest::extract(html, base_url)
+fn extract_manifest(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+) -> PyResult<Py<PyDict>> {
+    let discovery = with_html(py, html, |html| extractors::manifest::extract(html, base_url))?
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(discovery.to_py_dict(py))
 }
@@ -397,7 +545,8 @@ fn extract_manifest(py: Python, html: &str, base_url: Option<&str>) -> PyResult<
 #[pyfunction]
 #[pyo3(signature = (json, base_url=None))]
 fn parse_manifest(py: Python, json: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let manifest = extractors::manifest::parse_manifest(json, base_url)
+    let manifest = py
+        .allow_threads(|| extractors::manifest::parse_manifest(json, base_url))
         .map_err(|e| PyErr::new::<pyo3::exceptions::PyRuntimeError, _>(e.to_string()))?;
     Ok(manifest.to_py_dict(py))
 }
@@ -412,8 +561,20 @@ fn parse_manifest(py: Python, json: &str, base_url: Option<&str>) -> PyResult<Py
 /// - Microformats (Phase 7, already implemented)
 ///
 /// Args:
-///     html (str): HTML content to extract from
+///     html (str | bytes): HTML content to extract from
 ///     base_url (str, optional): Base URL for resolving relative URLs
+///     head_only (bool, optional): Only parse the document head. Parsing stops
+///         after </head> or the first body element; JSON-LD scripts in the head
+///         are still extracted. Defaults to False.
+///     formats (int, optional): Bitmask of FMT_* constants selecting which
+///         formats to extract, e.g. FMT_META | FMT_OPENGRAPH. Unselected
+///         formats are skipped entirely; 0 selects every format, as in the
+///         C API. Defaults to FMT_ALL.
+///     detect_encoding (bool, optional): Decode bytes input in the encoding
+///         given by a byte order mark, content_type or a <meta> charset,
+///         instead of as UTF-8. Defaults to False.
+///     content_type (str, optional): HTTP Content-Type header value or charset
+///         label of bytes input, used with detect_encoding.
 ///
 /// Returns:
 ///     dict: Dictionary containing all extracted data with keys:
@@ -432,230 +593,446 @@ fn parse_manifest(py: Python, json: &str, base_url: Option<&str>) -> PyResult<Py
 ///     >>> print(data['twitter']['card'])
 ///     >>> for obj in data.get('jsonld', []):
 ///     ...     print(obj.get('@type'))
+///     >>> head = meta_oxide.extract_all(html, head_only=True)
+///     >>> og = meta_oxide.extract_all(html, formats=meta_oxide.FMT_OPENGRAPH)
 #[cfg(feature = "python")]
 #[cfg(feature = "python")]
 #[pyfunction]
-#[pyo3(signature = (html, base_url=None))]
-fn extract_all(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
-    let dict = PyDict::new_bound(py);
+#[pyo3(signature = (
+    html,
+    base_url=None,
+    head_only=false,
+    formats=extract::formats::ALL,
+    detect_encoding=false,
+    content_type=None,
+))]
+fn extract_all(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+    head_only: bool,
+    formats: u32,
+    detect_encoding: bool,
+    content_type: Option<&str>,
+) -> PyResult<Py<PyDict>> {
+    let html = HtmlArg::new(html)?;
+    let options = extract::ExtractOptions {
+        head_only,
+        formats: extract::formats::or_all(formats),
+        typed_microformats: true,
+        ..Default::default()
+    };
+    let extraction = py.allow_threads(|| {
+        let text = if detect_encoding { html.decode(content_type) } else { html.text() };
+        extract::extract_shared(&text, base_url, &options)
+    });
+    extraction_to_py_dict(py, &extraction)
+}
 
-    // Extract Phase 1: Standard Meta Tags
-    match extractors::meta::extract(html, base_url) {
-        Ok(meta_tags) => {
-            dict.set_item("meta", meta_tags.to_py_dict(py))?;
-        }
-        Err(e) => {
-            // Log error but continue with other extractors
-            eprintln!("Meta extraction warning: {}", e);
-        }
-    }
+/// Extract metadata from many HTML documents in parallel
+///
+/// Runs the same extraction as extract_all() on every document, spread over
+/// an internal pool of worker threads. The GIL is released for the whole
+/// batch, so other Python threads keep running meanwhile.
+///
+/// Args:
+///     documents (list[str | bytes]): HTML documents to extract from
+///     base_urls (list[str | None], optional): Base URL for each document;
+///         must have the same length as documents when given
+///     head_only (bool, optional): Only parse each document's head.
+///         Defaults to False.
+///     formats (int, optional): Bitmask of FMT_* constants; 0 selects every
+///         format. Defaults to FMT_ALL.
+///
+/// Returns:
+///     list[dict]: One dictionary per document, in input order, with the same
+///         keys and value shapes as extract_all().
+///
+/// Example:
+///     >>> results = meta_oxide.extract_all_batch(pages, formats=meta_oxide.FMT_OPENGRAPH)
+///     >>> titles = [r.get('opengraph', {}).get('title') for r in results]
+#[cfg(feature = "python")]
+#[pyfunction]
+#[pyo3(signature = (documents, base_urls=None, head_only=false, formats=extract::formats::ALL))]
+fn extract_all_batch(
+    py: Python,
+    documents: Vec<Bound<'_, PyAny>>,
+    base_urls: Option<Vec<Option<String>>>,
+    head_only: bool,
+    formats: u32,
+) -> PyResult<Vec<Py<PyDict>>> {
+    extract_many(py, documents, base_urls, None, head_only, formats)
+}
 
-    // Extract Phase 2: Open Graph
-    match extractors::social::extract_opengraph(html, base_url) {
-        Ok(og) => {
-            dict.set_item("opengraph", og.to_py_dict(py))?;
-        }
-        Err(e) => {
-            eprintln!("OpenGraph extraction warning: {}", e);
-        }
+/// Extract metadata from many HTML documents on a pool of worker threads
+///
+/// Like extract_all_batch(), optionally with a pool of worker threads of its
+/// own for this call. Without one, the batch runs on the pool shared by the
+/// whole process (see set_thread_count()). Documents given as bytes or
+/// memoryview are read in place rather than copied.
+///
+/// Args:
+///     documents (list[str | bytes]): HTML documents to extract from
+///     base_urls (list[str | None], optional): Base URL for each document;
+///         must have the same length as documents when given
+///     workers (int, optional): Run this batch on a pool of this many worker
+///         threads, started for the call and stopped after it; 0 uses one
+///         per core. Defaults to the shared pool.
+///     head_only (bool, optional): Only parse each document's head.
+///         Defaults to False.
+///     formats (int, optional): Bitmask of FMT_* constants; 0 selects every
+///         format. Defaults to FMT_ALL.
+///
+/// Returns:
+///     list[dict]: One dictionary per document, in input order, with the same
+///         keys as extract_all_batch() results.
+///
+/// Example:
+///     >>> results = meta_oxide.extract_many(pages, workers=16)
+#[cfg(feature = "python")]
+#[pyfunction]
+#[pyo3(signature = (
+    documents,
+    base_urls=None,
+    workers=None,
+    head_only=false,
+    formats=extract::formats::ALL
+))]
+fn extract_many(
+    py: Python,
+    documents: Vec<Bound<'_, PyAny>>,
+    base_urls: Option<Vec<Option<String>>>,
+    workers: Option<usize>,
+    head_only: bool,
+    formats: u32,
+) -> PyResult<Vec<Py<PyDict>>> {
+    if base_urls.as_ref().is_some_and(|urls| urls.len() != documents.len()) {
+        return Err(PyErr::new::<pyo3::exceptions::PyValueError, _>(
+            "base_urls must have the same length as documents",
+        ));
     }
+    let documents = documents.iter().map(HtmlArg::new).collect::<PyResult<Vec<_>>>()?;
+
+    let formats = extract::formats::or_all(formats);
+    let options = extract::ExtractOptions {
+        head_only,
+        formats,
+        typed_microformats: true,
+        ..Default::default()
+    };
+    let extractions = py.allow_threads(|| {
+        // A pool of the call's own leaves the shared one alone, so concurrent
+        // callers asking for different sizes do not replace it in turn
+        let pool = match workers {
+            Some(0) => std::sync::Arc::new(pool::Pool::new(pool::default_threads())),
+            Some(workers) => std::sync::Arc::new(pool::Pool::new(workers)),
+            None => pool::global(),
+        };
+        pool.map(documents.len(), |i| {
+            let base_url = base_urls.as_ref().and_then(|urls| urls[i].as_deref());
+            extract::extract_shared(&documents[i].text(), base_url, &options)
+        })
+    });
+
+    extractions.iter().map(|extraction| extraction_to_py_dict(py, extraction)).collect()
+}
 
-    // Extract Phase 2: Twitter Cards (with fallback to OG)
-    match extractors::social::extract_twitter_with_fallback(html, base_url) {
-        Ok(twitter) => {
-            dict.set_item("twitter", twitter.to_py_dict(py))?;
-        }
-        Err(e) => {
-            eprintln!("Twitter extraction warning: {}", e);
-        }
-    }
+/// Set the number of worker threads of the shared pool
+///
+/// The shared pool runs extract_all_batch() calls and extract_many() calls
+/// without workers. It belongs to the whole process, including the C API
+/// loaded into it; batches already running finish on the old pool.
+///
+/// Args:
+///     threads (int): Number of worker threads; 0 uses one per core (the default)
+///
+/// Example:
+///     >>> meta_oxide.set_thread_count(8)
+#[cfg(feature = "python")]
+#[pyfunction]
+fn set_thread_count(threads: usize) {
+    pool::set_global_threads(threads);
+}
 
-    // Extract Phase 3: JSON-LD (41% adoption, HIGHEST IMPACT)
-    match extractors::jsonld::extract(html, base_url) {
-        Ok(objects) => {
-            if !objects.is_empty() {
-                let list = PyList::empty_bound(py);
-                for obj in objects {
-                    list.append(obj.to_py_dict(py)).unwrap();
-                }
-                dict.set_item("jsonld", list)?;
-            }
-        }
-        Err(e) => {
-            eprintln!("JSON-LD extraction warning: {}", e);
-        }
-    }
+/// Number of worker threads of the shared pool
+///
+/// Returns:
+///     int: Worker threads used by extract_all_batch() and extract_many()
+#[cfg(feature = "python")]
+#[pyfunction]
+fn thread_count() -> usize {
+    pool::global().threads()
+}
 
-    // Extract Phase 4: Microdata (26% adoption)
-    match extractors::microdata::extract(html, base_url) {
-        Ok(items) => {
-            if !items.is_empty() {
-                let list = PyList::empty_bound(py);
-                for item in items {
-                    list.append(item.to_py_dict(py)).unwrap();
-                }
-                dict.set_item("microdata", list)?;
-            }
-        }
-        Err(e) => {
-            eprintln!("Microdata extraction warning: {}", e);
+/// Extract metadata from HTML and report where the time went
+///
+/// Runs the same extraction as extract_all_batch() does for one document,
+/// timing the DOM parse, the head scan, every selected format and the
+/// conversion of the results to Python objects.
+///
+/// Args:
+///     html (str | bytes): HTML content to extract from
+///     base_url (str, optional): Base URL for resolving relative URLs
+///     head_only (bool, optional): Only parse the document head. Defaults to False.
+///     formats (int, optional): Bitmask of FMT_* constants; 0 selects every
+///         format. Defaults to FMT_ALL.
+///
+/// Returns:
+///     tuple[dict, dict]: The extraction, with the same keys as
+///         extract_all_batch() results, and the statistics: input_bytes,
+///         dom_nodes, json_ld_errors, parse_ns, head_scan_ns, convert_ns,
+///         total_ns and formats, which maps each selected format's key to
+///         {"ns", "items"}.
+///
+/// Example:
+///     >>> result, stats = meta_oxide.extract_all_with_stats(html)
+///     >>> slowest = max(stats['formats'].items(), key=lambda f: f[1]['ns'])
+#[cfg(feature = "python")]
+#[pyfunction]
+#[pyo3(signature = (html, base_url=None, head_only=false, formats=extract::formats::ALL))]
+fn extract_all_with_stats(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+    head_only: bool,
+    formats: u32,
+) -> PyResult<(Py<PyDict>, Py<PyDict>)> {
+    use extract::formats as fmt;
+    use std::time::Instant;
+
+    // Result keys by format bit position
+    const KEYS: [&str; fmt::COUNT] = [
+        "meta",
+        "opengraph",
+        "twitter",
+        "jsonld",
+        "microdata",
+        "microformats",
+        "rdfa",
+        "dublin_core",
+        "manifest",
+        "oembed",
+        "rel_links",
+    ];
+
+    let start = Instant::now();
+    let formats = extract::formats::or_all(formats);
+    let options = extract::ExtractOptions {
+        head_only,
+        formats,
+        typed_microformats: true,
+        ..Default::default()
+    };
+    let (extraction, stats) = with_html(py, html, |html| {
+        let mut stats = extract::Stats::default();
+        let extraction = extract::extract_all_with_stats(html, base_url, &options, &mut stats);
+        (extraction, stats)
+    })?;
+
+    let convert = Instant::now();
+    let result = extraction_to_py_dict(py, &extraction)?;
+    let convert_ns = convert.elapsed().as_nanos() as u64;
+
+    let per_format = PyDict::new_bound(py);
+    for (i, key) in KEYS.iter().enumerate() {
+        if formats & (1 << i) != 0 {
+            let entry = PyDict::new_bound(py);
+            entry.set_item("ns", stats.formats[i].as_nanos() as u64)?;
+            entry.set_item("items", stats.items[i])?;
+            per_format.set_item(key, entry)?;
         }
     }
 
-    // Extract Phase 7: Microformats (already implemented)
-    let mf_dict = PyDict::new_bound(py);
-    let mut has_microformats = false;
-
-    // Extract h-card
-    if let Ok(hcards) = extractors::microformats::hcard::extract(html, base_url) {
-        if !hcards.is_empty() {
-            let cards: Vec<_> = hcards.iter().map(|card| card.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-card", cards)?;
-            has_microformats = true;
-        }
-    }
+    let dict = PyDict::new_bound(py);
+    dict.set_item("input_bytes", stats.input_bytes)?;
+    dict.set_item("dom_nodes", stats.dom_nodes)?;
+    dict.set_item("json_ld_errors", stats.json_ld_errors)?;
+    dict.set_item("parse_ns", stats.parse.as_nanos() as u64)?;
+    dict.set_item("head_scan_ns", stats.head_scan.as_nanos() as u64)?;
+    dict.set_item("convert_ns", convert_ns)?;
+    dict.set_item("total_ns", start.elapsed().as_nanos() as u64)?;
+    dict.set_item("formats", per_format)?;
+
+    Ok((result, dict.unbind()))
+}
 
-    // Extract h-entry
-    if let Ok(entries) = extractors::microformats::hentry::extract(html, base_url) {
-        if !entries.is_empty() {
-            let entries_py: Vec<_> = entries.iter().map(|e| e.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-entry", entries_py)?;
-            has_microformats = true;
-        }
-    }
+/// Extract all metadata from HTML as a MessagePack document
+///
+/// The document is one map keyed like the C API's combined document (meta,
+/// openGraph, twitter, jsonLd, microdata, microformats, rdfa, dublinCore,
+/// manifest, oembed, relLinks), with the values the C and Node.js APIs give
+/// as JSON; formats that were not selected or not found are left out. It is
+/// typically a fraction of the size of the JSON text and is read back with
+/// any MessagePack library, so it suits results headed for a queue or a
+/// columnar store rather than Python code.
+///
+/// Args:
+///     html (str | bytes): HTML content to extract from
+///     base_url (str, optional): Base URL for resolving relative URLs
+///     head_only (bool, optional): Only parse the document head. Defaults to False.
+///     formats (int, optional): Bitmask of FMT_* constants; 0 selects every
+///         format. Defaults to FMT_ALL.
+///
+/// Returns:
+///     bytes: The MessagePack document
+///
+/// Example:
+///     >>> import msgpack
+///     >>> data = msgpack.unpackb(meta_oxide.extract_all_msgpack(html))
+///     >>> data['openGraph']['title']
+#[cfg(feature = "python")]
+#[pyfunction]
+#[pyo3(signature = (html, base_url=None, head_only=false, formats=extract::formats::ALL))]
+fn extract_all_msgpack(
+    py: Python,
+    html: &Bound<'_, PyAny>,
+    base_url: Option<&str>,
+    head_only: bool,
+    formats: u32,
+) -> PyResult<Py<PyBytes>> {
+    let formats = extract::formats::or_all(formats);
+    let options = extract::ExtractOptions { head_only, formats, ..Default::default() };
+    let encoded = with_html(py, html, |html| {
+        msgpack::extraction_to_vec(&extract::extract_shared(html, base_url, &options))
+    })?;
+    let bytes =
+        encoded.map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
+    Ok(PyBytes::new_bound(py, &bytes).unbind())
+}
 
-    // Extract h-event
-    if let Ok(events) = extractors::microformats::hevent::extract(html, base_url) {
-        if !events.is_empty() {
-            let events_py: Vec<_> = events.iter().map(|e| e.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-event", events_py)?;
-            has_microformats = true;
-        }
-    }
+/// Enable or disable the result cache
+///
+/// While enabled, extract_all(), extract_all_msgpack(), extract_many() and
+/// extract_all_batch() look up each document by a hash of its HTML, base URL
+/// and options and return the stored results of an identical earlier call
+/// without parsing again. With head_only=True only the head section is
+/// hashed, so pages that share a templated <head> share one entry. The cache
+/// is shared by the whole process, including the C and Node.js APIs loaded
+/// into it.
+///
+/// Args:
+///     max_bytes (int): Memory budget of the cache; 0 disables it (the default)
+///
+/// Example:
+///     >>> meta_oxide.cache_configure(64 << 20)
+#[cfg(feature = "python")]
+#[pyfunction]
+fn cache_configure(max_bytes: usize) {
+    cache::configure(max_bytes);
+}
 
-    // Extract h-review
-    if let Ok(reviews) = extractors::microformats::hreview::extract(html, base_url) {
-        if !reviews.is_empty() {
-            let reviews_py: Vec<_> = reviews.iter().map(|r| r.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-review", reviews_py)?;
-            has_microformats = true;
-        }
-    }
+/// Counters of the result cache
+///
+/// Returns:
+///     dict: hits, misses, head_hits, head_misses, evictions, entries and
+///         bytes; all 0 while the cache is disabled. Every cache_configure()
+///         call resets them.
+#[cfg(feature = "python")]
+#[pyfunction]
+fn cache_stats(py: Python) -> PyResult<Py<PyDict>> {
+    let stats = cache::stats();
+    let dict = PyDict::new_bound(py);
+    dict.set_item("hits", stats.hits)?;
+    dict.set_item("misses", stats.misses)?;
+    dict.set_item("head_hits", stats.head_hits)?;
+    dict.set_item("head_misses", stats.head_misses)?;
+    dict.set_item("evictions", stats.evictions)?;
+    dict.set_item("entries", stats.entries)?;
+    dict.set_item("bytes", stats.bytes)?;
+    Ok(dict.unbind())
+}
 
-    // Extract h-recipe
-    if let Ok(recipes) = extractors::microformats::hrecipe::extract(html, base_url) {
-        if !recipes.is_empty() {
-            let recipes_py: Vec<_> = recipes.iter().map(|r| r.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-recipe", recipes_py)?;
-            has_microformats = true;
-        }
-    }
+/// Convert an extraction into the dictionary layout used by extract_all()
+#[cfg(feature = "python")]
+fn extraction_to_py_dict(py: Python, extraction: &extract::Extraction) -> PyResult<Py<PyDict>> {
+    let dict = PyDict::new_bound(py);
 
-    // Extract h-product
-    if let Ok(products) = extractors::microformats::hproduct::extract(html, base_url) {
-        if !products.is_empty() {
-            let products_py: Vec<_> =
-                products.iter().map(|p| p.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-product", products_py)?;
-            has_microformats = true;
-        }
+    if let Some(ref meta) = extraction.meta {
+        dict.set_item("meta", meta.to_py_dict(py))?;
     }
-
-    // Extract h-feed
-    if let Ok(feeds) = extractors::microformats::hfeed::extract(html, base_url) {
-        if !feeds.is_empty() {
-            let feeds_py: Vec<_> = feeds.iter().map(|f| f.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-feed", feeds_py)?;
-            has_microformats = true;
-        }
+    if let Some(ref og) = extraction.open_graph {
+        dict.set_item("opengraph", og.to_py_dict(py))?;
     }
-
-    // Extract h-adr
-    if let Ok(addresses) = extractors::microformats::hadr::extract(html, base_url) {
-        if !addresses.is_empty() {
-            let addresses_py: Vec<_> =
-                addresses.iter().map(|a| a.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-adr", addresses_py)?;
-            has_microformats = true;
+    if let Some(ref twitter) = extraction.twitter {
+        dict.set_item("twitter", twitter.to_py_dict(py))?;
+    }
+    if let Some(ref objects) = extraction.json_ld {
+        let list = PyList::empty_bound(py);
+        for obj in objects {
+            list.append(obj.to_py_dict(py))?;
         }
+        dict.set_item("jsonld", list)?;
     }
-
-    // Extract h-geo
-    if let Ok(geos) = extractors::microformats::hgeo::extract(html, base_url) {
-        if !geos.is_empty() {
-            let geos_py: Vec<_> = geos.iter().map(|g| g.to_py_dict(py).into_py(py)).collect();
-            mf_dict.set_item("h-geo", geos_py)?;
-            has_microformats = true;
+    if let Some(ref items) = extraction.microdata {
+        let list = PyList::empty_bound(py);
+        for item in items {
+            list.append(item.to_py_dict(py))?;
         }
+        dict.set_item("microdata", list)?;
     }
-
-    if has_microformats {
+    if let Some(ref microformats) = extraction.microformats {
+        let mf_dict = PyDict::new_bound(py);
+        for (format_type, items) in microformats {
+            let py_items: Vec<PyObject> =
+                items.iter().map(|item| item.to_py_dict(py).into()).collect();
+            mf_dict.set_item(format_type, py_items)?;
+        }
         dict.set_item("microformats", mf_dict)?;
     }
-
-    // Extract Phase 5: oEmbed endpoint discovery
-    match extractors::oembed::extract(html, base_url) {
-        Ok(oembed) => {
-            if oembed.has_endpoints() {
-                dict.set_item("oembed", oembed.to_py_dict(py))?;
-            }
-        }
-        Err(e) => {
-            eprintln!("oEmbed extraction warning: {}", e);
-        }
+    if let Some(ref typed) = extraction.typed_microformats {
+        dict.set_item("microformats", typed_microformats_to_py_dict(py, typed)?)?;
     }
-
-    // Extract Phase 9: Dublin Core metadata
-    match extractors::dublin_core::extract(html) {
-        Ok(dc) => {
-            dict.set_item("dublin_core", dc.to_py_dict(py))?;
-        }
-        Err(e) => {
-            eprintln!("Dublin Core extraction warning: {}", e);
-        }
+    if let Some(ref oembed) = extraction.oembed {
+        dict.set_item("oembed", oembed.to_py_dict(py))?;
     }
-
-    // Extract rel-* link relationships
-    match extractors::rel_links::extract(html, base_url) {
-        Ok(rel_links) => {
-            if !rel_links.is_empty() {
-                dict.set_item("rel_links", rel_links)?;
-            }
-        }
-        Err(e) => {
-            eprintln!("rel_links extraction warning: {}", e);
+    if let Some(ref dc) = extraction.dublin_core {
+        dict.set_item("dublin_core", dc.to_py_dict(py))?;
+    }
+    if let Some(ref rel_links) = extraction.rel_links {
+        dict.set_item("rel_links", rel_links)?;
+    }
+    if let Some(ref items) = extraction.rdfa {
+        let list = PyList::empty_bound(py);
+        for item in items {
+            list.append(item.to_py_dict(py))?;
         }
+        dict.set_item("rdfa", list)?;
+    }
+    if let Some(ref manifest) = extraction.manifest {
+        dict.set_item("manifest", manifest.to_py_dict(py))?;
     }
 
-    // Extract RDFa (W3C standard with 62% adoption)
-    match extractors::rdfa::extract(html, base_url) {
-        Ok(rdfa_items) => {
-            if !rdfa_items.is_empty() {
-                let list = PyList::empty_bound(py);
-                for item in rdfa_items {
-                    list.append(item.to_py_dict(py)).unwrap();
-                }
-                dict.set_item("rdfa", list)?;
-            }
-        }
-        Err(e) => {
-            eprintln!("RDFa extraction warning: {}", e);
-        }
+    Ok(dict.unbind())
+}
+
+/// Convert typed microformats into one list per h-* type; empty types are left out
+#[cfg(feature = "python")]
+fn typed_microformats_to_py_dict(
+    py: Python,
+    typed: &extract::TypedMicroformats,
+) -> PyResult<Py<PyDict>> {
+    fn items<T>(py: Python, items: &[T], to_dict: fn(&T, Python) -> Py<PyDict>) -> Vec<PyObject> {
+        items.iter().map(|item| to_dict(item, py).into_py(py)).collect()
     }
 
-    // Extract Web App Manifest link
-    match extractors::manifest::extract(html, base_url) {
-        Ok(discovery) => {
-            if discovery.href.is_some() {
-                dict.set_item("manifest", discovery.to_py_dict(py))?;
-            }
-        }
-        Err(e) => {
-            eprintln!("Manifest extraction warning: {}", e);
+    let mf_dict = PyDict::new_bound(py);
+    let microformats: [(&str, Vec<PyObject>); 9] = [
+        ("h-card", items(py, &typed.hcard, HCard::to_py_dict)),
+        ("h-entry", items(py, &typed.hentry, HEntry::to_py_dict)),
+        ("h-event", items(py, &typed.hevent, HEvent::to_py_dict)),
+        ("h-review", items(py, &typed.hreview, HReview::to_py_dict)),
+        ("h-recipe", items(py, &typed.hrecipe, HRecipe::to_py_dict)),
+        ("h-product", items(py, &typed.hproduct, HProduct::to_py_dict)),
+        ("h-feed", items(py, &typed.hfeed, HFeed::to_py_dict)),
+        ("h-adr", items(py, &typed.hadr, HAdr::to_py_dict)),
+        ("h-geo", items(py, &typed.hgeo, HGeo::to_py_dict)),
+    ];
+    for (key, list) in microformats {
+        if !list.is_empty() {
+            mf_dict.set_item(key, list)?;
         }
     }
-
-    Ok(dict.unbind())
+    Ok(mf_dict.unbind())
 }
 
 #[cfg(feature = "python")]
@@ -706,6 +1083,32 @@ fn meta_oxide(_py: Python, m: &Bound<'_, PyModule>) -> PyResult<()> {
 
     // Main convenience function
     m.add_function(wrap_pyfunction!(extract_all, m)?)?;
+    m.add_function(wrap_pyfunction!(extract_all_batch, m)?)?;
+    m.add_function(wrap_pyfunction!(extract_many, m)?)?;
+    m.add_function(wrap_pyfunction!(extract_all_with_stats, m)?)?;
+    m.add_function(wrap_pyfunction!(extract_all_msgpack, m)?)?;
+
+    // Worker pool
+    m.add_function(wrap_pyfunction!(set_thread_count, m)?)?;
+    m.add_function(wrap_pyfunction!(thread_count, m)?)?;
+
+    // Result cache
+    m.add_function(wrap_pyfunction!(cache_configure, m)?)?;
+    m.add_function(wrap_pyfunction!(cache_stats, m)?)?;
+
+    // Format selection flags for extract_all()
+    m.add("FMT_META", extract::formats::META)?;
+    m.add("FMT_OPENGRAPH", extract::formats::OPEN_GRAPH)?;
+    m.add("FMT_TWITTER", extract::formats::TWITTER)?;
+    m.add("FMT_JSONLD", extract::formats::JSON_LD)?;
+    m.add("FMT_MICRODATA", extract::formats::MICRODATA)?;
+    m.add("FMT_MICROFORMATS", extract::formats::MICROFORMATS)?;
+    m.add("FMT_RDFA", extract::formats::RDFA)?;
+    m.add("FMT_DUBLIN_CORE", extract::formats::DUBLIN_CORE)?;
+    m.add("FMT_MANIFEST", extract::formats::MANIFEST)?;
+    m.add("FMT_OEMBED", extract::formats::OEMBED)?;
+    m.add("FMT_REL_LINKS", extract::formats::REL_LINKS)?;
+    m.add("FMT_ALL", extract::formats::ALL)?;
 
     // Add version
     m.add("__version__", env!("CARGO_PKG_VERSION"))?;
@@ -717,6 +1120,13 @@ fn meta_oxide(_py: Python, m: &Bound<'_, PyModule>) -> PyResult<()> {
 mod integration_tests {
     use super::*;
 
+    /// Call extract_all() the way Python does: with a str and every argument
+    #[cfg(feature = "python")]
+    fn call_extract_all(py: Python, html: &str, base_url: Option<&str>) -> PyResult<Py<PyDict>> {
+        let html = PyString::new_bound(py, html);
+        extract_all(py, html.as_any(), base_url, false, extract::formats::ALL, false, None)
+    }
+
     #[test]
     #[cfg(feature = "python")]
     fn test_extract_all_basic() {
@@ -729,7 +1139,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -746,7 +1156,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -764,7 +1174,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -782,7 +1192,7 @@ mod integration_tests {
                 </body>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -796,7 +1206,7 @@ mod integration_tests {
                 <span class="p-name">Jane</span>
             </div>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -812,7 +1222,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, Some("https://example.com"));
+            let result = call_extract_all(py, html, Some("https://example.com"));
             assert!(result.is_ok());
         });
     }
@@ -843,7 +1253,7 @@ mod integration_tests {
                 </body>
             </html>
             "#;
-            let result = extract_all(py, html, Some("https://example.com"));
+            let result = call_extract_all(py, html, Some("https://example.com"));
             assert!(result.is_ok());
         });
     }
@@ -853,7 +1263,7 @@ mod integration_tests {
     fn test_extract_all_empty_html() {
         Python::with_gil(|py| {
             let html = "<html><head></head></html>";
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -872,7 +1282,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             // Should still succeed, just with no JSON-LD
             assert!(result.is_ok());
         });
@@ -889,7 +1299,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -906,7 +1316,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -923,7 +1333,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, Some("https://example.com"));
+            let result = call_extract_all(py, html, Some("https://example.com"));
             assert!(result.is_ok());
         });
     }
@@ -951,7 +1361,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -968,7 +1378,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -985,7 +1395,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -1003,7 +1413,7 @@ mod integration_tests {
                 </head>
             </html>
             "#;
-            let result = extract_all(py, html, None);
+            let result = call_extract_all(py, html, None);
             assert!(result.is_ok());
         });
     }
@@ -1022,7 +1432,7 @@ mod integration_tests {
             }
             html.push_str("</body></html>");
 
-            let result = extract_all(py, &html, None);
+            let result = call_extract_all(py, &html, None);
             assert!(result.is_ok());
         });
     }
@@ -1040,7 +1450,7 @@ mod integration_tests {
             }
             html.push_str("</body></html>");
 
-            let result = extract_all(py, &html, None);
+            let result = call_extract_all(py, &html, None);
             assert!(result.is_ok());
         });
     }
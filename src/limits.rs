@@ -0,0 +1,301 @@
+//! Resource limits for a single extraction
+//!
+//! Hostile or broken pages (megabytes of inline JSON-LD, tens of thousands of
+//! nested `<div>`s) can make one call arbitrarily slow. [`Limits`] bounds the
+//! work done per call. When a limit is hit the extraction still returns what
+//! it found within the limit, and [`Extraction::limit`] says which limit
+//! stopped it.
+//!
+//! [`Extraction::limit`]: crate::extract::Extraction::limit
+
+use std::time::{Duration, Instant};
+
+use scraper::Html;
+
+use crate::extract::Extraction;
+use crate::extractors::head;
+
+/// Elements whose contents the tokenizer reads as text up to their end tag
+const RAW_TEXT_ELEMENTS: &[&str] =
+    &["script", "style", "title", "textarea", "xmp", "iframe", "noembed", "noframes", "noscript"];
+
+/// Per-call resource limits; `None` leaves a resource unlimited
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub struct Limits {
+    /// Parse at most this many bytes of HTML, cut at a character boundary
+    pub max_input_bytes: Option<usize>,
+    /// Parse at most this many start tags
+    ///
+    /// The document is cut before its `max_tags + 1`-th start tag. Tags are
+    /// found the way the tokenizer finds them: a `<` in text, comments,
+    /// doctypes and the contents of `<script>`, `<style>` and the other
+    /// raw-text elements does not count.
+    pub max_tags: Option<usize>,
+    /// Skip JSON-LD scripts longer than this many bytes without parsing them
+    pub max_json_ld_bytes: Option<usize>,
+    /// Keep at most this many JSON-LD objects, microdata items and RDFa items,
+    /// and this many microformat items of each type
+    pub max_items: Option<usize>,
+    /// Drop every node nested more than this many levels below the document
+    ///
+    /// Applied to the parsed tree, so it bounds the work of the extractors but
+    /// not of the parser; pair it with `max_input_bytes` or `max_tags` to bound
+    /// the parse too.
+    pub max_depth: Option<usize>,
+    /// Skip the formats not yet started once this much time has passed
+    ///
+    /// Checked between stages, so a single slow stage can overrun it.
+    pub deadline: Option<Duration>,
+}
+
+/// A limit that cut an extraction short
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Limit {
+    /// [`Limits::max_input_bytes`]
+    InputBytes,
+    /// [`Limits::max_tags`]
+    Tags,
+    /// [`Limits::max_json_ld_bytes`]
+    JsonLdBytes,
+    /// [`Limits::max_items`]
+    Items,
+    /// [`Limits::max_depth`]
+    Depth,
+    /// [`Limits::deadline`]
+    Deadline,
+}
+
+impl Limit {
+    /// Name of the matching [`Limits`] field
+    pub fn name(self) -> &'static str {
+        match self {
+            Limit::InputBytes => "max_input_bytes",
+            Limit::Tags => "max_tags",
+            Limit::JsonLdBytes => "max_json_ld_bytes",
+            Limit::Items => "max_items",
+            Limit::Depth => "max_depth",
+            Limit::Deadline => "deadline",
+        }
+    }
+}
+
+// The limits of one call and the first one that was hit
+pub(crate) struct Budget {
+    pub(crate) limits: Limits,
+    deadline: Option<Instant>,
+    pub(crate) hit: Option<Limit>,
+}
+
+impl Budget {
+    pub(crate) fn new(limits: &Limits) -> Self {
+        Self { limits: *limits, deadline: limits.deadline.map(|d| Instant::now() + d), hit: None }
+    }
+
+    pub(crate) fn unlimited() -> Self {
+        Self::new(&Limits::default())
+    }
+
+    pub(crate) fn hit(&mut self, limit: Limit) {
+        self.hit.get_or_insert(limit);
+    }
+
+    // Whether another stage may start; false once the deadline has passed
+    pub(crate) fn allows(&mut self) -> bool {
+        match self.deadline {
+            Some(deadline) if Instant::now() >= deadline => {
+                self.hit(Limit::Deadline);
+                false
+            }
+            _ => true,
+        }
+    }
+
+    // The prefix of `html` within the input byte and tag limits
+    pub(crate) fn cut_input<'h>(&mut self, html: &'h str) -> &'h str {
+        let mut end = html.len();
+
+        if let Some(max) = self.limits.max_input_bytes.filter(|&max| max < end) {
+            end = max;
+            while !html.is_char_boundary(end) {
+                end -= 1;
+            }
+            self.hit(Limit::InputBytes);
+        }
+
+        if let Some(max) = self.limits.max_tags {
+            if let Some(pos) = nth_start_tag(&html[..end], max) {
+                end = pos;
+                self.hit(Limit::Tags);
+            }
+        }
+
+        &html[..end]
+    }
+
+    // Detach every subtree rooted deeper than the depth limit, once parsed
+    //
+    // Detached nodes stay in the tree's arena, so extractors must walk from
+    // the root rather than over `tree.nodes()` (or `Html::select`).
+    pub(crate) fn prune(&mut self, document: &mut Html) {
+        let Some(max) = self.limits.max_depth else {
+            return;
+        };
+
+        let mut cut = Vec::new();
+        let mut stack = vec![(document.tree.root(), 0)];
+        while let Some((node, depth)) = stack.pop() {
+            if depth > max {
+                cut.push(node.id());
+            } else {
+                stack.extend(node.children().map(|child| (child, depth + 1)));
+            }
+        }
+
+        if !cut.is_empty() {
+            for id in cut {
+                if let Some(mut node) = document.tree.get_mut(id) {
+                    node.detach();
+                }
+            }
+            self.hit(Limit::Depth);
+        }
+    }
+
+    // Truncate the item lists of `out` to the item limit
+    pub(crate) fn cap_items(&mut self, out: &mut Extraction) {
+        let Some(max) = self.limits.max_items else {
+            return;
+        };
+
+        fn cap<T>(items: Option<&mut Vec<T>>, max: usize) -> bool {
+            items.is_some_and(|items| {
+                let over = items.len() > max;
+                items.truncate(max);
+                over
+            })
+        }
+
+        let mut over = cap(out.json_ld.as_mut(), max);
+        over |= cap(out.microdata.as_mut(), max);
+        over |= cap(out.rdfa.as_mut(), max);
+        for items in out.microformats.iter_mut().flat_map(|mf| mf.values_mut()) {
+            over |= cap(Some(items), max);
+        }
+        if let Some(typed) = out.typed_microformats.as_mut() {
+            over |= typed.truncate(max);
+        }
+
+        if over {
+            self.hit(Limit::Items);
+        }
+    }
+}
+
+// Offset of the start tag with index `n` in `html`, skipping everything the
+// tokenizer does not read as a start tag
+fn nth_start_tag(html: &str, n: usize) -> Option<usize> {
+    let bytes = html.as_bytes();
+    let mut pos = 0;
+    let mut count = 0;
+
+    while let Some(offset) = memchr::memchr(b'<', &bytes[pos..]) {
+        let start = pos + offset;
+        let rest = &bytes[start..];
+
+        // Comments, doctypes, processing instructions and end tags
+        if rest.starts_with(b"<!--") {
+            pos = head::find(bytes, start + 4, b"-->").map_or(bytes.len(), |end| end + 3);
+            continue;
+        }
+        if rest.starts_with(b"<!") || rest.starts_with(b"<?") || rest.starts_with(b"</") {
+            pos = memchr::memchr(b'>', &rest[2..]).map_or(bytes.len(), |end| start + 2 + end + 1);
+            continue;
+        }
+        if !rest.get(1).is_some_and(u8::is_ascii_alphabetic) {
+            // A stray '<' in text
+            pos = start + 1;
+            continue;
+        }
+
+        if count == n {
+            return Some(start);
+        }
+        count += 1;
+
+        let name_start = start + 1;
+        let name_len = bytes[name_start..]
+            .iter()
+            .take_while(|&&b| !b.is_ascii_whitespace() && b != b'/' && b != b'>')
+            .count();
+        let name = &bytes[name_start..name_start + name_len];
+        let end = head::tag_end(bytes, name_start + name_len)?;
+
+        if name.eq_ignore_ascii_case(b"plaintext") {
+            // Everything after it is text
+            return None;
+        }
+        pos = match RAW_TEXT_ELEMENTS.iter().find(|e| name.eq_ignore_ascii_case(e.as_bytes())) {
+            Some(raw) => head::find_end_tag(bytes, end, raw).unwrap_or(bytes.len()),
+            None => end,
+        };
+    }
+
+    None
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_cut_input_at_char_boundary() {
+        let limits = Limits { max_input_bytes: Some(3), ..Default::default() };
+        let mut budget = Budget::new(&limits);
+        assert_eq!(budget.cut_input("aé<b>"), "aé");
+        assert_eq!(budget.hit, Some(Limit::InputBytes));
+
+        let mut budget = Budget::new(&limits);
+        assert_eq!(budget.cut_input("ab"), "ab");
+        assert_eq!(budget.hit, None);
+    }
+
+    #[test]
+    fn test_cut_input_at_tag_limit() {
+        let limits = Limits { max_tags: Some(1), ..Default::default() };
+        let mut budget = Budget::new(&limits);
+        assert_eq!(budget.cut_input("<p>a</p><p>b</p>"), "<p>a</p>");
+        assert_eq!(budget.hit, Some(Limit::Tags));
+    }
+
+    #[test]
+    fn test_tag_limit_counts_only_start_tags() {
+        let limits = Limits { max_tags: Some(2), ..Default::default() };
+        let html = "<!DOCTYPE html><!-- <a><b> --><script>if (a<b) x = '<i>';</script> 1 < 2 <p>";
+        let mut budget = Budget::new(&limits);
+        assert_eq!(budget.cut_input(html), html);
+        assert_eq!(budget.hit, None);
+
+        let html = format!("{html}</p><em>cut</em>");
+        let mut budget = Budget::new(&limits);
+        assert_eq!(budget.cut_input(&html), &html[..html.find("<em>").unwrap()]);
+        assert_eq!(budget.hit, Some(Limit::Tags));
+    }
+
+    #[test]
+    fn test_deadline_stops_later_stages() {
+        let limits = Limits { deadline: Some(Duration::ZERO), ..Default::default() };
+        let mut budget = Budget::new(&limits);
+        assert!(!budget.allows());
+        assert_eq!(budget.hit, Some(Limit::Deadline));
+
+        assert!(Budget::unlimited().allows());
+    }
+
+    #[test]
+    fn test_first_limit_is_kept() {
+        let mut budget = Budget::unlimited();
+        budget.hit(Limit::Depth);
+        budget.hit(Limit::Items);
+        assert_eq!(budget.hit, Some(Limit::Depth));
+    }
+}
@@ -45,12 +45,20 @@
 /// - `number(selector)` - Parse as f32 → `Option<f32>`
 /// - `f64_number(selector)` - Parse as f64 → `Option<f64>`
 ///
+/// Every selector is compiled once per process via [`static_selector!`](crate::static_selector).
+///
 /// # Generated Code
 ///
-/// The macro generates a function with this signature:
+/// The macro generates four functions with these signatures:
 /// ```ignore
 /// pub fn extract(html: &str, base_url: Option<&str>) -> Result<Vec<TypeName>>
+/// pub fn extract_from_document(document: &Html, base_url: Option<&str>) -> Result<Vec<TypeName>>
+/// pub fn extract_with_base(document: &Html, base: &BaseUrl) -> Result<Vec<TypeName>>
+/// pub fn extract_from_element(element: &ElementRef, base: &BaseUrl) -> TypeName
 /// ```
+///
+/// Nested `h-card`/`h-product` properties are read with the nested type's
+/// `extract_from_element()` in place, without re-parsing their HTML.
 #[macro_export]
 macro_rules! microformat_extractor {
     // Main entry point: TypeName, root_selector { field: type(selector), ... }
@@ -63,31 +71,50 @@ macro_rules! microformat_extractor {
     ) => {
         #[allow(unused_variables)]
         pub fn extract(html: &str, base_url: Option<&str>) -> $crate::Result<Vec<$type_name>> {
-            use $crate::html_utils;
-
-            let document = html_utils::parse_html(html);
-            let mut items = Vec::new();
-
-            let root_selector = html_utils::create_selector($root_selector)?;
+            extract_from_document(&$crate::html_utils::parse_html(html), base_url)
+        }
 
-            for element in document.select(&root_selector) {
-                let mut item = <$type_name>::default();
+        #[allow(unused_variables)]
+        pub fn extract_from_document(
+            document: &$crate::html_utils::Html,
+            base_url: Option<&str>,
+        ) -> $crate::Result<Vec<$type_name>> {
+            extract_with_base(document, &$crate::url_utils::BaseUrl::for_document(document, base_url))
+        }
 
-                $(
-                    microformat_extractor!(@extract_property
-                        element,
-                        item,
-                        $field,
-                        $prop_type,
-                        $selector,
-                        base_url
-                    );
-                )*
+        #[allow(unused_variables)]
+        pub fn extract_with_base(
+            document: &$crate::html_utils::Html,
+            base: &$crate::url_utils::BaseUrl,
+        ) -> $crate::Result<Vec<$type_name>> {
+            let root_selector = $crate::static_selector!($root_selector)?;
+
+            Ok(document
+                .root_element()
+                .select(root_selector)
+                .map(|element| extract_from_element(&element, base))
+                .collect())
+        }
 
-                items.push(item);
-            }
+        #[allow(unused_variables)]
+        pub fn extract_from_element(
+            element: &$crate::html_utils::ElementRef,
+            base: &$crate::url_utils::BaseUrl,
+        ) -> $type_name {
+            let mut item = <$type_name>::default();
 
-            Ok(items)
+            $(
+                microformat_extractor!(@extract_property
+                    element,
+                    item,
+                    $field,
+                    $prop_type,
+                    $selector,
+                    base
+                );
+            )*
+
+            item
         }
     };
 
@@ -105,70 +132,89 @@ macro_rules! microformat_extractor {
     ) => {
         #[allow(unused_variables)]
         pub fn extract(html: &str, base_url: Option<&str>) -> $crate::Result<Vec<$type_name>> {
-            use $crate::html_utils;
-
-            let document = html_utils::parse_html(html);
-            let mut items = Vec::new();
-
-            let root_selector = html_utils::create_selector($root_selector)?;
-
-            for element in document.select(&root_selector) {
-                let mut item = <$type_name>::default();
-
-                // Extract regular properties
-                $(
-                    microformat_extractor!(@extract_property
-                        element,
-                        item,
-                        $field,
-                        $prop_type,
-                        $($selector),+,
-                        base_url
-                    );
-                )*
-
-                // Extract dual-field properties
-                $(
-                    microformat_extractor!(@extract_dual_property
-                        element,
-                        item,
-                        $text_field,
-                        $nested_field,
-                        $dual_prop_type,
-                        $nested_sel,
-                        $text_sel,
-                        base_url
-                    );
-                )*
-
-                items.push(item);
-            }
+            extract_from_document(&$crate::html_utils::parse_html(html), base_url)
+        }
+
+        #[allow(unused_variables)]
+        pub fn extract_from_document(
+            document: &$crate::html_utils::Html,
+            base_url: Option<&str>,
+        ) -> $crate::Result<Vec<$type_name>> {
+            extract_with_base(document, &$crate::url_utils::BaseUrl::for_document(document, base_url))
+        }
+
+        #[allow(unused_variables)]
+        pub fn extract_with_base(
+            document: &$crate::html_utils::Html,
+            base: &$crate::url_utils::BaseUrl,
+        ) -> $crate::Result<Vec<$type_name>> {
+            let root_selector = $crate::static_selector!($root_selector)?;
+
+            Ok(document
+                .root_element()
+                .select(root_selector)
+                .map(|element| extract_from_element(&element, base))
+                .collect())
+        }
 
-            Ok(items)
+        #[allow(unused_variables)]
+        pub fn extract_from_element(
+            element: &$crate::html_utils::ElementRef,
+            base: &$crate::url_utils::BaseUrl,
+        ) -> $type_name {
+            let mut item = <$type_name>::default();
+
+            // Extract regular properties
+            $(
+                microformat_extractor!(@extract_property
+                    element,
+                    item,
+                    $field,
+                    $prop_type,
+                    $($selector),+,
+                    base
+                );
+            )*
+
+            // Extract dual-field properties
+            $(
+                microformat_extractor!(@extract_dual_property
+                    element,
+                    item,
+                    $text_field,
+                    $nested_field,
+                    $dual_prop_type,
+                    $nested_sel,
+                    $text_sel,
+                    base
+                );
+            )*
+
+            item
         }
     };
 
     // Extract a single text property
-    (@extract_property $element:ident, $item:ident, $field:ident, text, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, text, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 $item.$field = $crate::html_utils::extract_text(&elem);
             }
         }
     };
 
     // Extract a URL property (from href or src attribute)
-    (@extract_property $element:ident, $item:ident, $field:ident, url, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, url, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 let url = $crate::html_utils::get_attr(&elem, "href")
                     .or_else(|| $crate::html_utils::get_attr(&elem, "src"));
 
-                // Resolve relative URLs if base_url is provided
+                // Resolve relative URLs if a base URL is known
                 if let Some(url_str) = url {
-                    if let Some(base) = $base_url {
+                    if $base_url.as_str().is_some() {
                         // Try to resolve relative URL
-                        if let Ok(resolved) = $crate::url_utils::resolve_url(Some(base), &url_str) {
+                        if let Ok(resolved) = $base_url.resolve(&url_str) {
                             $item.$field = Some(resolved);
                         } else {
                             // If resolution fails, use original URL
@@ -183,9 +229,9 @@ macro_rules! microformat_extractor {
     };
 
     // Extract HTML content (inner HTML)
-    (@extract_property $element:ident, $item:ident, $field:ident, html, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, html, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 let html_content = elem.inner_html().trim().to_string();
                 if !html_content.is_empty() {
                     $item.$field = Some(html_content);
@@ -195,9 +241,9 @@ macro_rules! microformat_extractor {
     };
 
     // Extract datetime (from datetime attribute or text)
-    (@extract_property $element:ident, $item:ident, $field:ident, date, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, date, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 $item.$field = $crate::html_utils::get_attr(&elem, "datetime")
                     .or_else(|| $crate::html_utils::extract_text(&elem));
             }
@@ -205,9 +251,9 @@ macro_rules! microformat_extractor {
     };
 
     // Extract multiple text values (Vec<String>)
-    (@extract_property $element:ident, $item:ident, $field:ident, multi_text, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            for elem in $element.select(&sel) {
+    (@extract_property $element:ident, $item:ident, $field:ident, multi_text, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            for elem in $element.select(sel) {
                 if let Some(text) = $crate::html_utils::extract_text(&elem) {
                     $item.$field.push(text);
                 }
@@ -216,15 +262,15 @@ macro_rules! microformat_extractor {
     };
 
     // Extract multiple URLs (Vec<String>)
-    (@extract_property $element:ident, $item:ident, $field:ident, multi_url, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            for elem in $element.select(&sel) {
+    (@extract_property $element:ident, $item:ident, $field:ident, multi_url, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            for elem in $element.select(sel) {
                 if let Some(url) = $crate::html_utils::get_attr(&elem, "href")
                     .or_else(|| $crate::html_utils::get_attr(&elem, "src")) {
 
-                    // Resolve relative URLs if base_url is provided
-                    if let Some(base) = $base_url {
-                        if let Ok(resolved) = $crate::url_utils::resolve_url(Some(base), &url) {
+                    // Resolve relative URLs if a base URL is known
+                    if $base_url.as_str().is_some() {
+                        if let Ok(resolved) = $base_url.resolve(&url) {
                             $item.$field.push(resolved);
                         } else {
                             $item.$field.push(url);
@@ -238,9 +284,9 @@ macro_rules! microformat_extractor {
     };
 
     // Extract numeric value (f32)
-    (@extract_property $element:ident, $item:ident, $field:ident, number, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, number, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 if let Some(text) = $crate::html_utils::extract_text(&elem) {
                     // Try to parse as f32
                     if let Ok(num) = text.parse::<f32>() {
@@ -252,9 +298,9 @@ macro_rules! microformat_extractor {
     };
 
     // Extract numeric value (f64)
-    (@extract_property $element:ident, $item:ident, $field:ident, f64_number, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, f64_number, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 if let Some(text) = $crate::html_utils::extract_text(&elem) {
                     // Try to parse as f64
                     if let Ok(num) = text.parse::<f64>() {
@@ -266,9 +312,9 @@ macro_rules! microformat_extractor {
     };
 
     // Extract email (special handling for mailto: links)
-    (@extract_property $element:ident, $item:ident, $field:ident, email, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
+    (@extract_property $element:ident, $item:ident, $field:ident, email, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
                 $item.$field = $crate::html_utils::get_attr(&elem, "href")
                     .map(|s| s.trim_start_matches("mailto:").to_string())
                     .or_else(|| $crate::html_utils::extract_text(&elem));
@@ -277,29 +323,23 @@ macro_rules! microformat_extractor {
     };
 
     // Extract nested h-card microformat (Option<Box<HCard>>)
-    (@extract_property $element:ident, $item:ident, $field:ident, nested_hcard, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
-                let nested_html = elem.html();
-                if let Ok(items) = $crate::extractors::microformats::hcard::extract(&nested_html, $base_url) {
-                    if let Some(item) = items.first() {
-                        $item.$field = Some(Box::new(item.clone()));
-                    }
-                }
+    (@extract_property $element:ident, $item:ident, $field:ident, nested_hcard, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
+                let nested =
+                    $crate::extractors::microformats::hcard::extract_from_element(&elem, $base_url);
+                $item.$field = Some(Box::new(nested));
             }
         }
     };
 
     // Extract nested h-product microformat (Option<Box<HProduct>>)
-    (@extract_property $element:ident, $item:ident, $field:ident, nested_hproduct, $selector:expr, $base_url:ident) => {
-        if let Ok(sel) = $crate::html_utils::create_selector($selector) {
-            if let Some(elem) = $element.select(&sel).next() {
-                let nested_html = elem.html();
-                if let Ok(items) = $crate::extractors::microformats::hproduct::extract(&nested_html, $base_url) {
-                    if let Some(item) = items.first() {
-                        $item.$field = Some(Box::new(item.clone()));
-                    }
-                }
+    (@extract_property $element:ident, $item:ident, $field:ident, nested_hproduct, $selector:literal, $base_url:ident) => {
+        if let Ok(sel) = $crate::static_selector!($selector) {
+            if let Some(elem) = $element.select(sel).next() {
+                let nested =
+                    $crate::extractors::microformats::hproduct::extract_from_element(&elem, $base_url);
+                $item.$field = Some(Box::new(nested));
             }
         }
     };
@@ -307,22 +347,19 @@ macro_rules! microformat_extractor {
     // Extract nested h-card with text fallback (for dual-field patterns)
     // Tries nested h-card first, if not found falls back to text extraction
     (@extract_dual_property $element:ident, $item:ident, $text_field:ident, $nested_field:ident,
-     nested_hcard_or_text, $nested_sel:expr, $text_sel:expr, $base_url:ident) => {
+     nested_hcard_or_text, $nested_sel:literal, $text_sel:literal, $base_url:ident) => {
         let mut found_nested = false;
-        if let Ok(sel) = $crate::html_utils::create_selector($nested_sel) {
-            if let Some(elem) = $element.select(&sel).next() {
-                let nested_html = elem.html();
-                if let Ok(items) = $crate::extractors::microformats::hcard::extract(&nested_html, $base_url) {
-                    if let Some(item) = items.first() {
-                        $item.$nested_field = Some(Box::new(item.clone()));
-                        found_nested = true;
-                    }
-                }
+        if let Ok(sel) = $crate::static_selector!($nested_sel) {
+            if let Some(elem) = $element.select(sel).next() {
+                let nested =
+                    $crate::extractors::microformats::hcard::extract_from_element(&elem, $base_url);
+                $item.$nested_field = Some(Box::new(nested));
+                found_nested = true;
             }
         }
         if !found_nested {
-            if let Ok(sel) = $crate::html_utils::create_selector($text_sel) {
-                if let Some(elem) = $element.select(&sel).next() {
+            if let Ok(sel) = $crate::static_selector!($text_sel) {
+                if let Some(elem) = $element.select(sel).next() {
                     $item.$text_field = $crate::html_utils::extract_text(&elem);
                 }
             }
@@ -332,22 +369,19 @@ macro_rules! microformat_extractor {
     // Extract nested h-product with text fallback (for dual-field patterns)
     // Tries nested h-product first, if not found falls back to text extraction
     (@extract_dual_property $element:ident, $item:ident, $text_field:ident, $nested_field:ident,
-     nested_hproduct_or_text, $nested_sel:expr, $text_sel:expr, $base_url:ident) => {
+     nested_hproduct_or_text, $nested_sel:literal, $text_sel:literal, $base_url:ident) => {
         let mut found_nested = false;
-        if let Ok(sel) = $crate::html_utils::create_selector($nested_sel) {
-            if let Some(elem) = $element.select(&sel).next() {
-                let nested_html = elem.html();
-                if let Ok(items) = $crate::extractors::microformats::hproduct::extract(&nested_html, $base_url) {
-                    if let Some(item) = items.first() {
-                        $item.$nested_field = Some(Box::new(item.clone()));
-                        found_nested = true;
-                    }
-                }
+        if let Ok(sel) = $crate::static_selector!($nested_sel) {
+            if let Some(elem) = $element.select(sel).next() {
+                let nested =
+                    $crate::extractors::microformats::hproduct::extract_from_element(&elem, $base_url);
+                $item.$nested_field = Some(Box::new(nested));
+                found_nested = true;
             }
         }
         if !found_nested {
-            if let Ok(sel) = $crate::html_utils::create_selector($text_sel) {
-                if let Some(elem) = $element.select(&sel).next() {
+            if let Ok(sel) = $crate::static_selector!($text_sel) {
+                if let Some(elem) = $element.select(sel).next() {
                     $item.$text_field = $crate::html_utils::extract_text(&elem);
                 }
             }
@@ -15,7 +15,7 @@
 //! For each invocation, the macro generates a complete PyO3 function with:
 //! - Proper `#[pyfunction]` annotation
 //! - `#[pyo3(signature = (html, base_url=None))]` for optional parameters
-//! - GIL acquisition via `Python::with_gil`
+//! - `str`, `bytes` or buffer input, extracted with the GIL released (`with_html`)
 //! - Error conversion to PyValueError
 //! - Automatic conversion to Python objects via `.to_py_dict()`
 //!
@@ -31,13 +31,17 @@
 //! /// Extract h-card microformat data
 //! #[pyfunction]
 //! #[pyo3(signature = (html, base_url=None))]
-//! fn extract_hcard(html: &str, base_url: Option<&str>) -> PyResult<Vec<PyObject>> {
-//!     Python::with_gil(|py| {
-//!         let items = extractors::microformats::hcard::extract(html, base_url)
-//!             .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
+//! fn extract_hcard(
+//!     py: Python,
+//!     html: &Bound<'_, PyAny>,
+//!     base_url: Option<&str>,
+//! ) -> PyResult<Vec<PyObject>> {
+//!     let items = with_html(py, html, |html| {
+//!         extractors::microformats::hcard::extract(html, base_url)
+//!     })?
+//!     .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
 //!
-//!         Ok(items.iter().map(|item| item.to_py_dict(py).into()).collect())
-//!     })
+//!     Ok(items.iter().map(|item| item.to_py_dict(py).into()).collect())
 //! }
 //! ```
 
@@ -67,13 +71,17 @@ macro_rules! py_extractor_binding {
         /// Extract microformat data
         #[pyfunction]
         #[pyo3(signature = (html, base_url=None))]
-        fn $func_name(html: &str, base_url: Option<&str>) -> PyResult<Vec<PyObject>> {
-            Python::with_gil(|py| {
-                let items = extractors::microformats::$module::extract(html, base_url)
-                    .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
+        fn $func_name(
+            py: Python,
+            html: &Bound<'_, PyAny>,
+            base_url: Option<&str>,
+        ) -> PyResult<Vec<PyObject>> {
+            let items = with_html(py, html, |html| {
+                extractors::microformats::$module::extract(html, base_url)
+            })?
+            .map_err(|e| PyErr::new::<pyo3::exceptions::PyValueError, _>(e.to_string()))?;
 
-                Ok(items.iter().map(|item| item.to_py_dict(py).into()).collect())
-            })
+            Ok(items.iter().map(|item| item.to_py_dict(py).into()).collect())
         }
     };
 }
@@ -0,0 +1,24 @@
+//! Precompiled CSS selectors
+//!
+//! Selector literals used on the extraction hot path are compiled once per
+//! process and shared by every later call, instead of being re-parsed for each
+//! document (or, inside the microformat extractors, for each root element).
+
+/// Get a `&'static Selector` for a selector literal, compiling it on first use
+///
+/// Expands to a `Result<&'static Selector>`. Each expansion site owns its own
+/// lazily initialized static, so the same literal at two call sites is compiled
+/// twice at most; an invalid selector reports the same error as
+/// `html_utils::create_selector` on every call.
+///
+/// ```ignore
+/// let selector = static_selector!("script[type='application/ld+json']")?;
+/// for script in document.root_element().select(selector) { /* ... */ }
+/// ```
+#[macro_export]
+macro_rules! static_selector {
+    ($selector:literal) => {{
+        static SELECTOR: $crate::html_utils::SelectorCell = $crate::html_utils::SelectorCell::new();
+        $crate::html_utils::cached_selector(&SELECTOR, $selector)
+    }};
+}
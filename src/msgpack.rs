@@ -0,0 +1,668 @@
+//! MessagePack encoding of extraction results
+//!
+//! A compact binary alternative to the JSON the rest of the API produces,
+//! for pipelines where JSON text is both the largest artifact and the
+//! slowest to read back. [`to_vec`] and [`write`] encode any `Serialize`
+//! type with the same shape `serde_json` gives it: structs become maps keyed
+//! by field name, `None` becomes nil, enums are externally tagged, and
+//! skipped fields are left out. A MessagePack reader therefore sees exactly
+//! the objects a JSON parser would see on the JSON output.
+//!
+//! Integers and strings take their smallest encoding, so the output is
+//! typically well under the size of the JSON text, and reading it back needs
+//! no number or escape parsing.
+
+use std::fmt;
+use std::ops::Range;
+
+use serde::ser::{self, Serialize};
+
+use crate::extract::{formats, Extraction};
+
+/// A value that could not be encoded
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Error(String);
+
+impl fmt::Display for Error {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        write!(f, "MessagePack encoding failed: {}", self.0)
+    }
+}
+
+impl std::error::Error for Error {}
+
+impl ser::Error for Error {
+    fn custom<T: fmt::Display>(msg: T) -> Self {
+        Error(msg.to_string())
+    }
+}
+
+/// Encode `value` as MessagePack
+pub fn to_vec<T: Serialize + ?Sized>(value: &T) -> Result<Vec<u8>, Error> {
+    let mut out = Vec::new();
+    write(&mut out, value)?;
+    Ok(out)
+}
+
+/// Append the MessagePack encoding of `value` to `out`
+pub fn write<T: Serialize + ?Sized>(out: &mut Vec<u8>, value: &T) -> Result<(), Error> {
+    value.serialize(&mut Serializer { out })
+}
+
+/// Encode an extraction as one map keyed like the combined JSON document of
+/// the C API
+///
+/// Keys are `meta`, `openGraph`, `twitter`, `jsonLd`, `microdata`,
+/// `microformats`, `rdfa`, `dublinCore`, `manifest`, `oembed` and `relLinks`;
+/// formats that were not selected or not found are left out.
+pub fn extraction_to_vec(extraction: &Extraction) -> Result<Vec<u8>, Error> {
+    let mut out = Vec::new();
+    write_extraction(&mut out, extraction)?;
+    Ok(out)
+}
+
+/// Append an extraction to `out` as in [`extraction_to_vec`]
+///
+/// Returns where each format's value landed in `out`, indexed by the bit
+/// position of its `formats` flag; absent formats get an empty range.
+pub fn write_extraction(
+    out: &mut Vec<u8>,
+    extraction: &Extraction,
+) -> Result<[Range<usize>; formats::COUNT], Error> {
+    struct Writer<'a> {
+        out: &'a mut Vec<u8>,
+        spans: [Range<usize>; formats::COUNT],
+        next: usize,
+    }
+
+    impl Writer<'_> {
+        fn entry<T: Serialize>(&mut self, key: &str, value: &Option<T>) -> Result<(), Error> {
+            if let Some(value) = value {
+                write_str(self.out, key)?;
+                let start = self.out.len();
+                write(self.out, value)?;
+                self.spans[self.next] = start..self.out.len();
+            }
+            self.next += 1;
+            Ok(())
+        }
+    }
+
+    let e = extraction;
+    let present = [
+        e.meta.is_some(),
+        e.open_graph.is_some(),
+        e.twitter.is_some(),
+        e.json_ld.is_some(),
+        e.microdata.is_some(),
+        e.microformats.is_some(),
+        e.rdfa.is_some(),
+        e.dublin_core.is_some(),
+        e.manifest.is_some(),
+        e.oembed.is_some(),
+        e.rel_links.is_some(),
+    ];
+    write_map_len(out, present.iter().filter(|&&p| p).count())?;
+
+    let mut w = Writer { out, spans: Default::default(), next: 0 };
+    w.entry("meta", &e.meta)?;
+    w.entry("openGraph", &e.open_graph)?;
+    w.entry("twitter", &e.twitter)?;
+    w.entry("jsonLd", &e.json_ld)?;
+    w.entry("microdata", &e.microdata)?;
+    w.entry("microformats", &e.microformats)?;
+    w.entry("rdfa", &e.rdfa)?;
+    w.entry("dublinCore", &e.dublin_core)?;
+    w.entry("manifest", &e.manifest)?;
+    w.entry("oembed", &e.oembed)?;
+    w.entry("relLinks", &e.rel_links)?;
+    Ok(w.spans)
+}
+
+/// Append a string header and the bytes of `s` to `out`
+pub fn write_str(out: &mut Vec<u8>, s: &str) -> Result<(), Error> {
+    let len = s.len();
+    if len < 32 {
+        out.push(0xa0 | len as u8);
+    } else if len <= u8::MAX as usize {
+        out.extend_from_slice(&[0xd9, len as u8]);
+    } else if len <= u16::MAX as usize {
+        out.push(0xda);
+        out.extend_from_slice(&(len as u16).to_be_bytes());
+    } else {
+        out.push(0xdb);
+        out.extend_from_slice(&length(len)?.to_be_bytes());
+    }
+    out.extend_from_slice(s.as_bytes());
+    Ok(())
+}
+
+/// Append a header for a map of `len` entries to `out`
+pub fn write_map_len(out: &mut Vec<u8>, len: usize) -> Result<(), Error> {
+    write_len(out, len, 0x80, 0xde, 0xdf)
+}
+
+fn write_array_len(out: &mut Vec<u8>, len: usize) -> Result<(), Error> {
+    write_len(out, len, 0x90, 0xdc, 0xdd)
+}
+
+// Array and map headers: a fix form for fewer than 16 entries, then 16 and 32 bits
+fn write_len(out: &mut Vec<u8>, len: usize, fix: u8, m16: u8, m32: u8) -> Result<(), Error> {
+    if len < 16 {
+        out.push(fix | len as u8);
+    } else if len <= u16::MAX as usize {
+        out.push(m16);
+        out.extend_from_slice(&(len as u16).to_be_bytes());
+    } else {
+        out.push(m32);
+        out.extend_from_slice(&length(len)?.to_be_bytes());
+    }
+    Ok(())
+}
+
+fn length(len: usize) -> Result<u32, Error> {
+    u32::try_from(len).map_err(|_| Error(format!("length {len} exceeds the format's limit")))
+}
+
+struct Serializer<'a> {
+    out: &'a mut Vec<u8>,
+}
+
+impl Serializer<'_> {
+    fn uint(&mut self, v: u64) {
+        if v < 0x80 {
+            self.out.push(v as u8);
+        } else if v <= u8::MAX as u64 {
+            self.out.extend_from_slice(&[0xcc, v as u8]);
+        } else if v <= u16::MAX as u64 {
+            self.out.push(0xcd);
+            self.out.extend_from_slice(&(v as u16).to_be_bytes());
+        } else if v <= u32::MAX as u64 {
+            self.out.push(0xce);
+            self.out.extend_from_slice(&(v as u32).to_be_bytes());
+        } else {
+            self.out.push(0xcf);
+            self.out.extend_from_slice(&v.to_be_bytes());
+        }
+    }
+
+    fn int(&mut self, v: i64) {
+        if v >= 0 {
+            self.uint(v as u64);
+        } else if v >= -32 {
+            self.out.push(v as u8);
+        } else if v >= i8::MIN as i64 {
+            self.out.extend_from_slice(&[0xd0, v as u8]);
+        } else if v >= i16::MIN as i64 {
+            self.out.push(0xd1);
+            self.out.extend_from_slice(&(v as i16).to_be_bytes());
+        } else if v >= i32::MIN as i64 {
+            self.out.push(0xd2);
+            self.out.extend_from_slice(&(v as i32).to_be_bytes());
+        } else {
+            self.out.push(0xd3);
+            self.out.extend_from_slice(&v.to_be_bytes());
+        }
+    }
+
+    // A map or array of `len` entries, or of as many as get written when the
+    // length is not known up front
+    fn compound(&mut self, len: Option<usize>, map: bool) -> Result<Compound<'_>, Error> {
+        let start = self.out.len();
+        match len {
+            Some(len) if map => write_map_len(self.out, len)?,
+            Some(len) => write_array_len(self.out, len)?,
+            // Reserve the widest header and fix it up in `end`
+            None => self.out.extend_from_slice(&[0; 5]),
+        }
+        Ok(Compound { out: self.out, start, count: len.is_none().then_some(0), map })
+    }
+
+    // `{variant: <value>}`, as serde_json tags enum variants
+    fn variant(&mut self, variant: &str) -> Result<(), Error> {
+        self.out.push(0x81);
+        write_str(self.out, variant)
+    }
+}
+
+struct Compound<'a> {
+    out: &'a mut Vec<u8>,
+    start: usize,
+    // Entries written so far when the header is still to be filled in
+    count: Option<usize>,
+    map: bool,
+}
+
+impl Compound<'_> {
+    fn element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        value.serialize(&mut Serializer { out: self.out })
+    }
+
+    fn entry<T: Serialize + ?Sized>(&mut self, key: &str, value: &T) -> Result<(), Error> {
+        write_str(self.out, key)?;
+        self.count = self.count.map(|n| n + 1);
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        let Some(count) = self.count else {
+            return Ok(());
+        };
+
+        let mut header = Vec::with_capacity(5);
+        if self.map {
+            write_map_len(&mut header, count)?;
+        } else {
+            write_array_len(&mut header, count)?;
+        }
+        self.out.splice(self.start..self.start + 5, header);
+        Ok(())
+    }
+}
+
+impl<'a> ser::Serializer for &'a mut Serializer<'_> {
+    type Ok = ();
+    type Error = Error;
+    type SerializeSeq = Compound<'a>;
+    type SerializeTuple = Compound<'a>;
+    type SerializeTupleStruct = Compound<'a>;
+    type SerializeTupleVariant = Compound<'a>;
+    type SerializeMap = Compound<'a>;
+    type SerializeStruct = Compound<'a>;
+    type SerializeStructVariant = Compound<'a>;
+
+    fn serialize_bool(self, v: bool) -> Result<(), Error> {
+        self.out.push(if v { 0xc3 } else { 0xc2 });
+        Ok(())
+    }
+
+    fn serialize_i8(self, v: i8) -> Result<(), Error> {
+        self.int(v.into());
+        Ok(())
+    }
+
+    fn serialize_i16(self, v: i16) -> Result<(), Error> {
+        self.int(v.into());
+        Ok(())
+    }
+
+    fn serialize_i32(self, v: i32) -> Result<(), Error> {
+        self.int(v.into());
+        Ok(())
+    }
+
+    fn serialize_i64(self, v: i64) -> Result<(), Error> {
+        self.int(v);
+        Ok(())
+    }
+
+    fn serialize_i128(self, v: i128) -> Result<(), Error> {
+        match (i64::try_from(v), u64::try_from(v)) {
+            (Ok(v), _) => self.int(v),
+            (_, Ok(v)) => self.uint(v),
+            _ => return Err(Error(format!("integer {v} is out of range"))),
+        }
+        Ok(())
+    }
+
+    fn serialize_u8(self, v: u8) -> Result<(), Error> {
+        self.uint(v.into());
+        Ok(())
+    }
+
+    fn serialize_u16(self, v: u16) -> Result<(), Error> {
+        self.uint(v.into());
+        Ok(())
+    }
+
+    fn serialize_u32(self, v: u32) -> Result<(), Error> {
+        self.uint(v.into());
+        Ok(())
+    }
+
+    fn serialize_u64(self, v: u64) -> Result<(), Error> {
+        self.uint(v);
+        Ok(())
+    }
+
+    fn serialize_u128(self, v: u128) -> Result<(), Error> {
+        let v = u64::try_from(v).map_err(|_| Error(format!("integer {v} is out of range")))?;
+        self.uint(v);
+        Ok(())
+    }
+
+    fn serialize_f32(self, v: f32) -> Result<(), Error> {
+        self.out.push(0xca);
+        self.out.extend_from_slice(&v.to_be_bytes());
+        Ok(())
+    }
+
+    fn serialize_f64(self, v: f64) -> Result<(), Error> {
+        self.out.push(0xcb);
+        self.out.extend_from_slice(&v.to_be_bytes());
+        Ok(())
+    }
+
+    fn serialize_char(self, v: char) -> Result<(), Error> {
+        write_str(self.out, v.encode_utf8(&mut [0; 4]))
+    }
+
+    fn serialize_str(self, v: &str) -> Result<(), Error> {
+        write_str(self.out, v)
+    }
+
+    fn serialize_bytes(self, v: &[u8]) -> Result<(), Error> {
+        let len = v.len();
+        if len <= u8::MAX as usize {
+            self.out.extend_from_slice(&[0xc4, len as u8]);
+        } else if len <= u16::MAX as usize {
+            self.out.push(0xc5);
+            self.out.extend_from_slice(&(len as u16).to_be_bytes());
+        } else {
+            self.out.push(0xc6);
+            self.out.extend_from_slice(&length(len)?.to_be_bytes());
+        }
+        self.out.extend_from_slice(v);
+        Ok(())
+    }
+
+    fn serialize_none(self) -> Result<(), Error> {
+        self.serialize_unit()
+    }
+
+    fn serialize_some<T: Serialize + ?Sized>(self, value: &T) -> Result<(), Error> {
+        value.serialize(self)
+    }
+
+    fn serialize_unit(self) -> Result<(), Error> {
+        self.out.push(0xc0);
+        Ok(())
+    }
+
+    fn serialize_unit_struct(self, _name: &'static str) -> Result<(), Error> {
+        self.serialize_unit()
+    }
+
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+    ) -> Result<(), Error> {
+        write_str(self.out, variant)
+    }
+
+    fn serialize_newtype_struct<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        value.serialize(self)
+    }
+
+    fn serialize_newtype_variant<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        self.variant(variant)?;
+        value.serialize(self)
+    }
+
+    fn serialize_seq(self, len: Option<usize>) -> Result<Compound<'a>, Error> {
+        self.compound(len, false)
+    }
+
+    fn serialize_tuple(self, len: usize) -> Result<Compound<'a>, Error> {
+        self.compound(Some(len), false)
+    }
+
+    fn serialize_tuple_struct(
+        self,
+        _name: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, Error> {
+        self.compound(Some(len), false)
+    }
+
+    fn serialize_tuple_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, Error> {
+        self.variant(variant)?;
+        self.compound(Some(len), false)
+    }
+
+    fn serialize_map(self, len: Option<usize>) -> Result<Compound<'a>, Error> {
+        self.compound(len, true)
+    }
+
+    // Derived impls leave fields skipped by `skip_serializing_if` out of
+    // `len`, so the header can be written up front; `#[serde(flatten)]`
+    // structs go through `serialize_map(None)` instead
+    fn serialize_struct(self, _name: &'static str, len: usize) -> Result<Compound<'a>, Error> {
+        self.compound(Some(len), true)
+    }
+
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Compound<'a>, Error> {
+        self.variant(variant)?;
+        self.compound(Some(len), true)
+    }
+}
+
+impl ser::SerializeSeq for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        self.count = self.count.map(|n| n + 1);
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+impl ser::SerializeTuple for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+impl ser::SerializeTupleStruct for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+impl ser::SerializeTupleVariant for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+impl ser::SerializeMap for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_key<T: Serialize + ?Sized>(&mut self, key: &T) -> Result<(), Error> {
+        self.count = self.count.map(|n| n + 1);
+        self.element(key)
+    }
+
+    fn serialize_value<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        self.element(value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+impl ser::SerializeStruct for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        key: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        self.entry(key, value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+impl ser::SerializeStructVariant for Compound<'_> {
+    type Ok = ();
+    type Error = Error;
+
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        key: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        self.entry(key, value)
+    }
+
+    fn end(self) -> Result<(), Error> {
+        Compound::end(self)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::collections::BTreeMap;
+
+    #[derive(serde::Serialize)]
+    struct Item {
+        name: &'static str,
+        #[serde(skip_serializing_if = "Option::is_none")]
+        url: Option<&'static str>,
+        count: i32,
+    }
+
+    #[test]
+    fn test_scalars_use_smallest_encoding() {
+        assert_eq!(to_vec(&5u64).unwrap(), [0x05]);
+        assert_eq!(to_vec(&200u32).unwrap(), [0xcc, 200]);
+        assert_eq!(to_vec(&-1i8).unwrap(), [0xff]);
+        assert_eq!(to_vec(&-33i64).unwrap(), [0xd0, 0xdf]);
+        assert_eq!(to_vec(&70000i64).unwrap(), [0xce, 0x00, 0x01, 0x11, 0x70]);
+        assert_eq!(to_vec(&Option::<u8>::None).unwrap(), [0xc0]);
+        assert_eq!(to_vec(&true).unwrap(), [0xc3]);
+        assert_eq!(to_vec(&1.5f64).unwrap(), [0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0]);
+        assert_eq!(to_vec("ab").unwrap(), [0xa2, b'a', b'b']);
+    }
+
+    #[test]
+    fn test_string_and_array_headers() {
+        let s = "x".repeat(40);
+        assert_eq!(to_vec(s.as_str()).unwrap()[..2], [0xd9, 40]);
+        let s = "x".repeat(300);
+        assert_eq!(to_vec(s.as_str()).unwrap()[..3], [0xda, 0x01, 0x2c]);
+
+        assert_eq!(to_vec(&[1u8, 2]).unwrap(), [0x92, 1, 2]);
+        let v = vec![0u8; 20];
+        assert_eq!(to_vec(&v).unwrap()[..3], [0xdc, 0x00, 20]);
+    }
+
+    #[test]
+    fn test_struct_skips_absent_fields() {
+        let item = Item { name: "a", url: None, count: 2 };
+        let expected =
+            [0x82, 0xa4, b'n', b'a', b'm', b'e', 0xa1, b'a', 0xa5, b'c', b'o', b'u', b'n', b't', 2];
+        assert_eq!(to_vec(&item).unwrap(), expected);
+    }
+
+    #[test]
+    fn test_unknown_length_header_is_fixed_up() {
+        struct Unsized(Vec<u8>);
+
+        impl Serialize for Unsized {
+            fn serialize<S: ser::Serializer>(&self, s: S) -> Result<S::Ok, S::Error> {
+                use ser::SerializeSeq;
+                let mut seq = s.serialize_seq(None)?;
+                for v in &self.0 {
+                    seq.serialize_element(v)?;
+                }
+                seq.end()
+            }
+        }
+
+        assert_eq!(to_vec(&Unsized(vec![7, 8])).unwrap(), [0x92, 7, 8]);
+        let long = to_vec(&Unsized(vec![1; 17])).unwrap();
+        assert_eq!(long[..3], [0xdc, 0x00, 17]);
+        assert_eq!(long.len(), 3 + 17);
+    }
+
+    #[test]
+    fn test_flattened_struct_header_is_fixed_up() {
+        #[derive(serde::Serialize)]
+        struct Outer {
+            id: u8,
+            #[serde(flatten)]
+            item: Item,
+        }
+
+        let outer = Outer { id: 1, item: Item { name: "a", url: None, count: 2 } };
+        let bytes = to_vec(&outer).unwrap();
+        assert_eq!(bytes[0], 0x83);
+        assert_eq!(bytes[1..4], [0xa2, b'i', b'd']);
+    }
+
+    #[test]
+    fn test_json_values_keep_their_shape() {
+        let value = serde_json::json!({"@type": "Thing", "n": [1, -2, 2.5], "x": null});
+        let mut expected = vec![0x83];
+        for (key, bytes) in [
+            ("@type", vec![0xa5, b'T', b'h', b'i', b'n', b'g']),
+            ("n", [vec![0x93, 1, 0xfe, 0xcb], 2.5f64.to_be_bytes().to_vec()].concat()),
+            ("x", vec![0xc0]),
+        ] {
+            write_str(&mut expected, key).unwrap();
+            expected.extend(bytes);
+        }
+        assert_eq!(to_vec(&value).unwrap(), expected);
+
+        let map: BTreeMap<&str, Vec<&str>> = [("author", vec!["/me"])].into();
+        assert_eq!(to_vec(&map).unwrap()[..2], [0x81, 0xa6]);
+    }
+}
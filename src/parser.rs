@@ -1,7 +1,7 @@
-use crate::errors::{MicroformatError, Result};
-use crate::extractors::common::url_utils;
+use crate::errors::Result;
+use crate::extractors::common::url_utils::BaseUrl;
 use crate::types::{MicroformatItem, PropertyValue};
-use scraper::{Html, Selector};
+use scraper::{ElementRef, Html};
 use std::collections::HashMap;
 
 /// Parse HTML and extract all microformats
@@ -9,90 +9,152 @@ pub fn parse_html(
     html: &str,
     base_url: Option<&str>,
 ) -> Result<HashMap<String, Vec<MicroformatItem>>> {
-    let document = Html::parse_document(html);
-    let mut results: HashMap<String, Vec<MicroformatItem>> = HashMap::new();
-
-    // Find all elements with microformat classes (h-*, p-*, u-*, dt-*, e-*)
-    let mf_selector = Selector::parse("[class*='h-']")
-        .map_err(|e| MicroformatError::ParseError(e.to_string()))?;
-
-    for element in document.select(&mf_selector) {
-        if let Some(classes) = element.value().attr("class") {
-            // Check for root microformat classes (h-*)
-            let h_classes: Vec<&str> =
-                classes.split_whitespace().filter(|c| c.starts_with("h-")).collect();
+    parse_document(&Html::parse_document(html), base_url)
+}
 
-            if !h_classes.is_empty() {
-                let item = parse_microformat_item(&element, base_url)?;
+/// Extract all microformats from an already parsed document
+///
+/// The document is walked once, depth first, keeping a stack of the open
+/// items. An `h-*` element inside another item becomes the value of its
+/// `p-*`/`u-*`/`dt-*`/`e-*` properties on that item, or one of the item's
+/// `children` when it has none, and its own properties stay with it. Only
+/// items outside any other item are returned, keyed by each of their types.
+pub fn parse_document(
+    document: &Html,
+    base_url: Option<&str>,
+) -> Result<HashMap<String, Vec<MicroformatItem>>> {
+    parse_document_with_base(document, &BaseUrl::for_document(document, base_url))
+}
 
-                for h_class in h_classes {
-                    results.entry(h_class.to_string()).or_default().push(item.clone());
+/// Extract all microformats from an already parsed document whose base URL
+/// is known, see [`parse_document`]
+pub fn parse_document_with_base(
+    document: &Html,
+    base: &BaseUrl,
+) -> Result<HashMap<String, Vec<MicroformatItem>>> {
+    let mut results: HashMap<String, Vec<MicroformatItem>> = HashMap::new();
+    let mut open: Vec<OpenItem> = Vec::new();
+
+    let mut stack = vec![Step::Enter(document.root_element())];
+    while let Some(step) = stack.pop() {
+        let element = match step {
+            Step::Enter(element) => element,
+            Step::Leave => {
+                if let Some(done) = open.pop() {
+                    close(done, &mut open, &mut results);
                 }
+                continue;
+            }
+        };
+
+        let classes = Classes::parse(element.value().attr("class"));
+        if !classes.types.is_empty() {
+            let item = MicroformatItem {
+                type_: classes.types.iter().map(|t| t.to_string()).collect(),
+                properties: HashMap::new(),
+                children: None,
+            };
+            open.push(OpenItem { item, properties: classes.properties });
+            stack.push(Step::Leave);
+        } else if let Some(owner) = open.last_mut() {
+            for (prefix, name) in classes.properties {
+                let value = extract_property_value(&element, prefix, base)?;
+                owner.item.properties.entry(name.to_string()).or_default().push(value);
             }
         }
+
+        let children = element.children().rev().filter_map(ElementRef::wrap);
+        stack.extend(children.map(Step::Enter));
     }
 
     Ok(results)
 }
 
-/// Parse a single microformat item
-fn parse_microformat_item(
-    element: &scraper::ElementRef,
-    base_url: Option<&str>,
-) -> Result<MicroformatItem> {
-    let mut properties: HashMap<String, Vec<PropertyValue>> = HashMap::new();
-    let mut type_classes = Vec::new();
-
-    // Extract type classes (h-*)
-    if let Some(classes) = element.value().attr("class") {
-        type_classes =
-            classes.split_whitespace().filter(|c| c.starts_with("h-")).map(String::from).collect();
-    }
+/// One step of the document walk
+enum Step<'a> {
+    Enter(ElementRef<'a>),
+    /// Close the innermost open item once its subtree has been visited
+    Leave,
+}
 
-    // Extract properties
-    extract_properties(element, &mut properties, base_url)?;
+/// An item whose element is still being walked
+struct OpenItem<'a> {
+    item: MicroformatItem,
+    /// Properties of the enclosing item this item is the value of
+    properties: Vec<(&'a str, &'a str)>,
+}
 
-    Ok(MicroformatItem { type_: type_classes, properties, children: None })
+/// The microformats2 classes of an element, tokenized once
+struct Classes<'a> {
+    /// Root class names (`h-*`)
+    types: Vec<&'a str>,
+    /// Property classes as (prefix, name), e.g. ("dt", "published")
+    properties: Vec<(&'a str, &'a str)>,
 }
 
-/// Extract properties from a microformat element
-fn extract_properties(
-    element: &scraper::ElementRef,
-    properties: &mut HashMap<String, Vec<PropertyValue>>,
-    base_url: Option<&str>,
-) -> Result<()> {
-    // Find all property elements (p-*, u-*, dt-*, e-*)
-    for child in element.descendants() {
-        if let Some(child_element) = scraper::ElementRef::wrap(child) {
-            if let Some(classes) = child_element.value().attr("class") {
-                for class in classes.split_whitespace() {
-                    let (prefix, name) = if let Some(name) = class.strip_prefix("p-") {
-                        ("p", name)
-                    } else if let Some(name) = class.strip_prefix("u-") {
-                        ("u", name)
-                    } else if let Some(name) = class.strip_prefix("dt-") {
-                        ("dt", name)
-                    } else if let Some(name) = class.strip_prefix("e-") {
-                        ("e", name)
-                    } else {
-                        continue;
-                    };
-
-                    let value = extract_property_value(&child_element, prefix, base_url)?;
-                    properties.entry(name.to_string()).or_default().push(value);
-                }
+impl<'a> Classes<'a> {
+    fn parse(class_attr: Option<&'a str>) -> Self {
+        let mut classes = Classes { types: Vec::new(), properties: Vec::new() };
+
+        for class in class_attr.unwrap_or_default().split_whitespace() {
+            let Some((prefix, name)) = class.split_once('-') else {
+                continue;
+            };
+            // Names are lowercase letters, digits and hyphens, so that classes
+            // such as `high-res` or `h-` are not mistaken for microformats
+            if name.is_empty()
+                || !name.bytes().all(|b| b.is_ascii_lowercase() || b.is_ascii_digit() || b == b'-')
+            {
+                continue;
+            }
+            match prefix {
+                "h" => classes.types.push(class),
+                "p" | "u" | "dt" | "e" => classes.properties.push((prefix, name)),
+                _ => {}
             }
         }
+
+        classes
     }
+}
 
-    Ok(())
+/// Attach a finished item to the enclosing item, or to the results if there is none
+fn close(
+    done: OpenItem,
+    open: &mut [OpenItem],
+    results: &mut HashMap<String, Vec<MicroformatItem>>,
+) {
+    let OpenItem { item, properties } = done;
+
+    let Some(owner) = open.last_mut() else {
+        // Only an item with several types is copied, once per extra type
+        for type_ in item.type_.iter().skip(1) {
+            results.entry(type_.clone()).or_default().push(item.clone());
+        }
+        if let Some(first) = item.type_.first().cloned() {
+            results.entry(first).or_default().push(item);
+        }
+        return;
+    };
+
+    match properties.split_last() {
+        Some(((_, last), rest)) => {
+            for (_, name) in rest {
+                let value = PropertyValue::Nested(Box::new(item.clone()));
+                owner.item.properties.entry(name.to_string()).or_default().push(value);
+            }
+            let value = PropertyValue::Nested(Box::new(item));
+            owner.item.properties.entry(last.to_string()).or_default().push(value);
+        }
+        None => owner.item.children.get_or_insert_with(Vec::new).push(item),
+    }
 }
 
 /// Extract a property value based on its type
 fn extract_property_value(
     element: &scraper::ElementRef,
     prefix: &str,
-    base_url: Option<&str>,
+    base: &BaseUrl,
 ) -> Result<PropertyValue> {
     match prefix {
         "p" => {
@@ -109,8 +171,7 @@ fn extract_property_value(
                 .map(String::from)
                 .unwrap_or_else(|| element.text().collect::<String>().trim().to_string());
 
-            let absolute_url =
-                if let Some(base) = base_url { resolve_url(base, &url)? } else { url };
+            let absolute_url = if base.as_str().is_some() { base.resolve(&url)? } else { url };
 
             Ok(PropertyValue::Url(absolute_url))
         }
@@ -134,14 +195,10 @@ fn extract_property_value(
     }
 }
 
-/// Resolve a relative URL against a base URL
-fn resolve_url(base: &str, relative: &str) -> Result<String> {
-    url_utils::resolve_url(Some(base), relative).map_err(Into::into)
-}
-
 #[cfg(test)]
 mod tests {
     use super::*;
+    use scraper::Selector;
 
     #[test]
     fn test_parse_html_basic() {
@@ -455,4 +512,65 @@ mod tests {
         let doc = Html::parse_document(html);
         assert!(!doc.root_element().html().is_empty());
     }
+
+    #[test]
+    fn test_parse_nested_item_as_property_value() {
+        let html = r#"
+            <div class="h-entry">
+                <span class="p-name">Blog Post</span>
+                <div class="p-author h-card">
+                    <span class="p-name">Author Name</span>
+                </div>
+            </div>
+        "#;
+        let items = parse_html(html, None).unwrap();
+        assert!(!items.contains_key("h-card"));
+
+        let entry = &items["h-entry"][0];
+        // The author's name stays with the author
+        assert_eq!(entry.properties["name"].len(), 1);
+        match &entry.properties["author"][0] {
+            PropertyValue::Nested(card) => {
+                assert_eq!(card.type_, vec!["h-card".to_string()]);
+                assert!(card.properties.contains_key("name"));
+            }
+            _ => panic!("Expected nested h-card"),
+        }
+    }
+
+    #[test]
+    fn test_parse_nested_item_without_property_is_child() {
+        let html = r#"
+            <div class="h-feed">
+                <span class="p-name">Feed</span>
+                <article class="h-entry"><span class="p-name">One</span></article>
+                <article class="h-entry"><span class="p-name">Two</span></article>
+            </div>
+        "#;
+        let items = parse_html(html, None).unwrap();
+        assert_eq!(items.len(), 1);
+
+        let feed = &items["h-feed"][0];
+        assert_eq!(feed.properties["name"].len(), 1);
+        let children = feed.children.as_ref().unwrap();
+        assert_eq!(children.len(), 2);
+        assert_eq!(children[1].type_, vec!["h-entry".to_string()]);
+    }
+
+    #[test]
+    fn test_parse_ignores_non_microformat_classes() {
+        let html = r#"<img class="high-res h- photo-u"><div class="h-card x-p-name"></div>"#;
+        let items = parse_html(html, None).unwrap();
+        assert_eq!(items.len(), 1);
+        assert!(items["h-card"][0].properties.is_empty());
+    }
+
+    #[test]
+    fn test_parse_item_with_several_types() {
+        let html = r#"<div class="h-card h-org"><span class="p-name">ACME</span></div>"#;
+        let items = parse_html(html, None).unwrap();
+        assert_eq!(items["h-card"].len(), 1);
+        assert_eq!(items["h-org"].len(), 1);
+        assert_eq!(items["h-org"][0].type_, vec!["h-card".to_string(), "h-org".to_string()]);
+    }
 }
@@ -0,0 +1,295 @@
+//! Persistent worker pool for batch extraction
+//!
+//! Batches are published to a queue shared by a fixed set of worker threads
+//! that live for the lifetime of the process (or until the pool is resized).
+//! Items are claimed one at a time from a shared counter, so a worker that
+//! finishes a small document immediately picks up the next one instead of
+//! waiting on a pre-assigned chunk. The calling thread works on its own batch
+//! too, which guarantees progress even when every worker is busy with batches
+//! from other callers.
+
+use std::any::Any;
+use std::collections::VecDeque;
+use std::panic::{self, AssertUnwindSafe};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Condvar, Mutex, MutexGuard, PoisonError};
+use std::thread;
+
+type Task<'a> = dyn Fn(usize) + Sync + 'a;
+
+/// One call to [`Pool::run`]
+struct Batch {
+    /// Borrowed from the caller of `run`, which outlives every use (see `work`)
+    task: *const Task<'static>,
+    len: usize,
+    next: AtomicUsize,
+    pending: Mutex<usize>,
+    done: Condvar,
+    panic: Mutex<Option<Box<dyn Any + Send>>>,
+}
+
+// SAFETY: `task` points to a `Sync` closure and is only dereferenced while the
+// owning `run` call is blocked waiting for the batch to finish.
+unsafe impl Send for Batch {}
+unsafe impl Sync for Batch {}
+
+impl Batch {
+    /// Claim and run items until none are left
+    fn work(&self) {
+        loop {
+            let index = self.next.fetch_add(1, Ordering::Relaxed);
+            if index >= self.len {
+                return;
+            }
+
+            // SAFETY: `run` does not return before `pending` reaches zero, which
+            // cannot happen while this claimed item is still running.
+            let task = unsafe { &*self.task };
+            if let Err(payload) = panic::catch_unwind(AssertUnwindSafe(|| task(index))) {
+                lock(&self.panic).get_or_insert(payload);
+            }
+
+            let mut pending = lock(&self.pending);
+            *pending -= 1;
+            if *pending == 0 {
+                self.done.notify_all();
+            }
+        }
+    }
+
+    fn exhausted(&self) -> bool {
+        self.next.load(Ordering::Relaxed) >= self.len
+    }
+}
+
+#[derive(Default)]
+struct Queue {
+    batches: VecDeque<Arc<Batch>>,
+    shutdown: bool,
+}
+
+#[derive(Default)]
+struct Shared {
+    queue: Mutex<Queue>,
+    available: Condvar,
+}
+
+/// A fixed-size set of worker threads
+pub struct Pool {
+    shared: Arc<Shared>,
+    threads: usize,
+}
+
+impl Pool {
+    /// Start a pool with `threads` workers
+    ///
+    /// With zero workers every batch runs on the calling thread.
+    pub fn new(threads: usize) -> Self {
+        let shared = Arc::new(Shared::default());
+
+        for index in 0..threads {
+            let shared = Arc::clone(&shared);
+            // A worker that fails to spawn only costs parallelism; the calling
+            // thread always drains its own batch
+            let _ = thread::Builder::new()
+                .name(format!("meta-oxide-{index}"))
+                .spawn(move || worker(&shared));
+        }
+
+        Self { shared, threads }
+    }
+
+    /// Number of worker threads
+    pub fn threads(&self) -> usize {
+        self.threads
+    }
+
+    /// Call `task(i)` for every `i` in `0..len`, spread over the pool
+    ///
+    /// Returns once every call has finished. If any call panics, the first
+    /// panic is resumed on the calling thread after the rest have completed.
+    pub fn run(&self, len: usize, task: &Task<'_>) {
+        if len == 0 {
+            return;
+        }
+        if self.threads == 0 || len == 1 {
+            (0..len).for_each(task);
+            return;
+        }
+
+        // SAFETY: only the lifetime is erased; this function blocks until
+        // every item has run, so the borrow is never used after it ends
+        let task = unsafe { std::mem::transmute::<*const Task<'_>, *const Task<'static>>(task) };
+        let batch = Arc::new(Batch {
+            task,
+            len,
+            next: AtomicUsize::new(0),
+            pending: Mutex::new(len),
+            done: Condvar::new(),
+            panic: Mutex::new(None),
+        });
+
+        lock(&self.shared.queue).batches.push_back(Arc::clone(&batch));
+        self.shared.available.notify_all();
+
+        batch.work();
+
+        let mut pending = lock(&batch.pending);
+        while *pending > 0 {
+            pending = batch.done.wait(pending).unwrap_or_else(PoisonError::into_inner);
+        }
+        drop(pending);
+
+        lock(&self.shared.queue).batches.retain(|b| !Arc::ptr_eq(b, &batch));
+
+        let payload = lock(&batch.panic).take();
+        if let Some(payload) = payload {
+            panic::resume_unwind(payload);
+        }
+    }
+
+    /// Compute `f(i)` for every `i` in `0..len` on the pool, in order
+    pub fn map<T, F>(&self, len: usize, f: F) -> Vec<T>
+    where
+        T: Send,
+        F: Fn(usize) -> T + Sync,
+    {
+        let slots: Vec<Mutex<Option<T>>> = (0..len).map(|_| Mutex::new(None)).collect();
+        self.run(len, &|index| *lock(&slots[index]) = Some(f(index)));
+        slots
+            .into_iter()
+            .map(|slot| {
+                slot.into_inner()
+                    .unwrap_or_else(PoisonError::into_inner)
+                    .expect("every item runs before Pool::run returns")
+            })
+            .collect()
+    }
+}
+
+impl Drop for Pool {
+    fn drop(&mut self) {
+        lock(&self.shared.queue).shutdown = true;
+        self.shared.available.notify_all();
+    }
+}
+
+fn worker(shared: &Shared) {
+    loop {
+        let batch = {
+            let mut queue = lock(&shared.queue);
+            loop {
+                if queue.shutdown {
+                    return;
+                }
+                while queue.batches.front().is_some_and(|b| b.exhausted()) {
+                    queue.batches.pop_front();
+                }
+                if let Some(batch) = queue.batches.front() {
+                    break Arc::clone(batch);
+                }
+                queue = shared.available.wait(queue).unwrap_or_else(PoisonError::into_inner);
+            }
+        };
+        batch.work();
+    }
+}
+
+/// Lock a mutex, ignoring poisoning (task panics are caught before they can poison)
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+/// Default worker count: one per available core
+pub fn default_threads() -> usize {
+    thread::available_parallelism().map_or(1, |n| n.get())
+}
+
+static GLOBAL: Mutex<Option<Arc<Pool>>> = Mutex::new(None);
+
+/// The process-wide pool, started with [`default_threads`] workers on first use
+pub fn global() -> Arc<Pool> {
+    Arc::clone(lock(&GLOBAL).get_or_insert_with(|| Arc::new(Pool::new(default_threads()))))
+}
+
+/// Replace the process-wide pool with one of `threads` workers
+///
+/// Zero selects [`default_threads`]. Batches already running finish on the old
+/// pool, whose workers exit once it is no longer in use.
+pub fn set_global_threads(threads: usize) {
+    resize(&mut lock(&GLOBAL), threads);
+}
+
+// Put a pool of `threads` workers (0 for the default) in `slot`, keeping the
+// current one if it already has that many
+fn resize(slot: &mut Option<Arc<Pool>>, threads: usize) {
+    let threads = if threads == 0 { default_threads() } else { threads };
+    if slot.as_ref().is_some_and(|pool| pool.threads() == threads) {
+        return;
+    }
+    *slot = Some(Arc::new(Pool::new(threads)));
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_map_preserves_order() {
+        let pool = Pool::new(4);
+        let out = pool.map(1000, |i| i * 2);
+        assert_eq!(out, (0..1000).map(|i| i * 2).collect::<Vec<_>>());
+    }
+
+    #[test]
+    fn test_run_without_workers() {
+        let pool = Pool::new(0);
+        let count = AtomicUsize::new(0);
+        pool.run(10, &|_| {
+            count.fetch_add(1, Ordering::Relaxed);
+        });
+        assert_eq!(count.load(Ordering::Relaxed), 10);
+    }
+
+    #[test]
+    fn test_pool_reused_across_concurrent_callers() {
+        let pool = Arc::new(Pool::new(2));
+        let handles: Vec<_> = (0..4)
+            .map(|n| {
+                let pool = Arc::clone(&pool);
+                thread::spawn(move || pool.map(100, |i| i + n))
+            })
+            .collect();
+
+        for (n, handle) in handles.into_iter().enumerate() {
+            assert_eq!(handle.join().unwrap(), (0..100).map(|i| i + n).collect::<Vec<_>>());
+        }
+    }
+
+    #[test]
+    fn test_panic_is_propagated() {
+        let pool = Pool::new(2);
+        let result = panic::catch_unwind(AssertUnwindSafe(|| {
+            pool.map(8, |i| if i == 5 { panic!("boom") } else { i })
+        }));
+        assert!(result.is_err());
+
+        // The pool keeps working after a panicking batch
+        assert_eq!(pool.map(3, |i| i), vec![0, 1, 2]);
+    }
+
+    // Sizes a local slot: the global pool is shared with tests running batches
+    #[test]
+    fn test_resize() {
+        let mut slot = None;
+        resize(&mut slot, 3);
+        let pool = Arc::clone(slot.as_ref().unwrap());
+        assert_eq!(pool.threads(), 3);
+
+        resize(&mut slot, 3);
+        assert!(Arc::ptr_eq(slot.as_ref().unwrap(), &pool), "same size keeps the pool");
+
+        resize(&mut slot, 0);
+        assert_eq!(slot.as_ref().unwrap().threads(), default_threads());
+    }
+}
@@ -0,0 +1,121 @@
+//! Byte-level prefilter for the DOM-walking formats
+//!
+//! Most pages carry no microdata, RDFa or microformats, yet extracting them
+//! costs a walk of the whole DOM each. [`formats_present`] searches the raw
+//! HTML for the attribute names and values those formats cannot do without
+//! (`itemscope`, `typeof`/`vocab`, an `h-*` class, `ld+json`) and clears the
+//! formats whose markers are missing, so their extractors are never run.
+//!
+//! A marker may match where the format is not really used (inside a comment,
+//! say); then the extractor runs and finds nothing, as it would have anyway.
+//! The reverse never happens, so skipping a format never changes a result.
+
+use std::sync::OnceLock;
+
+use memchr::memmem::Finder;
+
+use crate::extract::formats;
+
+/// Markers per format; a format may be present if any of its markers is
+const MARKERS: &[(u32, &[&str])] = &[
+    (formats::JSON_LD, &["ld+json"]),
+    (formats::MICRODATA, &["itemscope"]),
+    // An `h-` at the start of a class token, quoted, unquoted or after a space
+    (formats::MICROFORMATS, &["\"h-", "'h-", "=h-", " h-", "\th-", "\nh-", "\rh-", "\x0ch-"]),
+    (formats::RDFA, &["typeof", "vocab"]),
+];
+
+/// Formats the prefilter can rule out; all others are always kept
+pub const FILTERED: u32 =
+    formats::JSON_LD | formats::MICRODATA | formats::MICROFORMATS | formats::RDFA;
+
+/// Bytes lowercased and searched at a time
+const BLOCK: usize = 4096;
+
+/// Bytes carried over between blocks, so a marker split by a block boundary
+/// is still found; one less than the longest marker
+const OVERLAP: usize = 8;
+
+fn finders() -> &'static [(u32, Finder<'static>)] {
+    static FINDERS: OnceLock<Vec<(u32, Finder<'static>)>> = OnceLock::new();
+    FINDERS.get_or_init(|| {
+        MARKERS
+            .iter()
+            .flat_map(|&(format, needles)| needles.iter().map(move |n| (format, Finder::new(n))))
+            .collect()
+    })
+}
+
+/// The formats of `selected` that `html` may contain
+///
+/// Formats outside [`FILTERED`] are returned as selected. Markers are matched
+/// ASCII case-insensitively, as the HTML parser matches attribute names. The
+/// document is lowercased a block at a time into a stack buffer and each block
+/// searched with SIMD substring finders, stopping as soon as every filtered
+/// format has been seen.
+pub fn formats_present(html: &str, selected: u32) -> u32 {
+    let mut missing = selected & FILTERED;
+    let bytes = html.as_bytes();
+    let mut buf = [0u8; OVERLAP + BLOCK];
+
+    let mut start = 0;
+    while start < bytes.len() && missing != 0 {
+        let from = start.saturating_sub(OVERLAP);
+        let end = bytes.len().min(start + BLOCK);
+        let block = &mut buf[..end - from];
+        block.copy_from_slice(&bytes[from..end]);
+        block.make_ascii_lowercase();
+
+        for (format, finder) in finders() {
+            if missing & format != 0 && finder.find(block).is_some() {
+                missing &= !format;
+            }
+        }
+        start = end;
+    }
+
+    selected & !missing
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_overlap_covers_longest_marker() {
+        let longest = MARKERS.iter().flat_map(|(_, n)| n.iter()).map(|n| n.len()).max();
+        assert_eq!(longest, Some(OVERLAP + 1));
+    }
+
+    #[test]
+    fn test_plain_page_has_no_filtered_formats() {
+        let html = r#"<html><head><title>T</title><meta property="og:title" content="x"></head>
+            <body><p class="high-res width-full">Hello</p></body></html>"#;
+        assert_eq!(formats_present(html, formats::ALL), formats::HEAD);
+    }
+
+    #[test]
+    fn test_markers_found() {
+        let html = r#"<div itemscope><span class="p-name h-card">x</span></div>
+            <script type="application/LD+JSON">{}</script><div VOCAB="https://schema.org/">"#;
+        assert_eq!(formats_present(html, formats::ALL), formats::ALL);
+    }
+
+    #[test]
+    fn test_unselected_formats_stay_unselected() {
+        let html = r#"<div itemscope typeof="Person"></div>"#;
+        let selected = formats::META | formats::RDFA;
+        assert_eq!(formats_present(html, selected), selected);
+        assert_eq!(formats_present("", formats::META), formats::META);
+    }
+
+    #[test]
+    fn test_marker_across_block_boundary() {
+        for split in 1.."itemscope".len() {
+            let mut html = "x".repeat(BLOCK - split);
+            html.push_str("itemscope");
+            html.push_str(&"y".repeat(BLOCK));
+            assert_eq!(formats_present(&html, formats::MICRODATA), formats::MICRODATA, "{split}");
+        }
+    }
+}
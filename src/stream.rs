@@ -0,0 +1,362 @@
+//! Incremental extraction for documents that arrive in chunks
+//!
+//! A [`StreamExtractor`] is fed the body of an HTTP response as it is read.
+//! Each chunk goes straight to the HTML tree builder (see
+//! [`IncrementalParser`]), so the DOM grows as the document arrives and the
+//! raw bytes are not kept; [`StreamExtractor::finish`] completes the tree and
+//! runs the extractors over it.
+//!
+//! Alongside, a resumable scan looks for the end of the head section (see
+//! [`head::find_head_end`]). Head-level results are available from
+//! [`StreamExtractor::head`] as soon as `</head>` (or the first body tag) has
+//! arrived, without waiting for the rest of the page. They only reflect the
+//! head: `<meta>` and `<link rel>` tags count wherever they appear, so the body
+//! can still add to every format. A session therefore only completes early in
+//! head-only mode, where [`StreamExtractor::feed`] reports completion at the
+//! head boundary and the caller can stop reading; the body is never buffered
+//! or parsed.
+
+use std::borrow::Cow;
+
+use crate::extract::{self, formats, ExtractOptions, Extraction};
+use crate::extractors::common::html_utils::{self, IncrementalParser};
+use crate::extractors::head::{self, HeadEnd, HeadScan};
+
+/// Error returned by [`StreamExtractor::finish`]
+#[derive(Debug, thiserror::Error)]
+pub enum StreamError {
+    /// The document is not valid UTF-8
+    #[error("Invalid UTF-8 in document at byte {offset}")]
+    InvalidUtf8 {
+        /// Offset of the first invalid byte
+        offset: usize,
+    },
+}
+
+/// An extraction session over a document that arrives in chunks
+pub struct StreamExtractor {
+    base_url: Option<String>,
+    options: ExtractOptions,
+    lossy: bool,
+    /// The document as fed so far while the end of its head is pending, then
+    /// the head section alone
+    head_bytes: Vec<u8>,
+    /// Where the head boundary scan resumes while it is still pending
+    scan: HeadScan,
+    /// Byte offset where the head section ends, once known
+    head_end: Option<usize>,
+    /// Head-level results, computed on first request after `head_end` is known
+    head: Option<Extraction>,
+    /// Tree builder for the whole document; `None` in head-only mode, which
+    /// parses the head section at the end, and once invalid UTF-8 has made a
+    /// strict session fail
+    parser: Option<IncrementalParser>,
+    /// Start of a UTF-8 sequence cut off by the end of the last chunk
+    partial: Vec<u8>,
+    /// Bytes fed to the tree builder so far
+    fed: usize,
+    /// Offset of the first invalid UTF-8 sequence, in a strict session
+    invalid: Option<usize>,
+}
+
+impl StreamExtractor {
+    /// Start a session
+    ///
+    /// # Arguments
+    /// * `base_url` - Optional base URL for resolving relative URLs
+    /// * `options` - Format selection and parsing options, as for [`extract::extract_all`]
+    pub fn new(base_url: Option<&str>, options: ExtractOptions) -> Self {
+        Self {
+            base_url: base_url.map(str::to_owned),
+            options,
+            lossy: false,
+            head_bytes: Vec::new(),
+            scan: HeadScan::default(),
+            head_end: None,
+            head: None,
+            parser: (!options.head_only).then(IncrementalParser::new),
+            partial: Vec::new(),
+            fed: 0,
+            invalid: None,
+        }
+    }
+
+    /// Replace invalid UTF-8 with U+FFFD instead of failing in [`finish`](Self::finish)
+    pub fn lossy_utf8(mut self, lossy: bool) -> Self {
+        self.lossy = lossy;
+        self
+    }
+
+    /// Append a chunk of the document
+    ///
+    /// Chunks may split tags and multi-byte characters anywhere.
+    ///
+    /// # Returns
+    /// * `bool` - `true` once every requested format is complete (only in
+    ///   head-only mode, at the end of the head); further chunks are ignored
+    ///   and the caller can stop reading the document
+    pub fn feed(&mut self, chunk: &[u8]) -> bool {
+        if self.is_complete() {
+            return true;
+        }
+
+        if self.head_end.is_none() {
+            self.head_bytes.extend_from_slice(chunk);
+            match head::find_head_end(&self.head_bytes, self.scan) {
+                HeadEnd::Found(end) => {
+                    // Only the head section is looked at again, and only if
+                    // head-level formats were requested or the body is ignored
+                    self.head_end = Some(end);
+                    if self.options.head_only || self.options.formats & formats::HEAD != 0 {
+                        self.head_bytes.truncate(end);
+                        self.head_bytes.shrink_to_fit();
+                    } else {
+                        self.head_bytes = Vec::new();
+                    }
+                }
+                HeadEnd::Pending(scan) => self.scan = scan,
+            }
+        }
+
+        self.push(chunk);
+        self.is_complete()
+    }
+
+    // Decode `chunk` and hand it to the tree builder, holding back a character
+    // cut off at its end until the next chunk completes it
+    fn push(&mut self, chunk: &[u8]) {
+        let Some(parser) = self.parser.as_mut() else {
+            return;
+        };
+
+        let mut offset = self.fed - self.partial.len();
+        self.fed += chunk.len();
+
+        let joined;
+        let mut rest = if self.partial.is_empty() {
+            chunk
+        } else {
+            joined = [std::mem::take(&mut self.partial).as_slice(), chunk].concat();
+            &joined[..]
+        };
+
+        loop {
+            let err = match std::str::from_utf8(rest) {
+                Ok(text) => {
+                    parser.push(text);
+                    return;
+                }
+                Err(err) => err,
+            };
+            let (valid, after) = rest.split_at(err.valid_up_to());
+            // SAFETY: from_utf8 has checked everything before `valid_up_to`
+            parser.push(unsafe { std::str::from_utf8_unchecked(valid) });
+
+            let Some(len) = err.error_len() else {
+                self.partial = after.to_vec();
+                return;
+            };
+            if !self.lossy {
+                // The session can only fail from here on
+                self.invalid = Some(offset + valid.len());
+                self.parser = None;
+                return;
+            }
+            parser.push("\u{fffd}");
+            offset += valid.len() + len;
+            rest = &after[len..];
+        }
+    }
+
+    /// Whether the end of the head section has arrived
+    pub fn head_complete(&self) -> bool {
+        self.head_end.is_some()
+    }
+
+    /// Whether every requested format has been seen in full
+    ///
+    /// Only a head-only session completes before [`finish`](Self::finish).
+    pub fn is_complete(&self) -> bool {
+        self.options.head_only && self.head_end.is_some()
+    }
+
+    /// Head-level results, once the end of the head section has arrived
+    ///
+    /// Only the requested formats in [`formats::HEAD`] are filled in, from the
+    /// head section alone; [`finish`](Self::finish) also takes the tags in the
+    /// body into account. Returns `None` while the head is still incomplete or
+    /// if it is not valid UTF-8 (and the session is not lossy).
+    pub fn head(&mut self) -> Option<&Extraction> {
+        if self.head.is_none() {
+            self.head_end?;
+            let head = text(&self.head_bytes, self.lossy).ok()?;
+            let document = html_utils::parse_html(&head);
+            self.head = Some(extract::extract_from_document(
+                &document,
+                self.base_url.as_deref(),
+                self.options.formats & formats::HEAD,
+            ));
+        }
+        self.head.as_ref()
+    }
+
+    /// End the session and extract every requested format
+    ///
+    /// Equivalent to [`extract::extract_all`] over everything fed so far, or
+    /// over the head section alone in head-only mode. [`ExtractOptions::limits`]
+    /// do not apply.
+    pub fn finish(self) -> Result<Extraction, StreamError> {
+        if let Some(offset) = self.invalid {
+            return Err(StreamError::InvalidUtf8 { offset });
+        }
+
+        let document = match self.parser {
+            Some(mut parser) => {
+                if !self.partial.is_empty() {
+                    // The document ends inside a character
+                    if !self.lossy {
+                        let offset = self.fed - self.partial.len();
+                        return Err(StreamError::InvalidUtf8 { offset });
+                    }
+                    parser.push("\u{fffd}");
+                }
+                parser.finish()
+            }
+            None => {
+                let head = text(&self.head_bytes, self.lossy)
+                    .map_err(|offset| StreamError::InvalidUtf8 { offset })?;
+                html_utils::parse_html(&head)
+            }
+        };
+
+        Ok(extract::extract_from_document(
+            &document,
+            self.base_url.as_deref(),
+            self.options.formats,
+        ))
+    }
+}
+
+// `bytes` as text, or the offset of the first invalid byte unless `lossy`
+fn text(bytes: &[u8], lossy: bool) -> Result<Cow<'_, str>, usize> {
+    match std::str::from_utf8(bytes) {
+        Ok(text) => Ok(Cow::Borrowed(text)),
+        Err(_) if lossy => Ok(String::from_utf8_lossy(bytes)),
+        Err(err) => Err(err.valid_up_to()),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const HTML: &str = r#"<html><head>
+        <title>Streamed</title>
+        <meta property="og:title" content="OG">
+        <script type="application/ld+json">{"@type": "Article"}</script>
+        </head><body><a rel="me" href="https://example.com/me">me</a></body></html>"#;
+
+    fn feed_in_chunks(stream: &mut StreamExtractor, html: &str, size: usize) -> Option<usize> {
+        for (i, chunk) in html.as_bytes().chunks(size).enumerate() {
+            if stream.feed(chunk) {
+                return Some(i);
+            }
+        }
+        None
+    }
+
+    #[test]
+    fn test_head_only_completes_at_head_end() {
+        let options = ExtractOptions {
+            head_only: true,
+            formats: formats::META | formats::OPEN_GRAPH | formats::JSON_LD,
+            ..Default::default()
+        };
+        let mut stream = StreamExtractor::new(None, options);
+
+        let done_at = feed_in_chunks(&mut stream, HTML, 7).expect("completes before the end");
+        assert!(done_at < HTML.len() / 7);
+        assert!(stream.is_complete());
+
+        let out = stream.finish().unwrap();
+        assert_eq!(out.meta.unwrap().title, Some("Streamed".to_string()));
+        assert_eq!(out.open_graph.unwrap().title, Some("OG".to_string()));
+        assert!(out.json_ld.is_some());
+        assert!(out.rel_links.is_none());
+    }
+
+    #[test]
+    fn test_head_formats_see_the_body() {
+        // Head-level tags placed in the body, as templates often do
+        let html = r#"<html><head><title>T</title></head><body>
+            <meta name="description" content="Body description">
+            <meta property="og:title" content="Body OG">
+            <link rel="canonical" href="/canonical">
+            <p>text</p></body></html>"#;
+        let options = ExtractOptions { formats: formats::HEAD, ..Default::default() };
+
+        let mut stream = StreamExtractor::new(Some("https://example.com/"), options);
+        assert_eq!(feed_in_chunks(&mut stream, html, 9), None, "the body can still add tags");
+        let head = stream.head().unwrap();
+        assert_eq!(head.open_graph.as_ref().and_then(|og| og.title.as_deref()), None);
+
+        let streamed = serde_json::to_value(stream.finish().unwrap()).unwrap();
+        let whole = extract::extract_all(html, Some("https://example.com/"), &options);
+        assert_eq!(streamed, serde_json::to_value(&whole).unwrap());
+        assert_eq!(streamed["openGraph"]["title"], "Body OG");
+    }
+
+    #[test]
+    fn test_body_formats_wait_for_finish() {
+        let mut stream = StreamExtractor::new(None, ExtractOptions::default());
+        assert_eq!(feed_in_chunks(&mut stream, HTML, 5), None);
+        assert!(!stream.is_complete());
+
+        // Head results are available early, without body-level rel links
+        let head = stream.head().expect("head has arrived").clone();
+        assert!(head.meta.is_some());
+        assert!(head.json_ld.is_none());
+        assert!(head.rel_links.is_none());
+
+        let out = stream.finish().unwrap();
+        assert!(out.json_ld.is_some());
+        assert!(out.rel_links.unwrap().contains_key("me"));
+    }
+
+    #[test]
+    fn test_head_pending_until_boundary() {
+        let mut stream = StreamExtractor::new(None, ExtractOptions::default());
+        assert!(!stream.feed(b"<html><head><title>Par"));
+        assert!(stream.head().is_none());
+        assert!(!stream.feed(b"tial</title></he"));
+        assert!(stream.head().is_none());
+        stream.feed(b"ad><body>");
+        assert_eq!(
+            stream.head().unwrap().meta.as_ref().unwrap().title,
+            Some("Partial".to_string())
+        );
+    }
+
+    #[test]
+    fn test_split_utf8_and_invalid_input() {
+        let html = "<title>Caf\u{e9}</title>".as_bytes();
+        let (a, b) = html.split_at(11); // inside the two-byte 'é'
+        let mut stream = StreamExtractor::new(None, ExtractOptions::default());
+        stream.feed(a);
+        stream.feed(b);
+        assert_eq!(stream.finish().unwrap().meta.unwrap().title, Some("Caf\u{e9}".to_string()));
+
+        let mut stream = StreamExtractor::new(None, ExtractOptions::default());
+        stream.feed(b"<title>\xff</title>");
+        assert!(matches!(stream.finish(), Err(StreamError::InvalidUtf8 { offset: 7 })));
+
+        let mut stream = StreamExtractor::new(None, ExtractOptions::default()).lossy_utf8(true);
+        stream.feed(b"<title>\xff</title>");
+        assert_eq!(stream.finish().unwrap().meta.unwrap().title, Some("\u{fffd}".to_string()));
+
+        // A character cut off by the end of the document
+        let mut stream = StreamExtractor::new(None, ExtractOptions::default());
+        stream.feed(&a[..11]);
+        assert!(matches!(stream.finish(), Err(StreamError::InvalidUtf8 { offset: 10 })));
+    }
+}
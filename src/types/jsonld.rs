@@ -7,9 +7,11 @@
 use pyo3::prelude::*;
 #[cfg(feature = "python")]
 use pyo3::types::PyDict;
-use serde::{Deserialize, Serialize};
+use serde::de::{MapAccess, Visitor};
+use serde::{Deserialize, Deserializer, Serialize};
 use serde_json::Value;
 use std::collections::HashMap;
+use std::fmt;
 
 /// Helper module for deserializing numeric values that might be strings or numbers
 mod string_or_number {
@@ -65,7 +67,7 @@ mod string_or_int {
 ///
 /// JSON-LD objects can be of any Schema.org type (Article, Product, Person, etc.)
 /// and may contain nested objects and arrays.
-#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+#[derive(Debug, Clone, PartialEq, Serialize)]
 pub struct JsonLdObject {
     /// @context - usually "https://schema.org" or similar
     #[serde(rename = "@context")]
@@ -88,6 +90,48 @@ pub struct JsonLdObject {
     pub properties: HashMap<String, Value>,
 }
 
+// Deserialized by hand: `#[serde(flatten)]` would buffer every object into
+// an intermediate tree, copying each key and value, before sorting out the
+// `@` fields. This reads each entry once, straight from the input.
+impl<'de> Deserialize<'de> for JsonLdObject {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        struct ObjectVisitor;
+
+        impl<'de> Visitor<'de> for ObjectVisitor {
+            type Value = JsonLdObject;
+
+            fn expecting(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                f.write_str("a JSON-LD object")
+            }
+
+            fn visit_map<A: MapAccess<'de>>(self, mut map: A) -> Result<JsonLdObject, A::Error> {
+                let mut object = JsonLdObject {
+                    context: None,
+                    type_: None,
+                    id: None,
+                    graph: None,
+                    properties: HashMap::with_capacity(map.size_hint().unwrap_or(0)),
+                };
+                while let Some(key) = map.next_key::<String>()? {
+                    match key.as_str() {
+                        "@context" => object.context = map.next_value()?,
+                        "@type" => object.type_ = map.next_value()?,
+                        "@id" => object.id = map.next_value()?,
+                        "@graph" => object.graph = map.next_value()?,
+                        _ => {
+                            let value = map.next_value()?;
+                            object.properties.insert(key, value);
+                        }
+                    }
+                }
+                Ok(object)
+            }
+        }
+
+        deserializer.deserialize_map(ObjectVisitor)
+    }
+}
+
 /// Article type (most common JSON-LD type)
 #[derive(Debug, Clone, PartialEq, Serialize, Deserialize, Default)]
 pub struct Article {
@@ -935,6 +979,27 @@ mod tests {
         assert_eq!(graph.len(), 2);
     }
 
+    #[test]
+    fn test_jsonld_object_round_trip() {
+        let json = r#"{"@context":null,"@type":["A","B"],"@id":"x","n":{"@type":"C"},"k":[1]}"#;
+
+        let obj: JsonLdObject = serde_json::from_str(json).unwrap();
+        assert!(obj.context.is_none());
+        assert_eq!(obj.id.as_deref(), Some("x"));
+        assert_eq!(obj.properties.len(), 2);
+        assert_eq!(obj.properties["n"]["@type"], "C");
+
+        let again: JsonLdObject =
+            serde_json::from_str(&serde_json::to_string(&obj).unwrap()).unwrap();
+        assert_eq!(again, obj);
+    }
+
+    #[test]
+    fn test_jsonld_object_rejects_non_objects() {
+        assert!(serde_json::from_str::<JsonLdObject>("[]").is_err());
+        assert!(serde_json::from_str::<JsonLdObject>(r#"{"@id": 5}"#).is_err());
+    }
+
     #[test]
     fn test_article_deserialization() {
         let json = r#"{
@@ -111,13 +111,10 @@ pub struct RobotsDirective {
 impl RobotsDirective {
     /// Parse robots meta content into structured directive
     pub fn parse(content: &str) -> Self {
-        let content_lower = content.to_lowercase();
-        let directives: Vec<&str> = content_lower.split(',').map(|s| s.trim()).collect();
-
         let mut directive = RobotsDirective { raw: content.to_string(), ..Default::default() };
 
-        for d in directives {
-            match d {
+        for d in content.split(',').map(str::trim) {
+            match crate::html_utils::ascii_lowercase(d).as_ref() {
                 "index" => directive.index = Some(true),
                 "noindex" => directive.index = Some(false),
                 "follow" => directive.follow = Some(true),
@@ -394,6 +394,406 @@ TEST(test_basic_thread_safety) {
     meta_oxide_result_free(r2);
 }
 
+// Test 29: Head-only extraction skips the body
+TEST(test_extract_all_head_only) {
+    MetaOxideOptions options = {0};
+    options.head_only = true;
+
+    MetaOxideResult* result = meta_oxide_extract_all_with_options(RICH_HTML, NULL, &options);
+    ASSERT_NOT_NULL(result, "extract_all_with_options should succeed");
+    ASSERT_NOT_NULL(result->meta, "meta should be extracted from head");
+    ASSERT_NOT_NULL(result->open_graph, "open_graph should be extracted from head");
+    ASSERT_NOT_NULL(result->json_ld, "JSON-LD in head should be extracted");
+    ASSERT_NULL(result->microformats, "body microformats should be skipped");
+    ASSERT_NULL(result->microdata, "body microdata should be skipped");
+    meta_oxide_result_free(result);
+
+    result = meta_oxide_extract_all_with_options(RICH_HTML, NULL, NULL);
+    ASSERT_NOT_NULL(result, "NULL options should behave like extract_all");
+    ASSERT_NOT_NULL(result->microdata, "microdata should be extracted by default");
+    meta_oxide_result_free(result);
+}
+
+// Test 30: Format selection
+TEST(test_extract_selected) {
+    MetaOxideResult* result = meta_oxide_extract_selected(
+        RICH_HTML, NULL, META_OXIDE_FMT_OPEN_GRAPH | META_OXIDE_FMT_MICRODATA);
+    ASSERT_NOT_NULL(result, "extract_selected should succeed");
+    ASSERT_NOT_NULL(result->open_graph, "selected open_graph should be extracted");
+    ASSERT_NOT_NULL(result->microdata, "selected microdata should be extracted");
+    ASSERT_NULL(result->meta, "unselected meta should be NULL");
+    ASSERT_NULL(result->json_ld, "unselected JSON-LD should be NULL");
+    meta_oxide_result_free(result);
+
+    MetaOxideOptions options = {0};
+    options.formats = META_OXIDE_FMT_META;
+
+    result = meta_oxide_extract_all_with_options(RICH_HTML, NULL, &options);
+    ASSERT_NOT_NULL(result, "extract_all_with_options should succeed");
+    ASSERT_NOT_NULL(result->meta, "selected meta should be extracted");
+    ASSERT_NULL(result->open_graph, "unselected open_graph should be NULL");
+    meta_oxide_result_free(result);
+}
+
+// Test 31: Batch extraction with per-document errors
+TEST(test_extract_batch) {
+    MetaOxideInput docs[3] = {
+        {SIMPLE_HTML, NULL},
+        {NULL, NULL},
+        {RICH_HTML, "https://example.com"},
+    };
+    MetaOxideResult* out[3];
+    int errors[3];
+
+    meta_oxide_set_thread_count(2);
+    ASSERT(meta_oxide_thread_count() == 2, "thread count should be configurable");
+
+    int status = meta_oxide_extract_batch(docs, 3, NULL, out, errors);
+    ASSERT(status == 0, "batch should succeed");
+    ASSERT(errors[0] == 0, "first document should succeed");
+    ASSERT(errors[1] != 0, "NULL document should report an error");
+    ASSERT(errors[2] == 0, "third document should succeed");
+    ASSERT_NOT_NULL(out[0], "first result should be set");
+    ASSERT_NULL(out[1], "failed document should have no result");
+    ASSERT_NOT_NULL(out[2], "third result should be set");
+    ASSERT_NOT_NULL(out[2]->open_graph, "batch results should be fully extracted");
+
+    for (int i = 0; i < 3; i++) {
+        meta_oxide_result_free(out[i]);
+    }
+
+    status = meta_oxide_extract_batch(NULL, 1, NULL, out, NULL);
+    ASSERT(status != 0, "NULL docs should fail");
+}
+
+// Test 32: Length-delimited input
+TEST(test_extract_all_n) {
+    // A slice of a larger buffer, with an embedded NUL byte
+    const char buffer[] = "<title>Slice\0Title</title><meta name=\"description\" content=\"D\">TRAILING";
+    size_t len = sizeof(buffer) - 1 - strlen("TRAILING");
+
+    MetaOxideResult* result = meta_oxide_extract_all_n(buffer, len, NULL, 0, 0);
+    ASSERT_NOT_NULL(result, "extract_all_n should accept embedded NUL bytes");
+    ASSERT_NOT_NULL(result->meta, "meta should be extracted");
+    ASSERT(strstr(result->meta, "TRAILING") == NULL, "bytes past len should be ignored");
+    meta_oxide_result_free(result);
+
+    const char invalid[] = "<title>Caf\xE9</title>";
+    char* meta = meta_oxide_extract_meta_n(invalid, sizeof(invalid) - 1, NULL, 0, 0);
+    ASSERT_NULL(meta, "invalid UTF-8 should be rejected by default");
+    ASSERT(meta_oxide_last_error() == 3, "error should be InvalidUtf8");
+
+    meta = meta_oxide_extract_meta_n(invalid, sizeof(invalid) - 1, NULL, 0, META_OXIDE_INPUT_LOSSY);
+    ASSERT_NOT_NULL(meta, "lossy mode should accept invalid UTF-8");
+    meta_oxide_string_free(meta);
+}
+
+// Test 33: Streaming extraction stops once the head has arrived
+TEST(test_stream) {
+    MetaOxideOptions options = {0};
+    options.formats = META_OXIDE_FMT_META | META_OXIDE_FMT_OPEN_GRAPH;
+    options.head_only = true;
+
+    MetaOxideStream = meta_oxide_stream_new(NULL, &options);
+    ASSERT_NOT_NULL(stream, "stream_new should return a session");
+
+    const char* first = "<html><head><title>Stre";
+    const char* second = "amed</title></head><body>never needed</body>";
+    ASSERT(meta_oxide_stream_feed(stream, first, strlen(first)) == META_OXIDE_STREAM_NEED_MORE,
+           "a partial head should need more input");
+    ASSERT_NULL(meta_oxide_stream_head(stream), "head results should wait for the head");
+    ASSERT(meta_oxide_stream_feed(stream, second, strlen(second)) == META_OXIDE_STREAM_DONE,
+           "head-only sessions should be complete after </head>");
+
+    MetaOxideResult* head = meta_oxide_stream_head(stream);
+    ASSERT_NOT_NULL(head, "head results should be available early");
+    ASSERT(strstr(head->meta, "Streamed") != NULL, "title should span both chunks");
+    meta_oxide_result_free(head);
+
+    MetaOxideResult* result = meta_oxide_stream_finish(stream);
+    ASSERT_NOT_NULL(result, "stream_finish should return a result");
+    ASSERT_NULL(result->json_ld, "unselected formats should be NULL");
+    meta_oxide_result_free(result);
+}
+
+// Test 34: Context-owned results released by reset
+TEST(test_context) {
+    MetaOxideContext* ctx = meta_oxide_context_new();
+    ASSERT_NOT_NULL(ctx, "context_new should return a context");
+
+    const MetaOxideResult* first = meta_oxide_context_extract_all(ctx, "<title>First</title>", NULL, NULL);
+    const MetaOxideResult* second = meta_oxide_context_extract_all(ctx, "<title>Second</title>", NULL, NULL);
+    ASSERT_NOT_NULL(first, "context_extract_all should return a result");
+    ASSERT_NOT_NULL(second, "context_extract_all should return a result");
+    ASSERT(strstr(first->meta, "First") != NULL, "earlier results stay valid until reset");
+    ASSERT(strstr(second->meta, "Second") != NULL, "second result should be extracted");
+
+    meta_oxide_context_reset(ctx);
+    const MetaOxideResult* again = meta_oxide_context_extract_all(ctx, "<title>Again</title>", NULL, NULL);
+    ASSERT_NOT_NULL(again, "context should be reusable after reset");
+    ASSERT(strstr(again->meta, "Again") != NULL, "reused context should extract");
+
+    meta_oxide_context_free(ctx);
+}
+
+// Test 35: Typed results without JSON
+TEST(test_extract_typed) {
+    const char* html =
+        "<html><head><title>Typed</title>"
+        "<meta property=\"og:title\" content=\"OG\">"
+        "<script type=\"application/ld+json\">"
+        "{\"@type\": \"Article\", \"author\": {\"@type\": \"Person\", \"name\": \"Jane\"}}"
+        "</script></head></html>";
+
+    MetaOxideTypedResult* result = meta_oxide_extract_typed(html, NULL, NULL);
+    ASSERT_NOT_NULL(result, "extract_typed should return a handle");
+
+    const MetaOxideMetaTags* meta = meta_oxide_typed_meta(result);
+    ASSERT_NOT_NULL(meta, "meta tags should be extracted");
+    ASSERT(meta->title.len == 5 && strncmp(meta->title.ptr, "Typed", 5) == 0, "title should be borrowed");
+
+    const MetaOxideOpenGraph* og = meta_oxide_typed_open_graph(result);
+    ASSERT_NOT_NULL(og, "Open Graph should be extracted");
+    ASSERT(og->title.len == 2, "og:title should be extracted");
+
+    ASSERT(meta_oxide_item_count(result, META_OXIDE_FMT_JSON_LD) == 1, "one JSON-LD item");
+    const MetaOxideItem* article = meta_oxide_item(result, META_OXIDE_FMT_JSON_LD, 0);
+    const MetaOxideValue* author = meta_oxide_item_prop(article, "author", 0);
+    ASSERT_NOT_NULL(author, "author property should exist");
+    ASSERT_NOT_NULL(author->item, "author should be a nested item");
+    const MetaOxideValue* name = meta_oxide_item_prop(author->item, "name", 0);
+    ASSERT(name != NULL && strncmp(name->text.ptr, "Jane", name->text.len) == 0, "nested property");
+
+    meta_oxide_typed_result_free(result);
+}
+
+// Test 36: Single contiguous result buffer
+TEST(test_extract_buffer) {
+    const char* html =
+        "<html><head><title>Buffered</title>"
+        "<meta property=\"og:title\" content=\"OG\"></head></html>";
+    size_t len = strlen(html);
+
+    MetaOxideBuffer owned;
+    int status = meta_oxide_extract_all_buffer(html, len, NULL, 0, NULL, &owned);
+    ASSERT(status == 0, "extract_all_buffer should succeed");
+    ASSERT(owned.data[0] == '{' && strlen(owned.data) == owned.len, "combined JSON document");
+    ASSERT(owned.open_graph.len > 0, "Open Graph span should be set");
+    ASSERT(owned.json_ld.len == 0, "absent formats have empty spans");
+    ASSERT(strncmp(owned.data + owned.open_graph.offset, "{", 1) == 0, "span points at the value");
+
+    // Measure first, then write into a caller buffer
+    MetaOxideBuffer view;
+    status = meta_oxide_extract_all_into(html, len, NULL, 0, NULL, NULL, 0, &view);
+    ASSERT(status == 7, "an empty buffer is too small");
+    ASSERT(view.len == owned.len, "required length should be reported");
+
+    char* storage = malloc(view.len + 1);
+    status = meta_oxide_extract_all_into(html, len, NULL, 0, NULL, storage, view.len + 1, &view);
+    ASSERT(status == 0, "extract_all_into should succeed");
+    ASSERT(view.data == storage && strcmp(storage, owned.data) == 0, "same document in caller memory");
+
+    free(storage);
+    meta_oxide_buffer_free(&owned);
+    ASSERT(owned.data == NULL, "buffer_free should reset the struct");
+}
+
+// Test 37: Allocator hooks and caller-provided output buffers
+static size_t hook_live = 0;
+
+static void* counting_malloc(size_t size, void* user_data) {
+    (*(size_t*) user_data)++;
+    hook_live++;
+    return malloc(size);
+}
+
+static void counting_free(void* ptr, void* user_data) {
+    (void) user_data;
+    hook_live--;
+    free(ptr);
+}
+
+TEST(test_allocator_and_into) {
+    const char* html = "<html><head><title>Hooked</title></head></html>";
+    size_t calls = 0;
+
+    ASSERT(meta_oxide_set_allocator(counting_malloc, NULL, NULL) == 6, "hooks must be set together");
+    ASSERT(meta_oxide_set_allocator(counting_malloc, counting_free, &calls) == 0, "set_allocator should succeed");
+
+    MetaOxideResult* result = meta_oxide_extract_all(html, NULL);
+    ASSERT_NOT_NULL(result, "extract_all should work with custom hooks");
+    ASSERT(calls > 0 && hook_live > 0, "result strings should come from the hook");
+    meta_oxide_result_free(result);
+    ASSERT(hook_live == 0, "result_free should release through the hook");
+
+    ASSERT(meta_oxide_set_allocator(NULL, NULL, NULL) == 0, "default allocator should be restored");
+
+    // Measure, then write into a reusable buffer
+    size_t needed = 0;
+    ASSERT(meta_oxide_extract_meta_into(html, NULL, NULL, 0, &needed) == 7, "empty buffer is too small");
+    char buf[512];
+    ASSERT(needed <= sizeof(buf), "meta JSON should fit the scratch buffer");
+    ASSERT(meta_oxide_extract_meta_into(html, NULL, buf, sizeof(buf), &needed) == 0, "extract_meta_into should succeed");
+    ASSERT(strlen(buf) + 1 == needed && strstr(buf, "Hooked") != NULL, "meta JSON written in place");
+}
+
+// Test 38: Per-call statistics
+TEST(test_extract_stats) {
+    const char* html = "<html><head><title>Stats</title>"
+                       "<script type=\"application/ld+json\">[{\"@type\": \"A\"}, {\"@type\": \"B\"}]</script>"
+                       "</head></html>";
+    MetaOxideStats stats;
+    memset(&stats, 0xff, sizeof(stats));
+    MetaOxideOptions options = {0};
+    options.formats = META_OXIDE_FMT_META | META_OXIDE_FMT_JSON_LD;
+    options.stats = &stats;
+
+    MetaOxideResult* result = meta_oxide_extract_all_with_options(html, NULL, &options);
+    ASSERT_NOT_NULL(result, "extract_all_with_options should succeed");
+    size_t output = strlen(result->meta) + strlen(result->json_ld);
+    meta_oxide_result_free(result);
+
+    ASSERT(stats.input_bytes == strlen(html), "input_bytes should be the document length");
+    ASSERT(stats.output_bytes == output, "output_bytes should cover every JSON field");
+    ASSERT(stats.dom_nodes > 0, "dom_nodes should be counted");
+    ASSERT(stats.items[3] == 2 && stats.items[0] == 1, "items should be counted per format");
+    ASSERT(stats.format_ns[6] == 0 && stats.items[6] == 0, "unselected formats should report 0");
+    ASSERT(stats.total_ns >= stats.parse_ns + stats.serialize_ns, "total_ns should cover every stage");
+}
+
+// Test 39: Resource limits return partial results
+TEST(test_extract_limits) {
+    char html[4096] = "<html><head><title>Kept</title></head><body>";
+    for (int i = 0; i < 200; i++) {
+        strcat(html, "<p>x</p>");
+    }
+    strcat(html, "</body></html>");
+
+    MetaOxideLimits limits = {0};
+    limits.max_tags = 8;
+    MetaOxideOptions options = {0};
+    options.limits = &limits;
+
+    MetaOxideResult* result = meta_oxide_extract_all_with_options(html, NULL, &options);
+    ASSERT_NOT_NULL(result, "a hit limit should still return a result");
+    ASSERT(meta_oxide_last_error() == 8, "last error should be LimitExceeded");
+    ASSERT(result->meta != NULL && strstr(result->meta, "Kept") != NULL, "head results should survive");
+    meta_oxide_result_free(result);
+
+    limits.max_tags = 0;
+    result = meta_oxide_extract_all_with_options(html, NULL, &options);
+    ASSERT(meta_oxide_last_error() == 0, "zeroed limits should not limit anything");
+    meta_oxide_result_free(result);
+}
+
+// Test 40: The result cache answers repeated calls
+TEST(test_result_cache) {
+    const char* html = "<html><head><title>Cached</title></head><body></body></html>";
+    meta_oxide_cache_configure(1 << 20);
+
+    for (int i = 0; i < 2; i++) {
+        MetaOxideResult* result = meta_oxide_extract_all(html, NULL);
+        ASSERT_NOT_NULL(result, "cached extraction should succeed");
+        ASSERT(strstr(result->meta, "Cached") != NULL, "cached result should match");
+        meta_oxide_result_free(result);
+    }
+
+    MetaOxideCacheStats stats = meta_oxide_cache_stats();
+    ASSERT(stats.misses == 1, "first call should miss");
+    ASSERT(stats.hits == 1, "second call should hit");
+    ASSERT(stats.entries == 1 && stats.bytes > 0, "one entry should be stored");
+
+    meta_oxide_cache_configure(0);
+    stats = meta_oxide_cache_stats();
+    ASSERT(stats.hits == 0 && stats.entries == 0, "disabling should clear the counters");
+}
+
+// Test 41: MessagePack output has the same layout as the JSON document
+TEST(test_extract_msgpack) {
+    const char* html = "<html><head><title>Packed</title>"
+                       "<meta property=\"og:title\" content=\"OG\"></head></html>";
+    size_t len = strlen(html);
+
+    MetaOxideBuffer json;
+    int status = meta_oxide_extract_all_buffer(html, len, NULL, 0, NULL, &json);
+    ASSERT(status == 0, "JSON extraction should succeed");
+
+    MetaOxideOptions options = {0};
+    options.encoding = META_OXIDE_ENCODING_MSGPACK;
+    MetaOxideBuffer packed;
+    status = meta_oxide_extract_all_buffer(html, len, NULL, 0, &options, &packed);
+    ASSERT(status == 0, "MessagePack extraction should succeed");
+    ASSERT(((unsigned char) packed.data[0] & 0xf0) == 0x80, "document should be a map");
+    ASSERT(packed.len < json.len, "MessagePack should be smaller than JSON");
+    ASSERT(packed.open_graph.len > 0 && packed.json_ld.len == 0, "spans should match the formats found");
+    ASSERT(((unsigned char) packed.data[packed.open_graph.offset] & 0xf0) == 0x80,
+           "Open Graph span should point at a map");
+
+    MetaOxideBuffer view;
+    char storage[1024];
+    status = meta_oxide_extract_all_into(html, len, NULL, 0, &options, storage, sizeof storage, &view);
+    ASSERT(status == 0 && view.len == packed.len, "caller buffer should get the same document");
+    ASSERT(memcmp(storage, packed.data, packed.len) == 0, "documents should be identical");
+
+    options.encoding = 99;
+    MetaOxideBuffer unknown;
+    status = meta_oxide_extract_all_buffer(html, len, NULL, 0, &options, &unknown);
+    ASSERT(status != 0 && unknown.data == NULL, "unknown encodings should be rejected");
+
+    meta_oxide_buffer_free(&json);
+    meta_oxide_buffer_free(&packed);
+}
+
+// Test 42: Non-UTF-8 pages are decoded in their declared encoding
+TEST(test_detect_encoding) {
+    // "Привет" in windows-1251, declared by a <meta> tag
+    const char* html = "<html><head><meta charset=\"windows-1251\">"
+                       "<title>\xcf\xf0\xe8\xe2\xe5\xf2</title></head></html>";
+    size_t len = strlen(html);
+
+    MetaOxideResult* result = meta_oxide_extract_all_n(html, len, NULL, 0, 0);
+    ASSERT(result == NULL, "invalid UTF-8 should be rejected without the flag");
+
+    result = meta_oxide_extract_all_n(html, len, NULL, 0, META_OXIDE_INPUT_DETECT_ENCODING);
+    ASSERT(result != NULL, "detected extraction should succeed");
+    ASSERT(strstr(result->meta, "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82") != NULL,
+           "title should be transcoded to UTF-8");
+    meta_oxide_result_free(result);
+
+    // A Content-Type header outranks the <meta> declaration
+    MetaOxideOptions options = {0};
+    options.input_flags = META_OXIDE_INPUT_DETECT_ENCODING;
+    options.content_type = "text/html; charset=ISO-8859-1";
+    result = meta_oxide_extract_all_with_options_n(html, len, NULL, 0, &options);
+    ASSERT(result != NULL, "hinted extraction should succeed");
+    ASSERT(strstr(result->meta, "\xc3\x8f\xc3\xb0") != NULL, "title should be read as Latin-1");
+    meta_oxide_result_free(result);
+}
+
+// Test 43: JSON-LD filtered by @type keeps only the requested objects
+TEST(test_extract_json_ld_filtered) {
+    const char* html = "<script type=\"application/ld+json\">{\"@graph\": ["
+                       "{\"@type\": \"ItemList\", \"numberOfItems\": 2},"
+                       "{\"@type\": \"Product\", \"name\": \"Shoe\", \"sku\": \"S1\"}"
+                       "]}</script>";
+    const char* types[] = {"Product"};
+    const char* props[] = {"name"};
+
+    char* json = meta_oxide_extract_json_ld_filtered(html, NULL, types, 1, NULL, 0);
+    ASSERT(json != NULL, "filtered extraction should succeed");
+    ASSERT(strstr(json, "Shoe") != NULL && strstr(json, "S1") != NULL, "Product should be kept");
+    ASSERT(strstr(json, "ItemList") == NULL, "ItemList should be dropped");
+    meta_oxide_string_free(json);
+
+    json = meta_oxide_extract_json_ld_filtered(html, NULL, types, 1, props, 1);
+    ASSERT(json != NULL, "projected extraction should succeed");
+    ASSERT(strstr(json, "Shoe") != NULL && strstr(json, "S1") == NULL, "only name should be kept");
+    meta_oxide_string_free(json);
+
+    json = meta_oxide_extract_json_ld_filtered(html, NULL, NULL, 1, NULL, 0);
+    ASSERT(json == NULL, "a NULL type array should be rejected");
+}
+
 // Main test runner
 int main(void) {
     printf("=================================\n");
@@ -429,6 +829,21 @@ int main(void) {
     test_base_url_resolution();
     test_multiple_json_ld();
     test_basic_thread_safety();
+    test_extract_all_head_only();
+    test_extract_selected();
+    test_extract_batch();
+    test_extract_all_n();
+    test_stream();
+    test_context();
+    test_extract_typed();
+    test_extract_buffer();
+    test_allocator_and_into();
+    test_extract_stats();
+    test_extract_limits();
+    test_result_cache();
+    test_extract_msgpack();
+    test_detect_encoding();
+    test_extract_json_ld_filtered();
 
     // Print summary
     printf("\n=================================\n");
@@ -0,0 +1,200 @@
+/**
+ * MetaOxide C API Throughput Benchmark
+ *
+ * Runs meta_oxide_extract_all() over one document from a number of threads
+ * and reports throughput and p50/p99 latency for each thread count.
+ *
+ * Build:
+ *   gcc -O2 -I../include -L../target/release -o c_bench c_bench.c -lmeta_oxide -lpthread -ldl -lm
+ *
+ * Run:
+ *   LD_LIBRARY_PATH=../target/release ./c_bench [-n iterations] [-s bytes] [-t 1,2,4,8] file.html
+ *
+ *   -n  extractions per thread (default 2000)
+ *   -s  repeat the document body until it is at least this many bytes, as
+ *       the Rust benchmarks do for their medium and large documents
+ *   -t  comma-separated thread counts (default 1,2,4,8)
+ *
+ * Example, using the Rust benchmark corpus:
+ *   ./c_bench -s 102400 ../benches/corpus/product_listing.html
+ */
+
+#include "../include/meta_oxide.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_THREAD_COUNTS 16
+
+typedef struct {
+    const char *html;
+    const char *base_url;
+    size_t iterations;
+    double *latencies;  // nanoseconds, one per iteration
+    size_t failures;
+} Worker;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+static void *run_worker(void *arg) {
+    Worker *w = (Worker *) arg;
+    for (size_t i = 0; i < w->iterations; i++) {
+        double start = now_ns();
+        MetaOxideResult *result = meta_oxide_extract_all(w->html, w->base_url);
+        meta_oxide_result_free(result);
+        w->latencies[i] = now_ns() - start;
+        if (result == NULL) {
+            w->failures++;
+        }
+    }
+    return NULL;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *data = malloc((size_t) size + 1);
+    if (data != NULL && fread(data, 1, (size_t) size, f) != (size_t) size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    if (data != NULL) {
+        data[size] = '\0';
+        *len = (size_t) size;
+    }
+    return data;
+}
+
+// Repeat the body of `page` until the document is at least `target` bytes
+static char *grow(char *page, size_t len, size_t target) {
+    char *open = strstr(page, "<body");
+    char *start = open != NULL ? strchr(open, '>') : NULL;
+    char *end = NULL;
+    for (char *p = page; (p = strstr(p, "</body>")) != NULL; p++) {
+        end = p;
+    }
+    if (start == NULL || end == NULL || end <= start + 1 || len >= target) {
+        return page;
+    }
+    start++;
+
+    size_t head = (size_t) (end - page), body = (size_t) (end - start), tail = len - head;
+    size_t copies = (target - len + body - 1) / body;
+    char *html = malloc(len + copies * body + 1);
+    if (html == NULL) {
+        return page;
+    }
+
+    memcpy(html, page, head);
+    size_t pos = head;
+    for (size_t i = 0; i < copies; i++, pos += body) {
+        memcpy(html + pos, start, body);
+    }
+    memcpy(html + pos, end, tail + 1);
+    free(page);
+    return html;
+}
+
+int main(int argc, char **argv) {
+    size_t iterations = 2000, target = 0;
+    int threads[MAX_THREAD_COUNTS] = {1, 2, 4, 8};
+    int thread_counts = 4;
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            target = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            thread_counts = 0;
+            for (char *tok = strtok(argv[++i], ","); tok != NULL && thread_counts < MAX_THREAD_COUNTS;
+                 tok = strtok(NULL, ",")) {
+                int n = atoi(tok);
+                if (n > 0) {
+                    threads[thread_counts++] = n;
+                }
+            }
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL || iterations == 0 || thread_counts == 0) {
+        fprintf(stderr, "usage: %s [-n iterations] [-s bytes] [-t 1,2,4,8] file.html\n", argv[0]);
+        return 2;
+    }
+
+    size_t len = 0;
+    char *html = read_file(path, &len);
+    if (html == NULL) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+    html = grow(html, len, target);
+    len = strlen(html);
+
+    printf("MetaOxide %s, %s (%zu bytes), %zu extractions per thread\n",
+           meta_oxide_version(), path, len, iterations);
+    printf("%8s %14s %12s %12s %12s\n", "threads", "docs/s", "MB/s", "p50 (us)", "p99 (us)");
+
+    for (int t = 0; t < thread_counts; t++) {
+        int n = threads[t];
+        Worker *workers = calloc((size_t) n, sizeof(Worker));
+        pthread_t *ids = calloc((size_t) n, sizeof(pthread_t));
+        double *latencies = malloc((size_t) n * iterations * sizeof(double));
+        if (workers == NULL || ids == NULL || latencies == NULL) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+
+        // All workers share one document, as a server sharing a page cache would
+        for (int i = 0; i < n; i++) {
+            workers[i] = (Worker) {html, "https://example.com/page", iterations,
+                                   latencies + (size_t) i * iterations, 0};
+        }
+
+        double start = now_ns();
+        for (int i = 0; i < n; i++) {
+            pthread_create(&ids[i], NULL, run_worker, &workers[i]);
+        }
+        size_t failures = 0;
+        for (int i = 0; i < n; i++) {
+            pthread_join(ids[i], NULL);
+            failures += workers[i].failures;
+        }
+        double elapsed = (now_ns() - start) / 1e9;
+
+        size_t total = (size_t) n * iterations;
+        qsort(latencies, total, sizeof(double), compare_double);
+        double docs_per_sec = (double) total / elapsed;
+        printf("%8d %14.0f %12.1f %12.1f %12.1f%s\n", n, docs_per_sec,
+               docs_per_sec * (double) len / (1024.0 * 1024.0),
+               latencies[total / 2] / 1e3, latencies[(total * 99) / 100] / 1e3,
+               failures ? "  (failures)" : "");
+
+        free(latencies);
+        free(ids);
+        free(workers);
+    }
+
+    free(html);
+    return 0;
+}